@@ -26,5 +26,6 @@ class JPetAnalysisTools
 {
 public:
   static std::vector<JPetHit> getHitsOrderedByTime(const std::vector<JPetHit>& hits);
+  static void sortHitsByTime(std::vector<JPetHit>& hits);
 };
 #endif /* !JPETANALYSISTOOLS_H */
@@ -0,0 +1,85 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetChainReader.h
+ */
+
+#ifndef JPETCHAINREADER_H
+#define JPETCHAINREADER_H
+
+#include "./JPetReader/JPetReader.h"
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reader treating a list of ROOT files as one logical input.
+ *
+ * Entries are numbered globally over all files, in the order in which the
+ * files were given, similarly to TChain. To number the entries, all the files are
+ * opened in parallel by openFilesAndLoadData() and closed right after counting,
+ * except for the first one, which is read next. Every further file is opened again
+ * in the background while the entries of the preceding file are read, so that switching
+ * files does not stall the processing. Opening the files in other threads requires
+ * ROOT::EnableThreadSafety() to be called at startup, as JPetManager does; with
+ * the prefetching disabled all the files are opened in the calling thread.
+ * The entry object is owned by the reader and reused for all the files.
+ * The header and other objects (e.g. ParamBank) are read from the currently
+ * open file, which is the first one right after openFilesAndLoadData().
+ */
+class JPetChainReader: public JPetReader
+{
+public:
+  JPetChainReader();
+  virtual ~JPetChainReader();
+  bool openFilesAndLoadData(const std::vector<std::string>& fileNames, const char* treename = "T");
+  virtual bool openFileAndLoadData(const char* filename, const char* treename = "T") override;
+  virtual JPetReaderInterface::MyEvent& getCurrentEntry() override;
+  virtual bool nextEntry() override;
+  virtual bool firstEntry() override;
+  virtual bool lastEntry() override;
+  virtual bool nthEntry(long long n) override;
+  virtual long long getCurrentEntryNumber() const override;
+  virtual long long getNbOfAllEntries() const override;
+  virtual void closeFile() override;
+  int getCurrentFileIndex() const;
+  int getNbOfFiles() const;
+  void setPrefetchEnabled(bool enable);
+
+protected:
+  void openFiles(const std::vector<std::string>& fileNames, std::vector<long long>& nbOfEntries);
+  bool switchToFile(int index);
+  void closeCurrentFile();
+  void prepareEntry();
+  void prefetchFile(int index);
+  void dropPrefetchedFile();
+  static TFile* openFileForReading(const std::string& fileName);
+  static const long long kNoFile;
+  static const long long kNoTree;
+
+  std::vector<std::string> fFileNames;
+  std::vector<long long> fFirstEntryInFile;
+  /// First file, kept open after counting its entries until it is read
+  std::unique_ptr<TFile> fFirstFile;
+  /// Entry object read from all the files, fEntry points to it unless the MC truth is read
+  std::unique_ptr<TObject> fChainEntry;
+  std::unique_ptr<TObject> fEmptyEntry;
+  std::string fTreeName = "T";
+  int fCurrentFileIndex = -1;
+  long long fGlobalEntryNumber = -1;
+  bool fIsPrefetchEnabled = true;
+  int fPrefetchedFileIndex = -1;
+  std::future<TFile*> fPrefetchedFile;
+};
+
+#endif /* !JPETCHAINREADER_H */
@@ -0,0 +1,93 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetDetectorGeometryCache.h
+ */
+
+#ifndef JPETDETECTORGEOMETRYCACHE_H
+#define JPETDETECTORGEOMETRYCACHE_H
+
+#include "./JPetParamBank/JPetParamIndex.h"
+#include "./JPetParamBank/JPetParamBank.h"
+#include "./JPetStripPairTable/JPetStripPairTable.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Geometry of the scintillators of the Big Barrel, computed once from the param bank.
+ *
+ * The quantities are stored as structure of arrays: every array is indexed
+ * by the index of the scintillator, given by getIndex(scinID). The scintillators
+ * are ordered by the layer number and the slot number, as given by JPetGeomMapping.
+ * The center of the scintillator is computed from the radius of its layer
+ * and the theta angle of its barrel slot. The neighbours of a scintillator are the
+ * scintillators of the same layer in the neighbouring slots.
+ * The scintillators without a barrel slot or a layer are not included.
+ *
+ * The table of the pairs of scintillators is computed at the first call of getStripPairs().
+ *
+ * The cache is immutable. getGeometry() shares one cache between all users
+ * of the same param bank, e.g. all the tasks of one run.
+ */
+class JPetDetectorGeometryCache
+{
+public:
+  static const int kBadIndex;
+
+  static std::shared_ptr<const JPetDetectorGeometryCache> getGeometry(const std::shared_ptr<const JPetParamBank>& bank);
+
+  explicit JPetDetectorGeometryCache(const JPetParamBank& bank);
+  JPetDetectorGeometryCache(const JPetDetectorGeometryCache&) = delete;
+  JPetDetectorGeometryCache& operator=(const JPetDetectorGeometryCache&) = delete;
+
+  std::size_t getSize() const;
+  int getIndex(int scinID) const;
+
+  const std::vector<int>& getScinIDs() const;
+  const std::vector<double>& getCenterX() const;
+  const std::vector<double>& getCenterY() const;
+  const std::vector<double>& getTheta() const;
+  const std::vector<double>& getRadius() const;
+  const std::vector<double>& getLength() const;
+  const std::vector<int>& getLayerNumber() const;
+  const std::vector<int>& getSlotNumber() const;
+  const std::vector<int>& getNeighbours(int index) const;
+  const std::vector<std::size_t>& getLayersSizes() const;
+  const JPetStripPairTable& getStripPairs() const;
+
+  void getPositions(const std::vector<int>& scinIDs, std::vector<double>& posX, std::vector<double>& posY) const;
+
+private:
+  std::vector<int> fScinIDs;
+  /// Pointers to the elements of fScinIDs by the scintillator id, the index is their position in fScinIDs
+  std::map<int, const int*> fScinIDsByID;
+  JPetParamIndex<const int> fScinIDsIndex;
+  std::vector<double> fCenterX;
+  std::vector<double> fCenterY;
+  /// Theta angle of the barrel slot in degrees
+  std::vector<double> fTheta;
+  std::vector<double> fRadius;
+  std::vector<double> fLength;
+  /// Layer and slot numbers starting from 1, as in JPetGeomMapping
+  std::vector<int> fLayerNumber;
+  std::vector<int> fSlotNumber;
+  std::vector<std::vector<int>> fNeighbours;
+  /// Number of slots in each layer, as given by JPetGeomMapping
+  std::vector<std::size_t> fLayersSizes;
+  mutable std::once_flag fStripPairsFlag;
+  mutable std::unique_ptr<const JPetStripPairTable> fStripPairs;
+};
+
+#endif /* !JPETDETECTORGEOMETRYCACHE_H */
@@ -0,0 +1,90 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEntryIndex.h
+ */
+
+#ifndef JPETENTRYINDEX_H
+#define JPETENTRYINDEX_H
+
+#include <TObject.h>
+#include <limits>
+#include <string>
+#include <vector>
+
+class JPetTimeWindow;
+class TCollection;
+
+/**
+ * @brief Compact per-entry summary of the time windows stored in a JPet ROOT tree.
+ *
+ * For every entry written to the tree the index keeps a small summary (zone map):
+ * the time range covered by the objects in the window, the number of objects,
+ * the bitmasks of scintillators and layers that were hit and the energy range.
+ * The index is stored in the output file next to the tree, under the name
+ * JPetEntryIndex::kIndexName. It can be read back without touching the tree
+ * itself, which allows to seek by time or to skip entries that cannot match
+ * a user selection without decompressing them.
+ * The index implements Merge(), so it is concatenated correctly by hadd.
+ * If the entries are ordered in time (as the consecutive time windows are),
+ * the searches by time are binary searches, otherwise the summaries are scanned.
+ */
+class JPetEntryIndex: public TObject
+{
+public:
+  struct EntrySummary {
+    double fStartTime = std::numeric_limits<double>::max();
+    double fEndTime = std::numeric_limits<double>::lowest();
+    float fMinEnergy = std::numeric_limits<float>::max();
+    float fMaxEnergy = std::numeric_limits<float>::lowest();
+    unsigned int fObjectCount = 0;
+    unsigned long long fLayerMask = 0;
+    std::vector<unsigned long long> fScinMask;
+
+    bool hasTime() const;
+    bool hasEnergy() const;
+    bool overlapsTime(double from, double to) const;
+    bool overlapsEnergy(float from, float to) const;
+    bool isScinHit(int scinID) const;
+    bool isLayerHit(int layerID) const;
+    void addTime(double time);
+    void addEnergy(float energy);
+    void addScin(int scinID);
+    void addLayer(int layerID);
+  };
+
+  static const std::string kIndexName;
+  static const int kMaxLayerID;
+
+  JPetEntryIndex();
+  virtual ~JPetEntryIndex();
+  static EntrySummary summarize(const JPetTimeWindow& window, bool isTimeOnly = false);
+  void addEntry(const JPetTimeWindow& window);
+  void addSummary(const EntrySummary& summary);
+  size_t getNumberOfEntries() const;
+  const EntrySummary& getSummary(long long entry) const;
+  long long findFirstEntryAtTime(double time, long long firstEntry, long long lastEntry) const;
+  long long findFirstEntryInTimeRange(double from, double to, long long firstEntry, long long lastEntry) const;
+  bool isTimeOrdered() const;
+  Long64_t Merge(TCollection* list);
+  void Clear(Option_t* opt = "");
+
+private:
+  std::vector<EntrySummary> fSummaries;
+  /// Whether isTimeOrdered() is up to date, reset when the summaries change
+  mutable bool fIsTimeOrderChecked = false; //!
+  mutable bool fIsTimeOrdered = false; //!
+
+  ClassDef(JPetEntryIndex, 2);
+};
+
+#endif /* !JPETENTRYINDEX_H */
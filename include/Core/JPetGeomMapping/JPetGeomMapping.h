@@ -20,9 +20,11 @@
 #include "./JPetParamBank/JPetParamBank.h"
 #include "./JPetLayer/JPetLayer.h"
 #include "./JPetPM/JPetPM.h"
+#include "./JPetParamBank/JPetParamIndex.h"
 #include <cstddef>
 #include <vector>
 #include <map>
+#include <tuple>
 
 /**
  * @brief Implementation of methods for Big Barrel Mapping.
@@ -30,11 +32,30 @@
  * Created mapping is to be used in the analyses for application of various
  * parameters i.e. from calibrations. In general, use only for measurements
  * conducted with the Big Barrel detector.
+ * All the mappings are precomputed in the constructor: the lookups of the TOMB channel
+ * by (layer, slot, side, threshold), of the position of a TOMB channel and of the
+ * position of a barrel slot by its id are done in the dense tables in O(1).
+ * The positions by id are stored in vectors sorted by id and indexed with JPetParamIndex,
+ * pointing to the elements of the vectors. A copy of the mapping builds its own indices.
  */
 class JPetGeomMapping : public JPetGeomMappingInterface
 {
 public:
+  using TOMBMapping = std::map<std::tuple<int, int, JPetPM::Side, int>, int>;
+
+  struct TOMBChannelPos
+  {
+    int layer = 0;
+    int slot = 0;
+    JPetPM::Side side = JPetPM::SideA;
+    int threshold = 0;
+  };
+
   explicit JPetGeomMapping(const JPetParamBank &paramBank);
+  JPetGeomMapping(const JPetGeomMapping &other);
+  JPetGeomMapping &operator=(const JPetGeomMapping &other);
+  JPetGeomMapping(JPetGeomMapping &&) = default;
+  JPetGeomMapping &operator=(JPetGeomMapping &&) = default;
   virtual ~JPetGeomMapping();
   virtual size_t getLayersCount() const override;
   virtual size_t getLayerNumber(const JPetLayer &layer) const override;
@@ -43,22 +64,52 @@ public:
   virtual size_t getSlotNumber(const JPetBarrelSlot &slot) const override;
   virtual const StripPos getStripPos(const JPetBarrelSlot &slot) const override;
   virtual const std::vector<size_t> getLayersSizes() const override;
-  static void printTOMBMapping(
-    const std::map<std::tuple<int, int, JPetPM::Side, int>, int> &tombMap);
-  std::map<std::tuple<int, int, JPetPM::Side, int>, int> getTOMBMapping() const;
+  const StripPos getStripPosByID(int barrelSlotID) const;
+  static void printTOMBMapping(const TOMBMapping &tombMap);
+  const TOMBMapping &getTOMBMapping() const;
   int getTOMB(int layerNr, int slotNr, const JPetPM::Side &side, int threshold) const;
+  const TOMBChannelPos *getTOMBChannelPos(int tombChannel) const;
   double getRadiusOfLayer(int layer) const;
   size_t calcDeltaID(const JPetBarrelSlot &slot1, const JPetBarrelSlot &slot2) const;
   static const size_t kBadLayerNumber;
   static const size_t kBadSlotNumber;
 
 private:
-  std::map<std::tuple<int, int, JPetPM::Side, int>, int> getTOMBMap(
-    const JPetParamBank &bank) const;
-  std::map<std::tuple<int, int, JPetPM::Side, int>, int> fTOMBs;
+  struct SlotEntry
+  {
+    int id;
+    StripPos pos;
+    double theta;
+    double radius;
+  };
+
+  struct TOMBChannelEntry
+  {
+    int id;
+    TOMBChannelPos pos;
+  };
+
+  TOMBMapping getTOMBMap(const JPetParamBank &bank) const;
+  void buildTables(const JPetParamBank &bank);
+  void buildIndices();
+  const SlotEntry *findSlot(const JPetBarrelSlot &slot) const;
+  TOMBMapping fTOMBs;
   std::vector<std::map<double, int>> fThetaToSlot;
   std::vector<int> fNumberOfSlotsInLayer;
   std::map<double, int> fRadiusToLayer;
+  std::vector<double> fLayerRadii;
+  /// Index of the first slot of each layer in the list of all slots
+  std::vector<std::size_t> fFirstSlotOfLayer;
+  int fMinThreshold = 0;
+  int fThresholdsCount = 0;
+  /// TOMB channel indexed by (slot, side, threshold), -1 if not set
+  std::vector<int> fTOMBTable;
+  /// Positions of the TOMB channels sorted by id, indexed by fTOMBChannelsIndex
+  std::vector<TOMBChannelEntry> fTOMBChannels;
+  JPetParamIndex<const TOMBChannelEntry> fTOMBChannelsIndex;
+  /// Barrel Slots sorted by id, indexed by fSlotsIndex
+  std::vector<SlotEntry> fSlots;
+  JPetParamIndex<const SlotEntry> fSlotsIndex;
 };
 
 #endif /* !JPETGEOMMAPPING_H */
@@ -0,0 +1,83 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHadd.h
+ */
+
+#ifndef JPETHADD_H
+#define JPETHADD_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JPetTreeHeader;
+class TDirectory;
+class TFile;
+class TObject;
+class TTree;
+
+/**
+ * @brief Merges output files of the framework, aware of their structure.
+ *
+ * Unlike ROOT hadd, JPetHadd:
+ * - copies the compressed baskets of the tree without deserialising the time windows,
+ * - stores identical ParamBanks only once, comparing their serialised content,
+ * - merges the JPetTreeHeader stage histories of all inputs,
+ * - merges the statistics directories (histograms etc.) in parallel threads,
+ *   each thread reducing its own subset of input files.
+ * Every input file is opened once: after its tree is copied, it is passed to the thread
+ * merging its statistics. Other top level objects providing Merge() (e.g. JPetEntryIndex)
+ * are merged in input order. An existing output file is overwritten only if setForceOverwrite() is set.
+ */
+class JPetHadd
+{
+public:
+  using MergedObjects = std::map<std::string, std::unique_ptr<TObject>>;
+
+  explicit JPetHadd(const std::string& outputFileName);
+  ~JPetHadd();
+  void setNumberOfThreads(unsigned int nbOfThreads);
+  void setForceOverwrite(bool isForced);
+  bool merge(const std::vector<std::string>& inputFileNames);
+  int getNumberOfDistinctParamBanks() const;
+
+  static bool mergeObject(TObject* target, TObject* source);
+  static void mergeStageHistory(JPetTreeHeader& target, const JPetTreeHeader& source);
+
+private:
+  struct StatisticsGroup;
+
+  JPetHadd(const JPetHadd&);
+  void operator=(const JPetHadd&);
+
+  bool mergeInputs(const std::vector<std::string>& inputFileNames, TFile& outputFile);
+  bool mergeTreeAndParameters(TFile& inputFile, TFile& outputFile);
+  bool addParamBank(TObject* bank);
+  static void collectStatistics(StatisticsGroup& group);
+  static void collectDirectory(TDirectory* directory, const std::string& path, MergedObjects& merged);
+  static void writeObjects(const MergedObjects& objects, TFile& outputFile);
+
+  std::string fOutputFileName;
+  unsigned int fNbOfThreads = 1;
+  bool fIsForceOverwrite = false;
+  TTree* fOutputTree = nullptr;
+  JPetTreeHeader* fHeader = nullptr;
+  std::vector<std::unique_ptr<TObject>> fParamBanks;
+  /// Indices in fParamBanks of the banks with the given hash of the serialised content
+  std::unordered_multimap<std::size_t, std::size_t> fParamBankHashes;
+  MergedObjects fOtherObjects;
+};
+
+#endif /* !JPETHADD_H */
@@ -18,6 +18,7 @@
 
 #include "./JPetReaderInterface/JPetReaderInterface.h"
 #include "./JPetTreeHeader/JPetTreeHeader.h"
+#include "./JPetTimeWindowMC/JPetTimeWindowMC.h"
 #include "./JPetLoggerInclude.h"
 #include <TBranch.h>
 #include <TFile.h>
@@ -36,6 +37,8 @@ class boost::noncopyable;
  *
  * All objects inheriting from JPetAnalysisModule should use this class
  * in order to access and read data from ROOT files.
+ * If the tree contains the MC truth in separate branches (see JPetTimeWindowMC),
+ * the entries are read into a JPetTimeWindowMC owned by the reader.
  * @todo Add the correct file to 'file_with_no_jpettreeheader' test and
  * see TTree GetEntry method, add test of file with no JPetTreeHeader
  */
@@ -64,6 +67,7 @@ protected:
   virtual bool openFile(const char* filename);
   virtual bool loadData(const char* treename = "T");
   bool loadCurrentEntry();
+  bool setupBranches();
   inline bool isCorrectTreeEntryCode (int entryCode) const;
 
   TBranch* fBranch = nullptr;
@@ -71,6 +75,9 @@ protected:
   TTree* fTree = nullptr;
   TFile* fFile = nullptr;
   long long fCurrentEntryNumber = -1;
+  JPetTimeWindowMC* fMCEntry = nullptr;
+  /// The JPetTimeWindow base of fMCEntry, bound to a window branch of this class
+  JPetTimeWindow* fWindowEntry = nullptr;
 };
 
 #endif /* !JPETREADER_H */
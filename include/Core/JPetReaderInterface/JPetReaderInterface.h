@@ -29,6 +29,10 @@ class JPetReaderInterface {
   virtual bool nthEntry(long long int n)=0;
   virtual long long getCurrentEntryNumber() const =0;
   virtual long long getNbOfAllEntries() const =0;
+  /// False while the number of entries is not known yet, e.g. when the input is still being produced in parts
+  virtual bool isNbOfAllEntriesKnown() const { return true; }
+  /// False if the input turned out to be incomplete, e.g. when the writing of the input file has failed
+  virtual bool isInputValid() const { return true; }
   virtual bool openFileAndLoadData(const char* filename, const char* treename)=0;
   virtual void closeFile()=0;
 };
@@ -16,18 +16,28 @@
 #ifndef JPETSCOPEDATA_H
 #define JPETSCOPEDATA_H
 #include "./JPetDataInterface/JPetDataInterface.h"
+#include "./JPetRecoSignal/JPetRecoSignal.h"
 #include <string>
 #include <map>
 
 /**
  * @brief Wrapper class that contains data sent to JPetScopeTask.
+ *
+ * Besides the names of the files of the time window, it may contain the
+ * signals already parsed from these files, keyed by the file names.
+ * The data is passed to the task as const, but the parsed signals are handed over
+ * to it: the task may move them out of the signals returned by findSignal().
  */
 class JPetScopeData : public JPetDataInterface
 {
 public:
   explicit JPetScopeData(const std::pair<int, std::map<std::string, int>>& event);
+  JPetScopeData(const std::pair<int, std::map<std::string, int>>& event, std::map<std::string, JPetRecoSignal>&& signals);
   std::pair<int, std::map<std::string, int> > getEvent() const;
+  const std::map<std::string, JPetRecoSignal>& getSignals() const;
+  JPetRecoSignal* findSignal(const std::string& fileName) const;
 protected:
   std::pair<int, std::map<std::string, int>> fEvent;
+  mutable std::map<std::string, JPetRecoSignal> fSignals;
 };
 #endif /* !JPETSCOPEDATA_H */
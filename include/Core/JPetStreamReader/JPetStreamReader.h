@@ -0,0 +1,57 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamReader.h
+ */
+
+#ifndef JPETSTREAMREADER_H
+#define JPETSTREAMREADER_H
+
+#include "./JPetChainReader/JPetChainReader.h"
+#include "./JPetStreamedFile/JPetStreamedFile.h"
+#include <memory>
+
+/**
+ * @brief Reader of the data which is still being produced by the previous task.
+ *
+ * The producer publishes the data in complete, closed part files (see JPetStreamedFile),
+ * which are read one after another as a chain (see JPetChainReader). The entries of
+ * a part are available as soon as the part is published, and the reader waits for
+ * the next part when it reaches the end of the published ones. Until the producer
+ * finishes, the total number of entries is unknown (see isNbOfAllEntriesKnown()) and
+ * getNbOfAllEntries() returns the largest possible value, so the processing ends
+ * when nextEntry() returns false. If the producer reports a failure, the input is marked
+ * as invalid (see isInputValid()), so the consumer can fail instead of silently
+ * processing incomplete data.
+ */
+class JPetStreamReader: public JPetChainReader
+{
+public:
+  explicit JPetStreamReader(std::shared_ptr<JPetStreamedFile> stream);
+  virtual bool openFileAndLoadData(const char* filename, const char* treename = "T") override;
+  virtual bool lastEntry() override;
+  virtual bool nthEntry(long long n) override;
+  virtual long long getNbOfAllEntries() const override;
+  virtual bool isNbOfAllEntriesKnown() const override;
+  virtual bool isInputValid() const override;
+  bool isComplete() const;
+
+protected:
+  bool waitForEntry(long long n);
+  bool addNextPart();
+
+  std::shared_ptr<JPetStreamedFile> fStream;
+  bool fIsComplete = false;
+  bool fIsFailed = false;
+};
+
+#endif /* !JPETSTREAMREADER_H */
@@ -0,0 +1,69 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamedFile.h
+ */
+
+#ifndef JPETSTREAMEDFILE_H
+#define JPETSTREAMEDFILE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Data which is still being produced by one task while it may be already read by the next one.
+ *
+ * The producer (e.g. JPetUnpackTask) registers the data under the name of the file
+ * the next task expects with start(), publishes the data in complete, closed part files
+ * with addPart() and calls finish() at the end. Registered data is found by the consumers
+ * with find(), which then wait for the consecutive parts with waitForPart().
+ * The consumers never open a file which is still being written. The data stays registered
+ * after it is finished, since it exists only as the parts, so the consumers opening it
+ * later read the same parts and learn about a failure of the producer.
+ */
+class JPetStreamedFile
+{
+public:
+  static std::shared_ptr<JPetStreamedFile> start(const std::string& fileName);
+  static std::shared_ptr<JPetStreamedFile> find(const std::string& fileName);
+
+  const std::string& getFileName() const;
+  void addPart(const std::string& partFileName);
+  void finish(bool isSuccessful);
+  bool isFinished() const;
+  bool isSuccessful() const;
+  bool waitForPart(std::size_t index, std::string& partFileName);
+  std::vector<std::string> getPartFileNames() const;
+
+private:
+  explicit JPetStreamedFile(const std::string& fileName);
+  JPetStreamedFile(const JPetStreamedFile&);
+  void operator=(const JPetStreamedFile&);
+
+  static std::string getKey(const std::string& fileName);
+  static std::mutex& getRegistryMutex();
+  static std::map<std::string, std::shared_ptr<JPetStreamedFile>>& getRegistry();
+
+  const std::string fFileName;
+  mutable std::mutex fMutex;
+  std::condition_variable fProgress;
+  std::vector<std::string> fPartFileNames;
+  bool fIsFinished = false;
+  bool fIsSuccessful = false;
+};
+
+#endif /* !JPETSTREAMEDFILE_H */
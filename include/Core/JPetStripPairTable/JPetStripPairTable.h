@@ -0,0 +1,67 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStripPairTable.h
+ */
+
+#ifndef JPETSTRIPPAIRTABLE_H
+#define JPETSTRIPPAIRTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JPetDetectorGeometryCache;
+
+/**
+ * @brief Quantities of all the pairs of scintillators, computed once for the geometry.
+ *
+ * The scintillators are given by their indices in JPetDetectorGeometryCache.
+ * The table is symmetric, only the pairs (i, j) with i <= j are stored, in the
+ * structure of arrays. For every pair it gives:
+ * - the difference of the slot numbers, as JPetGeomMapping::calcDeltaID, or
+ *   kDifferentLayers if the scintillators are in different layers,
+ * - the distance between the centers of the scintillators in the XY plane [cm],
+ * - the maximum time of flight between any two points of the scintillators [ps],
+ *   i.e. the maximum distance between the points divided by the speed of light.
+ *   The time difference of the hits of a true coincidence cannot be larger.
+ */
+class JPetStripPairTable
+{
+public:
+  static const int kDifferentLayers;
+  /// Speed of light in cm/ps
+  static const double kSpeedOfLight;
+
+  explicit JPetStripPairTable(const JPetDetectorGeometryCache& geometry);
+
+  std::size_t getSize() const;
+
+  inline int getDeltaID(int first, int second) const { return fDeltaID[getPairIndex(first, second)]; }
+  inline float getDistance(int first, int second) const { return fDistance[getPairIndex(first, second)]; }
+  inline float getMaxTOF(int first, int second) const { return fMaxTOF[getPairIndex(first, second)]; }
+  inline bool isSameLayer(int first, int second) const { return getDeltaID(first, second) != kDifferentLayers; }
+  inline bool isSameSlot(int first, int second) const { return getDeltaID(first, second) == 0; }
+
+private:
+  inline static std::size_t getPairIndex(std::size_t first, std::size_t second)
+  {
+    return first <= second ? second * (second + 1) / 2 + first : first * (first + 1) / 2 + second;
+  }
+
+  std::size_t fSize = 0;
+  std::vector<std::int16_t> fDeltaID;
+  std::vector<float> fDistance;
+  std::vector<float> fMaxTOF;
+};
+
+#endif /* !JPETSTRIPPAIRTABLE_H */
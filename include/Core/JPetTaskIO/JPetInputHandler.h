@@ -17,6 +17,9 @@
 #define JPETINPUTHANDLER_H
 
 #include <memory.h>
+#include <functional>
+#include <limits>
+#include "./JPetEntryIndex/JPetEntryIndex.h"
 #include "./JPetReader/JPetReader.h"
 #include "./JPetParams/JPetParams.h"
 #include "./JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
@@ -28,10 +31,22 @@ struct EntryRange {
   long long currentEntry = -1ll;
 };
 
+/**
+ * @brief Helper class handling the input operations performed by JPetReader.
+ *
+ * If the input file contains a JPetEntryIndex (written by the task producing the file
+ * when the saveEntryIndex_bool option is set), entries can be selected by time
+ * with seekToTime() or the time range options, and entries which cannot match
+ * the predicate set with setEntryPredicate() are skipped without being read.
+ */
 class JPetInputHandler
 {
 
 public:
+  using EntryPredicate = std::function<bool(const JPetEntryIndex::EntrySummary&)>;
+  static const std::string kTimeRangeMinOptName;
+  static const std::string kTimeRangeMaxOptName;
+
   JPetInputHandler();
 
   bool openInput(const char* inputFileName, const JPetParams& params);
@@ -43,6 +58,14 @@ public:
   long long getCurrentEntryNumber() const;
   TObject& getEntry();
   bool nextEntry();
+  bool isEntryRangeEmpty() const;
+  bool isNbOfAllEntriesKnown() const;
+  bool isInputValid() const;
+
+  bool hasEntryIndex() const;
+  const JPetEntryIndex* getEntryIndex() const;
+  void setEntryPredicate(EntryPredicate predicate);
+  bool seekToTime(double time);
 
   /// Function calculates the correct entry range [first, last] based on the options provided and the internal reader state
   std::tuple<bool, long long, long long> calculateEntryRange(const jpet_options_tools::OptsStrAny& options) const;
@@ -54,7 +77,15 @@ protected:
 private:
   JPetInputHandler(const JPetInputHandler&);
   void operator=(const JPetInputHandler&);
+  bool openReader(const char* inputFilename, const jpet_options_tools::OptsStrAny& options);
+  bool loadEntryIndex();
+  bool isEntryAccepted(long long entry) const;
+  long long findAcceptedEntry(long long from) const;
   EntryRange fEntryRange;
+  std::unique_ptr<JPetEntryIndex> fEntryIndex{nullptr};
+  EntryPredicate fEntryPredicate;
+  double fTimeRangeMin = std::numeric_limits<double>::lowest();
+  double fTimeRangeMax = std::numeric_limits<double>::max();
 
 };
 #endif /*  !JPETINPUTHANDLER_H */
@@ -16,12 +16,14 @@
 #ifndef JPETOUTPUTHANDLER_H
 #define JPETOUTPUTHANDLER_H
 
+#include "JPetEntryIndex/JPetEntryIndex.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetParamManager/JPetParamManager.h"
 #include "JPetStatistics/JPetStatistics.h"
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 class JPetTreeHeader;
 class JPetTaskInterface;
@@ -29,19 +31,57 @@ class JPetTaskInterface;
 /**
  * @brief Helper class handles the output operation performed by JPetWriter
  * It is a helper method for the JPetTaskIO class.
+ * If the saveEntryIndex_bool option is set, for every written entry a summary
+ * is added to the JPetEntryIndex, which is stored in the output file together with the tree.
+ * Otherwise only the time range of the entries is computed, if the output is split by time.
+ *
+ * If the splitting options are set (outputSplitWindows_int, outputSplitSizeMB_int,
+ * outputSplitTimeSpan_double), the output is written into parts name_000N.type.root.
+ * A new part is started when the current one reaches any of the limits.
+ * Every part is self-contained: it has its own header, ParamBank, entry index and
+ * the snapshot of the statistics accumulated up to its end (the last part has the full statistics).
+ * At the end a manifest (name.type.manifest) with the list of the parts is written.
  */
 class JPetOutputHandler
 {
 public:
   JPetOutputHandler(); 
   explicit JPetOutputHandler(const char* outputFilename);
+  JPetOutputHandler(const char* outputFilename, const jpet_options_tools::OptsStrAny& options);
 
+  void setPartContent(JPetParamManager* manager, JPetTreeHeader* header, JPetStatistics* statistics,
+                      std::map<std::string, std::unique_ptr<JPetStatistics>>* subTasksStatistics);
   void saveOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics);
   void saveAndCloseOutput(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics, std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics);
   bool writeEventToFile(JPetTaskInterface* task);
+  bool isSplit() const;
+  const std::vector<std::string>& getPartFileNames() const;
+
+  static std::string getPartFileName(const std::string& outputFilename, int partNumber);
+  static std::string getManifestFileName(const std::string& outputFilename);
 
 protected:
-  JPetWriter fWriter;
+  bool isPartFull(const JPetEntryIndex::EntrySummary& summary) const;
+  bool startNextPart();
+  void savePart(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics,
+                std::map<std::string, std::unique_ptr<JPetStatistics>>& subTasksStatistics);
+  bool writeManifest() const;
+
+  std::unique_ptr<JPetWriter> fWriter;
+  JPetEntryIndex fEntryIndex;
+  bool fIsEntryIndexSaved = false;
+  long long fPartWindowsCount = 0;
+  std::string fOutputFilename;
+  std::vector<std::string> fPartFileNames;
+  int fSplitWindows = 0;
+  long long fSplitBytes = 0;
+  double fSplitTimeSpan = 0.;
+  double fPartStartTime = 0.;
+  bool fIsPartStartTimeSet = false;
+  JPetParamManager* fParamManager = nullptr;
+  JPetTreeHeader* fHeader = nullptr;
+  JPetStatistics* fStatistics = nullptr;
+  std::map<std::string, std::unique_ptr<JPetStatistics>>* fSubTasksStatistics = nullptr;
 
 private:
   JPetOutputHandler(const JPetOutputHandler&);
@@ -29,6 +29,8 @@ std::tuple<bool, long long, long long> setUserLimits(const jpet_options_tools::O
 std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(const OptsStrAny& opts, bool prevResetOutputPath, const std::string& inFileType, const std::string& outFileType);
 
 OptsStrAny setOutputOptions(const JPetParams& oldParams, bool resetOutputPath, const std::string& fullOutPath);
+/// @brief Function returns the output options with the parts of the split output set as the chained input of the next task.
+OptsStrAny setSplitOutputOptions(const OptsStrAny& outputOptions, const std::vector<std::string>& partFileNames);
 
 
 };
@@ -16,6 +16,7 @@
 #ifndef JPETUSERTASK_H
 #define JPETUSERTASK_H
 #include "JPetTask/JPetTask.h"
+#include "JPetDetectorGeometryCache/JPetDetectorGeometryCache.h"
 #include "JPetParams/JPetParams.h"
 #include "JPetStatistics/JPetStatistics.h"
 #include "JPetTimeWindowMC/JPetTimeWindowMC.h"
@@ -51,7 +52,13 @@ public:
 
   virtual void setEvent(TObject* ev);
   const JPetParamBank& getParamBank();
-  jpet_options_tools::OptsStrAny getOptions() const;
+  const JPetDetectorGeometryCache& getDetectorGeometry();
+  const jpet_options_tools::OptsStrAny& getOptions() const;
+  template <typename T>
+  JPetOptionHandle<T> getOptionHandle(const std::string& name) const
+  {
+    return fParams.getOptionHandle<T>(name);
+  }
   virtual JPetTimeWindow* getOutputEvents();
   JPetTimeWindow* getInputEvents();
 
@@ -66,5 +73,8 @@ protected:
   JPetStatistics* fStatistics = 0;
   JPetParams fParams;
   JPetTimeWindow* fOutputEvents = 0;
+
+private:
+  std::shared_ptr<const JPetDetectorGeometryCache> fDetectorGeometry;
 };
 #endif /* !JPETUSERTASK_H */
@@ -26,6 +26,7 @@ class boost::noncopyable;
 #include "./JPetBarrelSlot/JPetBarrelSlot.h"
 #include "./JPetPhysSignal/JPetPhysSignal.h"
 #include "./JPetTimeWindow/JPetTimeWindow.h"
+#include "./JPetTimeWindowMC/JPetTimeWindowMC.h"
 #include "./JPetSigCh/JPetSigCh.h"
 #include "./JPetEvent/JPetEvent.h"
 #include "./JPetLoggerInclude.h"
@@ -65,6 +66,7 @@ public:
   virtual ~JPetWriter(void);
   void closeFile();
   template <class T> bool write(const T& obj);
+  bool writeWithMCTruth(JPetTimeWindow& window, JPetTimeWindowMC& mcTruth);
   void writeHeader(TObject* header);
   void writeCollection(const TCollection* hash, const char* dirname,
     const char* subdirname = "");
@@ -72,6 +74,10 @@ public:
   {
     return fFile->WriteTObject(obj, name);
   }
+  long long getBytesWritten() const
+  {
+    return fFile ? fFile->GetBytesWritten() : 0;
+  }
   virtual bool isOpen() const
   {
     if (fFile) return (fFile->IsOpen() && !fFile->IsZombie());
@@ -84,6 +90,11 @@ protected:
   bool fIsBranchCreated;
   TTree* fTree;
   TList fTList;
+  bool fIsMCTruthBranchCreated = false;
+  JPetTimeWindow* fWindow = nullptr;
+  const TClass* fWindowClass = nullptr;
+  TClonesArray* fMCHits = nullptr;
+  TClonesArray* fDecayTrees = nullptr;
 };
 
 template <class T>
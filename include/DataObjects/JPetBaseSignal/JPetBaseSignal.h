@@ -17,6 +17,7 @@
 #define JPETBASESIGNAL_H
 
 #include "./JPetBarrelSlot/JPetBarrelSlot.h"
+#include "./JPetParamResolver/JPetParamResolver.h"
 #include "./JPetSigCh/JPetSigCh.h"
 #include "./JPetPM/JPetPM.h"
 #include <TObject.h>
@@ -27,7 +28,7 @@
  *
  * Class provides basic construction and methods for more specific Signal classes,
  * such as Raw and Physical Signals. A signal have to assigned to a Barrel Slot
- * and a PhotoMultiplier.
+ * and a PhotoMultiplier, referenced by their ids (see JPetParamResolver).
  */
 class JPetBaseSignal: public TObject
 {
@@ -46,29 +47,22 @@ public:
    * @brief Set the reference to the PhotoMultiplier parametric object
    */
   inline void setPM(const JPetPM & pm) {
-    fPM = const_cast<JPetPM*>(&pm);
+    JPetParamResolver::updateGeneration(fPointerGeneration, fPMPointer, fBarrelSlotPointer);
+    fPMPointer = &pm;
+    fPMID = pm.getID();
   }
 
   /**
    * @brief Set the reference to the BarrelSlot parametric object
    */
   inline void setBarrelSlot(const JPetBarrelSlot & bs) {
-    fBarrelSlot = const_cast<JPetBarrelSlot*>(&bs);
+    JPetParamResolver::updateGeneration(fPointerGeneration, fPMPointer, fBarrelSlotPointer);
+    fBarrelSlotPointer = &bs;
+    fBarrelSlotID = bs.getID();
   }
 
-  /**
-   * @brief Obtain a reference to the PhotoMultiplier parametric object
-   */
-  inline const JPetPM & getPM() const {
-    return (JPetPM&) *fPM.GetObject();
-  }
-
-  /**
-   * @brief Obtain a reference to the BarrelSlot parametric object related
-   */
-  inline const JPetBarrelSlot & getBarrelSlot() const {
-    return (JPetBarrelSlot&) *fBarrelSlot.GetObject();
-  }
+  const JPetPM & getPM() const;
+  const JPetBarrelSlot & getBarrelSlot() const;
 
   void Clear(Option_t * opt = "");
 
@@ -76,6 +70,11 @@ private:
   TRef fPM;
   TRef fBarrelSlot;
   RecoFlag fFlag = JPetBaseSignal::Unknown;
+  int fPMID = JPetParamResolver::kNoID;
+  int fBarrelSlotID = JPetParamResolver::kNoID;
+  const JPetPM* fPMPointer = nullptr; //!
+  const JPetBarrelSlot* fBarrelSlotPointer = nullptr; //!
+  unsigned int fPointerGeneration = 0; //!
 
 protected:
   #ifndef __CINT__
@@ -84,7 +83,7 @@ protected:
   bool fIsNullObject;
   #endif
 
-  ClassDef(JPetBaseSignal, 5);
+  ClassDef(JPetBaseSignal, 6);
 
 };
 #endif /* !JPETBASESIGNAL_H */
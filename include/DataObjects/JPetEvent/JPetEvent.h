@@ -28,7 +28,8 @@
  * An event consists of one or more JPetHits, registered in barrel slots.
  * The class constructor and setHits method by default order the hits
  * in the ascending time order. This behaviour can be turned off by
- * the orderedByTime flag. Also, when using addHit method the order
+ * the orderedByTime flag. Hits passed as rvalues are moved into the event
+ * and ordered in place. Also, when using addHit method the order
  * is NOT guaranteed anymore. It is the users responsibility to sort it in
  * (or not) during the reconstrution/analysis procedures.
  * The JPetEvent can be flagged with a type (JPetEventType enum),
@@ -49,11 +50,16 @@ public:
   JPetEvent(const std::vector<JPetHit>& hits,
             JPetEventType eventType = JPetEventType::kUnknown,
             bool orderedByTime = true);
+  JPetEvent(std::vector<JPetHit>&& hits,
+            JPetEventType eventType = JPetEventType::kUnknown,
+            bool orderedByTime = true);
   JPetEvent::RecoFlag getRecoFlag() const;
   const std::vector<JPetHit>& getHits() const;
   void setRecoFlag(JPetEvent::RecoFlag flag);
   void setHits(const std::vector<JPetHit>& hits, bool orderedByTime = true);
+  void setHits(std::vector<JPetHit>&& hits, bool orderedByTime = true);
   void addHit(const JPetHit& hit);
+  void addHit(JPetHit&& hit);
   JPetEventType getEventType() const;
   void setEventType(JPetEventType type);
   void addEventType(JPetEventType type);
@@ -18,6 +18,7 @@
 
 #include "./JPetBarrelSlot/JPetBarrelSlot.h"
 #include "./JPetPhysSignal/JPetPhysSignal.h"
+#include "./JPetParamResolver/JPetParamResolver.h"
 #include "./JPetScin/JPetScin.h"
 #include "TVector3.h"
 #include "TObject.h"
@@ -49,6 +50,10 @@ public:
           TVector3& Position, JPetPhysSignal& SignalA, JPetPhysSignal& SignalB,
           JPetBarrelSlot& BarrelSlot, JPetScin& Scintillator);
   virtual ~JPetHit();
+  JPetHit(const JPetHit&) = default;
+  JPetHit(JPetHit&&) = default;
+  JPetHit& operator=(const JPetHit&) = default;
+  JPetHit& operator=(JPetHit&&) = default;
   JPetHit::RecoFlag getRecoFlag() const;
   float getEnergy() const;
   float getQualityOfEnergy() const;
@@ -69,6 +74,8 @@ public:
   unsigned int getMCindex() const;
   bool isSignalASet()const;
   bool isSignalBSet()const;
+  bool isScintillatorSet() const;
+  bool isBarrelSlotSet() const;
   void setRecoFlag(JPetHit::RecoFlag flag);
   void setEnergy(float energy);
   void setQualityOfEnergy(float qualityOfEnergy);
@@ -106,8 +113,13 @@ private:
   TRef fBarrelSlot = NULL;
   TRef fScintillator = NULL;
   unsigned int fMCindex = kMCindexError;
+  int fBarrelSlotID = JPetParamResolver::kNoID;
+  int fScintillatorID = JPetParamResolver::kNoID;
+  const JPetBarrelSlot* fBarrelSlotPointer = nullptr; //!
+  const JPetScin* fScintillatorPointer = nullptr; //!
+  unsigned int fPointerGeneration = 0; //!
 
-  ClassDef(JPetHit, 8);
+  ClassDef(JPetHit, 9);
 };
 
 #endif /* !JPETHIT_H */
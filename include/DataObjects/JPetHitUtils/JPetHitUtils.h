@@ -21,7 +21,9 @@
 #include "./JPetLoggerInclude.h"
 #include "./JPetHit/JPetHit.h"
 #include "./JPetPM/JPetPM.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
 #include <map>
+#include <vector>
 
 /**
  * @brief Helper class to calculate properties of JPetHit objects.
@@ -31,6 +33,8 @@ class JPetHitUtils
 public:
   static double getTimeDiffAtThr(const JPetHit& hit, int threshold);
   static double getTimeAtThr(const JPetHit& hit, int threshold);
+  static bool getTimesAtThr(const JPetTimeWindow& rawSignals, int threshold, std::vector<int>& barrelSlotIDs,
+                            std::vector<double>& times, std::vector<double>& timeDiffs);
   const static double Unset;
 
 private:
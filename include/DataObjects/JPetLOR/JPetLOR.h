@@ -39,7 +39,12 @@ public:
 
   JPetLOR();
   JPetLOR(float time, float qualityOfTime, JPetHit& firstHit, JPetHit& secondHit);
+  JPetLOR(float time, float qualityOfTime, JPetHit&& firstHit, JPetHit&& secondHit);
   virtual ~JPetLOR();
+  JPetLOR(const JPetLOR&) = default;
+  JPetLOR(JPetLOR&&) = default;
+  JPetLOR& operator=(const JPetLOR&) = default;
+  JPetLOR& operator=(JPetLOR&&) = default;
 
   JPetLOR::RecoFlag getRecoFlag() const;
   void setRecoFlag(JPetLOR::RecoFlag flag);
@@ -50,8 +55,11 @@ public:
   const JPetHit& getFirstHit() const;
   const JPetHit& getSecondHit() const;
   void setHits(const JPetHit& firstHit, const JPetHit& secondHit);
+  void setHits(JPetHit&& firstHit, JPetHit&& secondHit);
   void setFirstHit(const JPetHit& firstHit);
+  void setFirstHit(JPetHit&& firstHit);
   void setSecondHit(const JPetHit& secondHit);
+  void setSecondHit(JPetHit&& secondHit);
   void setTimeDiff(const float td);
   void setQualityOfTimeDiff(const float qtd);
   float getTimeDiff() const;
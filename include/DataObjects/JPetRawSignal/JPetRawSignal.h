@@ -19,6 +19,7 @@
 #include "./JPetBaseSignal/JPetBaseSignal.h"
 #include "./JPetSigCh/JPetSigCh.h"
 #include <algorithm>
+#include <atomic>
 #include <utility>
 #include <vector>
 #include <map>
@@ -28,14 +29,30 @@
  *
  * The signal consists of two arrays of JPetSigCh objects - time value points
  * probed on the leading and trailing edge.
+ * The points are also indexed by the threshold number (from 1 to kNumberOfThresholds)
+ * in fixed arrays, giving the time, the threshold value and the point at each threshold
+ * in O(1) without allocations. The index is transient and kept up to date by addPoint(),
+ * Clear() and the copy and move operations. A signal read from a file has its index
+ * built at the first access, by one thread while the other ones wait for it.
+ * If an edge has two points at the same threshold, the first of them is indexed.
+ * The maps and the sorted vectors of points are built from the index when the edge
+ * has exactly one point per threshold, otherwise from the vectors of points.
+ *
+ * The const methods can be called concurrently, the other ones must not be called
+ * concurrently with any method of the same signal.
  */
 class JPetRawSignal: public JPetBaseSignal
 {
 public:
   enum PointsSortOrder { ByThrValue, ByThrNum };
+  static const unsigned int kNumberOfThresholds = 4;
 
   JPetRawSignal(const int points = 4);
   virtual ~JPetRawSignal();
+  JPetRawSignal(const JPetRawSignal& other);
+  JPetRawSignal(JPetRawSignal&& other);
+  JPetRawSignal& operator=(const JPetRawSignal& other);
+  JPetRawSignal& operator=(JPetRawSignal&& other);
   int getNumberOfPoints(JPetSigCh::EdgeType edge) const;
   void addPoint(const JPetSigCh& sigch);
   std::vector<JPetSigCh> getPoints(JPetSigCh::EdgeType edge,
@@ -44,13 +61,44 @@ public:
   std::map<int, std::pair<float, float>> getTimesVsThresholdValue(JPetSigCh::EdgeType edge) const;
   std::map<int, double> getTOTsVsThresholdValue() const;
   std::map<int, double> getTOTsVsThresholdNumber() const;
+  bool hasPoint(JPetSigCh::EdgeType edge, unsigned int thrNum) const;
+  const JPetSigCh& getPoint(JPetSigCh::EdgeType edge, unsigned int thrNum) const;
+  float getTime(JPetSigCh::EdgeType edge, unsigned int thrNum) const;
+  float getThresholdValue(JPetSigCh::EdgeType edge, unsigned int thrNum) const;
+  bool hasTOT(unsigned int thrNum) const;
+  float getTOT(unsigned int thrNum) const;
+  /// Whether the index of the edge has all the points, i.e. no doubled thresholds and no other threshold numbers
+  bool isThresholdIndexComplete(JPetSigCh::EdgeType edge) const;
 
   void Clear(Option_t * opt = "");
 
 private:
+  enum ThresholdIndexState { kIndexNotBuilt, kIndexBeingBuilt, kIndexBuilt };
+
+  void buildThresholdIndex() const;
+  void ensureThresholdIndex() const;
+  void indexPoint(int edgeIndex, std::size_t pointIndex, const JPetSigCh& point) const;
+  inline static int getEdgeIndex(JPetSigCh::EdgeType edge) { return edge == JPetSigCh::Trailing ? 0 : 1; }
+  inline int getPointIndex(JPetSigCh::EdgeType edge, unsigned int thrNum) const
+  {
+    if (fThresholdIndexState.load(std::memory_order_acquire) != kIndexBuilt) {
+      ensureThresholdIndex();
+    }
+    return (thrNum >= 1 && thrNum <= kNumberOfThresholds) ? fPointIndices[getEdgeIndex(edge)][thrNum - 1] : -1;
+  }
+  bool areThresholdValuesIncreasing(JPetSigCh::EdgeType edge) const;
+  bool areThresholdValuesUnique() const;
+
   std::vector<JPetSigCh> fLeadingPoints;
   std::vector<JPetSigCh> fTrailingPoints;
 
+  /// Index of the points by the threshold number, invalidated when the signal is read from a file
+  mutable std::atomic<int> fThresholdIndexState; //!
+  mutable int fPointIndices[2][kNumberOfThresholds]; //!
+  mutable float fTimes[2][kNumberOfThresholds]; //!
+  mutable float fThresholds[2][kNumberOfThresholds]; //!
+  mutable bool fIsThresholdIndexCompleteForEdge[2]; //!
+
   ClassDef(JPetRawSignal, 7);
 };
 
@@ -47,6 +47,10 @@ public:
   };
   JPetRecoSignal(const int points = 0);
   virtual ~JPetRecoSignal();
+  JPetRecoSignal(const JPetRecoSignal&) = default;
+  JPetRecoSignal(JPetRecoSignal&&) = default;
+  JPetRecoSignal& operator=(const JPetRecoSignal&) = default;
+  JPetRecoSignal& operator=(JPetRecoSignal&&) = default;
 
   /**
    * Get the shape of the signal as a vector of (time[ps], amplitude[mV]) pairs
@@ -167,6 +171,11 @@ public:
     return fRecoTimesAtThreshold;
   }
 
+  const std::map<float, float>& getRecoTimesAtThreshold() const
+  {
+    return fRecoTimesAtThreshold;
+  }
+
   /**
    * @brief Set the reconstructed time at an arbitrary threshold
    *
@@ -17,6 +17,7 @@
 #define JPETSIGCH_H
 
 #include "./JPetTOMBChannel/JPetTOMBChannel.h"
+#include "./JPetParamResolver/JPetParamResolver.h"
 #include "./JPetLoggerInclude.h"
 #include "./JPetFEB/JPetFEB.h"
 #include "./JPetTRB/JPetTRB.h"
@@ -31,6 +32,7 @@
  *
  * Represents time of signal from one PMT crossing a certain voltage threshold
  * at either leading or trailing edge of the signal.
+ * The parametric objects are referenced by their ids (see JPetParamResolver).
  */
 class JPetSigCh: public TObject
 {
@@ -79,8 +81,19 @@ private:
   TRef fFEB = NULL;
   TRef fTRB = NULL;
   TRef fTOMBChannel = NULL;
+  int fPMID = JPetParamResolver::kNoID;
+  int fFEBID = JPetParamResolver::kNoID;
+  int fTRBID = JPetParamResolver::kNoID;
+  int fTOMBChannelID = JPetParamResolver::kNoID;
+  const JPetPM* fPMPointer = nullptr; //!
+  const JPetFEB* fFEBPointer = nullptr; //!
+  const JPetTRB* fTRBPointer = nullptr; //!
+  const JPetTOMBChannel* fTOMBChannelPointer = nullptr; //!
+  unsigned int fPointerGeneration = 0; //!
 
-  ClassDef(JPetSigCh, 9);
+  void updatePointerGeneration();
+
+  ClassDef(JPetSigCh, 10);
 };
 
 #endif /* !JPETSIGCH_H */
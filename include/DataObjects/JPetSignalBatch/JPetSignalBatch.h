@@ -0,0 +1,73 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSignalBatch.h
+ */
+
+#ifndef JPETSIGNALBATCH_H
+#define JPETSIGNALBATCH_H
+
+#include "./JPetRawSignal/JPetRawSignal.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Leading and trailing times of many raw signals, stored as structure of arrays.
+ *
+ * For every threshold number (from 1 to kNumberOfThresholds) the batch keeps one
+ * contiguous array of the leading times and one of the trailing times [ps],
+ * with one element per signal, in the order the signals were added.
+ * A missing point is stored as NaN. All the points of an edge with doubled thresholds
+ * or other threshold numbers (see JPetRawSignal::isThresholdIndexComplete()) are stored as missing.
+ * The batch is filled once, e.g. from a whole JPetTimeWindow of raw signals with fill(),
+ * or as two batches of the signals of the sides A and B paired by barrel slot with the static fill(),
+ * and then processed by the kernels, which compute one quantity for all signals
+ * in simple loops over the arrays that the compiler vectorises.
+ * The kernels for the A and B sides take two batches of the same size,
+ * the i-th signal of one batch is paired with the i-th signal of the other.
+ * The results are NaN for the signals without the needed points, the summed TOT
+ * includes only the thresholds with both points. The kernels return false
+ * for a wrong threshold number or batches of different sizes.
+ * The output vectors are resized, so reusing them does not allocate memory.
+ */
+class JPetSignalBatch
+{
+public:
+  static const unsigned int kNumberOfThresholds = JPetRawSignal::kNumberOfThresholds;
+
+  void clear();
+  void reserve(std::size_t size);
+  std::size_t getSize() const;
+  void add(const JPetRawSignal& signal);
+  bool fill(const JPetTimeWindow& window);
+  static bool fill(const JPetTimeWindow& window, JPetSignalBatch& sideA, JPetSignalBatch& sideB,
+                   std::vector<int>* barrelSlotIDs = nullptr);
+
+  const std::vector<float>& getLeadingTimes(unsigned int thrNum) const;
+  const std::vector<float>& getTrailingTimes(unsigned int thrNum) const;
+
+  static bool computeTOT(const JPetSignalBatch& batch, unsigned int thrNum, std::vector<float>& tot);
+  static void computeSummedTOT(const JPetSignalBatch& batch, std::vector<double>& summedTOT);
+  static bool computeTimeDiffAB(const JPetSignalBatch& sideA, const JPetSignalBatch& sideB, unsigned int thrNum,
+                                std::vector<double>& timeDiff);
+  static bool computeMeanTime(const JPetSignalBatch& sideA, const JPetSignalBatch& sideB, unsigned int thrNum,
+                              std::vector<double>& meanTime);
+
+private:
+  std::size_t fSize = 0;
+  std::array<std::vector<float>, kNumberOfThresholds> fLeadingTimes;
+  std::array<std::vector<float>, kNumberOfThresholds> fTrailingTimes;
+};
+
+#endif /* !JPETSIGNALBATCH_H */
@@ -19,6 +19,8 @@
 #include <TClonesArray.h>
 #include <TNamed.h>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -27,6 +29,15 @@
  *
  * A single TimeWindow contains many objects (referred to as "events")
  * representing events which happened during one time window of the DAQ system.
+ *
+ * The events are pooled: Clear() keeps the objects constructed in the array
+ * and add() copy-assigns the new event into the next one. The containers nested
+ * in the recycled objects (vectors, maps) reuse their memory, and the array keeps
+ * the highest number of events seen so far, so in a steady state filling the
+ * window does not allocate memory.
+ * Temporary events can be moved into the window with add(T&&), or built directly
+ * in the next slot with emplace().
+ * For loops over many events JPetTypedWindowView offers typed access without dynamic_cast.
  */
 class JPetTimeWindow: public TObject
 {
@@ -38,7 +49,31 @@ public:
   template<typename T>
   void add(const T& evt)
   {
-    dynamic_cast<T&>(*(fEvents.ConstructedAt(fEventCount++))) = evt;
+    nextEvent<T>() = evt;
+  }
+
+  template<typename T, typename = typename std::enable_if<!std::is_reference<T>::value>::type>
+  void add(T&& evt)
+  {
+    nextEvent<T>() = std::move(evt);
+  }
+
+  /// Returns the next event, cleared, to be filled in place
+  template<typename T>
+  T& emplace()
+  {
+    T& evt = nextEvent<T>();
+    evt.Clear();
+    return evt;
+  }
+
+  /// Constructs the next event from the arguments and moves it into the recycled slot
+  template<typename T, typename Arg, typename... Args>
+  T& emplace(Arg&& arg, Args&&... args)
+  {
+    T& evt = nextEvent<T>();
+    evt = T(std::forward<Arg>(arg), std::forward<Args>(args)...);
+    return evt;
   }
 
   inline size_t getNumberOfEvents() const
@@ -51,6 +86,12 @@ public:
     return *fEvents[i];
   }
 
+  /// Class of the events, nullptr for a window created without the event type
+  inline const TClass* getEventClass() const
+  {
+    return fEvents.GetClass();
+  }
+
   template<typename T>
   inline const T& getEvent(int i) const
   {
@@ -63,15 +104,25 @@ public:
     fEventCount = 0;
   }
 
+  /// The events are not cleared, they are overwritten when the slots are reused by add()
   virtual void Clear()
   {
-    fEvents.Clear("C");
+    fEvents.Clear();
     fEventCount = 0;
   }
 
   ClassDef(JPetTimeWindow, 5);
 
 private:
+  template<typename T>
+  friend class JPetTypedWindowView;
+
+  template<typename T>
+  T& nextEvent()
+  {
+    return dynamic_cast<T&>(*(fEvents.ConstructedAt(fEventCount++)));
+  }
+
   TClonesArray fEvents;
   unsigned int fEventCount = 0;
 };
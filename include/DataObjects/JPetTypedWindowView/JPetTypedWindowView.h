@@ -0,0 +1,144 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTypedWindowView.h
+ */
+
+#ifndef JPETTYPEDWINDOWVIEW_H
+#define JPETTYPEDWINDOWVIEW_H
+
+#include "./JPetLoggerInclude.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
+#include <TClass.h>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Typed view over the events stored in a JPetTimeWindow.
+ *
+ * The class of the events is checked once, when the view is created, using the
+ * class of the TClonesArray of the window. Afterwards the events are accessed
+ * with static casts, without the dynamic_cast done by JPetTimeWindow::getEvent().
+ * The view provides random access iterators, so it can be used in range-for loops
+ * and with STL algorithms, e.g.:
+ *
+ *   JPetTypedWindowView<JPetHit> hits(window);
+ *   std::sort(hits.begin(), hits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
+ *
+ * Algorithms reordering the events (sort, partition) swap the contents of the events.
+ * A view of const T can be created for a const window. If the window holds events
+ * of a different class, an error is logged and the view is empty (isValid() returns false).
+ * The view must not outlive the window and is invalidated by adding events or clearing the window.
+ */
+template <typename T>
+class JPetTypedWindowView
+{
+public:
+  using Window = typename std::conditional<std::is_const<T>::value, const JPetTimeWindow, JPetTimeWindow>::type;
+
+  class iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename std::remove_const<T>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    iterator() {}
+    iterator(const TClonesArray* events, difference_type index) : fEvents(events), fIndex(index) {}
+
+    reference operator*() const { return static_cast<reference>(*fEvents->UncheckedAt(fIndex)); }
+    pointer operator->() const { return &**this; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator& operator++()
+    {
+      ++fIndex;
+      return *this;
+    }
+    iterator operator++(int)
+    {
+      iterator old(*this);
+      ++fIndex;
+      return old;
+    }
+    iterator& operator--()
+    {
+      --fIndex;
+      return *this;
+    }
+    iterator operator--(int)
+    {
+      iterator old(*this);
+      --fIndex;
+      return old;
+    }
+    iterator& operator+=(difference_type n)
+    {
+      fIndex += n;
+      return *this;
+    }
+    iterator& operator-=(difference_type n)
+    {
+      fIndex -= n;
+      return *this;
+    }
+    iterator operator+(difference_type n) const { return iterator(fEvents, fIndex + n); }
+    iterator operator-(difference_type n) const { return iterator(fEvents, fIndex - n); }
+    friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+    difference_type operator-(const iterator& other) const { return fIndex - other.fIndex; }
+
+    bool operator==(const iterator& other) const { return fIndex == other.fIndex; }
+    bool operator!=(const iterator& other) const { return fIndex != other.fIndex; }
+    bool operator<(const iterator& other) const { return fIndex < other.fIndex; }
+    bool operator>(const iterator& other) const { return fIndex > other.fIndex; }
+    bool operator<=(const iterator& other) const { return fIndex <= other.fIndex; }
+    bool operator>=(const iterator& other) const { return fIndex >= other.fIndex; }
+
+  private:
+    const TClonesArray* fEvents = nullptr;
+    difference_type fIndex = 0;
+  };
+
+  explicit JPetTypedWindowView(Window& window) : fEvents(&window.fEvents)
+  {
+    auto eventClass = fEvents->GetClass();
+    if (window.getNumberOfEvents() == 0 && !eventClass)
+    {
+      return;
+    }
+    if (!eventClass || !eventClass->InheritsFrom(std::remove_const<T>::type::Class()))
+    {
+      ERROR(std::string("Time window does not contain events of class ") + std::remove_const<T>::type::Class()->GetName());
+      return;
+    }
+    fSize = window.getNumberOfEvents();
+    fIsValid = true;
+  }
+
+  bool isValid() const { return fIsValid; }
+  std::size_t size() const { return fSize; }
+  bool empty() const { return fSize == 0; }
+  iterator begin() const { return iterator(fEvents, 0); }
+  iterator end() const { return iterator(fEvents, fSize); }
+  T& operator[](std::size_t i) const { return static_cast<T&>(*fEvents->UncheckedAt(i)); }
+
+private:
+  const TClonesArray* fEvents = nullptr;
+  std::size_t fSize = 0;
+  bool fIsValid = false;
+};
+
+#endif /* !JPETTYPEDWINDOWVIEW_H */
@@ -16,6 +16,7 @@
 #ifndef JPETGEANTPARSERTOOLS_H
 #define JPETGEANTPARSERTOOLS_H
 
+#include "JPetDetectorGeometryCache/JPetDetectorGeometryCache.h"
 #include "JPetParamBank/JPetParamBank.h"
 #include "JPetSmearingFunctions/JPetSmearingFunctions.h"
 #include <JPetGeantEventPack/JPetGeantEventPack.h>
@@ -43,6 +44,8 @@ public:
   static JPetMCHit createJPetMCHit(JPetGeantScinHits* geantHit, const JPetParamBank& paramBank);
 
   static JPetHit reconstructHit(JPetMCHit& hit, const JPetParamBank& paramBank, const float timeShift, JPetHitExperimentalParametrizer& parametrizer);
+  static JPetHit reconstructHit(JPetMCHit& hit, const JPetDetectorGeometryCache& geometry, const float timeShift,
+                                JPetHitExperimentalParametrizer& parametrizer);
 
   static bool isHitReconstructed(JPetHit& hit, const float th);
 
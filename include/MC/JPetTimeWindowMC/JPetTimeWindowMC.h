@@ -18,16 +18,26 @@
 
 #include "JPetData/JPetData.h"
 #include <JPetTimeWindow/JPetTimeWindow.h>
+#include <TBranch.h>
 #include <TClonesArray.h>
 #include <TNamed.h>
 #include <iostream>
 #include <map>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
  * @brief Container class representing a time window of the DAQ system
  *
  * A single TimeWindow contains many objects (referred to as "events") representing events which happened during one time window of the DAQ system.
+ *
+ * The MC truth (MC hits and decay trees) can be stored in the output tree either inside the window
+ * or, when the reconstructed events are written without copying, in separate TClonesArray branches
+ * kMCHitsBranchName and kDecayTreesBranchName next to a plain JPetTimeWindow branch. In the latter case
+ * the reader binds the MC truth branches to the arrays of the window with setMCTruthBranches() and selects
+ * the entry with setMCTruthEntry(). The MC truth of the entry is then read only when it is accessed
+ * for the first time, so that tasks using only the reconstructed events do not pay for reading it.
  */
 class JPetTimeWindowMC: public JPetTimeWindow
 {
@@ -45,12 +55,12 @@ public:
 
   JPetTimeWindowMC(const char* event_type, const char* mcHit_type, const char* decayTree_type) :
     JPetTimeWindow(event_type),
-    fMCHits(mcHit_type, 2000),
-    fDecayTrees(decayTree_type, 2000)
+    fMCHits(mcHit_type, kInitialMCArraySize),
+    fDecayTrees(decayTree_type, kInitialMCArraySize)
   {}
 
   JPetTimeWindowMC(JPetTimeWindowMC const& other, JPetTimeWindow const& inner)
-      : JPetTimeWindow(inner), fMCHits(other.fMCHits), fDecayTrees(other.fDecayTrees), fMCHitsCount(other.fMCHitsCount),
+      : JPetTimeWindow(inner), fMCHits(loaded(other).fMCHits), fDecayTrees(other.fDecayTrees), fMCHitsCount(other.fMCHitsCount),
         fDecayTreesCount(other.fDecayTreesCount)
   {
   }
@@ -58,34 +68,85 @@ public:
   template<typename T>
   void addMCHit(const T& evt)
   {
+    loadMCTruth();
     dynamic_cast<T&>(*(fMCHits.ConstructedAt(fMCHitsCount++))) = evt;
   }
 
+  template<typename T, typename = typename std::enable_if<!std::is_reference<T>::value>::type>
+  void addMCHit(T&& evt)
+  {
+    loadMCTruth();
+    dynamic_cast<T&>(*(fMCHits.ConstructedAt(fMCHitsCount++))) = std::move(evt);
+  }
+
   template<typename T>
   void addDecayTree(const T& evt)
   {
+    loadMCTruth();
     dynamic_cast<T&>(*(fDecayTrees.ConstructedAt(fDecayTreesCount++))) = evt;
   }
 
+  template<typename T, typename = typename std::enable_if<!std::is_reference<T>::value>::type>
+  void addDecayTree(T&& evt)
+  {
+    loadMCTruth();
+    dynamic_cast<T&>(*(fDecayTrees.ConstructedAt(fDecayTreesCount++))) = std::move(evt);
+  }
+
+  static const char* const kMCHitsBranchName;
+  static const char* const kDecayTreesBranchName;
+
+  /// Arrays of the MC truth, the non-const ones are used to bind them to the output tree branches
+  const TClonesArray& getMCHitsArray() const
+  {
+    loadMCTruth();
+    return fMCHits;
+  }
+
+  TClonesArray& getMCHitsArray()
+  {
+    loadMCTruth();
+    return fMCHits;
+  }
+
+  const TClonesArray& getDecayTreesArray() const
+  {
+    loadMCTruth();
+    return fDecayTrees;
+  }
+
+  TClonesArray& getDecayTreesArray()
+  {
+    loadMCTruth();
+    return fDecayTrees;
+  }
+
+  void setMCTruthBranches(TBranch* mcHitsBranch, TBranch* decayTreesBranch);
+  void setMCTruthEntry(long long entry);
+
   inline size_t getNumberOfMCHits() const
   {
+    loadMCTruth();
     return fMCHitsCount;
   }
 
   inline size_t getNumberOfDecayTrees() const
   {
+    loadMCTruth();
     return fDecayTreesCount;
   }
 
   template<typename T>
   inline const T& getMCHit(int i) const
   {
+    loadMCTruth();
     return *(dynamic_cast<T*>(fMCHits[i]));
   }
 
   template<typename T>
   inline const T& getDecayTrees(int i) const
   {
+    loadMCTruth();
     return *(dynamic_cast<T*>(fDecayTrees[i]));
   }
 
@@ -101,19 +162,51 @@ public:
   virtual void Clear()
   {
     JPetTimeWindow::Clear();
-    fMCHits.Clear("C");
-    fDecayTrees.Clear("C");
+    fMCHits.Clear();
+    fDecayTrees.Clear();
     fMCHitsCount = 0;
     fDecayTreesCount = 0;
+    fIsMCTruthLoaded = true;
+  }
+
+  bool isMCTruthLoaded() const
+  {
+    return fIsMCTruthLoaded;
   }
 
   ClassDef(JPetTimeWindowMC, 2);
 
 private:
-  TClonesArray fMCHits;
-  TClonesArray fDecayTrees;
-  unsigned int fMCHitsCount = 0;
-  unsigned int fDecayTreesCount = 0;
+  /// Initial size of the MC arrays, they grow on demand
+  static const int kInitialMCArraySize = 16;
+
+  /// Reads the MC truth of the selected entry if it has not been read yet
+  inline void loadMCTruth() const
+  {
+    if (!fIsMCTruthLoaded)
+    {
+      readMCTruth();
+    }
+  }
+  void readMCTruth() const;
+  static const JPetTimeWindowMC& loaded(const JPetTimeWindowMC& window)
+  {
+    window.loadMCTruth();
+    return window;
+  }
+
+  /// mutable since the MC truth is read from the branches on the first (const) access
+  mutable TClonesArray fMCHits;
+  mutable TClonesArray fDecayTrees;
+  mutable unsigned int fMCHitsCount = 0;
+  mutable unsigned int fDecayTreesCount = 0;
+  mutable bool fIsMCTruthLoaded = true; //!
+  long long fMCTruthEntry = -1; //!
+  TBranch* fMCHitsBranch = nullptr; //!
+  TBranch* fDecayTreesBranch = nullptr; //!
+  /// Addresses of the arrays given to the bound branches
+  TClonesArray* fMCHitsAddress = nullptr; //!
+  TClonesArray* fDecayTreesAddress = nullptr; //!
 };
 
 #endif
@@ -43,5 +43,7 @@ void setOutputFileType(OptsStrAny& options, const std::string fileType);
 void setResetEventRangeOption(OptsStrAny& options, bool isReset);
 void setOutputFile(OptsStrAny& options, const std::string file);
 void setOutputPath(OptsStrAny& options, const std::string path);
+void setChainInputFiles(OptsStrAny& options, bool isChain);
+void setInputFiles(OptsStrAny& options, const std::vector<std::string>& files);
 };
 #endif /* !JPETOPTIONSGENERATORTOOLS_H */
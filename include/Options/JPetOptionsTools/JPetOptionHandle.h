@@ -0,0 +1,81 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetOptionHandle.h
+ */
+
+#ifndef JPETOPTIONHANDLE_H
+#define JPETOPTIONHANDLE_H
+
+#include "./JPetOptionsTools/JPetOptionsTools.h"
+#include "JPetLoggerInclude.h"
+#include <boost/any.hpp>
+#include <cassert>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Typed handle to the value of one option, e.g. JPetOptionHandle<double>.
+ *
+ * The option is looked up by its name and its type is checked once, when the handle
+ * is created (e.g. in the init() of a task, with JPetParams::getOptionHandle()).
+ * Then get() only dereferences the pointer to the value: no lookup, no cast
+ * and no allocation. The handle keeps the options alive, so it stays valid
+ * as long as it exists. The options shared by JPetParams are immutable.
+ * If the option is not set or has another type, the handle is not set
+ * and getOr() returns the given default value.
+ */
+template <typename T>
+class JPetOptionHandle
+{
+public:
+  JPetOptionHandle() {}
+
+  JPetOptionHandle(const std::shared_ptr<const jpet_options_tools::OptsStrAny>& options, const std::string& name) : fName(name)
+  {
+    if (!options)
+    {
+      return;
+    }
+    auto option = options->find(name);
+    if (option == options->end())
+    {
+      return;
+    }
+    fValue = boost::any_cast<T>(&option->second);
+    if (!fValue)
+    {
+      ERROR("Bad option type of:" + name + " " + option->second.type().name());
+      return;
+    }
+    fOptions = options;
+  }
+
+  inline bool isSet() const { return fValue != nullptr; }
+
+  inline const T& get() const
+  {
+    assert(fValue);
+    return *fValue;
+  }
+
+  inline const T& getOr(const T& defaultValue) const { return fValue ? *fValue : defaultValue; }
+
+  const std::string& getName() const { return fName; }
+
+private:
+  std::string fName;
+  std::shared_ptr<const jpet_options_tools::OptsStrAny> fOptions;
+  const T* fValue = nullptr;
+};
+
+#endif /* !JPETOPTIONHANDLE_H */
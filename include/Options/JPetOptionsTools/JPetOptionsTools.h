@@ -45,6 +45,7 @@ std::vector<std::string> getInputFiles(const OptsStrAny& opts);
 std::string getInputFile(const OptsStrAny& opts);
 std::string getScopeConfigFile(const OptsStrAny& opts);
 std::string getScopeInputDirectory(const OptsStrAny& opts);
+bool isScopeCache(const OptsStrAny& opts);
 std::string getOutputFile(const OptsStrAny& opts);
 std::string getOutputPath(const OptsStrAny& opts);
 long long getFirstEvent(const OptsStrAny& opts);
@@ -52,8 +53,16 @@ long long getLastEvent(const OptsStrAny& opts);
 long long getTotalEvents(const OptsStrAny& opts);
 int getRunNumber(const OptsStrAny& opts);
 bool isProgressBar(const OptsStrAny& opts);
+bool isChainInputFiles(const OptsStrAny& opts);
+int getOutputSplitWindows(const OptsStrAny& opts);
+int getOutputSplitSizeMB(const OptsStrAny& opts);
+double getOutputSplitTimeSpan(const OptsStrAny& opts);
+bool isSaveEntryIndex(const OptsStrAny& opts);
+bool isStreamUnpacking(const OptsStrAny& opts);
+int getStreamUnpackingChunkSizeMB(const OptsStrAny& opts);
 bool isLocalDB(const OptsStrAny& opts);
 std::string getLocalDB(const OptsStrAny& opts);
+bool isLocalDBCompile(const OptsStrAny& opts);
 bool isLocalDBCreate(const OptsStrAny& opts);
 std::string getLocalDBCreate(const OptsStrAny& opts);
 std::string getUnpackerConfigFile(const OptsStrAny& opts);
@@ -29,6 +29,7 @@
 #include "JPetTRB/JPetTRB.h"
 #include "JPetPM/JPetPM.h"
 
+#include "JPetParamBank/JPetParamIndex.h"
 #include <cassert>
 #include <map>
 
@@ -40,6 +41,8 @@ public:
   ~JPetParamBank();
   bool isDummy() const;
   void clear();
+  void buildIndex();
+  bool isIndexBuilt() const;
   int getSize(ParamObjectType type) const;
 
   /**
@@ -47,12 +50,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addScintillator(JPetScin scintillator) {
+    fScintillatorsIndex.clear();
     if (fScintillators.insert(std::make_pair(scintillator.getID(), new JPetScin(scintillator))).second == false) {
       WARNING("the scintillator with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetScin*>& getScintillators() const { return fScintillators; }
-  inline JPetScin& getScintillator(int i) const { return *(fScintillators.at(i)); }
+  inline JPetScin& getScintillator(int i) const { return fScintillatorsIndex.get(fScintillators, i); }
+  inline JPetScin* findScintillator(int i) const { return fScintillatorsIndex.find(fScintillators, i); }
   inline int getScintillatorsSize() const { return fScintillators.size(); }
 
   /**
@@ -60,12 +65,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addPM(JPetPM pm) {
+    fPMsIndex.clear();
     if (fPMs.insert(std::make_pair(pm.getID(), new JPetPM(pm))).second == false) {
       WARNING("the pm with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetPM*>& getPMs() const { return fPMs; }
-  inline JPetPM& getPM(int id) const { return *(fPMs.at(id)); }
+  inline JPetPM& getPM(int id) const { return fPMsIndex.get(fPMs, id); }
+  inline JPetPM* findPM(int id) const { return fPMsIndex.find(fPMs, id); }
   int getPMsSize() const { return fPMs.size(); }
 
   /**
@@ -73,12 +80,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addFEB(JPetFEB feb) {
+    fFEBsIndex.clear();
     if (fFEBs.insert(std::make_pair(feb.getID(), new JPetFEB(feb))).second == false) {
       WARNING("the feb with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetFEB*>& getFEBs() const { return fFEBs; }
-  inline JPetFEB& getFEB(int i) const { return *(fFEBs.at(i)); }
+  inline JPetFEB& getFEB(int i) const { return fFEBsIndex.get(fFEBs, i); }
+  inline JPetFEB* findFEB(int i) const { return fFEBsIndex.find(fFEBs, i); }
   inline int getFEBsSize() const { return fFEBs.size(); }
 
   /**
@@ -86,12 +95,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addTRB(JPetTRB trb) {
+    fTRBsIndex.clear();
     if (fTRBs.insert(std::make_pair(trb.getID(), new JPetTRB(trb))).second == false) {
       WARNING("the trb with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetTRB*>& getTRBs() const { return fTRBs; }
-  inline JPetTRB& getTRB(int i) const { return *(fTRBs.at(i)); }
+  inline JPetTRB& getTRB(int i) const { return fTRBsIndex.get(fTRBs, i); }
+  inline JPetTRB* findTRB(int i) const { return fTRBsIndex.find(fTRBs, i); }
   inline int getTRBsSize() const { return fTRBs.size(); }
 
   /**
@@ -99,12 +110,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addBarrelSlot(JPetBarrelSlot slot) {
+    fBarrelSlotsIndex.clear();
     if (fBarrelSlots.insert(std::make_pair(slot.getID(), new JPetBarrelSlot(slot))).second == false) {
       WARNING("the barrelslot with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetBarrelSlot*>& getBarrelSlots() const { return fBarrelSlots; }
-  inline JPetBarrelSlot& getBarrelSlot(int i) const { return *(fBarrelSlots.at(i)); }
+  inline JPetBarrelSlot& getBarrelSlot(int i) const { return fBarrelSlotsIndex.get(fBarrelSlots, i); }
+  inline JPetBarrelSlot* findBarrelSlot(int i) const { return fBarrelSlotsIndex.find(fBarrelSlots, i); }
   inline int getBarrelSlotsSize() const { return fBarrelSlots.size(); }
 
   /**
@@ -112,12 +125,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addLayer(JPetLayer layer) {
+    fLayersIndex.clear();
     if (fLayers.insert(std::make_pair(layer.getID(), new JPetLayer(layer))).second == false) {
       WARNING("the layer with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetLayer*>& getLayers() const { return fLayers; }
-  inline JPetLayer& getLayer(int i) const { return *(fLayers.at(i)); }
+  inline JPetLayer& getLayer(int i) const { return fLayersIndex.get(fLayers, i); }
+  inline JPetLayer* findLayer(int i) const { return fLayersIndex.find(fLayers, i); }
   inline int getLayersSize() const { return fLayers.size(); }
 
   /**
@@ -125,12 +140,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addFrame(JPetFrame frame) {
+    fFramesIndex.clear();
     if (fFrames.insert(std::make_pair(frame.getID(), new JPetFrame(frame))).second == false) {
       WARNING("the frame with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetFrame*>& getFrames() const { return fFrames; }
-  inline JPetFrame& getFrame(int i) const { return *(fFrames.at(i)); }
+  inline JPetFrame& getFrame(int i) const { return fFramesIndex.get(fFrames, i); }
+  inline JPetFrame* findFrame(int i) const { return fFramesIndex.find(fFrames, i); }
   inline int getFramesSize() const { return fFrames.size(); }
 
   /**
@@ -138,12 +155,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addTOMBChannel(JPetTOMBChannel tombchannel) {
+    fTOMBChannelsIndex.clear();
     if (fTOMBChannels.insert(std::make_pair(tombchannel.getChannel(), new JPetTOMBChannel(tombchannel))).second == false) {
       WARNING("the tombchannel with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetTOMBChannel*>& getTOMBChannels() const { return fTOMBChannels; }
-  inline JPetTOMBChannel& getTOMBChannel(int i) const { return *(fTOMBChannels.at(i)); }
+  inline JPetTOMBChannel& getTOMBChannel(int i) const { return fTOMBChannelsIndex.get(fTOMBChannels, i); }
+  inline JPetTOMBChannel* findTOMBChannel(int i) const { return fTOMBChannelsIndex.find(fTOMBChannels, i); }
   inline int getTOMBChannelsSize() const { return fTOMBChannels.size(); }
 
   /**
@@ -151,12 +170,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addDataSource(JPetDataSource dataSource) {
+    fDataSourcesIndex.clear();
     if (fDataSources.insert(std::make_pair(dataSource.getID(), new JPetDataSource(dataSource))).second == false) {
       WARNING("The Data Source with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetDataSource*>& getDataSources() const { return fDataSources; }
-  inline JPetDataSource& getDataSource(int i) const { return *(fDataSources.at(i)); }
+  inline JPetDataSource& getDataSource(int i) const { return fDataSourcesIndex.get(fDataSources, i); }
+  inline JPetDataSource* findDataSource(int i) const { return fDataSourcesIndex.find(fDataSources, i); }
   inline int getDataSourcesSize() const { return fDataSources.size(); }
 
   /**
@@ -164,12 +185,14 @@ public:
    * already exists in the Param Bank, the new element will not be added.
    */
   inline void addDataModule(JPetDataModule dataModule) {
+    fDataModulesIndex.clear();
     if (fDataModules.insert(std::make_pair(dataModule.getID(), new JPetDataModule(dataModule))).second == false) {
       WARNING("The Data Module with this id already exists in the ParamBank. It will not be added.");
     }
   }
   inline const std::map<int, JPetDataModule*>& getDataModules() const { return fDataModules; }
-  inline JPetDataModule& getDataModule(int i) const { return *(fDataModules.at(i)); }
+  inline JPetDataModule& getDataModule(int i) const { return fDataModulesIndex.get(fDataModules, i); }
+  inline JPetDataModule* findDataModule(int i) const { return fDataModulesIndex.find(fDataModules, i); }
   inline int getDataModulesSize() const { return fDataModules.size(); }
 
   Int_t Write(const char* name, Int_t option, Int_t bufsize) const { return TObject::Write(name, option, bufsize); }
@@ -191,6 +214,17 @@ private:
   std::map<int, JPetTRB*> fTRBs;
   std::map<int, JPetPM*> fPMs;
 
+  JPetParamIndex<JPetTOMBChannel> fTOMBChannelsIndex; //!
+  JPetParamIndex<JPetDataSource> fDataSourcesIndex; //!
+  JPetParamIndex<JPetDataModule> fDataModulesIndex; //!
+  JPetParamIndex<JPetBarrelSlot> fBarrelSlotsIndex; //!
+  JPetParamIndex<JPetScin> fScintillatorsIndex; //!
+  JPetParamIndex<JPetLayer> fLayersIndex; //!
+  JPetParamIndex<JPetFrame> fFramesIndex; //!
+  JPetParamIndex<JPetFEB> fFEBsIndex; //!
+  JPetParamIndex<JPetTRB> fTRBsIndex; //!
+  JPetParamIndex<JPetPM> fPMsIndex; //!
+
   template <typename T> void copyMapValues(std::map<int, T*>& target, const std::map<int, T*>& source) {
     for (auto& c : source) {
       target[c.first] = new T(*c.second);
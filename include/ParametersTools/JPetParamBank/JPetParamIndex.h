@@ -0,0 +1,236 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamIndex.h
+ */
+
+#ifndef JPETPARAMINDEX_H
+#define JPETPARAMINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Dense index of the objects of one kind stored in JPetParamBank, giving O(1) lookups by id.
+ *
+ * The pointers to the objects are stored in one contiguous table. If the ids are compact,
+ * the table is indexed directly by the id minus the smallest id. Otherwise, it is a perfect hash
+ * table built with the hash and displace method: the ids are divided into buckets by one hash
+ * function and, for every bucket, the seed of the second hash function is chosen so that
+ * every id has its own slot. A lookup takes two hashes and one comparison.
+ * The index does not own the objects, it must be built again when the objects change.
+ * If it is not built, the lookups fall back to the map with the objects.
+ */
+template <typename T>
+class JPetParamIndex
+{
+public:
+  void build(const std::map<int, T*>& objects)
+  {
+    clear();
+    if (objects.empty())
+    {
+      fIsBuilt = true;
+      return;
+    }
+    std::int64_t minID = objects.begin()->first;
+    std::int64_t span = static_cast<std::int64_t>(objects.rbegin()->first) - minID + 1;
+    if (span <= static_cast<std::int64_t>(kMaxDirectSpanPerObject * objects.size() + kMaxDirectSpanMargin))
+    {
+      fIsDirect = true;
+      fMinID = minID;
+      fSlots.resize(span);
+      for (const auto& object : objects)
+      {
+        fSlots[object.first - minID] = {object.first, object.second};
+      }
+      fIsBuilt = true;
+      return;
+    }
+    for (std::size_t size = getTableSize(objects.size()); size <= kMaxHashSizePerObject * objects.size(); size *= 2)
+    {
+      if (fillHashTable(objects, size))
+      {
+        fIsBuilt = true;
+        return;
+      }
+    }
+    clear();
+  }
+
+  void clear()
+  {
+    fSlots.clear();
+    fIsBuilt = false;
+    fIsDirect = false;
+    fMinID = 0;
+    fMask = 0;
+    fSeeds.clear();
+  }
+
+  bool isBuilt() const { return fIsBuilt; }
+  bool isDirect() const { return fIsDirect; }
+
+  /**
+   * @brief Returns the object with the given id, throws std::out_of_range if there is no such object.
+   */
+  inline T& get(const std::map<int, T*>& objects, int id) const
+  {
+    if (auto object = find(objects, id))
+    {
+      return *object;
+    }
+    throw std::out_of_range("No object with id " + std::to_string(id) + " in the ParamBank");
+  }
+
+  /**
+   * @brief Returns the object with the given id or nullptr if there is no such object.
+   */
+  inline T* find(const std::map<int, T*>& objects, int id) const
+  {
+    if (!fIsBuilt)
+    {
+      auto object = objects.find(id);
+      return object == objects.end() ? nullptr : object->second;
+    }
+    return find(id);
+  }
+
+  /**
+   * @brief Returns the object with the given id or nullptr if there is no such object or the index is not built.
+   */
+  inline T* find(int id) const
+  {
+    const Slot* slot = nullptr;
+    if (fIsDirect)
+    {
+      auto index = static_cast<std::uint64_t>(static_cast<std::int64_t>(id) - fMinID);
+      if (index < fSlots.size())
+      {
+        slot = &fSlots[index];
+      }
+    }
+    else if (!fSlots.empty())
+    {
+      slot = &fSlots[hash(id, fSeeds[hash(id, 0) & (fSeeds.size() - 1)]) & fMask];
+    }
+    if (!slot || slot->fID != id)
+    {
+      return nullptr;
+    }
+    return slot->fObject;
+  }
+
+private:
+  struct Slot
+  {
+    int fID = 0;
+    T* fObject = nullptr;
+  };
+
+  static const std::size_t kMaxDirectSpanPerObject = 2;
+  static const std::size_t kMaxDirectSpanMargin = 64;
+  static const std::size_t kMaxHashSizePerObject = 16;
+  static const std::uint32_t kMaxSeed = 1u << 16;
+
+  static inline std::uint32_t hash(int id, std::uint32_t seed)
+  {
+    std::uint32_t value = static_cast<std::uint32_t>(id) * 2654435761u ^ seed;
+    value ^= value >> 16;
+    value *= 0x45d9f3bu;
+    value ^= value >> 16;
+    return value;
+  }
+
+  static std::size_t getTableSize(std::size_t nbOfObjects)
+  {
+    std::size_t size = 1;
+    while (size < 2 * nbOfObjects)
+    {
+      size *= 2;
+    }
+    return size;
+  }
+
+  /// The largest buckets are placed first, when most of the slots are still free.
+  bool fillHashTable(const std::map<int, T*>& objects, std::size_t size)
+  {
+    fSlots.assign(size, Slot());
+    fMask = size - 1;
+    fSeeds.assign(size / 2, 0);
+    std::vector<std::vector<Slot>> buckets(fSeeds.size());
+    for (const auto& object : objects)
+    {
+      buckets[hash(object.first, 0) & (fSeeds.size() - 1)].push_back({object.first, object.second});
+    }
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < buckets.size(); i++)
+    {
+      if (!buckets[i].empty())
+      {
+        order.push_back(i);
+      }
+    }
+    std::stable_sort(order.begin(), order.end(),
+      [&buckets](std::size_t first, std::size_t second) { return buckets[first].size() > buckets[second].size(); });
+    for (auto bucket : order)
+    {
+      if (!placeBucket(buckets[bucket], fSeeds[bucket]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool placeBucket(const std::vector<Slot>& bucket, std::uint32_t& bucketSeed)
+  {
+    std::vector<std::size_t> placed;
+    for (std::uint32_t seed = 1; seed <= kMaxSeed; seed++)
+    {
+      placed.clear();
+      for (const auto& object : bucket)
+      {
+        auto index = hash(object.fID, seed) & fMask;
+        if (fSlots[index].fObject)
+        {
+          break;
+        }
+        fSlots[index] = object;
+        placed.push_back(index);
+      }
+      if (placed.size() == bucket.size())
+      {
+        bucketSeed = seed;
+        return true;
+      }
+      for (auto index : placed)
+      {
+        fSlots[index] = Slot();
+      }
+    }
+    return false;
+  }
+
+  std::vector<Slot> fSlots;
+  bool fIsBuilt = false;
+  bool fIsDirect = false;
+  std::int64_t fMinID = 0;
+  std::size_t fMask = 0;
+  std::vector<std::uint32_t> fSeeds;
+};
+
+#endif /* !JPETPARAMINDEX_H */
@@ -0,0 +1,66 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBankRegistry.h
+ */
+
+#ifndef JPETPARAMBANKREGISTRY_H
+#define JPETPARAMBANKREGISTRY_H
+
+#include "./JPetParamBank/JPetParamBank.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+/**
+ * @brief Process-wide registry of the immutable param banks generated from the parameter sources.
+ *
+ * A bank is identified by the id of its source (see JPetParamGetter::getSourceId), the run number
+ * and the set of the parametric objects expected to be missing. It is built once, by the first
+ * caller, and shared by all the param managers asking for the same bank, e.g. by the task chain
+ * executors processing different files of the same run in parallel.
+ * The registry holds the banks weakly, as JPetDetectorGeometryCache does: a bank is deleted
+ * when its last user releases it, and its entry is removed at the next call.
+ * Callers asking for different banks do not wait for each other. All methods are thread-safe.
+ *
+ * The shared banks are read-only, they are handed out only as const. Their objects must not
+ * be modified, e.g. by setting the TRefs between them, since other threads read them at the
+ * same time. Writing a shared bank to a file only reads the ProcessID tables of ROOT,
+ * which are guarded by its global lock after ROOT::EnableThreadSafety(), called by JPetManager.
+ */
+class JPetParamBankRegistry
+{
+public:
+  using Key = std::tuple<std::string, int, std::set<ParamObjectType>>;
+  using Builder = std::function<std::shared_ptr<const JPetParamBank>()>;
+
+  static std::shared_ptr<const JPetParamBank> getParamBank(const Key& key, const Builder& builder);
+  static std::size_t getSize();
+  static void clear();
+
+private:
+  struct Entry
+  {
+    std::mutex fMutex;
+    std::weak_ptr<const JPetParamBank> fBank;
+  };
+
+  static void removeExpiredEntries();
+  static std::mutex& getMutex();
+  static std::map<Key, std::shared_ptr<Entry>>& getEntries();
+};
+
+#endif /* !JPETPARAMBANKREGISTRY_H */
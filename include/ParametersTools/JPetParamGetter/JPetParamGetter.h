@@ -36,6 +36,12 @@ public:
   virtual ParamObjectsDescriptions getAllBasicData(ParamObjectType type, const int runId) = 0;
   virtual ParamRelationalData getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int runId) = 0;
   virtual ~JPetParamGetter() {};
+  /**
+   * @brief Identifies the source of the parameters and its version. The getters with the same
+   * non-empty id return the same data, so the param banks generated from them can be shared.
+   * The empty id means that the data cannot be shared.
+   */
+  virtual std::string getSourceId() const { return std::string(); }
   static int getTOMBChannelFromDescription(std::string p_desc);
 };
 
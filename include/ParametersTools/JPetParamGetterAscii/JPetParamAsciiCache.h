@@ -0,0 +1,79 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamAsciiCache.h
+ */
+
+#ifndef JPETPARAMASCIICACHE_H
+#define JPETPARAMASCIICACHE_H
+
+#include "./JPetParamGetter/JPetParamGetter.h"
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Process-wide cache of the parsed local DB json files.
+ *
+ * Each file is parsed once and converted to the descriptions of the objects,
+ * grouped by run and by the name of the objects (e.g. "PMs"). The parsed
+ * document is shared and immutable. It is parsed again if the modification
+ * time or the size of the file changes, or after invalidate() is called,
+ * e.g. when the file is written by JPetParamSaverAscii.
+ * The documents read from other formats (e.g. JPetParamBinaryFile) are cached the same way,
+ * with the function reading the file given to getDocument().
+ * All methods are thread-safe.
+ */
+class JPetParamAsciiCache
+{
+public:
+  using ObjectsOfRun = std::map<std::string, std::vector<ParamObjectDescription>>;
+
+  class Document
+  {
+  public:
+    explicit Document(const boost::property_tree::ptree& tree);
+    explicit Document(std::map<std::string, ObjectsOfRun>&& runs);
+    const ObjectsOfRun* getRun(const std::string& runId) const;
+    const std::map<std::string, ObjectsOfRun>& getRuns() const;
+
+  private:
+    std::map<std::string, ObjectsOfRun> fRuns;
+  };
+
+  using Loader = std::function<std::shared_ptr<const Document>(const std::string& fileName)>;
+
+  static std::shared_ptr<const Document> getDocument(const std::string& fileName);
+  static std::shared_ptr<const Document> getDocument(const std::string& fileName, const Loader& loader);
+  static std::shared_ptr<const Document> readJson(const std::string& fileName);
+  static void invalidate(const std::string& fileName);
+  static void clear();
+  static ParamObjectDescription toDescription(const boost::property_tree::ptree& info);
+
+private:
+  struct Entry
+  {
+    std::int64_t fModificationTime = 0;
+    std::uintmax_t fSize = 0;
+    std::shared_ptr<const Document> fDocument;
+  };
+
+  static std::mutex& getMutex();
+  static std::map<std::string, Entry>& getEntries();
+};
+
+#endif /* !JPETPARAMASCIICACHE_H */
@@ -17,10 +17,17 @@
 #define JPETPARAMGETTERASCII_H
 
 #include "./JPetParamGetter/JPetParamGetter.h"
-#include <boost/property_tree/ptree.hpp>
+#include "./JPetParamGetterAscii/JPetParamAsciiCache.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
 
+/**
+ * @brief Param getter reading the local DB json file.
+ *
+ * The file is parsed once per process and shared by all getters (see JPetParamAsciiCache).
+ */
 class JPetParamGetterAscii : public JPetParamGetter
 {
 public:
@@ -30,12 +37,17 @@ public:
   ParamRelationalData getAllRelationalData(
     ParamObjectType type1, ParamObjectType type2, const int runID
   );
+  std::string getSourceId() const;
+
+protected:
+  virtual std::shared_ptr<const JPetParamAsciiCache::Document> loadDocument();
+  std::string filename;
 
 private:
   JPetParamGetterAscii(const JPetParamGetterAscii &paramGetterAscii);
   JPetParamGetterAscii& operator=(const JPetParamGetterAscii &paramGetterAscii);
-  ParamObjectDescription toDescription(boost::property_tree::ptree & info);
-  std::string filename;
+  const std::vector<ParamObjectDescription>* getDescriptions(ParamObjectType type, const int runId);
+  std::shared_ptr<const JPetParamAsciiCache::Document> fDocument;
 };
 
 #endif /* !JPETPARAMGETTERASCII_H */
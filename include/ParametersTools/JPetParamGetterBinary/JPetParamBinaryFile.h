@@ -0,0 +1,55 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBinaryFile.h
+ */
+
+#ifndef JPETPARAMBINARYFILE_H
+#define JPETPARAMBINARYFILE_H
+
+#include "./JPetParamGetterAscii/JPetParamAsciiCache.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Compiled, binary form of the local DB json file.
+ *
+ * The file starts with the magic string, the format version, the FNV-1a hash of the contents
+ * of the json file it was compiled from, and the size of the contents.
+ * The contents are the table of all distinct strings (run numbers, names of the objects,
+ * names and values of the fields), followed by the runs, each of them with the arrays
+ * of the objects of every kind, each object given as the array of the (name, value) pairs
+ * of indices in the string table. The file ends with the checksum of the contents.
+ * The numbers are stored in the byte order of the machine, the files are not portable
+ * between the machines with different byte orders (they are rejected by the checksum).
+ *
+ * The file is read with a single read and converted to the same document as the json file,
+ * so JPetParamGetterBinary returns exactly the same descriptions as JPetParamGetterAscii.
+ * It is only another storage format of the local DB: it saves parsing the json file,
+ * while the factories still build the objects from the string descriptions.
+ */
+class JPetParamBinaryFile
+{
+public:
+  static const std::string kFileSuffix;
+  static const std::uint32_t kVersion;
+
+  static std::string getCompiledFileName(const std::string& jsonFileName);
+  static bool compile(const std::string& jsonFileName, const std::string& binaryFileName);
+  static bool isUpToDate(const std::string& jsonFileName, const std::string& binaryFileName);
+  static bool write(const JPetParamAsciiCache::Document& document, std::uint64_t sourceHash,
+    const std::string& binaryFileName);
+  static std::shared_ptr<const JPetParamAsciiCache::Document> read(const std::string& binaryFileName);
+};
+
+#endif /* !JPETPARAMBINARYFILE_H */
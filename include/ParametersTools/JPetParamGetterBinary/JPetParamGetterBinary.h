@@ -0,0 +1,37 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamGetterBinary.h
+ */
+
+#ifndef JPETPARAMGETTERBINARY_H
+#define JPETPARAMGETTERBINARY_H
+
+#include "./JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include <memory>
+#include <string>
+
+/**
+ * @brief Param getter reading the local DB compiled to the binary file (see JPetParamBinaryFile).
+ *
+ * The file is read once per process and shared by all getters, like the json file read by JPetParamGetterAscii.
+ */
+class JPetParamGetterBinary : public JPetParamGetterAscii
+{
+public:
+  explicit JPetParamGetterBinary(std::string filename) : JPetParamGetterAscii(filename) {}
+
+protected:
+  virtual std::shared_ptr<const JPetParamAsciiCache::Document> loadDocument() override;
+};
+
+#endif /* !JPETPARAMGETTERBINARY_H */
@@ -34,24 +34,26 @@
 #include <boost/any.hpp>
 #include <cassert>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <set>
+#include <vector>
 
 class JPetParamManager
 {
 public:
-  explicit JPetParamManager(): fParamGetter(), fBank(0), fIsNullObject(false) {}
+  explicit JPetParamManager(): fParamGetter(), fIsNullObject(false) {}
   explicit JPetParamManager(JPetParamGetter* paramGetter):
-    fParamGetter(paramGetter), fBank(0) , fIsNullObject(false) {}
+    fParamGetter(paramGetter), fIsNullObject(false) {}
   explicit JPetParamManager(JPetParamGetter* paramGetter, const std::set<ParamObjectType>& expectMissing):
-    fParamGetter(paramGetter), fExpectMissing(expectMissing), fBank(0), fIsNullObject(false) {}
+    fParamGetter(paramGetter), fExpectMissing(expectMissing), fIsNullObject(false) {}
 
   /**
    * Special constructor to create NullObject. This object can be returned
    * if JPetParamManager is not created, and the const& is expected to be returned.
    */
-  explicit JPetParamManager(bool isNull): fParamGetter(), fBank(0), fIsNullObject(isNull) {}
+  explicit JPetParamManager(bool isNull): fParamGetter(), fIsNullObject(isNull) {}
   ~JPetParamManager();
 
   /**
@@ -78,6 +80,7 @@ public:
   bool saveParametersToFile(std::string filename);
   void clearParameters();
   const JPetParamBank& getParamBank() const;
+  std::shared_ptr<const JPetParamBank> getParamBankAsShared() const;
   inline bool isNullObject() const { return fIsNullObject; }
   inline std::set<ParamObjectType> getExpectMissing() const { return fExpectMissing; }
 
@@ -86,7 +89,9 @@ private:
   JPetParamManager& operator=(const JPetParamManager&);
   JPetParamGetter* fParamGetter = nullptr;
   std::set<ParamObjectType> fExpectMissing;
-  JPetParamBank* fBank = nullptr;
+  std::shared_ptr<const JPetParamBank> fBank;
+  /// Banks of the merged inputs following the first one, see JPetHadd
+  std::vector<std::unique_ptr<JPetParamBank>> fMergedParamBanks;
   bool fIsNullObject;
 
   std::map<int, JPetTRBFactory> fTRBFactories;
@@ -110,6 +115,7 @@ private:
   JPetTOMBChannelFactory& getTOMBChannelFactory(const int runID);
   JPetDataSourceFactory& getDataSourceFactory(const int runID);
   JPetDataModuleFactory& getDataModuleFactory(const int runID);
+  std::shared_ptr<const JPetParamBank> buildParamBank(const int run);
 };
 
 #endif /* !_J_PET_PARAM_MANAGER_ */
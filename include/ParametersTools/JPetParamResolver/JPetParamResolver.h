@@ -0,0 +1,122 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamResolver.h
+ */
+
+#ifndef JPETPARAMRESOLVER_H
+#define JPETPARAMRESOLVER_H
+
+#include "JPetParamBank/JPetParamBank.h"
+#include <TRef.h>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Resolves the references of the data objects (JPetSigCh, JPetBaseSignal, JPetHit)
+ * to the parametric objects.
+ *
+ * The data objects store the ids of the parametric objects, written to the files,
+ * and the transient pointers to them, set only in memory by the setters.
+ * When the objects are read from a file, only the ids are known, and they are resolved
+ * with the dense index of the param bank bound to the current thread with Binding.
+ * JPetTaskIO binds the param bank of its input while it processes the events.
+ * The files written before the ids were introduced keep the references as TRefs,
+ * which are used if there is no id.
+ * The pointers may point to the objects of a bank which is no longer bound, so the data
+ * objects store the binding generation in which they were set (see updateGeneration()),
+ * and the pointers of an older generation are not used.
+ */
+class JPetParamResolver
+{
+public:
+  static const int kNoID = -1;
+
+  /**
+   * @brief Binds the param bank to the current thread until the binding is destroyed.
+   * The bank bound before is restored then.
+   */
+  class Binding
+  {
+  public:
+    explicit Binding(std::shared_ptr<const JPetParamBank> bank);
+    ~Binding();
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+
+  private:
+    std::shared_ptr<const JPetParamBank> fPreviousBank;
+  };
+
+  static const JPetParamBank* getParamBank();
+
+  /**
+   * @brief Returns the generation of the bindings, incremented whenever a param bank
+   * is bound or unbound in any thread.
+   */
+  static unsigned int getBindingGeneration() { return getGenerationCounter().load(std::memory_order_acquire); }
+
+  /**
+   * @brief To be called by the setters of the data objects before setting a pointer.
+   *
+   * If a param bank has been bound or unbound since the pointers were set, they are reset,
+   * and the generation is updated, so that all the pointers set afterwards are used.
+   */
+  template <typename... T>
+  static void updateGeneration(unsigned int& generation, const T*&... pointers)
+  {
+    auto current = getBindingGeneration();
+    if (generation != current)
+    {
+      int unused[] = {0, (pointers = nullptr, 0)...};
+      (void)unused;
+      generation = current;
+    }
+  }
+
+  /**
+   * @brief Returns the object pointed to if it was set in the current binding generation,
+   * the object with the given id from the bound param bank, or the object referenced by the TRef,
+   * whichever is found first, or nullptr.
+   */
+  template <typename T>
+  static const T* resolve(const T* object, unsigned int generation, int id, const TRef& ref)
+  {
+    if (object && generation == getBindingGeneration())
+    {
+      return object;
+    }
+    object = nullptr;
+    if (id != kNoID)
+    {
+      auto bank = getParamBank();
+      if (bank && (object = find(*bank, id, object)))
+      {
+        return object;
+      }
+    }
+    return static_cast<const T*>(ref.GetObject());
+  }
+
+private:
+  static std::shared_ptr<const JPetParamBank>& getBoundParamBank();
+  static std::atomic<unsigned int>& getGenerationCounter();
+
+  static const JPetScin* find(const JPetParamBank& bank, int id, const JPetScin*) { return bank.findScintillator(id); }
+  static const JPetPM* find(const JPetParamBank& bank, int id, const JPetPM*) { return bank.findPM(id); }
+  static const JPetFEB* find(const JPetParamBank& bank, int id, const JPetFEB*) { return bank.findFEB(id); }
+  static const JPetTRB* find(const JPetParamBank& bank, int id, const JPetTRB*) { return bank.findTRB(id); }
+  static const JPetBarrelSlot* find(const JPetParamBank& bank, int id, const JPetBarrelSlot*) { return bank.findBarrelSlot(id); }
+  static const JPetTOMBChannel* find(const JPetParamBank& bank, int id, const JPetTOMBChannel*) { return bank.findTOMBChannel(id); }
+};
+
+#endif /* !JPETPARAMRESOLVER_H */
@@ -18,23 +18,38 @@
 
 #include "./JPetParamManager/JPetParamManager.h"
 #include "./JPetOptionsTools/JPetOptionsTools.h"
+#include "./JPetOptionsTools/JPetOptionHandle.h"
 #include <boost/any.hpp>
 #include <string>
 #include <memory>
 #include <map>
 
+/**
+ * @brief Options and param manager passed between the tasks.
+ *
+ * The options are immutable and shared by all the copies of the params,
+ * so passing the params from one stage to the next one does not copy them.
+ * New options are set by creating new params.
+ */
 class JPetParams
 {
 public:
   JPetParams();
   JPetParams(const jpet_options_tools::OptsStrAny& opts, std::shared_ptr<JPetParamManager> mgr);
-  jpet_options_tools::OptsStrAny getOptions() const;
+  JPetParams(std::shared_ptr<const jpet_options_tools::OptsStrAny> opts, std::shared_ptr<JPetParamManager> mgr);
+  const jpet_options_tools::OptsStrAny& getOptions() const;
+  std::shared_ptr<const jpet_options_tools::OptsStrAny> getOptionsAsShared() const;
+  template <typename T>
+  JPetOptionHandle<T> getOptionHandle(const std::string& name) const
+  {
+    return JPetOptionHandle<T>(fOptions, name);
+  }
   JPetParamManager* getParamManager() const;
   std::shared_ptr<JPetParamManager> getParamManagerAsShared() const;
   void setParamManager(std::shared_ptr<JPetParamManager> mgr);
 
 protected:
-  jpet_options_tools::OptsStrAny fOptions;
+  std::shared_ptr<const jpet_options_tools::OptsStrAny> fOptions;
   std::shared_ptr<JPetParamManager> fParamManager;
 };
 #endif /* !JPETPARAMS_H */
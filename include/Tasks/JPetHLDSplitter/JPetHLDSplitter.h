@@ -0,0 +1,82 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDSplitter.h
+ */
+
+#ifndef JPETHLDSPLITTER_H
+#define JPETHLDSPLITTER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Splitter of the HLD data into smaller HLD files (chunks) made of whole events.
+ *
+ * The data is given in blocks of any size with write(), so it can be taken directly
+ * from JPetUnzipTask::decompress() without storing the whole decompressed file.
+ * Every chunk starts with the first 32 bytes of the data (the file header skipped
+ * by Unpacker2) followed by the complete events, so it can be unpacked on its own.
+ * The size of an event is the first word of its header, events are padded to 8 bytes.
+ * A chunk is closed when the next event would exceed the chunk size (a larger event
+ * makes up a chunk by itself) and passed to the handler, which may e.g. unpack it
+ * or publish it with JPetStreamedFile::addPart(). The chunks are named as the parts
+ * of the split output (see JPetOutputHandler::getPartFileName()), e.g. dir/file_0002.hld
+ * for dir/file.hld.
+ */
+class JPetHLDSplitter
+{
+public:
+  /// Called with the name of every closed chunk, returning false aborts the splitting
+  using ChunkHandler = std::function<bool(const std::string& chunkFileName)>;
+  static const std::size_t kHeaderSize;
+  static const std::size_t kEventAlignment;
+  static const std::size_t kDefaultChunkSize;
+
+  JPetHLDSplitter(const std::string& fileName, std::size_t chunkSize, const ChunkHandler& handler, long long maxEvents = -1);
+  ~JPetHLDSplitter();
+  bool write(const char* data, std::size_t size);
+  bool close();
+  bool isEventLimitReached() const;
+  long long getNbOfEvents() const;
+  int getNbOfChunks() const;
+  static bool splitFile(const std::string& hldFileName, JPetHLDSplitter& splitter);
+  static std::size_t getChunkSize(int chunkSizeMB);
+
+private:
+  JPetHLDSplitter(const JPetHLDSplitter&);
+  void operator=(const JPetHLDSplitter&);
+
+  bool startEvent();
+  bool writeToChunk(const char* data, std::size_t size);
+  bool openChunk();
+  bool closeChunk();
+
+  const std::string fFileName;
+  const std::size_t fChunkSize;
+  const ChunkHandler fHandler;
+  const long long fMaxEvents;
+  std::string fFileHeader;
+  std::string fEventHeader;
+  /// Bytes of the current event, including the padding, which were not written yet
+  std::size_t fEventBytesLeft = 0;
+  long long fNbOfEvents = 0;
+  std::FILE* fChunk = nullptr;
+  std::string fChunkFileName;
+  std::size_t fChunkSizeOfEvents = 0;
+  int fNbOfChunks = 0;
+  bool fIsFailed = false;
+};
+
+#endif /* !JPETHLDSPLITTER_H */
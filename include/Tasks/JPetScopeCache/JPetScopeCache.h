@@ -0,0 +1,91 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeCache.h
+ */
+
+#ifndef JPETSCOPECACHE_H
+#define JPETSCOPECACHE_H
+
+#include "./JPetScopeWindowReader/JPetScopeWindowReader.h"
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Binary cache of the oscilloscope data of one input directory (one collimator position).
+ *
+ * The cache contains the time windows with the file names and the photomultiplier ids,
+ * followed by the parsed waveforms of all files, stored as float pairs (time, amplitude).
+ * It is valid only for the same input directory and mapping of the file prefixes
+ * to the photomultiplier ids, if none of the directories was modified since the cache
+ * was created (any file added, removed or renamed changes the modification time
+ * of its directory), and if the checksum of its contents is correct.
+ * Note that the files modified in place are not detected.
+ *
+ * Writing: snapshotDirectories() before scanning the directory, create() with
+ * the windows, writeSignals() for every window in order, close().
+ * Reading: open() and, if it succeeds, readSignals() for every window in order.
+ */
+class JPetScopeCache
+{
+public:
+  using Window = JPetScopeWindowReader::Window;
+  using Signals = JPetScopeWindowReader::Signals;
+  static const std::string kCacheFileSuffix;
+
+  JPetScopeCache(const std::string& cacheFileName, const std::string& inputDirectory,
+    const std::map<std::string, int>& prefixToPMId);
+  ~JPetScopeCache();
+  JPetScopeCache(const JPetScopeCache&) = delete;
+  JPetScopeCache& operator=(const JPetScopeCache&) = delete;
+
+  bool open();
+  const std::vector<Window>& getWindows() const;
+  bool readSignals(Signals& signals);
+
+  void snapshotDirectories();
+  bool create(const std::vector<Window>& windows);
+  bool writeSignals(const Signals& signals);
+  bool close();
+
+private:
+  using DirectoryTimes = std::vector<std::pair<std::string, std::int64_t>>;
+
+  bool isChecksumCorrect();
+  bool readHeader();
+  bool write(const void* data, std::size_t size);
+  bool writeString(const std::string& value);
+  template <typename T>
+  bool writeValue(T value) { return write(&value, sizeof(value)); }
+  bool read(void* data, std::size_t size);
+  bool readString(std::string& value);
+  template <typename T>
+  bool readValue(T& value) { return read(&value, sizeof(value)); }
+  void abortWriting();
+  std::string getTemporaryFileName() const;
+
+  std::string fCacheFileName;
+  std::string fInputDirectory;
+  std::uint64_t fKey = 0;
+  DirectoryTimes fDirectories;
+  std::vector<Window> fWindows;
+  std::size_t fNextWindow = 0;
+  std::ifstream fInput;
+  std::ofstream fOutput;
+  std::uint64_t fChecksum = 0;
+};
+
+#endif /* !JPETSCOPECACHE_H */
@@ -0,0 +1,48 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeFileReader.h
+ */
+
+#ifndef JPETSCOPEFILEREADER_H
+#define JPETSCOPEFILEREADER_H
+
+#include "./JPetRecoSignal/JPetRecoSignal.h"
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Parser of the oscilloscope ASCII files.
+ *
+ * The file is memory-mapped and parsed in place, without the stdio
+ * conversions, directly into the shape points of the signal, which are
+ * allocated once, based on the segment size from the header.
+ * The files with the .tsv extension have no header. The times are converted
+ * from seconds to picoseconds and the amplitudes from volts to millivolts.
+ * The methods are static and can be called concurrently for different files.
+ */
+class JPetScopeFileReader
+{
+public:
+  static const double kSecondsToPicoseconds;
+  static const double kVoltsToMillivolts;
+  static const int kNbOfHeaderLines = 5;
+
+  static bool readSignal(const std::string& fileName, JPetRecoSignal& signal);
+  static bool parseSignal(const char* data, std::size_t size, bool hasHeader, JPetRecoSignal& signal,
+    const std::string& fileName = "");
+  static const char* parseFloat(const char* pos, const char* end, float& value);
+  static const char* parseInt(const char* pos, const char* end, int& value);
+  static bool hasHeader(const std::string& fileName);
+};
+
+#endif /* !JPETSCOPEFILEREADER_H */
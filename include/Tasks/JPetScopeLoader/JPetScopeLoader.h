@@ -28,6 +28,7 @@
 #include <set>
 
 class JPetParamBank;
+class JPetScopeData;
 class JPetPM;
 class JPetScin;
 class JPetTreeHeader;
@@ -47,6 +48,10 @@ class JPetWriter;
  * map contains a set of file names corresponding to the signals and (second int)
  * photomultiplier ids bound to given signal.
  *
+ * The parsed data of the input directory are saved in a binary cache next to
+ * the output file (see JPetScopeCache) and read from it by the next runs,
+ * unless the scopeCache_bool option is set to false.
+ *
  * Please, note that this class overrides the createInputObjects, createOutputObjects
  * and setInputAndOutputFile methods from JPetTaskIO class. The overriden method
  * setInputAndOutputFile is called init() in the original JPetTaskIO.
@@ -77,6 +82,8 @@ protected:
   bool createOutputObjects(const char*) override;
   std::tuple<bool, std::string, std::string, bool> setInputAndOutputFile(
     const jpet_options_tools::OptsStrAny options) const override;
+  bool processWindow(JPetTaskInterface* subTask, const JPetScopeData& data);
+  std::string getScopeCacheFileName() const;
 };
 
 #endif /* !_SCOPE_LOADER_MODULE_H_ */
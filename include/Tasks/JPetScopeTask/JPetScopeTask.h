@@ -17,9 +17,12 @@
 #define JPETSCOPETASK_H
 
 #include "JPetUserTask/JPetUserTask.h"
+#include "JPetRecoSignal/JPetRecoSignal.h"
 #include <string>
 #include <map>
 
+class JPetScopeData;
+
 /**
  * @brief Module for oscilloscope data
  */
@@ -35,6 +38,8 @@ protected:
   bool exec() override;
   bool terminate() override;
   std::pair<int, std::map<std::string, int>> fInputFilesInCurrentWindow;
+  /// Data with the signals already parsed by JPetScopeLoader, the files not found there are parsed by the task
+  const JPetScopeData* fCurrentData = nullptr;
 };
 
 #endif /* !JPETSCOPETASK_H */
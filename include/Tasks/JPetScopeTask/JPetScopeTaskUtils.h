@@ -14,48 +14,13 @@
  */
 
 #include "./JPetRecoSignal/JPetRecoSignal.h"
-
-const double ks2ps = 1.0e+12;
-const double kV2mV = 1.0e+3;
-const int kbuflen = 256;
+#include "./JPetScopeFileReader/JPetScopeFileReader.h"
 
 namespace RecoSignalUtils
 {
-  JPetRecoSignal generateSignal(const char* filename) {
-    FILE* input_file = fopen(filename, "r");
-    if (!input_file) {
-      ERROR(Form("Error: cannot open file %s", filename));
-      return JPetRecoSignal(0);
-    }
-    int segment_size = 0;
-    std::string fileNameWithExtension(filename);
-    if(fileNameWithExtension.substr(fileNameWithExtension.find_last_of(".") + 1) != "tsv") {
-      char buf[kbuflen];
-      char tmp[kbuflen];
-      if (fgets(buf, kbuflen, input_file) != 0)
-      sscanf(buf, "%s %*s %*s", tmp);
-      if (fgets(buf, kbuflen, input_file) != 0)
-      sscanf(buf, "%*s %*s %*s %d", &segment_size);
-      if (fgets(buf, kbuflen, input_file) != 0);
-      if (fgets(buf, kbuflen, input_file) != 0)
-      sscanf(buf, "%*s %s %s %*s", tmp, tmp + kbuflen/2);
-      if (fgets(buf, kbuflen, input_file) != 0);
-    }
-    JPetRecoSignal reco_signal(segment_size);
-    for (int i = 0; i < segment_size; ++i) {
-      float value, threshold;
-      int stat;
-      stat = fscanf(input_file, "%f %f\n", &value, &threshold);
-      if (stat != 2) {
-	       ERROR(Form("Non-numerical symbol in file %s at line %d", filename, i + 6));
-	       char tmp[kbuflen];
-	       if (fgets(tmp, kbuflen, input_file) != 0);
-      }
-      float time = value * ks2ps;
-      float amplitude = threshold * kV2mV;
-      reco_signal.setShapePoint(time, amplitude);
-    }
-    fclose(input_file);
+  inline JPetRecoSignal generateSignal(const char* filename) {
+    JPetRecoSignal reco_signal(0);
+    JPetScopeFileReader::readSignal(filename, reco_signal);
     return reco_signal;
   }
 }
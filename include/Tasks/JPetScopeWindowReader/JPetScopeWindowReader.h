@@ -0,0 +1,68 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeWindowReader.h
+ */
+
+#ifndef JPETSCOPEWINDOWREADER_H
+#define JPETSCOPEWINDOWREADER_H
+
+#include "./JPetRecoSignal/JPetRecoSignal.h"
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool of threads parsing the oscilloscope files of consecutive time windows.
+ *
+ * Each time window is given as in JPetScopeData, i.e. its index and the map of
+ * file names to the photomultiplier ids. The workers parse the files of the
+ * windows in parallel, at most a given number of windows ahead of the consumer,
+ * which takes the parsed signals with getSignals(), window by window, in order.
+ */
+class JPetScopeWindowReader
+{
+public:
+  using Window = std::pair<int, std::map<std::string, int>>;
+  using Signals = std::map<std::string, JPetRecoSignal>;
+
+  JPetScopeWindowReader(const std::vector<Window>& windows, unsigned int nbOfThreads = 0, std::size_t maxWindowsAhead = 0);
+  ~JPetScopeWindowReader();
+  JPetScopeWindowReader(const JPetScopeWindowReader&) = delete;
+  JPetScopeWindowReader& operator=(const JPetScopeWindowReader&) = delete;
+
+  std::size_t getNbOfWindows() const;
+  unsigned int getNbOfThreads() const;
+  Signals getSignals(std::size_t index);
+  static Signals readWindow(const Window& window);
+
+private:
+  void work();
+
+  const std::vector<Window> fWindows;
+  std::size_t fMaxWindowsAhead = 0;
+  std::vector<Signals> fSignals;
+  std::vector<bool> fIsParsed;
+  std::size_t fNextToParse = 0;
+  std::size_t fNextToConsume = 0;
+  bool fIsStopped = false;
+  std::mutex fMutex;
+  std::condition_variable fParsed;
+  std::condition_variable fConsumed;
+  std::vector<std::thread> fWorkers;
+};
+
+#endif /* !JPETSCOPEWINDOWREADER_H */
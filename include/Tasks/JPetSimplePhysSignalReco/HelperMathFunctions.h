@@ -24,13 +24,17 @@
 #endif
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/vector.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
 
 /**
  * @brief Helper mathematical functions used in the reconstruction
  */
 namespace ublas = boost::numeric::ublas;
 
-float polynomialFit(const ublas::vector<float>& t, const ublas::vector<float>& v_source, int alfa, float v0) {
+inline float polynomialFit(const ublas::vector<float>& t, const ublas::vector<float>& v_source, int alfa, float v0) {
   ublas::vector<float> v(v_source);
   int K;
   float tSig = -1.0;
@@ -72,4 +76,185 @@ float polynomialFit(const ublas::vector<float>& t, const ublas::vector<float>& v
   return tSig;
 }
 
+/**
+ * @brief Points of many signals for the batched polynomial fit, stored as structure of arrays.
+ *
+ * The k-th point of every signal is kept in the k-th array of the times and of the voltages,
+ * so PolynomialFitBatch::fit() computes the sums for many signals at once, in loops
+ * over contiguous arrays without branches, which the compiler vectorises.
+ * The missing points of the signals with less than kMaxPoints points are zero,
+ * they do not change the sums of the points and are excluded from the sums
+ * of squares by multiplying them by zero. The roots of the voltages are taken
+ * from a small table of the already computed values, since the signals share
+ * the same few threshold values. For every signal the fit does the same operations,
+ * in the same order, as polynomialFit(), so the results are the same.
+ * The arrays are reused by the next fit, so fitting many batches does not allocate memory.
+ */
+class PolynomialFitBatch
+{
+public:
+  static const int kMaxPoints = 4;
+  static const std::size_t kRootTableSize = 16;
+  static const std::size_t kChunkSize = 256;
+
+  void clear()
+  {
+    fSize = 0;
+    fNumberOfPoints.clear();
+    for (int k = 0; k < kMaxPoints; k++) {
+      fTimes[k].clear();
+      fVolts[k].clear();
+    }
+  }
+
+  void reserve(std::size_t size)
+  {
+    fNumberOfPoints.reserve(size);
+    for (int k = 0; k < kMaxPoints; k++) {
+      fTimes[k].reserve(size);
+      fVolts[k].reserve(size);
+    }
+  }
+
+  std::size_t getSize() const { return fSize; }
+
+  /**
+   * Adds the points of one signal. Returns false, without adding them,
+   * if the signal has more than kMaxPoints points.
+   */
+  bool add(const float* t, const float* v, int numberOfPoints)
+  {
+    if (numberOfPoints < 0 || numberOfPoints > kMaxPoints) {
+      return false;
+    }
+    for (int k = 0; k < kMaxPoints; k++) {
+      fTimes[k].push_back(k < numberOfPoints ? t[k] : 0.f);
+      fVolts[k].push_back(k < numberOfPoints ? v[k] : 0.f);
+    }
+    fNumberOfPoints.push_back(numberOfPoints);
+    fSize++;
+    return true;
+  }
+
+  /**
+   * Fits all the signals of the batch, tSig[i] is the result of polynomialFit()
+   * for the points of the i-th signal.
+   */
+  void fit(int alfa, float v0, std::vector<float>& tSig)
+  {
+    tSig.resize(fSize);
+    float* result = tSig.data();
+    const float* numberOfPoints = fNumberOfPoints.data();
+    const float* t0 = fTimes[0].data();
+    if (alfa < 1) {
+      for (std::size_t i = 0; i < fSize; i++) {
+        float first = t0[i];
+        result[i] = numberOfPoints[i] == 1.f ? first : -1.f;
+      }
+      return;
+    }
+    computeRoots(alfa);
+    const float* t1 = fTimes[1].data();
+    const float* t2 = fTimes[2].data();
+    const float* t3 = fTimes[3].data();
+    const float* v0s = fRoots[0].data();
+    const float* v1s = fRoots[1].data();
+    const float* v2s = fRoots[2].data();
+    const float* v3s = fRoots[3].data();
+    if (v0 > 0.0)
+      v0 = 0.0;
+    double rootOfV0 = pow(-v0, 1.0 / alfa);
+    /// The fits of a chunk go to local arrays, which cannot alias the points,
+    /// and the special cases are selected in a separate loop, so both loops have no branches
+    float fits[kChunkSize];
+    float slopes[kChunkSize];
+    for (std::size_t start = 0; start < fSize; start += kChunkSize) {
+      std::size_t end = start + kChunkSize < fSize ? start + kChunkSize : fSize;
+      for (std::size_t i = start; i < end; i++) {
+        float K = numberOfPoints[i];
+        float t[kMaxPoints] = {t0[i], t1[i], t2[i], t3[i]};
+        float v[kMaxPoints] = {v0s[i], v1s[i], v2s[i], v3s[i]};
+        float meanT = 0.0;
+        float meanV = 0.0;
+        float sx = 0.0;
+        float sxy = 0.0;
+        for (int k = 0; k < kMaxPoints; k++) {
+          meanT = meanT + t[k];
+          meanV = meanV + v[k];
+        }
+        meanT = meanT / K;
+        meanV = meanV / K;
+        for (int k = 0; k < kMaxPoints; k++) {
+          float mask = static_cast<float>(K > k);
+          float dt = (t[k] - meanT) * mask;
+          float dv = (v[k] - meanV) * mask;
+          sx = sx + dt * dt;
+          sxy = sxy + dt * dv;
+        }
+        float a = sxy / sx;
+        float b = meanV - a * meanT;
+        slopes[i - start] = a;
+        fits[i - start] = (rootOfV0 - b) / a;
+      }
+      for (std::size_t i = start; i < end; i++) {
+        float first = t0[i];
+        float tSigSignal = fits[i - start];
+        tSigSignal = fabs(slopes[i - start]) < 1e-10 ? first : tSigSignal;
+        tSigSignal = numberOfPoints[i] < 2.f ? first : tSigSignal;
+        result[i] = numberOfPoints[i] < 1.f ? -1.f : tSigSignal;
+      }
+    }
+  }
+
+private:
+  /// Roots of the negated voltages, as computed in polynomialFit()
+  void computeRoots(int alfa)
+  {
+    if (alfa != fRootTableAlfa) {
+      fRootTableSize = 0;
+      fRootTableAlfa = alfa;
+    }
+    for (int k = 0; k < kMaxPoints; k++) {
+      fRoots[k].resize(fSize);
+      const float* volts = fVolts[k].data();
+      float* roots = fRoots[k].data();
+      if (alfa == 1) {
+        for (std::size_t i = 0; i < fSize; i++) {
+          roots[i] = -volts[i];
+        }
+        continue;
+      }
+      for (std::size_t i = 0; i < fSize; i++) {
+        roots[i] = getRoot(volts[i], alfa);
+      }
+    }
+  }
+
+  float getRoot(float volt, int alfa)
+  {
+    for (std::size_t j = 0; j < fRootTableSize; j++) {
+      if (fRootTableVolts[j] == volt) {
+        return fRootTableRoots[j];
+      }
+    }
+    float root = pow(-volt, 1.0 / alfa);
+    if (fRootTableSize < kRootTableSize) {
+      fRootTableVolts[fRootTableSize] = volt;
+      fRootTableRoots[fRootTableSize] = root;
+      fRootTableSize++;
+    }
+    return root;
+  }
+
+  std::size_t fSize = 0;
+  std::vector<float> fNumberOfPoints;
+  std::array<std::vector<float>, kMaxPoints> fTimes;
+  std::array<std::vector<float>, kMaxPoints> fVolts;
+  std::array<std::vector<float>, kMaxPoints> fRoots;
+  int fRootTableAlfa = 0;
+  std::size_t fRootTableSize = 0;
+  std::array<float, kRootTableSize> fRootTableVolts;
+  std::array<float, kRootTableSize> fRootTableRoots;
+};
+
 #endif /* !_HELPERMATHFUNCTIONS_H_ */
@@ -18,10 +18,22 @@
 
 #include "./JPetPhysSignal/JPetPhysSignal.h"
 #include "./JPetRecoSignal/JPetRecoSignal.h"
+#include "./JPetSimplePhysSignalReco/HelperMathFunctions.h"
+#include "./JPetTimeWindow/JPetTimeWindow.h"
 #include "./JPetUserTask/JPetUserTask.h"
+#include <vector>
 
 class JPetWriter;
 
+/**
+ * @brief Simple example of the reconstruction of JPetPhysSignals from JPetRecoSignals.
+ *
+ * The time of a signal is fitted to its leading edge points with polynomialFit().
+ * The signals of a time window are fitted together with PolynomialFitBatch,
+ * reading the points from the threshold index of their raw signals.
+ * The task does not set up an output window, so exec() does nothing and the
+ * signals of a window are created by calling createPhysSignals().
+ */
 class JPetSimplePhysSignalReco: public JPetUserTask
 {
 public:
@@ -33,12 +45,18 @@ public:
   inline void setAlpha(int val) { fAlpha = val; }
   inline void setThresholdSel(float val) { fThresholdSel = val; }
   void readConfigFileAndSetAlphaAndThreshParams(const char* filename);
+  std::vector<JPetPhysSignal> createPhysSignals(const JPetTimeWindow& window);
 
 private:
   JPetPhysSignal createPhysSignal(JPetRecoSignal& signals);
+  JPetPhysSignal createPhysSignal(const JPetRecoSignal& recoSignal, double time) const;
+  bool addToFitBatch(const JPetRawSignal& rawSignal, double& time);
   void savePhysSignal( JPetPhysSignal signal);
   int fAlpha;
   float fThresholdSel;
+  PolynomialFitBatch fFitBatch;
+  std::vector<float> fFitTimes;
+  std::vector<int> fFitIndices;
 };
 
 #endif /* !_JPETSIMPLEPHYSSIGNALRECO_H_ */
@@ -20,22 +20,49 @@
 #include <boost/any.hpp>
 #include "Unpacker2.h"
 #include <map>
+#include <memory>
+#include <thread>
 
+class JPetStreamedFile;
+
+/**
+ * @brief Task unpacking the HLD file with Unpacker2.
+ *
+ * If the streamUnpacking_bool option is set, the unpacking runs in a background
+ * thread and the next task reads the unpacked data while it is being produced
+ * (see JPetStreamedFile and JPetStreamReader). The HLD data is unpacked in chunks
+ * of whole events (see JPetHLDSplitter): the chunks handed over by JPetUnzipTask are
+ * unpacked as they arrive, a plain HLD file is split into chunks written next to the output.
+ * Every chunk is removed once unpacked, and the unpacked chunk is published as a part
+ * of the output, e.g. file_0002.hld.root, so the next task reads the entries of a part
+ * as soon as the part is closed. The list of the parts is written to file.hld.manifest,
+ * as for the split output (see JPetOutputHandler). The thread is joined when the task is destroyed.
+ * A failure of the unpacking is reported by the next task, which fails after
+ * reading the published parts.
+ */
 class JPetUnpackTask: public JPetTask
 {
 public:
   using OptsStrAny = std::map<std::string, boost::any>;
   explicit JPetUnpackTask(const char* name = "");
+  virtual ~JPetUnpackTask();
   bool init(const JPetParams& inOptions) override;
   bool run(const JPetDataInterface& inData) override;
   bool terminate(JPetParams& outOptions) override;
   static bool validateFiles(
     std::string fileNameWithPath, std::string xmlConfig,
     std::string totCalib, bool totCalibSet,
-    std::string tdcCalib, bool tdcCalibSet
+    std::string tdcCalib, bool tdcCalibSet,
+    bool isInputStreamed = false
   );
 
 protected:
+  bool unpack(const std::string& inputFile, const std::string& inputFilePath);
+  bool unpackStream(std::shared_ptr<JPetStreamedFile> input, JPetStreamedFile& output);
+  bool unpackChunk(const std::string& chunkFileName, JPetStreamedFile& output);
+  bool writeManifest(const JPetStreamedFile& output) const;
+  std::string getUnpackedFileName() const;
+
   const std::string kTDCnonlinearityCalibKey = "Unpacker_TDCnonlinearityCalib_std::string";
   const std::string kTOTOffsetCalibKey = "Unpacker_TOToffsetCalib_std::string";
   std::string fOutputFilePath = std::string("");
@@ -46,6 +73,7 @@ protected:
   std::string fXMLConfFile = std::string("");
   int fEventsToProcess = 1000000000;
   Unpacker2* fUnpacker2 = nullptr;
+  std::thread fUnpackThread;
   OptsStrAny fOptions;
 };
 
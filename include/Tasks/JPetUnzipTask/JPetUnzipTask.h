@@ -18,20 +18,54 @@
 
 #include "JPetTask/JPetTask.h"
 #include <boost/any.hpp>
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <string>
+#include <thread>
 
+class JPetStreamedFile;
+
+/**
+ * @brief Task decompressing the input file (.gz, .xz, .bz2 or .zip).
+ *
+ * The files are decompressed in the process with zlib, liblzma and libbzip2,
+ * streaming the data in large blocks directly into the output file. The .xz files
+ * are decoded with multiple threads if liblzma supports it. Zip archives are
+ * expected to contain a single file stored or compressed with deflate.
+ * The decompressed data can be also passed to any other consumer (e.g. a pipe)
+ * with decompress(), without creating a temporary file.
+ *
+ * If the streamUnpacking_bool option is set, the file is decompressed in a background
+ * thread into HLD chunks (see JPetHLDSplitter), which are handed over to JPetUnpackTask
+ * as soon as they are finished (see JPetStreamedFile), so the unpacking starts before
+ * the whole file is decompressed. The chunks replace the decompressed file and are
+ * removed by JPetUnpackTask once unpacked. The thread is joined when the task is destroyed.
+ */
 class JPetUnzipTask: public JPetTask
 {
 public:
   using OptsStrAny = std::map<std::string, boost::any>;
+  /// Consumer of consecutive blocks of the decompressed data, returning false to abort
+  using DataSink = std::function<bool(const char* data, std::size_t size)>;
+  static const std::size_t kBufferSize;
+
   explicit JPetUnzipTask(const char* name = "");
+  virtual ~JPetUnzipTask();
   bool init(const JPetParams& inOptions) override;
   bool run(const JPetDataInterface& inData) override;
   bool terminate(JPetParams& outOptions) override;
   static bool unzipFile(std::string fileNameWithPath, std::string outputPath);
+  static bool decompress(const std::string& fileNameWithPath, const DataSink& sink);
+  static std::string getUnzippedFileName(const std::string& fileNameWithPath, const std::string& outputPath);
+  static bool unzipToChunks(const std::string& fileNameWithPath, const std::string& hldFileName,
+    std::size_t chunkSize, JPetStreamedFile& stream);
 
 protected:
+  std::string getNextInputFile() const;
+
   OptsStrAny fOptions;
+  std::thread fUnzipThread;
 };
 
 #endif /* !JPETUNZIPTASK_H */
@@ -21,6 +21,14 @@
 std::vector<JPetHit> JPetAnalysisTools::getHitsOrderedByTime(const std::vector<JPetHit>& oldHits)
 {
   auto hits(oldHits);
-  std::sort(hits.begin(), hits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
+  sortHitsByTime(hits);
   return hits;
 }
+
+/**
+ * Sorting the vector of JPetHits by ascending time in place
+ */
+void JPetAnalysisTools::sortHitsByTime(std::vector<JPetHit>& hits)
+{
+  std::sort(hits.begin(), hits.end(), [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); });
+}
@@ -0,0 +1,350 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetChainReader.cpp
+ */
+
+#include "JPetChainReader/JPetChainReader.h"
+#include <TClass.h>
+#include <TNamed.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+const long long JPetChainReader::kNoFile = -1;
+const long long JPetChainReader::kNoTree = -2;
+
+JPetChainReader::JPetChainReader() {}
+
+JPetChainReader::~JPetChainReader() { closeFile(); }
+
+/**
+ * @brief Open the list of files as one input.
+ *
+ * Every file is opened to count its entries and build the global entry
+ * numbering and closed afterwards, except for the first one. Then the reader
+ * is positioned at the first entry. Returns false
+ * if any of the files cannot be opened or does not contain the tree.
+ */
+bool JPetChainReader::openFilesAndLoadData(const std::vector<std::string>& fileNames, const char* treename)
+{
+  closeFile();
+  if (fileNames.empty())
+  {
+    ERROR("empty list of input files");
+    return false;
+  }
+  if (!treename)
+  {
+    ERROR("empty tree name");
+    return false;
+  }
+  fTreeName = treename;
+  std::vector<long long> nbOfEntries;
+  openFiles(fileNames, nbOfEntries);
+  fFirstEntryInFile.push_back(0);
+  for (std::size_t i = 0; i < fileNames.size(); i++)
+  {
+    if (nbOfEntries[i] < 0)
+    {
+      ERROR(std::string(nbOfEntries[i] == kNoFile ? "Cannot open file: " : "in reading tree from file: ") + fileNames[i]);
+      closeFile();
+      return false;
+    }
+    fFirstEntryInFile.push_back(fFirstEntryInFile.back() + nbOfEntries[i]);
+  }
+  fFileNames = fileNames;
+  if (getNbOfAllEntries() > 0)
+  {
+    /// the first entry may be located in a further file if the leading ones are empty
+    if (!firstEntry())
+    {
+      closeFile();
+      return false;
+    }
+  }
+  else if (!switchToFile(0))
+  {
+    closeFile();
+    return false;
+  }
+  return true;
+}
+
+bool JPetChainReader::openFileAndLoadData(const char* filename, const char* treename)
+{
+  if (!filename)
+  {
+    ERROR("empty file name");
+    return false;
+  }
+  return openFilesAndLoadData({filename}, treename);
+}
+
+bool JPetChainReader::nextEntry() { return nthEntry(fGlobalEntryNumber + 1); }
+
+bool JPetChainReader::firstEntry() { return nthEntry(0); }
+
+bool JPetChainReader::lastEntry() { return nthEntry(getNbOfAllEntries() - 1); }
+
+/**
+ * @brief Load the entry with the global number n, switching files if needed.
+ */
+bool JPetChainReader::nthEntry(long long n)
+{
+  fGlobalEntryNumber = n;
+  if (n < 0 || n >= getNbOfAllEntries())
+  {
+    fCurrentEntryNumber = -1;
+    return false;
+  }
+  auto nextFile = std::upper_bound(fFirstEntryInFile.begin(), fFirstEntryInFile.end(), n);
+  int index = std::distance(fFirstEntryInFile.begin(), nextFile) - 1;
+  if (index != fCurrentFileIndex && !switchToFile(index))
+  {
+    return false;
+  }
+  fCurrentEntryNumber = n - fFirstEntryInFile[index];
+  return loadCurrentEntry();
+}
+
+/**
+ * @brief Returns the current entry, or an empty event if it cannot be read.
+ *
+ * Unlike in JPetReader, the empty event does not replace the entry object,
+ * which is reused for the following entries.
+ */
+JPetReaderInterface::MyEvent& JPetChainReader::getCurrentEntry()
+{
+  if (fTree && loadCurrentEntry())
+  {
+    return *fEntry;
+  }
+  ERROR("Could not read the current event");
+  if (!fEmptyEntry)
+  {
+    fEmptyEntry.reset(new TNamed("Empty event", "Empty event"));
+  }
+  return *fEmptyEntry;
+}
+
+long long JPetChainReader::getCurrentEntryNumber() const { return fGlobalEntryNumber; }
+
+long long JPetChainReader::getNbOfAllEntries() const { return fFirstEntryInFile.empty() ? 0 : fFirstEntryInFile.back(); }
+
+void JPetChainReader::closeFile()
+{
+  dropPrefetchedFile();
+  JPetReader::closeFile();
+  fFirstFile.reset();
+  fChainEntry.reset();
+  fFileNames.clear();
+  fFirstEntryInFile.clear();
+  fCurrentFileIndex = -1;
+  fGlobalEntryNumber = -1;
+}
+
+int JPetChainReader::getCurrentFileIndex() const { return fCurrentFileIndex; }
+
+int JPetChainReader::getNbOfFiles() const { return fFileNames.size(); }
+
+/**
+ * @brief Enable or disable opening the next file in a background thread.
+ */
+void JPetChainReader::setPrefetchEnabled(bool enable)
+{
+  fIsPrefetchEnabled = enable;
+  if (!enable)
+  {
+    dropPrefetchedFile();
+  }
+}
+
+/**
+ * @brief Open the files and count their entries, in parallel if the prefetching is enabled.
+ *
+ * The number of entries is kNoFile if the file cannot be opened and kNoTree if it does not contain the tree.
+ * The files are closed after counting, only the first one is kept in fFirstFile.
+ */
+void JPetChainReader::openFiles(const std::vector<std::string>& fileNames, std::vector<long long>& nbOfEntries)
+{
+  fFirstFile.reset();
+  nbOfEntries.assign(fileNames.size(), kNoFile);
+  auto openFile = [this, &fileNames, &nbOfEntries](std::size_t index) {
+    std::unique_ptr<TFile> file(openFileForReading(fileNames[index]));
+    if (!file)
+    {
+      return;
+    }
+    auto tree = dynamic_cast<TTree*>(file->Get(fTreeName.c_str()));
+    nbOfEntries[index] = tree ? tree->GetEntries() : kNoTree;
+    if (index == 0)
+    {
+      fFirstFile = std::move(file);
+    }
+  };
+  unsigned int nbOfThreads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), fileNames.size());
+  if (!fIsPrefetchEnabled || nbOfThreads < 2)
+  {
+    for (std::size_t i = 0; i < fileNames.size(); i++)
+    {
+      openFile(i);
+    }
+    return;
+  }
+  std::atomic<std::size_t> nextIndex(0);
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < nbOfThreads; i++)
+  {
+    threads.emplace_back([&nextIndex, &fileNames, &openFile]() {
+      for (auto index = nextIndex++; index < fileNames.size(); index = nextIndex++)
+      {
+        openFile(index);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+/**
+ * @brief Make the file with the given index the current one.
+ *
+ * The first file is the one kept open after counting the entries, the other ones are taken from
+ * the prefetched one, otherwise they are opened synchronously. Afterwards the opening of the next
+ * file is started.
+ */
+bool JPetChainReader::switchToFile(int index)
+{
+  TFile* file = nullptr;
+  if (index == 0 && fFirstFile)
+  {
+    file = fFirstFile.release();
+  }
+  else if (index == fPrefetchedFileIndex && fPrefetchedFile.valid())
+  {
+    file = fPrefetchedFile.get();
+    fPrefetchedFileIndex = -1;
+  }
+  else
+  {
+    dropPrefetchedFile();
+    file = openFileForReading(fFileNames[index]);
+  }
+  if (!file)
+  {
+    ERROR(std::string("Cannot open file: ") + fFileNames[index]);
+    return false;
+  }
+  closeCurrentFile();
+  fFile = file;
+  fTree = dynamic_cast<TTree*>(fFile->Get(fTreeName.c_str()));
+  if (!fTree)
+  {
+    ERROR(std::string("in reading tree from file: ") + fFileNames[index]);
+    return false;
+  }
+  prepareEntry();
+  if (!setupBranches())
+  {
+    ERROR(std::string("in reading branch from tree in file: ") + fFileNames[index]);
+    return false;
+  }
+  fCurrentFileIndex = index;
+  /// the first file is not needed anymore if it has been skipped
+  fFirstFile.reset();
+  prefetchFile(index + 1);
+  return true;
+}
+
+/**
+ * @brief Close the current file, keeping the entry objects for the next one.
+ */
+void JPetChainReader::closeCurrentFile()
+{
+  if (fFile)
+  {
+    delete fFile;
+  }
+  fFile = nullptr;
+  fTree = nullptr;
+  fBranch = nullptr;
+  fCurrentEntryNumber = -1;
+}
+
+/**
+ * @brief Point fEntry to the entry object of the reader before the branch address is set.
+ *
+ * If fEntry were null, ROOT would allocate a new entry object for the tree of every file.
+ * The object is created once, with the class of the entry branch, and recreated
+ * only if a file stores entries of another class.
+ */
+void JPetChainReader::prepareEntry()
+{
+  fEntry = nullptr;
+  auto branch = dynamic_cast<TBranch*>(fTree->GetListOfBranches()->At(0));
+  auto entryClass = branch ? TClass::GetClass(branch->GetClassName()) : nullptr;
+  if (!entryClass || !entryClass->InheritsFrom(TObject::Class()))
+  {
+    return;
+  }
+  if (!fChainEntry || fChainEntry->IsA() != entryClass)
+  {
+    fChainEntry.reset(static_cast<TObject*>(entryClass->New()));
+  }
+  fEntry = fChainEntry.get();
+}
+
+/**
+ * @brief Start opening the first file with entries, starting from the given index.
+ */
+void JPetChainReader::prefetchFile(int index)
+{
+  while (index < static_cast<int>(fFileNames.size()) && fFirstEntryInFile[index + 1] == fFirstEntryInFile[index])
+  {
+    index++;
+  }
+  if (!fIsPrefetchEnabled || index >= static_cast<int>(fFileNames.size()) || index == fPrefetchedFileIndex)
+  {
+    return;
+  }
+  dropPrefetchedFile();
+  auto fileName = fFileNames[index];
+  fPrefetchedFile = std::async(std::launch::async, [fileName]() { return openFileForReading(fileName); });
+  fPrefetchedFileIndex = index;
+}
+
+void JPetChainReader::dropPrefetchedFile()
+{
+  if (fPrefetchedFile.valid())
+  {
+    delete fPrefetchedFile.get();
+  }
+  fPrefetchedFileIndex = -1;
+}
+
+/**
+ * @brief Returns the opened file or nullptr. Safe to call from a background thread.
+ */
+TFile* JPetChainReader::openFileForReading(const std::string& fileName)
+{
+  auto file = new TFile(fileName.c_str(), "READ");
+  if (!file->IsOpen() || file->IsZombie())
+  {
+    delete file;
+    return nullptr;
+  }
+  return file;
+}
@@ -0,0 +1,201 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetDetectorGeometryCache.cpp
+ */
+
+#include "JPetDetectorGeometryCache/JPetDetectorGeometryCache.h"
+#include "JPetGeomMapping/JPetGeomMapping.h"
+#include <TMath.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+const int JPetDetectorGeometryCache::kBadIndex = -1;
+
+/**
+ * @brief Returns the geometry of the param bank, computed at the first call for the bank
+ * and shared by the following calls, or nullptr if the bank is not set.
+ */
+std::shared_ptr<const JPetDetectorGeometryCache> JPetDetectorGeometryCache::getGeometry(const std::shared_ptr<const JPetParamBank>& bank)
+{
+  if (!bank)
+  {
+    return nullptr;
+  }
+  using Entry = std::pair<std::weak_ptr<const JPetParamBank>, std::shared_ptr<const JPetDetectorGeometryCache>>;
+  static std::mutex mutex;
+  static std::map<const JPetParamBank*, Entry> geometries;
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto it = geometries.begin(); it != geometries.end();)
+  {
+    if (it->second.first.expired())
+    {
+      it = geometries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  auto& entry = geometries[bank.get()];
+  if (!entry.second)
+  {
+    entry.first = bank;
+    entry.second = std::make_shared<const JPetDetectorGeometryCache>(*bank);
+  }
+  return entry.second;
+}
+
+JPetDetectorGeometryCache::JPetDetectorGeometryCache(const JPetParamBank& bank)
+{
+  JPetGeomMapping mapping(bank);
+  fLayersSizes = mapping.getLayersSizes();
+  std::vector<std::tuple<int, int, int, const JPetScin*>> scins;
+  for (const auto& scin : bank.getScintillators())
+  {
+    const auto& slot = scin.second->getBarrelSlot();
+    if (slot.isNullObject() || slot.getLayer().isNullObject())
+    {
+      continue;
+    }
+    auto pos = mapping.getStripPos(slot);
+    if (pos.layer == JPetGeomMapping::kBadLayerNumber || pos.slot == JPetGeomMapping::kBadSlotNumber)
+    {
+      continue;
+    }
+    scins.emplace_back(pos.layer, pos.slot, scin.first, scin.second);
+  }
+  std::sort(scins.begin(), scins.end());
+
+  std::map<std::pair<int, int>, std::vector<int>> scinsInSlot;
+  for (const auto& scin : scins)
+  {
+    int index = fScinIDs.size();
+    auto layer = std::get<0>(scin);
+    auto slotNr = std::get<1>(scin);
+    const auto& slot = std::get<3>(scin)->getBarrelSlot();
+    auto radius = slot.getLayer().getRadius();
+    auto theta = slot.getTheta();
+    fScinIDs.push_back(std::get<2>(scin));
+    fCenterX.push_back(radius * std::cos(TMath::DegToRad() * theta));
+    fCenterY.push_back(radius * std::sin(TMath::DegToRad() * theta));
+    fTheta.push_back(theta);
+    fRadius.push_back(radius);
+    fLength.push_back(std::get<3>(scin)->getScinSize(JPetScin::kLength));
+    fLayerNumber.push_back(layer);
+    fSlotNumber.push_back(slotNr);
+    scinsInSlot[std::make_pair(layer, slotNr)].push_back(index);
+  }
+  for (const auto& scinID : fScinIDs)
+  {
+    fScinIDsByID[scinID] = &scinID;
+  }
+  fScinIDsIndex.build(fScinIDsByID);
+
+  fNeighbours.resize(fScinIDs.size());
+  for (std::size_t index = 0; index < fScinIDs.size(); index++)
+  {
+    int slotsCount = mapping.getSlotsCount(static_cast<std::size_t>(fLayerNumber[index]));
+    if (slotsCount < 2)
+    {
+      continue;
+    }
+    int previous = (fSlotNumber[index] + slotsCount - 2) % slotsCount + 1;
+    int next = fSlotNumber[index] % slotsCount + 1;
+    for (auto slotNr : {previous, next})
+    {
+      auto neighbours = scinsInSlot.find(std::make_pair(fLayerNumber[index], slotNr));
+      if (neighbours == scinsInSlot.end())
+      {
+        continue;
+      }
+      for (auto neighbour : neighbours->second)
+      {
+        if (std::find(fNeighbours[index].begin(), fNeighbours[index].end(), neighbour) == fNeighbours[index].end())
+        {
+          fNeighbours[index].push_back(neighbour);
+        }
+      }
+    }
+  }
+}
+
+std::size_t JPetDetectorGeometryCache::getSize() const { return fScinIDs.size(); }
+
+/**
+ * @brief Returns the index of the scintillator with the given id or kBadIndex if there is no such scintillator.
+ */
+int JPetDetectorGeometryCache::getIndex(int scinID) const
+{
+  auto id = fScinIDsIndex.find(fScinIDsByID, scinID);
+  return id ? static_cast<int>(id - fScinIDs.data()) : kBadIndex;
+}
+
+const std::vector<int>& JPetDetectorGeometryCache::getScinIDs() const { return fScinIDs; }
+
+const std::vector<double>& JPetDetectorGeometryCache::getCenterX() const { return fCenterX; }
+
+const std::vector<double>& JPetDetectorGeometryCache::getCenterY() const { return fCenterY; }
+
+const std::vector<double>& JPetDetectorGeometryCache::getTheta() const { return fTheta; }
+
+const std::vector<double>& JPetDetectorGeometryCache::getRadius() const { return fRadius; }
+
+const std::vector<double>& JPetDetectorGeometryCache::getLength() const { return fLength; }
+
+const std::vector<int>& JPetDetectorGeometryCache::getLayerNumber() const { return fLayerNumber; }
+
+const std::vector<int>& JPetDetectorGeometryCache::getSlotNumber() const { return fSlotNumber; }
+
+/**
+ * @brief Returns the indices of the neighbours of the scintillator with the given index.
+ */
+const std::vector<int>& JPetDetectorGeometryCache::getNeighbours(int index) const { return fNeighbours.at(index); }
+
+const std::vector<std::size_t>& JPetDetectorGeometryCache::getLayersSizes() const { return fLayersSizes; }
+
+/**
+ * @brief Returns the table of the pairs of scintillators, computed at the first call.
+ */
+const JPetStripPairTable& JPetDetectorGeometryCache::getStripPairs() const
+{
+  std::call_once(fStripPairsFlag, [this]() { fStripPairs.reset(new JPetStripPairTable(*this)); });
+  return *fStripPairs;
+}
+
+/**
+ * @brief Fills the positions X and Y of the centers of the scintillators with the given ids.
+ *
+ * The positions of the unknown scintillators are set to NaN.
+ */
+void JPetDetectorGeometryCache::getPositions(const std::vector<int>& scinIDs, std::vector<double>& posX, std::vector<double>& posY) const
+{
+  posX.resize(scinIDs.size());
+  posY.resize(scinIDs.size());
+  for (std::size_t i = 0; i < scinIDs.size(); i++)
+  {
+    auto index = getIndex(scinIDs[i]);
+    if (index == kBadIndex)
+    {
+      posX[i] = std::numeric_limits<double>::quiet_NaN();
+      posY[i] = std::numeric_limits<double>::quiet_NaN();
+      continue;
+    }
+    posX[i] = fCenterX[index];
+    posY[i] = fCenterY[index];
+  }
+}
@@ -0,0 +1,325 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEntryIndex.cpp
+ */
+
+#include "JPetEntryIndex/JPetEntryIndex.h"
+#include "JPetBarrelSlot/JPetBarrelSlot.h"
+#include "JPetEvent/JPetEvent.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetLayer/JPetLayer.h"
+#include "JPetLoggerInclude.h"
+#include "JPetPhysSignal/JPetPhysSignal.h"
+#include "JPetRawSignal/JPetRawSignal.h"
+#include "JPetScin/JPetScin.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetTypedWindowView/JPetTypedWindowView.h"
+#include <TCollection.h>
+#include <algorithm>
+
+ClassImp(JPetEntryIndex);
+
+const std::string JPetEntryIndex::kIndexName = "EntryIndex";
+const int JPetEntryIndex::kMaxLayerID = 63;
+
+namespace
+{
+const int kBitsPerWord = 64;
+
+void summarizeHit(const JPetHit& hit, bool isTimeOnly, JPetEntryIndex::EntrySummary& summary)
+{
+  summary.addTime(hit.getTime());
+  if (isTimeOnly)
+  {
+    return;
+  }
+  summary.addEnergy(hit.getEnergy());
+  if (hit.isScintillatorSet())
+  {
+    summary.addScin(hit.getScintillator().getID());
+  }
+  if (hit.isBarrelSlotSet())
+  {
+    summary.addLayer(hit.getBarrelSlot().getLayer().getID());
+  }
+}
+
+/// Leading times of the signal, from the threshold index if it has all the points
+void summarizeRawSignal(const JPetRawSignal& signal, JPetEntryIndex::EntrySummary& summary)
+{
+  if (signal.isThresholdIndexComplete(JPetSigCh::Leading))
+  {
+    for (unsigned int thrNum = 1; thrNum <= JPetRawSignal::kNumberOfThresholds; thrNum++)
+    {
+      if (signal.hasPoint(JPetSigCh::Leading, thrNum))
+      {
+        summary.addTime(signal.getTime(JPetSigCh::Leading, thrNum));
+      }
+    }
+    return;
+  }
+  for (const auto& sigCh : signal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum))
+  {
+    summary.addTime(sigCh.getValue());
+  }
+}
+}
+
+bool JPetEntryIndex::EntrySummary::hasTime() const { return fStartTime <= fEndTime; }
+
+bool JPetEntryIndex::EntrySummary::hasEnergy() const { return fMinEnergy <= fMaxEnergy; }
+
+/**
+ * An entry without any timing information cannot be excluded, so it is
+ * treated as overlapping every time range.
+ */
+bool JPetEntryIndex::EntrySummary::overlapsTime(double from, double to) const
+{
+  if (!hasTime())
+    return true;
+  return fStartTime <= to && fEndTime >= from;
+}
+
+bool JPetEntryIndex::EntrySummary::overlapsEnergy(float from, float to) const
+{
+  if (!hasEnergy())
+    return false;
+  return fMinEnergy <= to && fMaxEnergy >= from;
+}
+
+bool JPetEntryIndex::EntrySummary::isScinHit(int scinID) const
+{
+  if (scinID < 0)
+    return false;
+  unsigned int word = scinID / kBitsPerWord;
+  if (word >= fScinMask.size())
+    return false;
+  return (fScinMask[word] >> (scinID % kBitsPerWord)) & 1ull;
+}
+
+bool JPetEntryIndex::EntrySummary::isLayerHit(int layerID) const
+{
+  if (layerID < 0 || layerID > kMaxLayerID)
+    return false;
+  return (fLayerMask >> layerID) & 1ull;
+}
+
+void JPetEntryIndex::EntrySummary::addTime(double time)
+{
+  if (time < fStartTime)
+    fStartTime = time;
+  if (time > fEndTime)
+    fEndTime = time;
+}
+
+void JPetEntryIndex::EntrySummary::addEnergy(float energy)
+{
+  if (energy < fMinEnergy)
+    fMinEnergy = energy;
+  if (energy > fMaxEnergy)
+    fMaxEnergy = energy;
+}
+
+void JPetEntryIndex::EntrySummary::addScin(int scinID)
+{
+  if (scinID < 0)
+    return;
+  unsigned int word = scinID / kBitsPerWord;
+  if (word >= fScinMask.size())
+    fScinMask.resize(word + 1, 0ull);
+  fScinMask[word] |= 1ull << (scinID % kBitsPerWord);
+}
+
+void JPetEntryIndex::EntrySummary::addLayer(int layerID)
+{
+  if (layerID < 0 || layerID > kMaxLayerID)
+  {
+    ERROR("Layer ID " + std::to_string(layerID) + " out of the range of the entry index [0, " + std::to_string(kMaxLayerID) + "]");
+    return;
+  }
+  fLayerMask |= 1ull << layerID;
+}
+
+JPetEntryIndex::JPetEntryIndex() {}
+
+JPetEntryIndex::~JPetEntryIndex() {}
+
+/**
+ * @brief Build the summary of a single time window.
+ *
+ * Times are taken from the objects stored in the window (signal channels,
+ * raw signals, physical signals, hits and events). Energies, scintillators and
+ * layers are only known for hits, so they are filled from JPetHit objects
+ * and from the hits contained in JPetEvent objects. If isTimeOnly is set,
+ * only the time range and the number of objects are filled.
+ * The class of the objects is checked once per window.
+ */
+JPetEntryIndex::EntrySummary JPetEntryIndex::summarize(const JPetTimeWindow& window, bool isTimeOnly)
+{
+  EntrySummary summary;
+  summary.fObjectCount = window.getNumberOfEvents();
+  auto eventClass = window.getEventClass();
+  if (summary.fObjectCount == 0 || !eventClass)
+  {
+    return summary;
+  }
+  if (eventClass->InheritsFrom(JPetHit::Class()))
+  {
+    for (const auto& hit : JPetTypedWindowView<const JPetHit>(window))
+    {
+      summarizeHit(hit, isTimeOnly, summary);
+    }
+  }
+  else if (eventClass->InheritsFrom(JPetEvent::Class()))
+  {
+    for (const auto& event : JPetTypedWindowView<const JPetEvent>(window))
+    {
+      for (const auto& hit : event.getHits())
+      {
+        summarizeHit(hit, isTimeOnly, summary);
+      }
+    }
+  }
+  else if (eventClass->InheritsFrom(JPetPhysSignal::Class()))
+  {
+    for (const auto& physSignal : JPetTypedWindowView<const JPetPhysSignal>(window))
+    {
+      summary.addTime(physSignal.getTime());
+    }
+  }
+  else if (eventClass->InheritsFrom(JPetRawSignal::Class()))
+  {
+    for (const auto& rawSignal : JPetTypedWindowView<const JPetRawSignal>(window))
+    {
+      summarizeRawSignal(rawSignal, summary);
+    }
+  }
+  else if (eventClass->InheritsFrom(JPetSigCh::Class()))
+  {
+    for (const auto& sigCh : JPetTypedWindowView<const JPetSigCh>(window))
+    {
+      summary.addTime(sigCh.getValue());
+    }
+  }
+  return summary;
+}
+
+void JPetEntryIndex::addEntry(const JPetTimeWindow& window) { addSummary(summarize(window)); }
+
+void JPetEntryIndex::addSummary(const EntrySummary& summary)
+{
+  fSummaries.push_back(summary);
+  fIsTimeOrderChecked = false;
+}
+
+size_t JPetEntryIndex::getNumberOfEntries() const { return fSummaries.size(); }
+
+const JPetEntryIndex::EntrySummary& JPetEntryIndex::getSummary(long long entry) const { return fSummaries.at(entry); }
+
+/**
+ * @brief Find the first entry in the range [firstEntry, lastEntry] which contains
+ * objects at or after the given time.
+ *
+ * Entries without timing information are skipped. Returns -1 if no entry in
+ * the range reaches the requested time.
+ */
+long long JPetEntryIndex::findFirstEntryAtTime(double time, long long firstEntry, long long lastEntry) const
+{
+  return findFirstEntryInTimeRange(time, std::numeric_limits<double>::max(), firstEntry, lastEntry);
+}
+
+/**
+ * @brief Find the first entry in the range [firstEntry, lastEntry] which has objects
+ * in the time range [from, to], or -1 if there is none. Entries without timing information are skipped.
+ */
+long long JPetEntryIndex::findFirstEntryInTimeRange(double from, double to, long long firstEntry, long long lastEntry) const
+{
+  if (firstEntry < 0)
+    firstEntry = 0;
+  if (lastEntry >= static_cast<long long>(fSummaries.size()))
+    lastEntry = fSummaries.size() - 1;
+  if (firstEntry > lastEntry)
+    return -1;
+  if (isTimeOrdered())
+  {
+    auto begin = fSummaries.begin() + firstEntry;
+    auto end = fSummaries.begin() + lastEntry + 1;
+    auto found = std::partition_point(begin, end, [from](const EntrySummary& summary) { return summary.fEndTime < from; });
+    if (found == end || found->fStartTime > to)
+      return -1;
+    return found - fSummaries.begin();
+  }
+  for (auto entry = firstEntry; entry <= lastEntry; entry++)
+  {
+    const auto& summary = fSummaries[entry];
+    if (summary.hasTime() && summary.fEndTime >= from && summary.fStartTime <= to)
+      return entry;
+  }
+  return -1;
+}
+
+/**
+ * @brief Whether all the entries have timing information and their start and end times do not decrease.
+ *
+ * Checked once after the summaries change.
+ */
+bool JPetEntryIndex::isTimeOrdered() const
+{
+  if (fIsTimeOrderChecked)
+    return fIsTimeOrdered;
+  fIsTimeOrdered = true;
+  for (size_t entry = 0; entry < fSummaries.size() && fIsTimeOrdered; entry++)
+  {
+    const auto& summary = fSummaries[entry];
+    fIsTimeOrdered = summary.hasTime();
+    if (fIsTimeOrdered && entry > 0)
+    {
+      const auto& previous = fSummaries[entry - 1];
+      fIsTimeOrdered = previous.fStartTime <= summary.fStartTime && previous.fEndTime <= summary.fEndTime;
+    }
+  }
+  fIsTimeOrderChecked = true;
+  return fIsTimeOrdered;
+}
+
+/**
+ * @brief Append the indices from the list, in order.
+ *
+ * Called by hadd and TFileMerger, which concatenate the trees of the merged
+ * files in the same order, so the merged index stays aligned with the merged tree.
+ */
+Long64_t JPetEntryIndex::Merge(TCollection* list)
+{
+  if (!list)
+    return fSummaries.size();
+  TIter next(list);
+  while (auto obj = next())
+  {
+    auto other = dynamic_cast<JPetEntryIndex*>(obj);
+    if (!other)
+    {
+      ERROR(Form("Cannot merge %s with JPetEntryIndex", obj->GetName()));
+      return -1;
+    }
+    fSummaries.insert(fSummaries.end(), other->fSummaries.begin(), other->fSummaries.end());
+  }
+  fIsTimeOrderChecked = false;
+  return fSummaries.size();
+}
+
+void JPetEntryIndex::Clear(Option_t*)
+{
+  fSummaries.clear();
+  fIsTimeOrderChecked = false;
+}
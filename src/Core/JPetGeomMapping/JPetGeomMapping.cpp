@@ -14,12 +14,45 @@
  */
 
 #include "JPetGeomMapping/JPetGeomMapping.h"
+#include <algorithm>
 
 using namespace std;
 
 const size_t JPetGeomMapping::kBadLayerNumber = 99999999;
 const size_t JPetGeomMapping::kBadSlotNumber = 99999999;
 
+namespace
+{
+/**
+ * Indexes the entries sorted by id. The pointers to the entries stay valid
+ * as long as the vector is not modified, also after it is moved.
+ */
+template <typename Entry>
+void buildIndex(const vector<Entry>& entries, JPetParamIndex<const Entry>& index)
+{
+  map<int, const Entry*> entriesByID;
+  for (const auto& entry : entries)
+  {
+    entriesByID.emplace_hint(entriesByID.end(), entry.id, &entry);
+  }
+  index.build(entriesByID);
+}
+
+/**
+ * Returns the entry with the given id or nullptr, with the binary search if the index could not be built.
+ */
+template <typename Entry>
+const Entry* findByID(const vector<Entry>& entries, const JPetParamIndex<const Entry>& index, int id)
+{
+  if (index.isBuilt())
+  {
+    return index.find(id);
+  }
+  auto entry = lower_bound(entries.begin(), entries.end(), id, [](const Entry& other, int otherID) { return other.id < otherID; });
+  return entry != entries.end() && entry->id == id ? &*entry : nullptr;
+}
+}
+
 /**
  * Constructor of mapping with a param bank as an argument
  */
@@ -62,6 +95,29 @@ JPetGeomMapping::JPetGeomMapping(const JPetParamBank& paramBank)
     layerNumber++;
   }
   fTOMBs = getTOMBMap(paramBank);
+  buildTables(paramBank);
+}
+
+/**
+ * Copy constructor, the indices are built for the copied entries
+ */
+JPetGeomMapping::JPetGeomMapping(const JPetGeomMapping& other):
+  JPetGeomMappingInterface(other), fTOMBs(other.fTOMBs), fThetaToSlot(other.fThetaToSlot), fNumberOfSlotsInLayer(other.fNumberOfSlotsInLayer),
+  fRadiusToLayer(other.fRadiusToLayer), fLayerRadii(other.fLayerRadii), fFirstSlotOfLayer(other.fFirstSlotOfLayer),
+  fMinThreshold(other.fMinThreshold), fThresholdsCount(other.fThresholdsCount), fTOMBTable(other.fTOMBTable),
+  fTOMBChannels(other.fTOMBChannels), fSlots(other.fSlots)
+{
+  buildIndices();
+}
+
+JPetGeomMapping& JPetGeomMapping::operator=(const JPetGeomMapping& other)
+{
+  if (this != &other)
+  {
+    JPetGeomMapping copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
 }
 
 /**
@@ -131,6 +187,10 @@ size_t JPetGeomMapping::getSlotsCount(const size_t layerNr) const
  */
 size_t JPetGeomMapping::getSlotNumber(const JPetBarrelSlot& slot) const
 {
+  if (auto entry = findSlot(slot))
+  {
+    return entry->pos.slot;
+  }
   auto layerNr = getLayerNumber(slot.getLayer());
   auto theta = slot.getTheta();
   if ((fNumberOfSlotsInLayer.size() < layerNr) || (layerNr <= 0))
@@ -152,9 +212,26 @@ size_t JPetGeomMapping::getSlotNumber(const JPetBarrelSlot& slot) const
  */
 const StripPos JPetGeomMapping::getStripPos(const JPetBarrelSlot& slot) const
 {
+  if (auto entry = findSlot(slot))
+  {
+    return entry->pos;
+  }
   return {.layer = getLayerNumber(slot.getLayer()), .slot = getSlotNumber(slot)};
 }
 
+/**
+ * Return Strip Position structure for the Barrel Slot with the given id
+ * or kBadLayerNumber and kBadSlotNumber if there is no such Barrel Slot in the mapping
+ */
+const StripPos JPetGeomMapping::getStripPosByID(int barrelSlotID) const
+{
+  if (auto entry = findByID(fSlots, fSlotsIndex, barrelSlotID))
+  {
+    return entry->pos;
+  }
+  return {.layer = kBadLayerNumber, .slot = kBadSlotNumber};
+}
+
 /**
  * Returns a vector of sizes of all Layers
  */
@@ -169,7 +246,7 @@ const vector<size_t> JPetGeomMapping::getLayersSizes() const
 /**
  * Prints out the mapping of TOMB channels
  */
-void JPetGeomMapping::printTOMBMapping(const std::map<std::tuple<int, int, JPetPM::Side, int>, int>& tombMap)
+void JPetGeomMapping::printTOMBMapping(const TOMBMapping& tombMap)
 {
   for (auto& el : tombMap)
   {
@@ -184,25 +261,34 @@ void JPetGeomMapping::printTOMBMapping(const std::map<std::tuple<int, int, JPetP
 }
 
 /**
- * Returns the created mapping
+ * Returns the created mapping, without copying it
  */
-std::map<std::tuple<int, int, JPetPM::Side, int>, int> JPetGeomMapping::getTOMBMapping() const { return fTOMBs; }
+const JPetGeomMapping::TOMBMapping& JPetGeomMapping::getTOMBMapping() const { return fTOMBs; }
 
 /**
  * Returns the number of the channel, indicated by the set of the
- * argument parameters: Layer, Slot, PM Side and Threshold
+ * argument parameters: Layer, Slot, PM Side and Threshold, or -1 if there is no such channel
  */
 int JPetGeomMapping::getTOMB(int layerNr, int barrel_slot_nr, const JPetPM::Side& side, int threshold) const
 {
-  auto key = std::make_tuple(layerNr, barrel_slot_nr, side, threshold);
-  if (fTOMBs.find(key) == fTOMBs.end())
+  if (layerNr <= 0 || layerNr > static_cast<int>(fNumberOfSlotsInLayer.size()) || barrel_slot_nr <= 0 ||
+      barrel_slot_nr > fNumberOfSlotsInLayer[layerNr - 1] || (side != JPetPM::SideA && side != JPetPM::SideB) ||
+      threshold < fMinThreshold || threshold >= fMinThreshold + fThresholdsCount)
   {
     return -1;
   }
-  else
-  {
-    return fTOMBs.at(key);
-  }
+  auto slotIndex = fFirstSlotOfLayer[layerNr - 1] + barrel_slot_nr - 1;
+  return fTOMBTable[(slotIndex * 2 + side) * fThresholdsCount + threshold - fMinThreshold];
+}
+
+/**
+ * Returns the Layer, Slot, PM Side and Threshold of the TOMB channel
+ * or nullptr if there is no such channel in the mapping
+ */
+const JPetGeomMapping::TOMBChannelPos* JPetGeomMapping::getTOMBChannelPos(int tombChannel) const
+{
+  auto entry = findByID(fTOMBChannels, fTOMBChannelsIndex, tombChannel);
+  return entry ? &entry->pos : nullptr;
 }
 
 /**
@@ -210,12 +296,11 @@ int JPetGeomMapping::getTOMB(int layerNr, int barrel_slot_nr, const JPetPM::Side
  */
 double JPetGeomMapping::getRadiusOfLayer(int layer) const
 {
-  for (auto it = fRadiusToLayer.begin(); it != fRadiusToLayer.end(); it++)
+  if (layer <= 0 || layer > static_cast<int>(fLayerRadii.size()))
   {
-    if (it->second == layer)
-      return it->first;
+    return 0.;
   }
-  return 0.;
+  return fLayerRadii[layer - 1];
 }
 
 /**
@@ -249,10 +334,10 @@ size_t JPetGeomMapping::calcDeltaID(const JPetBarrelSlot& slot1, const JPetBarre
  * If any of param objects needed to create the map is not set in JPetParamBank,
  * the empty map will be returned.
  */
-std::map<std::tuple<int, int, JPetPM::Side, int>, int> JPetGeomMapping::getTOMBMap(const JPetParamBank& bank) const
+JPetGeomMapping::TOMBMapping JPetGeomMapping::getTOMBMap(const JPetParamBank& bank) const
 {
-  auto tombChannels = bank.getTOMBChannels();
-  std::map<std::tuple<int, int, JPetPM::Side, int>, int> result;
+  const auto& tombChannels = bank.getTOMBChannels();
+  TOMBMapping result;
   bool errorOccured = false;
   for (const auto& el : tombChannels)
   {
@@ -289,11 +374,117 @@ std::map<std::tuple<int, int, JPetPM::Side, int>, int> JPetGeomMapping::getTOMBM
   if (errorOccured)
   {
     ERROR("Error occured while generating TOMBMap. Empty map will be returned!");
-    std::map<std::tuple<int, int, JPetPM::Side, int>, int> emptyMap;
-    return emptyMap;
+    return TOMBMapping();
   }
   else
   {
     return result;
   }
 }
+
+/**
+ * Private method filling the dense lookup tables: the table of TOMB channels
+ * indexed by the slot, side and threshold, the positions of the TOMB channels
+ * and the positions of the Barrel Slots indexed by their ids.
+ */
+void JPetGeomMapping::buildTables(const JPetParamBank& bank)
+{
+  for (const auto& radius : fRadiusToLayer)
+  {
+    fLayerRadii.push_back(radius.first);
+  }
+  std::size_t slotsCount = 0;
+  for (auto slotsInLayer : fNumberOfSlotsInLayer)
+  {
+    fFirstSlotOfLayer.push_back(slotsCount);
+    slotsCount += slotsInLayer;
+  }
+  for (const auto& slot : bank.getBarrelSlots())
+  {
+    if (slot.second->getLayer().isNullObject())
+    {
+      continue;
+    }
+    auto radius = slot.second->getLayer().getRadius();
+    auto layer = fRadiusToLayer.find(radius);
+    if (layer == fRadiusToLayer.end())
+    {
+      continue;
+    }
+    auto theta = slot.second->getTheta();
+    const auto& thetaToSlot = fThetaToSlot[layer->second - 1];
+    auto slotNr = thetaToSlot.find(theta);
+    if (slotNr == thetaToSlot.end())
+    {
+      continue;
+    }
+    SlotEntry entry;
+    entry.id = slot.first;
+    entry.pos.layer = layer->second;
+    entry.pos.slot = slotNr->second;
+    entry.theta = theta;
+    entry.radius = radius;
+    fSlots.push_back(entry);
+  }
+  if (fTOMBs.empty())
+  {
+    buildIndices();
+    return;
+  }
+  int maxThreshold = std::get<3>(fTOMBs.begin()->first);
+  fMinThreshold = maxThreshold;
+  for (const auto& tomb : fTOMBs)
+  {
+    fMinThreshold = std::min(fMinThreshold, std::get<3>(tomb.first));
+    maxThreshold = std::max(maxThreshold, std::get<3>(tomb.first));
+  }
+  fThresholdsCount = maxThreshold - fMinThreshold + 1;
+  fTOMBTable.assign(slotsCount * 2 * fThresholdsCount, -1);
+  map<int, TOMBChannelPos> positionsByID;
+  for (const auto& tomb : fTOMBs)
+  {
+    TOMBChannelPos pos;
+    pos.layer = std::get<0>(tomb.first);
+    pos.slot = std::get<1>(tomb.first);
+    pos.side = std::get<2>(tomb.first);
+    pos.threshold = std::get<3>(tomb.first);
+    positionsByID[tomb.second] = pos;
+    if (pos.layer <= 0 || pos.layer > static_cast<int>(fNumberOfSlotsInLayer.size()) || pos.slot <= 0 ||
+        pos.slot > fNumberOfSlotsInLayer[pos.layer - 1])
+    {
+      continue;
+    }
+    auto slotIndex = fFirstSlotOfLayer[pos.layer - 1] + pos.slot - 1;
+    fTOMBTable[(slotIndex * 2 + pos.side) * fThresholdsCount + pos.threshold - fMinThreshold] = tomb.second;
+  }
+  fTOMBChannels.reserve(positionsByID.size());
+  for (const auto& pos : positionsByID)
+  {
+    fTOMBChannels.push_back({pos.first, pos.second});
+  }
+  buildIndices();
+}
+
+/**
+ * Private method indexing the Barrel Slots and the TOMB channels by their ids
+ */
+void JPetGeomMapping::buildIndices()
+{
+  buildIndex(fSlots, fSlotsIndex);
+  buildIndex(fTOMBChannels, fTOMBChannelsIndex);
+}
+
+/**
+ * Private method returning the entry of the Barrel Slot with the same id,
+ * if its layer radius and theta are the same as the ones of the given slot.
+ * Otherwise nullptr is returned and the slot is looked up by its radius and theta.
+ */
+const JPetGeomMapping::SlotEntry* JPetGeomMapping::findSlot(const JPetBarrelSlot& slot) const
+{
+  auto entry = findByID(fSlots, fSlotsIndex, slot.getID());
+  if (!entry || entry->theta != slot.getTheta() || slot.getLayer().isNullObject() || entry->radius != slot.getLayer().getRadius())
+  {
+    return nullptr;
+  }
+  return entry;
+}
@@ -0,0 +1,497 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHadd.cpp
+ */
+
+#include "JPetHadd/JPetHadd.h"
+#include "JPetLoggerInclude.h"
+#include "JPetTreeHeader/JPetTreeHeader.h"
+#include "JPetUserInfoStructure/JPetUserInfoStructure.h"
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TProcessID.h>
+#include <TROOT.h>
+#include <TTree.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+const std::string kTreeName = "T";
+const std::string kParamBankName = "ParamBank";
+/// Number of input files waiting for each statistics thread, bounding the number of open files
+const std::size_t kMaxQueuedFiles = 2;
+
+TFile* openInputFile(const std::string& fileName)
+{
+  auto file = new TFile(fileName.c_str(), "READ");
+  if (!file->IsOpen() || file->IsZombie())
+  {
+    delete file;
+    return nullptr;
+  }
+  return file;
+}
+
+bool isSameStage(const JPetTreeHeader::ProcessingStageInfo& first, const JPetTreeHeader::ProcessingStageInfo& second)
+{
+  return first.fModuleName == second.fModuleName && first.fModuleDescription == second.fModuleDescription &&
+         first.fModuleVersion == second.fModuleVersion && first.fCreationTime == second.fCreationTime;
+}
+
+std::string serialise(TObject* object)
+{
+  TBufferFile buffer(TBuffer::kWrite);
+  object->Streamer(buffer);
+  return std::string(buffer.Buffer(), buffer.Length());
+}
+}
+
+/**
+ * @brief Input files of a contiguous subset of inputs, passed by the main thread to
+ * the thread merging their statistics, and the partial result of the merging.
+ */
+struct JPetHadd::StatisticsGroup
+{
+  std::mutex fMutex;
+  std::condition_variable fCondition;
+  std::deque<std::unique_ptr<TFile>> fFiles;
+  bool fIsClosed = false;
+  MergedObjects fMerged;
+  std::thread fThread;
+
+  void push(std::unique_ptr<TFile> file)
+  {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fCondition.wait(lock, [this]() { return fFiles.size() < kMaxQueuedFiles; });
+    fFiles.push_back(std::move(file));
+    fCondition.notify_all();
+  }
+
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fIsClosed = true;
+    }
+    fCondition.notify_all();
+    if (fThread.joinable())
+    {
+      fThread.join();
+    }
+  }
+};
+
+JPetHadd::JPetHadd(const std::string& outputFileName) : fOutputFileName(outputFileName) {}
+
+JPetHadd::~JPetHadd() {}
+
+/**
+ * @brief Set the number of threads used to merge the statistics. 0 means all available cores.
+ */
+void JPetHadd::setNumberOfThreads(unsigned int nbOfThreads)
+{
+  fNbOfThreads = nbOfThreads > 0 ? nbOfThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Allow overwriting the output file if it already exists, as the -f option of hadd.
+ */
+void JPetHadd::setForceOverwrite(bool isForced) { fIsForceOverwrite = isForced; }
+
+int JPetHadd::getNumberOfDistinctParamBanks() const { return fParamBanks.size(); }
+
+/**
+ * @brief Merge the input files into the output file.
+ *
+ * The entries of the tree are stored in the order of the input files.
+ * Distinct ParamBanks are written as consecutive cycles of the ParamBank key,
+ * so the bank of the first file is always available as ParamBank;1.
+ * JPetParamManager reads the following cycles too.
+ */
+bool JPetHadd::merge(const std::vector<std::string>& inputFileNames)
+{
+  if (inputFileNames.empty())
+  {
+    ERROR("empty list of input files");
+    return false;
+  }
+  TH1::AddDirectory(false);
+  TFile outputFile(fOutputFileName.c_str(), fIsForceOverwrite ? "RECREATE" : "CREATE");
+  if (!outputFile.IsOpen() || outputFile.IsZombie())
+  {
+    ERROR(std::string("Cannot create output file: ") + fOutputFileName + (fIsForceOverwrite ? "" : ", use -f to overwrite an existing file"));
+    return false;
+  }
+  fParamBanks.clear();
+  fParamBankHashes.clear();
+  fOtherObjects.clear();
+  fOutputTree = nullptr;
+  fHeader = nullptr;
+  bool isOk = mergeInputs(inputFileNames, outputFile);
+  if (isOk)
+  {
+    outputFile.cd();
+    if (fOutputTree)
+    {
+      fOutputTree->Write("", TObject::kOverwrite);
+    }
+    for (const auto& bank : fParamBanks)
+    {
+      outputFile.WriteTObject(bank.get(), kParamBankName.c_str());
+    }
+    writeObjects(fOtherObjects, outputFile);
+  }
+  outputFile.Close();
+  fOutputTree = nullptr;
+  fHeader = nullptr;
+  fOtherObjects.clear();
+  return isOk;
+}
+
+/**
+ * @brief Sequential pass over the inputs, merging the tree, header, ParamBanks and other
+ * top level objects, while the statistics are merged in parallel threads.
+ *
+ * The inputs are divided into contiguous groups, each reduced by a separate thread with
+ * its own objects. The partial results are combined at the end.
+ */
+bool JPetHadd::mergeInputs(const std::vector<std::string>& inputFileNames, TFile& outputFile)
+{
+  unsigned int nbOfGroups = std::min<unsigned int>(fNbOfThreads, inputFileNames.size());
+  std::vector<std::unique_ptr<StatisticsGroup>> groups;
+  for (unsigned int i = 0; i < nbOfGroups; i++)
+  {
+    groups.emplace_back(new StatisticsGroup());
+  }
+  if (nbOfGroups > 1)
+  {
+    ROOT::EnableThreadSafety();
+    for (auto& group : groups)
+    {
+      group->fThread = std::thread(&JPetHadd::collectStatistics, std::ref(*group));
+    }
+  }
+  bool isOk = true;
+  for (unsigned int i = 0; i < inputFileNames.size() && isOk; i++)
+  {
+    std::unique_ptr<TFile> inputFile(openInputFile(inputFileNames[i]));
+    if (!inputFile)
+    {
+      ERROR(std::string("Cannot open file: ") + inputFileNames[i]);
+      isOk = false;
+      break;
+    }
+    isOk = mergeTreeAndParameters(*inputFile, outputFile);
+    auto& group = *groups[i * nbOfGroups / inputFileNames.size()];
+    if (!isOk)
+    {
+      ERROR(std::string("in merging file: ") + inputFileNames[i]);
+    }
+    else if (nbOfGroups > 1)
+    {
+      group.push(std::move(inputFile));
+    }
+    else
+    {
+      collectDirectory(inputFile.get(), "", group.fMerged);
+    }
+  }
+  for (auto& group : groups)
+  {
+    group->close();
+  }
+  if (!isOk)
+  {
+    return false;
+  }
+  auto& merged = groups[0]->fMerged;
+  for (unsigned int i = 1; i < nbOfGroups; i++)
+  {
+    for (auto& object : groups[i]->fMerged)
+    {
+      auto target = merged.find(object.first);
+      if (target == merged.end())
+      {
+        merged[object.first] = std::move(object.second);
+      }
+      else if (!mergeObject(target->second.get(), object.second.get()))
+      {
+        WARNING(std::string("Object ") + object.first + " cannot be merged, keeping the one from the first file");
+      }
+    }
+  }
+  writeObjects(merged, outputFile);
+  fHeader->setVariable("Merged files", std::to_string(inputFileNames.size()));
+  return true;
+}
+
+/**
+ * @brief Merge the tree, header, ParamBanks and other top level objects of the input.
+ *
+ * The baskets of the tree are copied with the "fast" option, so the time windows
+ * are never deserialised and the cost is dominated by the file I/O. The input tree
+ * is deleted afterwards, so that the file can be passed to another thread.
+ */
+bool JPetHadd::mergeTreeAndParameters(TFile& inputFile, TFile& outputFile)
+{
+  std::vector<TObject*> banks;
+  TIter nextKey(inputFile.GetListOfKeys());
+  std::string lastName;
+  while (auto key = static_cast<TKey*>(nextKey()))
+  {
+    std::string name = key->GetName();
+    auto keyClass = TClass::GetClass(key->GetClassName());
+    if (name == kTreeName || !keyClass || keyClass == TProcessID::Class() || keyClass->InheritsFrom(TDirectory::Class()))
+    {
+      continue;
+    }
+    if (name == kParamBankName)
+    {
+      banks.push_back(key->ReadObj());
+      continue;
+    }
+    /// only the highest cycle of the other objects is merged
+    if (name == lastName)
+    {
+      continue;
+    }
+    lastName = name;
+    std::unique_ptr<TObject> object(key->ReadObj());
+    auto merged = fOtherObjects.find(name);
+    if (merged == fOtherObjects.end())
+    {
+      fOtherObjects[name] = std::move(object);
+    }
+    else if (!mergeObject(merged->second.get(), object.get()))
+    {
+      WARNING(std::string("Object ") + name + " cannot be merged, keeping the one from the first file");
+    }
+  }
+  bool isOk = true;
+  for (auto bank : banks)
+  {
+    isOk = addParamBank(bank) && isOk;
+  }
+  if (!isOk)
+  {
+    return false;
+  }
+  auto tree = dynamic_cast<TTree*>(inputFile.Get(kTreeName.c_str()));
+  if (!tree)
+  {
+    ERROR(std::string("in reading tree from file: ") + inputFile.GetName());
+    return false;
+  }
+  auto header = dynamic_cast<JPetTreeHeader*>(tree->GetUserInfo()->At(JPetUserInfoStructure::kHeader));
+  if (!fOutputTree)
+  {
+    outputFile.cd();
+    fOutputTree = tree->CloneTree(0);
+    fOutputTree->SetDirectory(&outputFile);
+    fOutputTree->GetUserInfo()->Clear();
+    fHeader = header ? new JPetTreeHeader(*header) : new JPetTreeHeader();
+    fOutputTree->GetUserInfo()->AddAt(fHeader, JPetUserInfoStructure::kHeader);
+  }
+  else if (header)
+  {
+    mergeStageHistory(*fHeader, *header);
+  }
+  isOk = fOutputTree->CopyEntries(tree, -1, "fast") >= 0;
+  if (!isOk)
+  {
+    ERROR(std::string("in copying entries from file: ") + inputFile.GetName());
+  }
+  delete tree;
+  return isOk;
+}
+
+/**
+ * @brief Keep the bank unless an identical one is already stored.
+ *
+ * Banks are compared by their serialised content, which is identical for
+ * banks created from the same parameters. Only the hashes of the content are kept,
+ * the stored banks with the same hash are serialised again to compare the content.
+ * The entries refer to the parameters by their ids, so one bank serves the entries of all such inputs.
+ */
+bool JPetHadd::addParamBank(TObject* bank)
+{
+  std::unique_ptr<TObject> ownedBank(bank);
+  if (!bank)
+  {
+    ERROR("in reading ParamBank");
+    return false;
+  }
+  auto content = serialise(bank);
+  auto hash = std::hash<std::string>()(content);
+  auto sameHash = fParamBankHashes.equal_range(hash);
+  for (auto stored = sameHash.first; stored != sameHash.second; ++stored)
+  {
+    if (serialise(fParamBanks[stored->second].get()) == content)
+    {
+      return true;
+    }
+  }
+  fParamBankHashes.emplace(hash, fParamBanks.size());
+  fParamBanks.push_back(std::move(ownedBank));
+  return true;
+}
+
+/**
+ * @brief Merge the statistics of the files passed to the group until it is closed.
+ */
+void JPetHadd::collectStatistics(StatisticsGroup& group)
+{
+  while (true)
+  {
+    std::unique_ptr<TFile> inputFile;
+    {
+      std::unique_lock<std::mutex> lock(group.fMutex);
+      group.fCondition.wait(lock, [&group]() { return !group.fFiles.empty() || group.fIsClosed; });
+      if (group.fFiles.empty())
+      {
+        return;
+      }
+      inputFile = std::move(group.fFiles.front());
+      group.fFiles.pop_front();
+    }
+    group.fCondition.notify_all();
+    collectDirectory(inputFile.get(), "", group.fMerged);
+  }
+}
+
+/**
+ * @brief Merge the objects of all subdirectories of the directory into the map, keyed by their paths.
+ */
+void JPetHadd::collectDirectory(TDirectory* directory, const std::string& path, MergedObjects& merged)
+{
+  TIter nextKey(directory->GetListOfKeys());
+  std::string lastName;
+  while (auto key = static_cast<TKey*>(nextKey()))
+  {
+    std::string name = key->GetName();
+    if (name == lastName)
+    {
+      continue;
+    }
+    lastName = name;
+    auto keyClass = TClass::GetClass(key->GetClassName());
+    if (!keyClass)
+    {
+      continue;
+    }
+    if (keyClass->InheritsFrom(TDirectory::Class()))
+    {
+      auto subdirectory = directory->GetDirectory(name.c_str());
+      if (subdirectory)
+      {
+        collectDirectory(subdirectory, path + name + "/", merged);
+      }
+      continue;
+    }
+    /// top level objects are handled in order together with the tree
+    if (path.empty())
+    {
+      continue;
+    }
+    std::unique_ptr<TObject> object(key->ReadObj());
+    auto target = merged.find(path + name);
+    if (target == merged.end())
+    {
+      merged[path + name] = std::move(object);
+    }
+    else if (!mergeObject(target->second.get(), object.get()))
+    {
+      WARNING(std::string("Object ") + path + name + " cannot be merged, keeping the one from the first file");
+    }
+  }
+}
+
+/**
+ * @brief Write the objects to the file, creating the directories given in their paths.
+ */
+void JPetHadd::writeObjects(const MergedObjects& objects, TFile& outputFile)
+{
+  for (const auto& object : objects)
+  {
+    TDirectory* directory = &outputFile;
+    auto separator = object.first.rfind('/');
+    std::string name = object.first.substr(separator == std::string::npos ? 0 : separator + 1);
+    if (separator != std::string::npos)
+    {
+      std::string path = object.first.substr(0, separator);
+      directory = outputFile.GetDirectory(path.c_str());
+      if (!directory)
+      {
+        outputFile.mkdir(path.c_str());
+        directory = outputFile.GetDirectory(path.c_str());
+      }
+    }
+    directory->WriteTObject(object.second.get(), name.c_str(), "Overwrite");
+  }
+}
+
+/**
+ * @brief Merge source into target using the Merge method of the class, as TFileMerger does.
+ */
+bool JPetHadd::mergeObject(TObject* target, TObject* source)
+{
+  if (!target || !source || target->IsA() != source->IsA())
+  {
+    return false;
+  }
+  TList list;
+  list.Add(source);
+  auto mergeFunction = target->IsA()->GetMerge();
+  if (mergeFunction)
+  {
+    mergeFunction(target, &list, nullptr);
+    return true;
+  }
+  if (!target->IsA()->GetMethodWithPrototype("Merge", "TCollection*"))
+  {
+    return false;
+  }
+  Int_t error = 0;
+  target->Execute("Merge", Form("(TCollection*)%p", static_cast<void*>(&list)), &error);
+  return error == 0;
+}
+
+/**
+ * @brief Append the processing stages of the source missing in the target.
+ */
+void JPetHadd::mergeStageHistory(JPetTreeHeader& target, const JPetTreeHeader& source)
+{
+  for (int i = 0; i < source.getStagesNb(); i++)
+  {
+    const auto& stage = source.getProcessingStageInfo(i);
+    bool isPresent = false;
+    for (int j = 0; j < target.getStagesNb() && !isPresent; j++)
+    {
+      isPresent = isSameStage(stage, target.getProcessingStageInfo(j));
+    }
+    if (!isPresent)
+    {
+      target.addStageInfo(stage.fModuleName, stage.fModuleDescription, stage.fModuleVersion, stage.fCreationTime);
+    }
+  }
+}
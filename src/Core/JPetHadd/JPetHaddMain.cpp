@@ -0,0 +1,73 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHaddMain.cpp
+ *  @brief Command line merging tool: JPetHadd [-j nbOfThreads] output.root input1.root input2.root ...
+ */
+
+#include "JPetHadd/JPetHadd.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+int printUsage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-f] [-j nbOfThreads] output.root input1.root [input2.root ...]" << std::endl;
+  return 1;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned int nbOfThreads = 0;
+  bool isForceOverwrite = false;
+  std::vector<std::string> fileNames;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument = argv[i];
+    if (argument == "-j")
+    {
+      if (i + 1 >= argc)
+      {
+        return printUsage(argv[0]);
+      }
+      try
+      {
+        nbOfThreads = std::stoul(argv[++i]);
+      }
+      catch (const std::exception&)
+      {
+        std::cerr << "Invalid number of threads: " << argv[i] << std::endl;
+        return printUsage(argv[0]);
+      }
+    }
+    else if (argument == "-f")
+    {
+      isForceOverwrite = true;
+    }
+    else
+    {
+      fileNames.push_back(argument);
+    }
+  }
+  if (fileNames.size() < 2)
+  {
+    return printUsage(argv[0]);
+  }
+  JPetHadd hadd(fileNames.front());
+  hadd.setNumberOfThreads(nbOfThreads);
+  hadd.setForceOverwrite(isForceOverwrite);
+  return hadd.merge(std::vector<std::string>(fileNames.begin() + 1, fileNames.end())) ? 0 : 1;
+}
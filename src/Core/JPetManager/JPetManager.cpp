@@ -21,6 +21,7 @@
 #include "JPetOptionsGenerator/JPetOptionsGenerator.h"
 #include "JPetTaskChainExecutor/JPetTaskChainExecutor.h"
 
+#include <TROOT.h>
 #include <TThread.h>
 #include <cassert>
 #include <exception>
@@ -38,6 +39,8 @@ JPetManager& JPetManager::getManager()
 
 void JPetManager::run(int argc, const char** argv)
 {
+  /// The tasks, readers and writers use threads, ROOT must be prepared before any of them is started
+  ROOT::EnableThreadSafety();
   bool isOk = true;
   std::map<std::string, boost::any> allValidatedOptions;
   std::tie(isOk, allValidatedOptions) = parseCmdLine(argc, argv);
@@ -15,6 +15,7 @@
 
 #include "JPetReader/JPetReader.h"
 #include "JPetUserInfoStructure/JPetUserInfoStructure.h"
+#include <TClass.h>
 #include <cassert>
 
 /**
@@ -39,6 +40,11 @@ JPetReader::~JPetReader()
     delete fFile;
     fFile = 0;
   }
+  if (fMCEntry)
+  {
+    delete fMCEntry;
+    fMCEntry = nullptr;
+  }
 }
 
 JPetReader::MyEvent& JPetReader::getCurrentEntry()
@@ -50,7 +56,7 @@ JPetReader::MyEvent& JPetReader::getCurrentEntry()
   else
   {
     ERROR("Could not read the current event");
-    if (fEntry)
+    if (fEntry && fEntry != fMCEntry)
     {
       delete fEntry;
     }
@@ -101,6 +107,9 @@ void JPetReader::closeFile()
   if (fFile)
     delete fFile;
   fFile = 0;
+  if (fMCEntry)
+    delete fMCEntry;
+  fMCEntry = nullptr;
   fBranch = 0;
   fEntry = 0;
   fTree = 0;
@@ -137,15 +146,59 @@ bool JPetReader::loadData(const char* treename)
     ERROR("in reading tree");
     return false;
   }
+  if (!setupBranches())
+  {
+    ERROR("in reading branch from tree");
+    return false;
+  }
+  firstEntry();
+  return true;
+}
+
+/**
+ * @brief Set the address of the first branch of the tree, which contains the entries.
+ *
+ * If the MC truth is stored in separate branches, the entry is a JPetTimeWindowMC owned by the reader,
+ * with the MC truth branches bound to its arrays. They are excluded from reading the whole tree entry
+ * and read by the window itself. The window branch is bound with a pointer of its own class:
+ * a JPetTimeWindow branch reads into the JPetTimeWindow base of the entry.
+ */
+bool JPetReader::setupBranches()
+{
   TObjArray* arr = fTree->GetListOfBranches();
   fBranch = (TBranch*)(arr->At(0));
   if (!fBranch)
   {
-    ERROR("in reading branch from tree");
     return false;
   }
+  auto mcHitsBranch = fTree->GetBranch(JPetTimeWindowMC::kMCHitsBranchName);
+  auto decayTreesBranch = fTree->GetBranch(JPetTimeWindowMC::kDecayTreesBranchName);
+  if (mcHitsBranch || decayTreesBranch)
+  {
+    auto windowClass = TClass::GetClass(fBranch->GetClassName());
+    if (windowClass != JPetTimeWindow::Class() && windowClass != JPetTimeWindowMC::Class())
+    {
+      ERROR(std::string("The MC truth branches are stored next to a branch of class ") + fBranch->GetClassName()
+            + " instead of JPetTimeWindow");
+      return false;
+    }
+    if (!fMCEntry)
+    {
+      fMCEntry = new JPetTimeWindowMC();
+    }
+    fEntry = fMCEntry;
+    fMCEntry->setMCTruthBranches(mcHitsBranch, decayTreesBranch);
+    if (mcHitsBranch)
+      fTree->SetBranchStatus(JPetTimeWindowMC::kMCHitsBranchName, false);
+    if (decayTreesBranch)
+      fTree->SetBranchStatus(JPetTimeWindowMC::kDecayTreesBranchName, false);
+    if (windowClass == JPetTimeWindow::Class())
+    {
+      fWindowEntry = fMCEntry;
+      return fTree->SetBranchAddress(fBranch->GetName(), &fWindowEntry) >= 0;
+    }
+  }
   fBranch->SetAddress(&fEntry);
-  firstEntry();
   return true;
 }
 
@@ -193,6 +246,10 @@ bool JPetReader::loadCurrentEntry()
   if (fTree)
   {
     int entryCode = fTree->GetEntry(fCurrentEntryNumber);
+    if (fMCEntry && isCorrectTreeEntryCode(entryCode))
+    {
+      fMCEntry->setMCTruthEntry(fCurrentEntryNumber);
+    }
     return isCorrectTreeEntryCode(entryCode);
   }
   return false;
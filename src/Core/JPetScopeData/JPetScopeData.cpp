@@ -17,4 +17,20 @@
 
 JPetScopeData::JPetScopeData(const std::pair<int, std::map<std::string, int>>& event) : fEvent(event) {}
 
+JPetScopeData::JPetScopeData(const std::pair<int, std::map<std::string, int>>& event, std::map<std::string, JPetRecoSignal>&& signals)
+    : fEvent(event), fSignals(std::move(signals))
+{
+}
+
 std::pair<int, std::map<std::string, int>> JPetScopeData::getEvent() const { return fEvent; }
+
+const std::map<std::string, JPetRecoSignal>& JPetScopeData::getSignals() const { return fSignals; }
+
+/**
+ * @brief Returns the signal parsed from the file, which can be moved out, or nullptr if it was not parsed.
+ */
+JPetRecoSignal* JPetScopeData::findSignal(const std::string& fileName) const
+{
+  auto signal = fSignals.find(fileName);
+  return signal == fSignals.end() ? nullptr : &signal->second;
+}
@@ -0,0 +1,153 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamReader.cpp
+ */
+
+#include "JPetStreamReader/JPetStreamReader.h"
+#include <limits>
+
+JPetStreamReader::JPetStreamReader(std::shared_ptr<JPetStreamedFile> stream) : fStream(stream) {}
+
+/**
+ * @brief Wait for the first part of the data and load it.
+ *
+ * The file name is only used in the messages, the parts are taken from the stream.
+ * Returns false if the producer finished without publishing any part
+ * or if the first part cannot be read.
+ */
+bool JPetStreamReader::openFileAndLoadData(const char* filename, const char* treename)
+{
+  closeFile();
+  if (!filename)
+  {
+    ERROR("empty file name");
+    return false;
+  }
+  if (!treename)
+  {
+    ERROR("empty tree name");
+    return false;
+  }
+  fTreeName = treename;
+  fIsComplete = false;
+  fIsFailed = false;
+  if (!addNextPart())
+  {
+    ERROR(std::string("No data was written to: ") + filename);
+    closeFile();
+    return false;
+  }
+  if (!fIsComplete)
+  {
+    INFO(std::string("Reading the data while it is being produced: ") + filename);
+  }
+  /// the first entry may be located in a further part if the leading ones are empty
+  if (!firstEntry() && !switchToFile(0))
+  {
+    closeFile();
+    return false;
+  }
+  return true;
+}
+
+bool JPetStreamReader::lastEntry()
+{
+  waitForEntry(std::numeric_limits<long long>::max());
+  return nthEntry(JPetChainReader::getNbOfAllEntries() - 1);
+}
+
+bool JPetStreamReader::nthEntry(long long n)
+{
+  waitForEntry(n);
+  return JPetChainReader::nthEntry(n);
+}
+
+/**
+ * @brief Returns the number of entries if the data is complete, the largest possible value otherwise.
+ *
+ * The latter is only an upper bound for the loops over entries, use isNbOfAllEntriesKnown()
+ * before presenting the number of entries.
+ */
+long long JPetStreamReader::getNbOfAllEntries() const
+{
+  return fIsComplete ? JPetChainReader::getNbOfAllEntries() : std::numeric_limits<long long>::max();
+}
+
+bool JPetStreamReader::isNbOfAllEntriesKnown() const { return fIsComplete; }
+
+bool JPetStreamReader::isInputValid() const { return !fIsFailed; }
+
+bool JPetStreamReader::isComplete() const { return fIsComplete; }
+
+/**
+ * @brief Wait until the part containing the entry n is published or the producer finishes.
+ * Returns true if the entry is available.
+ */
+bool JPetStreamReader::waitForEntry(long long n)
+{
+  while (n >= JPetChainReader::getNbOfAllEntries() && addNextPart())
+  {
+  }
+  return n >= 0 && n < JPetChainReader::getNbOfAllEntries();
+}
+
+/**
+ * @brief Wait for the next part and append its entries to the chain.
+ *
+ * Returns false and marks the data as complete if the producer finished without
+ * publishing the next part. A part which cannot be read ends the data as failed.
+ */
+bool JPetStreamReader::addNextPart()
+{
+  if (fIsComplete)
+  {
+    return false;
+  }
+  std::string partFileName;
+  if (!fStream->waitForPart(fFileNames.size(), partFileName))
+  {
+    fIsComplete = true;
+    fIsFailed = !fStream->isSuccessful();
+    if (fIsFailed)
+    {
+      ERROR(std::string("The writing of the data was not successful, it is incomplete: ") + fStream->getFileName());
+    }
+    return false;
+  }
+  std::unique_ptr<TFile> file(openFileForReading(partFileName));
+  auto tree = file ? dynamic_cast<TTree*>(file->Get(fTreeName.c_str())) : nullptr;
+  if (!tree)
+  {
+    ERROR(std::string("Cannot open file or read the tree: ") + partFileName);
+    fIsComplete = true;
+    fIsFailed = true;
+    return false;
+  }
+  if (fFirstEntryInFile.empty())
+  {
+    fFirstEntryInFile.push_back(0);
+  }
+  fFirstEntryInFile.push_back(fFirstEntryInFile.back() + tree->GetEntries());
+  fFileNames.push_back(partFileName);
+  if (fFileNames.size() == 1)
+  {
+    /// kept open until it is read, as the first file of the chain
+    fFirstFile = std::move(file);
+  }
+  else if (fCurrentFileIndex >= 0)
+  {
+    /// the current part was switched to before the next one was published
+    prefetchFile(fCurrentFileIndex + 1);
+  }
+  return true;
+}
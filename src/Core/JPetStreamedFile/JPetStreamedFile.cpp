@@ -0,0 +1,135 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamedFile.cpp
+ */
+
+#include "JPetStreamedFile/JPetStreamedFile.h"
+#include <boost/filesystem.hpp>
+
+JPetStreamedFile::JPetStreamedFile(const std::string& fileName) : fFileName(fileName) {}
+
+/**
+ * @brief Register the data as being produced. Data registered before under the same name is replaced.
+ */
+std::shared_ptr<JPetStreamedFile> JPetStreamedFile::start(const std::string& fileName)
+{
+  std::shared_ptr<JPetStreamedFile> file(new JPetStreamedFile(fileName));
+  std::lock_guard<std::mutex> lock(getRegistryMutex());
+  getRegistry()[getKey(fileName)] = file;
+  return file;
+}
+
+/**
+ * @brief Returns the data registered under the file name, nullptr if it is not produced in parts.
+ */
+std::shared_ptr<JPetStreamedFile> JPetStreamedFile::find(const std::string& fileName)
+{
+  std::lock_guard<std::mutex> lock(getRegistryMutex());
+  auto file = getRegistry().find(getKey(fileName));
+  if (file == getRegistry().end())
+  {
+    return nullptr;
+  }
+  return file->second;
+}
+
+const std::string& JPetStreamedFile::getFileName() const { return fFileName; }
+
+/**
+ * @brief Publish the next part of the data. The file must be complete and closed. Wakes up all waiting readers.
+ */
+void JPetStreamedFile::addPart(const std::string& partFileName)
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fPartFileNames.push_back(partFileName);
+  }
+  fProgress.notify_all();
+}
+
+/**
+ * @brief Mark the data as complete. Wakes up all waiting readers.
+ */
+void JPetStreamedFile::finish(bool isSuccessful)
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fIsFinished = true;
+    fIsSuccessful = isSuccessful;
+  }
+  fProgress.notify_all();
+}
+
+bool JPetStreamedFile::isFinished() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fIsFinished;
+}
+
+bool JPetStreamedFile::isSuccessful() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fIsSuccessful;
+}
+
+/**
+ * @brief Wait until the part with the given index is published or the producer finishes.
+ *
+ * Returns true and the name of the part if it is published, false if the producer
+ * finished without publishing it.
+ */
+bool JPetStreamedFile::waitForPart(std::size_t index, std::string& partFileName)
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fProgress.wait(lock, [this, index]() { return fIsFinished || index < fPartFileNames.size(); });
+  if (index >= fPartFileNames.size())
+  {
+    return false;
+  }
+  partFileName = fPartFileNames[index];
+  return true;
+}
+
+std::vector<std::string> JPetStreamedFile::getPartFileNames() const
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  return fPartFileNames;
+}
+
+/**
+ * @brief Absolute path without the "." elements, so that e.g. "./file.root" and "file.root" are the same key.
+ */
+std::string JPetStreamedFile::getKey(const std::string& fileName)
+{
+  boost::filesystem::path key;
+  for (const auto& element : boost::filesystem::absolute(fileName))
+  {
+    if (element != ".")
+    {
+      key /= element;
+    }
+  }
+  return key.string();
+}
+
+std::mutex& JPetStreamedFile::getRegistryMutex()
+{
+  static std::mutex registryMutex;
+  return registryMutex;
+}
+
+std::map<std::string, std::shared_ptr<JPetStreamedFile>>& JPetStreamedFile::getRegistry()
+{
+  static std::map<std::string, std::shared_ptr<JPetStreamedFile>> registry;
+  return registry;
+}
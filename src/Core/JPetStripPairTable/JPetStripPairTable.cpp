@@ -0,0 +1,61 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStripPairTable.cpp
+ */
+
+#include "JPetStripPairTable/JPetStripPairTable.h"
+#include "JPetDetectorGeometryCache/JPetDetectorGeometryCache.h"
+#include <cmath>
+#include <cstdlib>
+
+const int JPetStripPairTable::kDifferentLayers = -1;
+const double JPetStripPairTable::kSpeedOfLight = 0.0299792458;
+
+JPetStripPairTable::JPetStripPairTable(const JPetDetectorGeometryCache& geometry) : fSize(geometry.getSize())
+{
+  const auto& layersSizes = geometry.getLayersSizes();
+  const auto& centerX = geometry.getCenterX();
+  const auto& centerY = geometry.getCenterY();
+  const auto& length = geometry.getLength();
+  auto pairsCount = fSize * (fSize + 1) / 2;
+  fDeltaID.resize(pairsCount);
+  fDistance.resize(pairsCount);
+  fMaxTOF.resize(pairsCount);
+  for (std::size_t second = 0; second < fSize; second++)
+  {
+    for (std::size_t first = 0; first <= second; first++)
+    {
+      auto pairIndex = getPairIndex(first, second);
+      auto layer = geometry.getLayerNumber()[first];
+      if (layer != geometry.getLayerNumber()[second])
+      {
+        fDeltaID[pairIndex] = kDifferentLayers;
+      }
+      else
+      {
+        int deltaID = std::abs(geometry.getSlotNumber()[first] - geometry.getSlotNumber()[second]);
+        int layerSize = layersSizes[layer - 1];
+        fDeltaID[pairIndex] = deltaID > layerSize / 2 ? layerSize - deltaID : deltaID;
+      }
+      auto distance = std::hypot(centerX[first] - centerX[second], centerY[first] - centerY[second]);
+      auto maxDistanceZ = (length[first] + length[second]) / 2.;
+      fDistance[pairIndex] = distance;
+      fMaxTOF[pairIndex] = std::hypot(distance, maxDistanceZ) / kSpeedOfLight;
+    }
+  }
+}
+
+/**
+ * @brief Returns the number of the scintillators in the table.
+ */
+std::size_t JPetStripPairTable::getSize() const { return fSize; }
@@ -14,9 +14,15 @@
  */
 
 #include "JPetTaskIO/JPetInputHandler.h"
+#include "JPetChainReader/JPetChainReader.h"
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetStreamReader/JPetStreamReader.h"
 #include "JPetTaskIO/JPetTaskIOTools.h"
+#include <limits>
+
+const std::string JPetInputHandler::kTimeRangeMinOptName = "timeRangeMin_double";
+const std::string JPetInputHandler::kTimeRangeMaxOptName = "timeRangeMax_double";
 
 JPetInputHandler::JPetInputHandler() { fReader = jpet_common_tools::make_unique<JPetReader>(); }
 
@@ -24,8 +30,9 @@ bool JPetInputHandler::openInput(const char* inputFilename, const JPetParams& pa
 {
   using namespace jpet_options_tools;
   auto options = params.getOptions();
-  if (fReader->openFileAndLoadData(inputFilename, JPetReader::kRootTreeName.c_str()))
+  if (openReader(inputFilename, options))
   {
+    loadEntryIndex();
     /// For all types of files which has not hld format we assume
     /// that we can read paramBank from the file.
     if (FileTypeChecker::getInputFileType(options) != FileTypeChecker::kHldRoot &&
@@ -49,12 +56,51 @@ bool JPetInputHandler::openInput(const char* inputFilename, const JPetParams& pa
   return true;
 }
 
+/**
+ * @brief Open the input file or, if the chained input is requested,
+ * all input files as one logical input.
+ *
+ * The input files of the chain are converted to the data type of the given input file name.
+ * If the streamUnpacking_bool option is set and the input is produced in parts
+ * by the previous task (see JPetStreamedFile), it is read with JPetStreamReader,
+ * which waits for the parts not published yet.
+ */
+bool JPetInputHandler::openReader(const char* inputFilename, const jpet_options_tools::OptsStrAny& options)
+{
+  using namespace jpet_options_tools;
+  if (isChainInputFiles(options))
+  {
+    auto dataType = JPetCommonTools::extractDataTypeFromFileName(inputFilename);
+    std::vector<std::string> inputFiles;
+    for (const auto& file : getInputFiles(options))
+    {
+      inputFiles.push_back(JPetCommonTools::replaceDataTypeInFileName(file, dataType));
+    }
+    auto chainReader = jpet_common_tools::make_unique<JPetChainReader>();
+    bool isOpen = chainReader->openFilesAndLoadData(inputFiles, JPetReader::kRootTreeName.c_str());
+    fReader = std::move(chainReader);
+    if (isOpen)
+    {
+      INFO(Form("Processing %d input files as one chained input", static_cast<int>(inputFiles.size())));
+    }
+    return isOpen;
+  }
+  auto stream = isStreamUnpacking(options) ? JPetStreamedFile::find(inputFilename) : nullptr;
+  if (stream)
+  {
+    INFO(std::string("The input is produced by the previous task and will be read in parts: ") + inputFilename);
+    fReader = jpet_common_tools::make_unique<JPetStreamReader>(stream);
+  }
+  return fReader->openFileAndLoadData(inputFilename, JPetReader::kRootTreeName.c_str());
+}
+
 void JPetInputHandler::closeInput()
 {
   if (fReader)
   {
     fReader->closeFile();
   }
+  fEntryIndex.reset();
 }
 
 EntryRange JPetInputHandler::getEntryRange() const { return fEntryRange; }
@@ -73,6 +119,33 @@ bool JPetInputHandler::setEntryRange(const jpet_options_tools::OptsStrAny& optio
   fEntryRange.firstEntry = firstEntry;
   fEntryRange.lastEntry = lastEntry;
   fEntryRange.currentEntry = firstEntry;
+
+  using namespace jpet_options_tools;
+  fTimeRangeMin = std::numeric_limits<double>::lowest();
+  fTimeRangeMax = std::numeric_limits<double>::max();
+  if (isOptionSet(options, kTimeRangeMinOptName))
+  {
+    fTimeRangeMin = getOptionAsDouble(options, kTimeRangeMinOptName);
+  }
+  if (isOptionSet(options, kTimeRangeMaxOptName))
+  {
+    fTimeRangeMax = getOptionAsDouble(options, kTimeRangeMaxOptName);
+  }
+  if (fEntryIndex)
+  {
+    auto acceptedEntry = findAcceptedEntry(firstEntry);
+    if (acceptedEntry < 0)
+    {
+      WARNING("No entry in the requested range matches the selection, no entries will be processed");
+      fEntryRange.currentEntry = lastEntry + 1;
+      return true;
+    }
+    fEntryRange.currentEntry = acceptedEntry;
+  }
+  else if (isOptionSet(options, kTimeRangeMinOptName) || isOptionSet(options, kTimeRangeMaxOptName))
+  {
+    WARNING("Time range selection requested, but the input file does not contain an entry index. All entries will be processed");
+  }
   assert(fReader);
   return fReader->nthEntry(fEntryRange.currentEntry);
 }
@@ -101,13 +174,164 @@ TObject& JPetInputHandler::getEntry()
 
 bool JPetInputHandler::nextEntry()
 {
-  if (fEntryRange.currentEntry == fEntryRange.lastEntry)
+  if (fEntryRange.currentEntry >= fEntryRange.lastEntry)
   {
     return false;
   }
-  fEntryRange.currentEntry++;
   assert(fReader);
-  return fReader->nextEntry();
+  if (!fEntryIndex)
+  {
+    fEntryRange.currentEntry++;
+    return fReader->nextEntry();
+  }
+  auto acceptedEntry = findAcceptedEntry(fEntryRange.currentEntry + 1);
+  if (acceptedEntry < 0)
+  {
+    fEntryRange.currentEntry = fEntryRange.lastEntry;
+    return false;
+  }
+  fEntryRange.currentEntry = acceptedEntry;
+  return fReader->nthEntry(acceptedEntry);
+}
+
+/**
+ * @brief True if the entry range contains no entry to process,
+ * e.g. because none of the entries matched the selection.
+ */
+bool JPetInputHandler::isEntryRangeEmpty() const { return fEntryRange.currentEntry > fEntryRange.lastEntry; }
+
+/**
+ * @brief Returns false while the input is still being produced and the last entry of the range is only an upper bound.
+ */
+bool JPetInputHandler::isNbOfAllEntriesKnown() const { return !fReader || fReader->isNbOfAllEntriesKnown(); }
+
+/**
+ * @brief Returns false if the input turned out to be incomplete, e.g. because the previous task failed to write it.
+ */
+bool JPetInputHandler::isInputValid() const { return !fReader || fReader->isInputValid(); }
+
+bool JPetInputHandler::hasEntryIndex() const { return fEntryIndex != nullptr; }
+
+const JPetEntryIndex* JPetInputHandler::getEntryIndex() const { return fEntryIndex.get(); }
+
+/**
+ * @brief Set the predicate used to select entries based on their summary.
+ *
+ * Entries for which the predicate returns false are skipped by nextEntry()
+ * and setEntryRange() without being read from the tree.
+ * The predicate is ignored if the input file has no entry index.
+ */
+void JPetInputHandler::setEntryPredicate(EntryPredicate predicate) { fEntryPredicate = predicate; }
+
+/**
+ * @brief Move to the first accepted entry in the entry range which contains
+ * objects at or after the given time.
+ *
+ * Returns false if the input has no entry index or no such entry exists,
+ * in which case the current entry is not changed.
+ */
+bool JPetInputHandler::seekToTime(double time)
+{
+  if (!fEntryIndex)
+  {
+    WARNING("Cannot seek by time, the input file does not contain an entry index");
+    return false;
+  }
+  auto entry = fEntryIndex->findFirstEntryAtTime(time, fEntryRange.firstEntry, fEntryRange.lastEntry);
+  if (entry < 0)
+  {
+    return false;
+  }
+  entry = findAcceptedEntry(entry);
+  if (entry < 0)
+  {
+    return false;
+  }
+  fEntryRange.currentEntry = entry;
+  assert(fReader);
+  return fReader->nthEntry(entry);
+}
+
+/**
+ * @brief Read the entry index stored next to the tree, if present.
+ *
+ * The index is ignored if the number of summaries does not match the number
+ * of entries in the tree, e.g. for files merged by tools not aware of the index.
+ */
+bool JPetInputHandler::loadEntryIndex()
+{
+  fEntryIndex.reset();
+  auto reader = dynamic_cast<JPetReader*>(fReader.get());
+  if (!reader)
+  {
+    return false;
+  }
+  if (dynamic_cast<JPetChainReader*>(reader))
+  {
+    DEBUG("The entry index is not used for the chained input");
+    return false;
+  }
+  auto index = dynamic_cast<JPetEntryIndex*>(reader->getObjectFromFile(JPetEntryIndex::kIndexName.c_str()));
+  if (!index)
+  {
+    DEBUG("No entry index found in the input file");
+    return false;
+  }
+  if (static_cast<long long>(index->getNumberOfEntries()) != fReader->getNbOfAllEntries())
+  {
+    WARNING("The entry index does not match the number of entries in the tree, it will be ignored");
+    delete index;
+    return false;
+  }
+  fEntryIndex.reset(index);
+  return true;
+}
+
+bool JPetInputHandler::isEntryAccepted(long long entry) const
+{
+  if (!fEntryIndex)
+  {
+    return true;
+  }
+  const auto& summary = fEntryIndex->getSummary(entry);
+  if (!summary.overlapsTime(fTimeRangeMin, fTimeRangeMax))
+  {
+    return false;
+  }
+  return !fEntryPredicate || fEntryPredicate(summary);
+}
+
+/**
+ * @brief Returns the first accepted entry in [from, lastEntry] or -1 if there is none.
+ *
+ * If the entries are ordered in time, the entries outside of the time range
+ * are skipped with a binary search in the index, and only the entries
+ * in the time range are checked with the predicate.
+ */
+long long JPetInputHandler::findAcceptedEntry(long long from) const
+{
+  if (!fEntryIndex)
+  {
+    return from <= fEntryRange.lastEntry ? from : -1;
+  }
+  bool isTimeRangeSet = fTimeRangeMin > std::numeric_limits<double>::lowest() || fTimeRangeMax < std::numeric_limits<double>::max();
+  bool isSearchedByTime = isTimeRangeSet && fEntryIndex->isTimeOrdered();
+  for (auto entry = from; entry <= fEntryRange.lastEntry; entry++)
+  {
+    if (isSearchedByTime && !fEntryIndex->getSummary(entry).overlapsTime(fTimeRangeMin, fTimeRangeMax))
+    {
+      entry = fEntryIndex->findFirstEntryInTimeRange(fTimeRangeMin, fTimeRangeMax, entry, fEntryRange.lastEntry);
+      if (entry < 0)
+      {
+        return -1;
+      }
+    }
+    if (isEntryAccepted(entry))
+    {
+      return entry;
+    }
+  }
+  return -1;
 }
 
 long long JPetInputHandler::getCurrentEntryNumber() const
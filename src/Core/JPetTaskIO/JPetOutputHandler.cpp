@@ -14,16 +14,57 @@
  */
 
 #include "JPetTaskIO/JPetOutputHandler.h"
+#include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetTaskIO/version.h"
 #include "JPetTimeWindowMC/JPetTimeWindowMC.h"
 #include "JPetTreeHeader/JPetTreeHeader.h"
 #include "JPetUserTask/JPetUserTask.h"
 #include "JPetWriter/JPetWriter.h"
+#include <TH1.h>
+#include <THashTable.h>
 #include <cassert>
+#include <fstream>
 
-JPetOutputHandler::JPetOutputHandler() : fWriter("defaultOutput.root") {}
+JPetOutputHandler::JPetOutputHandler() : fWriter(jpet_common_tools::make_unique<JPetWriter>("defaultOutput.root")) {}
 
-JPetOutputHandler::JPetOutputHandler(const char* outputFilename) : fWriter(outputFilename) {}
+JPetOutputHandler::JPetOutputHandler(const char* outputFilename)
+    : fWriter(jpet_common_tools::make_unique<JPetWriter>(outputFilename)), fOutputFilename(outputFilename)
+{
+}
+
+/**
+ * @brief Output to the file or, if any of the splitting options is set, to the consecutive parts of it.
+ */
+JPetOutputHandler::JPetOutputHandler(const char* outputFilename, const jpet_options_tools::OptsStrAny& options)
+    : fOutputFilename(outputFilename)
+{
+  using namespace jpet_options_tools;
+  fIsEntryIndexSaved = isSaveEntryIndex(options);
+  fSplitWindows = getOutputSplitWindows(options);
+  fSplitBytes = getOutputSplitSizeMB(options) * 1024ll * 1024ll;
+  fSplitTimeSpan = getOutputSplitTimeSpan(options);
+  if (fSplitWindows > 0 || fSplitBytes > 0 || fSplitTimeSpan > 0.)
+  {
+    fPartFileNames.push_back(getPartFileName(fOutputFilename, 0));
+    fWriter = jpet_common_tools::make_unique<JPetWriter>(fPartFileNames.back().c_str());
+  }
+  else
+  {
+    fWriter = jpet_common_tools::make_unique<JPetWriter>(outputFilename);
+  }
+}
+
+/**
+ * @brief Set the objects saved in every part of the split output when it is closed.
+ */
+void JPetOutputHandler::setPartContent(JPetParamManager* manager, JPetTreeHeader* header, JPetStatistics* statistics,
+                                       std::map<std::string, std::unique_ptr<JPetStatistics>>* subTasksStatistics)
+{
+  fParamManager = manager;
+  fHeader = header;
+  fStatistics = statistics;
+  fSubTasksStatistics = subTasksStatistics;
+}
 
 void JPetOutputHandler::saveOutput(JPetParamManager& manager, JPetTreeHeader* fHeader, JPetStatistics* fStatistics,
                                    std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics)
@@ -31,16 +72,35 @@ void JPetOutputHandler::saveOutput(JPetParamManager& manager, JPetTreeHeader* fH
   assert(fHeader);
   assert(fStatistics);
 
-  fWriter.writeHeader(fHeader);
-  fWriter.writeCollection(fStatistics->getStatsTable(), "Main Task Stats");
-  for (auto it = fSubTasksStatistics.begin(); it != fSubTasksStatistics.end(); it++)
+  if (isSplit())
+  {
+    fHeader->setVariable("Output part", std::to_string(fPartFileNames.size() - 1));
+    if (!writeManifest())
+    {
+      ERROR("Could not write the manifest of the output parts: " + getManifestFileName(fOutputFilename));
+    }
+  }
+  savePart(manager, fHeader, fStatistics, fSubTasksStatistics);
+  manager.clearParameters();
+}
+
+void JPetOutputHandler::savePart(JPetParamManager& manager, JPetTreeHeader* header, JPetStatistics* statistics,
+                                 std::map<std::string, std::unique_ptr<JPetStatistics>>& subTasksStatistics)
+{
+  fWriter->writeHeader(header);
+  fWriter->writeCollection(statistics->getStatsTable(), "Main Task Stats");
+  for (auto it = subTasksStatistics.begin(); it != subTasksStatistics.end(); it++)
   {
     if (it->second)
-      fWriter.writeCollection(it->second->getStatsTable(), it->first.c_str());
+      fWriter->writeCollection(it->second->getStatsTable(), it->first.c_str());
+  }
+  if (fIsEntryIndexSaved)
+  {
+    fWriter->writeObject(&fEntryIndex, JPetEntryIndex::kIndexName.c_str());
   }
+  fEntryIndex.Clear();
   // store the parametric objects in the ouptut ROOT file
-  manager.saveParametersToFile(&fWriter);
-  manager.clearParameters();
+  manager.saveParametersToFile(fWriter.get());
 }
 
 bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
@@ -51,15 +111,37 @@ bool JPetOutputHandler::writeEventToFile(JPetTaskInterface* task)
   if (pOutputEntry != nullptr)
   {
     auto pInputEvent = dynamic_cast<JPetTimeWindowMC*>(pUserTask->getInputEvents());
+    if ((pInputEvent == nullptr) && (pOutputEntry->getNumberOfEvents() == 0))
+    {
+      return true;
+    }
+    /// Without the index only the split by time needs the summary
+    JPetEntryIndex::EntrySummary summary;
+    if (fIsEntryIndexSaved || fSplitTimeSpan > 0.)
+    {
+      summary = JPetEntryIndex::summarize(*pOutputEntry, !fIsEntryIndexSaved);
+    }
+    if (isSplit() && isPartFull(summary) && !startNextPart())
+    {
+      return false;
+    }
     if ((pInputEvent != nullptr))
     {
-      fWriter.write(JPetTimeWindowMC(*pInputEvent, *pOutputEntry));
+      fWriter->writeWithMCTruth(*pOutputEntry, *pInputEvent);
     }
     else
     {
-      if(pOutputEntry->getNumberOfEvents() > 0){
-        fWriter.write(*pOutputEntry);
-      }
+      fWriter->write(*pOutputEntry);
+    }
+    if (fIsEntryIndexSaved)
+    {
+      fEntryIndex.addSummary(summary);
+    }
+    fPartWindowsCount++;
+    if (!fIsPartStartTimeSet && summary.hasTime())
+    {
+      fPartStartTime = summary.fStartTime;
+      fIsPartStartTimeSet = true;
     }
   }
   else
@@ -75,5 +157,120 @@ void JPetOutputHandler::saveAndCloseOutput(JPetParamManager& manager, JPetTreeHe
                                            std::map<std::string, std::unique_ptr<JPetStatistics>>& fSubTasksStatistics)
 {
   saveOutput(manager, fHeader, fStatistics, fSubTasksStatistics);
-  fWriter.closeFile();
+  fWriter->closeFile();
+}
+
+bool JPetOutputHandler::isSplit() const { return !fPartFileNames.empty(); }
+
+/**
+ * @brief Names of the parts written so far, empty if the output is not split.
+ */
+const std::vector<std::string>& JPetOutputHandler::getPartFileNames() const { return fPartFileNames; }
+
+/**
+ * @brief Name of the part, e.g. dir/file_0002.hit.root for dir/file.hit.root
+ *
+ * The number is inserted before the data type, so the type can still be extracted from the name.
+ */
+std::string JPetOutputHandler::getPartFileName(const std::string& outputFilename, int partNumber)
+{
+  auto fileNameStart = outputFilename.rfind('/');
+  fileNameStart = fileNameStart == std::string::npos ? 0 : fileNameStart + 1;
+  auto typeStart = outputFilename.find('.', fileNameStart);
+  auto partName = outputFilename;
+  return partName.insert(typeStart == std::string::npos ? partName.size() : typeStart, Form("_%04d", partNumber));
+}
+
+std::string JPetOutputHandler::getManifestFileName(const std::string& outputFilename)
+{
+  const std::string rootSuffix = ".root";
+  auto manifestName = outputFilename;
+  if (manifestName.size() >= rootSuffix.size() && manifestName.compare(manifestName.size() - rootSuffix.size(), rootSuffix.size(), rootSuffix) == 0)
+  {
+    manifestName.erase(manifestName.size() - rootSuffix.size());
+  }
+  return manifestName + ".manifest";
+}
+
+/**
+ * @brief Checks, before the given window is written, if any of the splitting limits is reached.
+ */
+bool JPetOutputHandler::isPartFull(const JPetEntryIndex::EntrySummary& summary) const
+{
+  if (fPartWindowsCount == 0)
+  {
+    return false;
+  }
+  if (fSplitWindows > 0 && fPartWindowsCount >= fSplitWindows)
+  {
+    return true;
+  }
+  if (fSplitBytes > 0 && fWriter->getBytesWritten() >= fSplitBytes)
+  {
+    return true;
+  }
+  return fSplitTimeSpan > 0. && fIsPartStartTimeSet && summary.hasTime() && summary.fEndTime - fPartStartTime > fSplitTimeSpan;
+}
+
+/**
+ * @brief Save and close the current part and open the next one.
+ *
+ * The histograms are detached from the closed file, since they are still filled
+ * and saved in the following parts.
+ */
+bool JPetOutputHandler::startNextPart()
+{
+  if (!fParamManager || !fHeader || !fStatistics || !fSubTasksStatistics)
+  {
+    ERROR("The content of the output parts is not set, cannot split the output");
+    return false;
+  }
+  /// the header is owned by the tree of the closed part
+  auto header = new JPetTreeHeader(*fHeader);
+  header->setVariable("Output part", std::to_string(fPartFileNames.size() - 1));
+  savePart(*fParamManager, header, fStatistics, *fSubTasksStatistics);
+  std::vector<const THashTable*> statsTables = {fStatistics->getStatsTable()};
+  for (const auto& subTaskStatistics : *fSubTasksStatistics)
+  {
+    if (subTaskStatistics.second)
+      statsTables.push_back(subTaskStatistics.second->getStatsTable());
+  }
+  for (auto table : statsTables)
+  {
+    TIter next(table);
+    while (auto object = next())
+    {
+      if (auto histogram = dynamic_cast<TH1*>(object))
+        histogram->SetDirectory(nullptr);
+    }
+  }
+  fWriter->closeFile();
+  fPartFileNames.push_back(getPartFileName(fOutputFilename, fPartFileNames.size()));
+  fWriter = jpet_common_tools::make_unique<JPetWriter>(fPartFileNames.back().c_str());
+  fIsPartStartTimeSet = false;
+  fPartWindowsCount = 0;
+  if (!fWriter->isOpen())
+  {
+    ERROR("Could not open the next part of the output: " + fPartFileNames.back());
+    return false;
+  }
+  INFO("Output continued in the file: " + fPartFileNames.back());
+  return true;
+}
+
+/**
+ * @brief Write the list of the parts, one file name per line.
+ */
+bool JPetOutputHandler::writeManifest() const
+{
+  std::ofstream manifest(getManifestFileName(fOutputFilename));
+  if (!manifest)
+  {
+    return false;
+  }
+  for (const auto& partFileName : fPartFileNames)
+  {
+    manifest << partFileName << std::endl;
+  }
+  return manifest.good();
 }
@@ -18,6 +18,7 @@
 #include "JPetData/JPetData.h"
 #include "JPetLoggerInclude.h"
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetParamResolver/JPetParamResolver.h"
 #include "JPetTask/JPetTask.h"
 #include "JPetTaskIO/JPetTaskIOTools.h"
 #include "JPetTaskIO/version.h"
@@ -84,6 +85,10 @@ bool JPetTaskIO::init(const JPetParams& params)
   return true;
 }
 
+/**
+ * The param bank is bound to JPetParamResolver while the events are processed,
+ * so the references of the data objects read from the input are resolved with it.
+ */
 bool JPetTaskIO::run(const JPetDataInterface&)
 {
   using namespace jpet_options_tools;
@@ -92,6 +97,7 @@ bool JPetTaskIO::run(const JPetDataInterface&)
     ERROR("No subTask set");
     return false;
   }
+  JPetParamResolver::Binding paramBankBinding(getParamManager().getParamBankAsShared());
   if (isInput())
   {
     if (!fInputHandler)
@@ -121,9 +127,15 @@ bool JPetTaskIO::run(const JPetDataInterface&)
         ERROR("Some error occured in setEntryRange");
         return false;
       }
+      if (isProgressBarOn && !fInputHandler->isNbOfAllEntriesKnown())
+      {
+        INFO("The number of entries is unknown while the input is being produced, the progress bar of " + subTaskName + " is disabled.");
+        isProgressBarOn = false;
+      }
       auto lastEvent = fInputHandler->getLastEntryNumber();
       assert(lastEvent >= 0);
-      do
+      bool isEntryAvailable = !fInputHandler->isEntryRangeEmpty();
+      while (isEntryAvailable)
       {
         if (isProgressBarOn)
         {
@@ -144,7 +156,13 @@ bool JPetTaskIO::run(const JPetDataInterface&)
             return false;
           }
         }
-      } while (fInputHandler->nextEntry());
+        isEntryAvailable = fInputHandler->nextEntry();
+      }
+      if (!fInputHandler->isInputValid())
+      {
+        ERROR("The input of " + subTaskName + " is incomplete, the previous task failed to write it.");
+        return false;
+      }
     }
     else
     {
@@ -192,6 +210,11 @@ bool JPetTaskIO::terminate(JPetParams& output_params)
       return false;
     }
     fOutputHandler->saveAndCloseOutput(getParamManager(), fHeader, fStatistics.get(), fSubTasksStatistics);
+    if (fOutputHandler->isSplit())
+    {
+      auto newOpts = JPetTaskIOTools::setSplitOutputOptions(output_params.getOptions(), fOutputHandler->getPartFileNames());
+      output_params = JPetParams(newOpts, output_params.getParamManagerAsShared());
+    }
   }
   if (isInput())
   {
@@ -227,14 +250,15 @@ JPetParams JPetTaskIO::mergeWithExtraParams(const JPetParams& oldParams, const J
 {
   using namespace jpet_options_tools;
   using namespace jpet_options_generator_tools;
-  auto oldOpts = oldParams.getOptions();
-  auto extraOpts = extraParams.getOptions();
+  const auto& extraOpts = extraParams.getOptions();
   // @todo this is hardcoded and should be moved somewhere.
   const std::string stopIterationOptName = "StopIteration_bool";
-  if (isOptionSet(extraOpts, stopIterationOptName))
+  if (!isOptionSet(extraOpts, stopIterationOptName))
   {
-    oldOpts[stopIterationOptName] = getOptionValue(extraOpts, stopIterationOptName);
+    return oldParams;
   }
+  auto oldOpts = oldParams.getOptions();
+  oldOpts[stopIterationOptName] = getOptionValue(extraOpts, stopIterationOptName);
   return JPetParams(oldOpts, oldParams.getParamManagerAsShared());
 }
 
@@ -269,14 +293,14 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
     ERROR("isOutput set to false and you are trying to createOutputObjects");
     return false;
   }
-  fOutputHandler = jpet_common_tools::make_unique<JPetOutputHandler>(outputFilename);
+  using namespace jpet_options_tools;
+  auto options = fParams.getOptions();
+  fOutputHandler = jpet_common_tools::make_unique<JPetOutputHandler>(outputFilename, options);
   if (!fOutputHandler)
   {
     ERROR("OutputHandler is not set, cannot creat output file.");
     return false;
   }
-  using namespace jpet_options_tools;
-  auto options = fParams.getOptions();
 
   if (FileTypeChecker::getInputFileType(options) == FileTypeChecker::kHldRoot ||
       FileTypeChecker::getInputFileType(options) == FileTypeChecker::kMCGeant)
@@ -328,6 +352,7 @@ bool JPetTaskIO::createOutputObjects(const char* outputFilename)
   {
     WARNING("the subTask does not exist, so JPetStatistics not passed to it");
   }
+  fOutputHandler->setPartContent(&getParamManager(), fHeader, fStatistics.get(), &fSubTasksStatistics);
   return true;
 }
 
@@ -128,7 +128,20 @@ OptsStrAny setOutputOptions(const JPetParams& oldParams, bool resetOutputPath, c
     jpet_options_generator_tools::setOutputPath(new_opts, "");
   }
   jpet_options_generator_tools::setOutputFile(new_opts, fullOutPath);
+  // the chained input files are merged into one output file, read by the next task
+  if (jpet_options_tools::isChainInputFiles(new_opts))
+  {
+    jpet_options_generator_tools::setChainInputFiles(new_opts, false);
+  }
+
+  return new_opts;
+}
 
+OptsStrAny setSplitOutputOptions(const OptsStrAny& outputOptions, const std::vector<std::string>& partFileNames)
+{
+  OptsStrAny new_opts = outputOptions;
+  jpet_options_generator_tools::setChainInputFiles(new_opts, true);
+  jpet_options_generator_tools::setInputFiles(new_opts, partFileNames);
   return new_opts;
 }
 
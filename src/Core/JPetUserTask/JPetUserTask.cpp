@@ -21,6 +21,7 @@ JPetUserTask::JPetUserTask(const char* name) : JPetTask(name) {}
 bool JPetUserTask::init(const JPetParams& inOptions)
 {
   fParams = inOptions;
+  fDetectorGeometry.reset();
   return init();
 }
 
@@ -54,6 +55,22 @@ const JPetParamBank& JPetUserTask::getParamBank()
   return paramManager->getParamBank();
 }
 
+/**
+ * Returns the geometry of the detector computed from the param bank.
+ * It is computed once and shared by all the tasks using the same param bank.
+ */
+const JPetDetectorGeometryCache& JPetUserTask::getDetectorGeometry()
+{
+  if (!fDetectorGeometry)
+  {
+    auto paramManager = fParams.getParamManager();
+    assert(paramManager);
+    fDetectorGeometry = JPetDetectorGeometryCache::getGeometry(paramManager->getParamBankAsShared());
+  }
+  assert(fDetectorGeometry);
+  return *fDetectorGeometry;
+}
+
 void JPetUserTask::setStatistics(JPetStatistics* statistics) { fStatistics = statistics; }
 
 JPetStatistics& JPetUserTask::getStatistics()
@@ -66,7 +83,7 @@ void JPetUserTask::setEvent(TObject* ev) { fEvent = ev; }
 
 JPetTimeWindow* JPetUserTask::getInputEvents() { return dynamic_cast<JPetTimeWindow*>(fEvent); }
 
-jpet_options_tools::OptsStrAny JPetUserTask::getOptions() const { return fParams.getOptions(); }
+const jpet_options_tools::OptsStrAny& JPetUserTask::getOptions() const { return fParams.getOptions(); }
 
 JPetTimeWindow* JPetUserTask::getOutputEvents() { return fOutputEvents; }
 
@@ -62,6 +62,54 @@ void JPetWriter::closeFile()
   }
   fFileName.clear();
   fIsBranchCreated = false;
+  fIsMCTruthBranchCreated = false;
+  fWindowClass = nullptr;
+}
+
+/**
+ * @brief Write the window together with the MC truth of the given MC window, without copying any of them.
+ *
+ * The window is stored in the regular branch and the MC hits and decay trees in separate TClonesArray
+ * branches (JPetTimeWindowMC::kMCHitsBranchName and kDecayTreesBranchName), split by data members
+ * and with the StreamerInfo of their classes in the file. The branches are created at the first call,
+ * the window branch with the class of the given window, and bound to the member pointers, which are
+ * only redirected to the given objects at every call. The objects are taken by non-const reference,
+ * since ROOT reads them through these pointers, but they are not modified.
+ */
+bool JPetWriter::writeWithMCTruth(JPetTimeWindow& window, JPetTimeWindowMC& mcTruth)
+{
+  if (!isOpen())
+  {
+    ERROR("Could not write to file. Have you closed it already?");
+    return false;
+  }
+  if (fIsBranchCreated && !fIsMCTruthBranchCreated)
+  {
+    ERROR("Could not write the MC truth, the tree was created without the MC truth branches.");
+    return false;
+  }
+  fFile->cd();
+  fWindow = &window;
+  fMCHits = &mcTruth.getMCHitsArray();
+  fDecayTrees = &mcTruth.getDecayTreesArray();
+  if (!fIsBranchCreated)
+  {
+    assert(fTree);
+    fTree->Branch(fWindow->GetName(), fWindow->IsA()->GetName(), &fWindow);
+    fTree->Branch(JPetTimeWindowMC::kMCHitsBranchName, &fMCHits);
+    fTree->Branch(JPetTimeWindowMC::kDecayTreesBranchName, &fDecayTrees);
+    fWindowClass = fWindow->IsA();
+    fIsBranchCreated = true;
+    fIsMCTruthBranchCreated = true;
+  }
+  else if (fWindow->IsA() != fWindowClass)
+  {
+    ERROR(std::string("Could not write a window of class ") + fWindow->IsA()->GetName() + " to the branch of class "
+          + fWindowClass->GetName());
+    return false;
+  }
+  fTree->Fill();
+  return true;
 }
 
 void JPetWriter::writeHeader(TObject* header)
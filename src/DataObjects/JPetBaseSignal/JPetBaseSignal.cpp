@@ -14,6 +14,7 @@
  */
 
 #include "JPetBaseSignal/JPetBaseSignal.h"
+#include "JPetLoggerInclude.h"
 
 ClassImp(JPetBaseSignal);
 
@@ -44,8 +45,45 @@ JPetBaseSignal& JPetBaseSignal::getDummyResult()
   return dummyResult;
 }
 
+/**
+ * @brief Obtain a reference to the PhotoMultiplier parametric object
+ */
+const JPetPM& JPetBaseSignal::getPM() const
+{
+  if (auto pm = JPetParamResolver::resolve(fPMPointer, fPointerGeneration, fPMID, fPM))
+  {
+    return *pm;
+  }
+  else
+  {
+    ERROR("No JPetPM slot set, Null object will be returned");
+    return JPetPM::getDummyResult();
+  }
+}
+
+/**
+ * @brief Obtain a reference to the BarrelSlot parametric object related
+ */
+const JPetBarrelSlot& JPetBaseSignal::getBarrelSlot() const
+{
+  if (auto barrelSlot = JPetParamResolver::resolve(fBarrelSlotPointer, fPointerGeneration, fBarrelSlotID, fBarrelSlot))
+  {
+    return *barrelSlot;
+  }
+  else
+  {
+    ERROR("No JPetBarrelSlot slot set, Null object will be returned");
+    return JPetBarrelSlot::getDummyResult();
+  }
+}
+
 void JPetBaseSignal::Clear(Option_t*)
 {
   fBarrelSlot = NULL;
   fPM = NULL;
+  fBarrelSlotID = JPetParamResolver::kNoID;
+  fPMID = JPetParamResolver::kNoID;
+  fBarrelSlotPointer = nullptr;
+  fPMPointer = nullptr;
+  fFlag = JPetBaseSignal::Unknown;
 }
@@ -15,6 +15,7 @@
 
 #include "JPetEvent/JPetEvent.h"
 #include "JPetAnalysisTools/JPetAnalysisTools.h"
+#include <utility>
 
 ClassImp(JPetEvent);
 
@@ -25,6 +26,11 @@ JPetEvent::JPetEvent(const std::vector<JPetHit>& hits, JPetEventType eventType,
   setHits(hits, orderedByTime);
 }
 
+JPetEvent::JPetEvent(std::vector<JPetHit>&& hits, JPetEventType eventType, bool orderedByTime) : TObject(), fType(eventType)
+{
+  setHits(std::move(hits), orderedByTime);
+}
+
 void JPetEvent::setRecoFlag(JPetEvent::RecoFlag flag) { fFlag = flag; }
 
 JPetEvent::RecoFlag JPetEvent::getRecoFlag() const { return fFlag; }
@@ -35,13 +41,23 @@ JPetEvent::RecoFlag JPetEvent::getRecoFlag() const { return fFlag; }
  */
 void JPetEvent::setHits(const std::vector<JPetHit>& hits, bool orderedByTime)
 {
+  fHits = hits;
   if (orderedByTime)
   {
-    fHits = JPetAnalysisTools::getHitsOrderedByTime(hits);
+    JPetAnalysisTools::sortHitsByTime(fHits);
   }
-  else
+}
+
+/**
+ * Move the whole vector of hits to this event, without copying the hits.
+ * If requested, the hits are ordered by time in place.
+ */
+void JPetEvent::setHits(std::vector<JPetHit>&& hits, bool orderedByTime)
+{
+  fHits = std::move(hits);
+  if (orderedByTime)
   {
-    fHits = hits;
+    JPetAnalysisTools::sortHitsByTime(fHits);
   }
 }
 
@@ -50,6 +66,11 @@ void JPetEvent::setHits(const std::vector<JPetHit>& hits, bool orderedByTime)
  */
 void JPetEvent::addHit(const JPetHit& hit) { fHits.push_back(hit); }
 
+/**
+ * Moving hit to the event, this method does not sort nor order added hits by time.
+ */
+void JPetEvent::addHit(JPetHit&& hit) { fHits.push_back(std::move(hit)); }
+
 /**
  * Get vector of hits from this event.
  */
@@ -30,7 +30,8 @@ JPetHit::JPetHit() : TObject(), fFlag(JPetHit::Unknown) {}
 JPetHit::JPetHit(float energy, float qualityOfEnergy, float time, float qualityOfTime, TVector3& position, JPetPhysSignal& signalA,
                  JPetPhysSignal& signalB, JPetBarrelSlot& barreSlot, JPetScin& scin)
     : TObject(), fFlag(JPetHit::Unknown), fEnergy(energy), fQualityOfEnergy(qualityOfEnergy), fTime(time), fQualityOfTime(qualityOfTime),
-      fPos(position), fSignalA(signalA), fSignalB(signalB), fBarrelSlot(&barreSlot), fScintillator(&scin)
+      fPos(position), fSignalA(signalA), fSignalB(signalB), fBarrelSlotID(barreSlot.getID()), fScintillatorID(scin.getID()), fBarrelSlotPointer(&barreSlot),
+      fScintillatorPointer(&scin), fPointerGeneration(JPetParamResolver::getBindingGeneration())
 {
   fIsSignalAset = true;
   fIsSignalBset = true;
@@ -131,8 +132,8 @@ const JPetPhysSignal& JPetHit::getSignalB() const { return fSignalB; }
  */
 const JPetScin& JPetHit::getScintillator() const
 {
-  if (fScintillator.GetObject())
-    return (JPetScin&)*fScintillator.GetObject();
+  if (auto scintillator = JPetParamResolver::resolve(fScintillatorPointer, fPointerGeneration, fScintillatorID, fScintillator))
+    return *scintillator;
   else
   {
     ERROR("No JPetScin slot set, Null object will be returned");
@@ -145,8 +146,8 @@ const JPetScin& JPetHit::getScintillator() const
  */
 const JPetBarrelSlot& JPetHit::getBarrelSlot() const
 {
-  if (fBarrelSlot.GetObject())
-    return (JPetBarrelSlot&)*fBarrelSlot.GetObject();
+  if (auto barrelSlot = JPetParamResolver::resolve(fBarrelSlotPointer, fPointerGeneration, fBarrelSlotID, fBarrelSlot))
+    return *barrelSlot;
   else
   {
     ERROR("No JPetBarrelSlot slot set, Null object will be returned");
@@ -168,6 +169,16 @@ bool JPetHit::isSignalASet() const { return fIsSignalAset; }
  */
 bool JPetHit::isSignalBSet() const { return fIsSignalBset; }
 
+/**
+ * Check if the scintillator reference is set and can be resolved
+ */
+bool JPetHit::isScintillatorSet() const { return JPetParamResolver::resolve(fScintillatorPointer, fPointerGeneration, fScintillatorID, fScintillator) != nullptr; }
+
+/**
+ * Check if the barrel slot reference is set and can be resolved
+ */
+bool JPetHit::isBarrelSlotSet() const { return JPetParamResolver::resolve(fBarrelSlotPointer, fPointerGeneration, fBarrelSlotID, fBarrelSlot) != nullptr; }
+
 /**
  * Set the reconstruction flag with enum
  */
@@ -226,12 +237,22 @@ void JPetHit::setPos(float x, float y, float z) { fPos.SetXYZ(x, y, z); }
 /**
  * Set the barrel slot object for this hit
  */
-void JPetHit::setBarrelSlot(JPetBarrelSlot& bs) { fBarrelSlot = &bs; }
+void JPetHit::setBarrelSlot(JPetBarrelSlot& bs)
+{
+  JPetParamResolver::updateGeneration(fPointerGeneration, fBarrelSlotPointer, fScintillatorPointer);
+  fBarrelSlotPointer = &bs;
+  fBarrelSlotID = bs.getID();
+}
 
 /**
  * Set the scintillator object for this hit
  */
-void JPetHit::setScintillator(JPetScin& sc) { fScintillator = &sc; }
+void JPetHit::setScintillator(JPetScin& sc)
+{
+  JPetParamResolver::updateGeneration(fPointerGeneration, fBarrelSlotPointer, fScintillatorPointer);
+  fScintillatorPointer = &sc;
+  fScintillatorID = sc.getID();
+}
 
 /**
  * @brief Checks consistency of the hit object
@@ -340,7 +361,8 @@ void JPetHit::setSignalB(const JPetPhysSignal& p_sig)
 void JPetHit::setMCindex(unsigned int i) { fMCindex = i; }
 
 /**
- * Set values of the hit to zero/false/null
+ * Set values of the hit to zero/false/null.
+ * The signals are cleared in place, so that their containers keep the allocated memory.
  */
 void JPetHit::Clear(Option_t*)
 {
@@ -351,11 +373,15 @@ void JPetHit::Clear(Option_t*)
   fTimeDiff = 0.0f;
   fQualityOfTimeDiff = 0.0f;
   fPos = TVector3();
-  fSignalA = JPetPhysSignal();
-  fSignalB = JPetPhysSignal();
+  fSignalA.Clear();
+  fSignalB.Clear();
   fIsSignalAset = false;
   fIsSignalBset = false;
   fBarrelSlot = NULL;
   fScintillator = NULL;
+  fBarrelSlotID = JPetParamResolver::kNoID;
+  fScintillatorID = JPetParamResolver::kNoID;
+  fBarrelSlotPointer = nullptr;
+  fScintillatorPointer = nullptr;
   fMCindex = 0u;
 }
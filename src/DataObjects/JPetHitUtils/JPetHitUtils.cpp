@@ -14,29 +14,99 @@
  */
 
 #include "JPetHitUtils/JPetHitUtils.h"
+#include "JPetSignalBatch/JPetSignalBatch.h"
 
 #include <limits>
 
 const double JPetHitUtils::Unset = -std::numeric_limits<double>::infinity();
 
-double JPetHitUtils::getTimeDiffAtThr(const JPetHit& hit, int thr)
+namespace
+{
+/**
+ * Leading times of the signals A and B at the threshold number, returns false if any of them is missing.
+ * If the threshold indices of both signals are complete the times are taken from the index,
+ * otherwise from the maps, which are empty for the signals with doubled thresholds.
+ */
+bool getLeadingTimesAtThr(const JPetHit& hit, int thr, double& timeA, double& timeB)
 {
-  std::map<int, double> lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
+  const JPetRawSignal& signalA = hit.getSignalA().getRecoSignal().getRawSignal();
+  const JPetRawSignal& signalB = hit.getSignalB().getRecoSignal().getRawSignal();
+  if (signalA.isThresholdIndexComplete(JPetSigCh::Leading) && signalB.isThresholdIndexComplete(JPetSigCh::Leading))
+  {
+    if (thr < 1 || thr > static_cast<int>(JPetRawSignal::kNumberOfThresholds) || !signalA.hasPoint(JPetSigCh::Leading, thr) ||
+        !signalB.hasPoint(JPetSigCh::Leading, thr))
+    {
+      return false;
+    }
+    timeA = signalA.getTime(JPetSigCh::Leading, thr);
+    timeB = signalB.getTime(JPetSigCh::Leading, thr);
+    return true;
+  }
+  std::map<int, double> lead_times_A = signalA.getTimesVsThresholdNumber(JPetSigCh::Leading);
+  std::map<int, double> lead_times_B = signalB.getTimesVsThresholdNumber(JPetSigCh::Leading);
   if (lead_times_B.count(thr) > 0 && lead_times_A.count(thr) > 0)
   {
-    return lead_times_A[thr] - lead_times_B[thr];
+    timeA = lead_times_A[thr];
+    timeB = lead_times_B[thr];
+    return true;
+  }
+  return false;
+}
+}
+
+double JPetHitUtils::getTimeDiffAtThr(const JPetHit& hit, int thr)
+{
+  double timeA = 0.;
+  double timeB = 0.;
+  if (getLeadingTimesAtThr(hit, thr, timeA, timeB))
+  {
+    return timeA - timeB;
   }
   return Unset;
 }
 
 double JPetHitUtils::getTimeAtThr(const JPetHit& hit, int thr)
 {
-  std::map<int, double> lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  if (lead_times_B.count(thr) > 0 && lead_times_A.count(thr) > 0)
+  double timeA = 0.;
+  double timeB = 0.;
+  if (getLeadingTimesAtThr(hit, thr, timeA, timeB))
   {
-    return 0.5 * (lead_times_A[thr] + lead_times_B[thr]);
+    return 0.5 * (timeA + timeB);
   }
   return Unset;
 }
+
+/**
+ * @brief Times and A-B time differences at the threshold of the hit candidates of a whole time window.
+ *
+ * The raw signals of the window are paired by barrel slot with JPetSignalBatch::fill()
+ * and for every pair the barrel slot ID, the time as given by getTimeAtThr() and the time difference
+ * as given by getTimeDiffAtThr() are stored. The values of the pairs without the leading points
+ * at the threshold are Unset. Returns false if the window does not contain raw signals
+ * or the threshold number is wrong.
+ */
+bool JPetHitUtils::getTimesAtThr(const JPetTimeWindow& rawSignals, int thr, std::vector<int>& barrelSlotIDs,
+                                 std::vector<double>& times, std::vector<double>& timeDiffs)
+{
+  JPetSignalBatch sideA;
+  JPetSignalBatch sideB;
+  if (thr < 1 || !JPetSignalBatch::fill(rawSignals, sideA, sideB, &barrelSlotIDs) ||
+      !JPetSignalBatch::computeMeanTime(sideA, sideB, thr, times) ||
+      !JPetSignalBatch::computeTimeDiffAB(sideA, sideB, thr, timeDiffs))
+  {
+    barrelSlotIDs.clear();
+    times.clear();
+    timeDiffs.clear();
+    return false;
+  }
+  for (std::size_t i = 0; i < times.size(); i++)
+  {
+    /// NaN is the only value not equal to itself
+    if (times[i] != times[i])
+    {
+      times[i] = Unset;
+      timeDiffs[i] = Unset;
+    }
+  }
+  return true;
+}
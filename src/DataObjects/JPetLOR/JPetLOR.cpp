@@ -36,6 +36,17 @@ JPetLOR::JPetLOR(float Time, float QualityOfTime, JPetHit& firstHit, JPetHit& se
   fIsHitSet[1] = true;
 }
 
+/**
+ * Constructor taking over the hits without copying them
+ */
+JPetLOR::JPetLOR(float Time, float QualityOfTime, JPetHit&& firstHit, JPetHit&& secondHit)
+    : TObject(), fTime(Time), fQualityOfTime(QualityOfTime), fTimeDiff(0.0f), fQualityOfTimeDiff(0.0f), fFirstHit(std::move(firstHit)),
+      fSecondHit(std::move(secondHit))
+{
+  fIsHitSet[0] = true;
+  fIsHitSet[1] = true;
+}
+
 /**
  * Destructor
  */
@@ -86,6 +97,17 @@ void JPetLOR::setHits(const JPetHit& firstHit, const JPetHit& secondHit)
   fIsHitSet[1] = true;
 }
 
+/**
+ * Move both hits to this event at once.
+ */
+void JPetLOR::setHits(JPetHit&& firstHit, JPetHit&& secondHit)
+{
+  fFirstHit = std::move(firstHit);
+  fSecondHit = std::move(secondHit);
+  fIsHitSet[0] = true;
+  fIsHitSet[1] = true;
+}
+
 /**
  * Set the hit, that is first in time.
  */
@@ -95,6 +117,15 @@ void JPetLOR::setFirstHit(const JPetHit& firstHit)
   fIsHitSet[0] = true;
 }
 
+/**
+ * Move the hit, that is first in time.
+ */
+void JPetLOR::setFirstHit(JPetHit&& firstHit)
+{
+  fFirstHit = std::move(firstHit);
+  fIsHitSet[0] = true;
+}
+
 /**
  * Set the hit, that is second in time.
  */
@@ -104,6 +135,15 @@ void JPetLOR::setSecondHit(const JPetHit& secondHit)
   fIsHitSet[1] = true;
 }
 
+/**
+ * Move the hit, that is second in time.
+ */
+void JPetLOR::setSecondHit(JPetHit&& secondHit)
+{
+  fSecondHit = std::move(secondHit);
+  fIsHitSet[1] = true;
+}
+
 /**
  * Set LOR time difference.
  */
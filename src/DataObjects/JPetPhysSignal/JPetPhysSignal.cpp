@@ -48,13 +48,14 @@ void JPetPhysSignal::setRecoSignal(const JPetRecoSignal& recoSignal)
 }
 
 /**
- * Clear the signals values (set all to zero/null)
+ * Clear the signals values (set all to zero/null), the reconstructed signal is cleared in place
  */
 void JPetPhysSignal::Clear(Option_t*)
 {
+  JPetBaseSignal::Clear();
   fTime = 0.;
   fQualityOfTime = 0.;
   fPhe = 0.;
   fQualityOfPhe = 0.;
-  fRecoSignal = JPetRecoSignal();
+  fRecoSignal.Clear();
 }
@@ -14,18 +14,68 @@
  */
 
 #include "JPetRawSignal/JPetRawSignal.h"
+#include <cassert>
+#include <thread>
 
 ClassImp(JPetRawSignal);
 
+const unsigned int JPetRawSignal::kNumberOfThresholds;
+
 /**
  * @brief Constructor
  *
  * @param Maximal number of points probed at one edge of the signal (defalult = 4)
  */
-JPetRawSignal::JPetRawSignal(const int points)
+JPetRawSignal::JPetRawSignal(const int points): fThresholdIndexState(kIndexNotBuilt)
 {
   fLeadingPoints.reserve(points);
   fTrailingPoints.reserve(points);
+  buildThresholdIndex();
+}
+
+/**
+ * @brief The copy and move operations build the index of the new signal.
+ *
+ * The moved-from signal has its index rebuilt at the next access.
+ */
+JPetRawSignal::JPetRawSignal(const JPetRawSignal& other):
+  JPetBaseSignal(other), fLeadingPoints(other.fLeadingPoints), fTrailingPoints(other.fTrailingPoints),
+  fThresholdIndexState(kIndexNotBuilt)
+{
+  buildThresholdIndex();
+}
+
+JPetRawSignal::JPetRawSignal(JPetRawSignal&& other):
+  JPetBaseSignal(std::move(other)), fLeadingPoints(std::move(other.fLeadingPoints)),
+  fTrailingPoints(std::move(other.fTrailingPoints)), fThresholdIndexState(kIndexNotBuilt)
+{
+  buildThresholdIndex();
+  other.fThresholdIndexState.store(kIndexNotBuilt, std::memory_order_release);
+}
+
+JPetRawSignal& JPetRawSignal::operator=(const JPetRawSignal& other)
+{
+  if (this != &other)
+  {
+    JPetBaseSignal::operator=(other);
+    fLeadingPoints = other.fLeadingPoints;
+    fTrailingPoints = other.fTrailingPoints;
+    buildThresholdIndex();
+  }
+  return *this;
+}
+
+JPetRawSignal& JPetRawSignal::operator=(JPetRawSignal&& other)
+{
+  if (this != &other)
+  {
+    JPetBaseSignal::operator=(std::move(other));
+    fLeadingPoints = std::move(other.fLeadingPoints);
+    fTrailingPoints = std::move(other.fTrailingPoints);
+    buildThresholdIndex();
+    other.fThresholdIndexState.store(kIndexNotBuilt, std::memory_order_release);
+  }
+  return *this;
 }
 
 /**
@@ -62,13 +112,16 @@ int JPetRawSignal::getNumberOfPoints(JPetSigCh::EdgeType edge) const
  */
 void JPetRawSignal::addPoint(const JPetSigCh& sigch)
 {
+  ensureThresholdIndex();
   if (sigch.getType() == JPetSigCh::Trailing)
   {
     fTrailingPoints.push_back(sigch);
+    indexPoint(getEdgeIndex(JPetSigCh::Trailing), fTrailingPoints.size() - 1, sigch);
   }
   else if (sigch.getType() == JPetSigCh::Leading)
   {
     fLeadingPoints.push_back(sigch);
+    indexPoint(getEdgeIndex(JPetSigCh::Leading), fLeadingPoints.size() - 1, sigch);
   }
 }
 
@@ -87,6 +140,20 @@ void JPetRawSignal::addPoint(const JPetSigCh& sigch)
  */
 std::vector<JPetSigCh> JPetRawSignal::getPoints(JPetSigCh::EdgeType edge, JPetRawSignal::PointsSortOrder order) const
 {
+  bool isIndexOrdered = order == JPetRawSignal::ByThrNum ? isThresholdIndexComplete(edge) : areThresholdValuesIncreasing(edge);
+  if (isIndexOrdered)
+  {
+    std::vector<JPetSigCh> sorted;
+    sorted.reserve(getNumberOfPoints(edge));
+    for (unsigned int thrNum = 1; thrNum <= kNumberOfThresholds; thrNum++)
+    {
+      if (hasPoint(edge, thrNum))
+      {
+        sorted.push_back(getPoint(edge, thrNum));
+      }
+    }
+    return sorted;
+  }
   std::vector<JPetSigCh> sorted = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
   if (order == JPetRawSignal::ByThrNum)
   {
@@ -105,6 +172,17 @@ std::vector<JPetSigCh> JPetRawSignal::getPoints(JPetSigCh::EdgeType edge, JPetRa
 std::map<int, double> JPetRawSignal::getTimesVsThresholdNumber(JPetSigCh::EdgeType edge) const
 {
   std::map<int, double> thrToTime;
+  if (isThresholdIndexComplete(edge))
+  {
+    for (unsigned int thrNum = 1; thrNum <= kNumberOfThresholds; thrNum++)
+    {
+      if (hasPoint(edge, thrNum))
+      {
+        thrToTime.emplace_hint(thrToTime.end(), thrNum, getTime(edge, thrNum));
+      }
+    }
+    return thrToTime;
+  }
   const std::vector<JPetSigCh>& vec = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
   for (std::vector<JPetSigCh>::const_iterator it = vec.begin(); it != vec.end(); ++it)
   {
@@ -128,6 +206,17 @@ std::map<int, double> JPetRawSignal::getTimesVsThresholdNumber(JPetSigCh::EdgeTy
 std::map<int, std::pair<float, float>> JPetRawSignal::getTimesVsThresholdValue(JPetSigCh::EdgeType edge) const
 {
   std::map<int, std::pair<float, float>> thrToTime;
+  if (isThresholdIndexComplete(edge))
+  {
+    for (unsigned int thrNum = 1; thrNum <= kNumberOfThresholds; thrNum++)
+    {
+      if (hasPoint(edge, thrNum))
+      {
+        thrToTime.emplace_hint(thrToTime.end(), thrNum, std::make_pair(getThresholdValue(edge, thrNum), getTime(edge, thrNum)));
+      }
+    }
+    return thrToTime;
+  }
   const std::vector<JPetSigCh>& vec = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
   for (std::vector<JPetSigCh>::const_iterator it = vec.begin(); it != vec.end(); ++it)
   {
@@ -151,9 +240,20 @@ std::map<int, std::pair<float, float>> JPetRawSignal::getTimesVsThresholdValue(J
 std::map<int, double> JPetRawSignal::getTOTsVsThresholdNumber() const
 {
   std::map<int, double> thrToTOT;
-  for (auto leading : fLeadingPoints)
+  if (isThresholdIndexComplete(JPetSigCh::Leading) && isThresholdIndexComplete(JPetSigCh::Trailing))
   {
-    for (auto trailing : fTrailingPoints)
+    for (unsigned int thrNum = 1; thrNum <= kNumberOfThresholds; thrNum++)
+    {
+      if (hasTOT(thrNum))
+      {
+        thrToTOT.emplace_hint(thrToTOT.end(), thrNum, getTOT(thrNum));
+      }
+    }
+    return thrToTOT;
+  }
+  for (const auto& leading : fLeadingPoints)
+  {
+    for (const auto& trailing : fTrailingPoints)
     {
       if (leading.getThresholdNumber() == trailing.getThresholdNumber())
       {
@@ -171,9 +271,20 @@ std::map<int, double> JPetRawSignal::getTOTsVsThresholdNumber() const
 std::map<int, double> JPetRawSignal::getTOTsVsThresholdValue() const
 {
   std::map<int, double> thrToTOT;
-  for (auto leading : fLeadingPoints)
+  if (areThresholdValuesUnique())
+  {
+    for (unsigned int thrNum = 1; thrNum <= kNumberOfThresholds; thrNum++)
+    {
+      if (hasTOT(thrNum))
+      {
+        thrToTOT[static_cast<int>(getThresholdValue(JPetSigCh::Leading, thrNum))] = getTOT(thrNum);
+      }
+    }
+    return thrToTOT;
+  }
+  for (const auto& leading : fLeadingPoints)
   {
-    for (auto trailing : fTrailingPoints)
+    for (const auto& trailing : fTrailingPoints)
     {
       if (leading.getThreshold() == trailing.getThreshold())
       {
@@ -185,8 +296,201 @@ std::map<int, double> JPetRawSignal::getTOTsVsThresholdValue() const
   return thrToTOT;
 }
 
+/**
+ * @brief Removes all points keeping the capacity of the containers.
+ */
 void JPetRawSignal::Clear(Option_t*)
 {
+  JPetBaseSignal::Clear();
   fLeadingPoints.clear();
   fTrailingPoints.clear();
+  buildThresholdIndex();
+}
+
+/**
+ * @brief Checks if there is a point at the threshold with the given number on the edge.
+ */
+bool JPetRawSignal::hasPoint(JPetSigCh::EdgeType edge, unsigned int thrNum) const { return getPointIndex(edge, thrNum) >= 0; }
+
+/**
+ * @brief Returns the point at the threshold with the given number on the edge.
+ *
+ * There must be such a point, see hasPoint().
+ */
+const JPetSigCh& JPetRawSignal::getPoint(JPetSigCh::EdgeType edge, unsigned int thrNum) const
+{
+  auto index = getPointIndex(edge, thrNum);
+  assert(index >= 0);
+  return edge == JPetSigCh::Trailing ? fTrailingPoints[index] : fLeadingPoints[index];
+}
+
+/**
+ * @brief Returns the time [ps] at the threshold with the given number on the edge, or 0 if there is no such point.
+ */
+float JPetRawSignal::getTime(JPetSigCh::EdgeType edge, unsigned int thrNum) const
+{
+  return getPointIndex(edge, thrNum) >= 0 ? fTimes[getEdgeIndex(edge)][thrNum - 1] : 0.f;
+}
+
+/**
+ * @brief Returns the value [mV] of the threshold with the given number on the edge, or 0 if there is no such point.
+ */
+float JPetRawSignal::getThresholdValue(JPetSigCh::EdgeType edge, unsigned int thrNum) const
+{
+  return getPointIndex(edge, thrNum) >= 0 ? fThresholds[getEdgeIndex(edge)][thrNum - 1] : 0.f;
+}
+
+/**
+ * @brief Checks if there are both leading and trailing points at the threshold with the given number.
+ */
+bool JPetRawSignal::hasTOT(unsigned int thrNum) const
+{
+  return hasPoint(JPetSigCh::Leading, thrNum) && hasPoint(JPetSigCh::Trailing, thrNum);
+}
+
+/**
+ * @brief Returns the TOT [ps] at the threshold with the given number, or 0 if there is no leading or trailing point.
+ */
+float JPetRawSignal::getTOT(unsigned int thrNum) const
+{
+  if (!hasTOT(thrNum))
+  {
+    return 0.f;
+  }
+  return getTime(JPetSigCh::Trailing, thrNum) - getTime(JPetSigCh::Leading, thrNum);
+}
+
+bool JPetRawSignal::isThresholdIndexComplete(JPetSigCh::EdgeType edge) const
+{
+  ensureThresholdIndex();
+  return fIsThresholdIndexCompleteForEdge[getEdgeIndex(edge)];
+}
+
+/**
+ * @brief Whether the index of the edge is complete and the threshold values grow
+ * with the threshold number, so the index is also sorted by the threshold value.
+ */
+bool JPetRawSignal::areThresholdValuesIncreasing(JPetSigCh::EdgeType edge) const
+{
+  if (!isThresholdIndexComplete(edge))
+  {
+    return false;
+  }
+  auto edgeIndex = getEdgeIndex(edge);
+  bool isPreviousSet = false;
+  float previous = 0.f;
+  for (unsigned int thr = 0; thr < kNumberOfThresholds; thr++)
+  {
+    if (fPointIndices[edgeIndex][thr] < 0)
+    {
+      continue;
+    }
+    if (isPreviousSet && !(previous < fThresholds[edgeIndex][thr]))
+    {
+      return false;
+    }
+    previous = fThresholds[edgeIndex][thr];
+    isPreviousSet = true;
+  }
+  return true;
+}
+
+/**
+ * @brief Whether the indices of both edges are complete and the threshold values identify
+ * the thresholds: two points have the same value (also rounded to int) if and only if
+ * they have the same threshold number. Then pairing the points by the threshold value
+ * is the same as pairing them by the threshold number.
+ */
+bool JPetRawSignal::areThresholdValuesUnique() const
+{
+  if (!isThresholdIndexComplete(JPetSigCh::Leading) || !isThresholdIndexComplete(JPetSigCh::Trailing))
+  {
+    return false;
+  }
+  for (int edgeA = 0; edgeA < 2; edgeA++)
+  {
+    for (unsigned int thrA = 0; thrA < kNumberOfThresholds; thrA++)
+    {
+      if (fPointIndices[edgeA][thrA] < 0)
+      {
+        continue;
+      }
+      for (int edgeB = 0; edgeB < 2; edgeB++)
+      {
+        for (unsigned int thrB = 0; thrB < kNumberOfThresholds; thrB++)
+        {
+          if (fPointIndices[edgeB][thrB] < 0)
+          {
+            continue;
+          }
+          float valueA = fThresholds[edgeA][thrA];
+          float valueB = fThresholds[edgeB][thrB];
+          bool isSameThreshold = thrA == thrB;
+          if (isSameThreshold != (valueA == valueB) || (!isSameThreshold && static_cast<int>(valueA) == static_cast<int>(valueB)))
+          {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Build the index of both edges from the vectors of points.
+ *
+ * Called from the constructors and the non-const methods, or by ensureThresholdIndex().
+ */
+void JPetRawSignal::buildThresholdIndex() const
+{
+  for (auto edge : {JPetSigCh::Trailing, JPetSigCh::Leading})
+  {
+    auto edgeIndex = getEdgeIndex(edge);
+    const auto& points = (edge == JPetSigCh::Trailing ? fTrailingPoints : fLeadingPoints);
+    std::fill(fPointIndices[edgeIndex], fPointIndices[edgeIndex] + kNumberOfThresholds, -1);
+    fIsThresholdIndexCompleteForEdge[edgeIndex] = true;
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+      indexPoint(edgeIndex, i, points[i]);
+    }
+  }
+  fThresholdIndexState.store(kIndexBuilt, std::memory_order_release);
+}
+
+/**
+ * @brief Build the index if it has been invalidated, i.e. the signal was read from a file.
+ *
+ * Only the thread that changes the state to kIndexBeingBuilt builds the index,
+ * the other ones wait until it is built.
+ */
+void JPetRawSignal::ensureThresholdIndex() const
+{
+  int state = fThresholdIndexState.load(std::memory_order_acquire);
+  if (state == kIndexBuilt)
+  {
+    return;
+  }
+  if (state == kIndexNotBuilt && fThresholdIndexState.compare_exchange_strong(state, kIndexBeingBuilt, std::memory_order_acq_rel))
+  {
+    buildThresholdIndex();
+    return;
+  }
+  while (fThresholdIndexState.load(std::memory_order_acquire) != kIndexBuilt)
+  {
+    std::this_thread::yield();
+  }
+}
+
+void JPetRawSignal::indexPoint(int edgeIndex, std::size_t pointIndex, const JPetSigCh& point) const
+{
+  auto thrNum = point.getThresholdNumber();
+  if (thrNum < 1 || thrNum > kNumberOfThresholds || fPointIndices[edgeIndex][thrNum - 1] >= 0)
+  {
+    fIsThresholdIndexCompleteForEdge[edgeIndex] = false;
+    return;
+  }
+  fPointIndices[edgeIndex][thrNum - 1] = pointIndex;
+  fTimes[edgeIndex][thrNum - 1] = point.getValue();
+  fThresholds[edgeIndex][thrNum - 1] = point.getThreshold();
 }
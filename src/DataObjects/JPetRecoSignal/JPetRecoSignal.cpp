@@ -86,15 +86,16 @@ void JPetRecoSignal::setRawSignal(const JPetRawSignal& rawSignal)
 }
 
 /**
- * Reset signal values to zero/null, clear arrays.
+ * Reset signal values to zero/null, clear arrays keeping their capacity.
  */
 void JPetRecoSignal::Clear(Option_t*)
 {
+  JPetBaseSignal::Clear();
   fShape.clear();
   fDelay = 0.;
   fAmplitude = 0.;
   fOffset = 0.;
   fCharge = 0.;
-  fRawSignal = JPetRawSignal();
+  fRawSignal.Clear();
   fRecoTimesAtThreshold.clear();
 }
@@ -79,9 +79,9 @@ int JPetSigCh::getDAQch() const { return fDAQch; }
  */
 const JPetPM& JPetSigCh::getPM() const
 {
-  if (fPM.GetObject())
+  if (auto object = JPetParamResolver::resolve(fPMPointer, fPointerGeneration, fPMID, fPM))
   {
-    return (JPetPM&)*fPM.GetObject();
+    return *object;
   }
   else
   {
@@ -95,9 +95,9 @@ const JPetPM& JPetSigCh::getPM() const
  */
 const JPetFEB& JPetSigCh::getFEB() const
 {
-  if (fFEB.GetObject())
+  if (auto object = JPetParamResolver::resolve(fFEBPointer, fPointerGeneration, fFEBID, fFEB))
   {
-    return (JPetFEB&)*fFEB.GetObject();
+    return *object;
   }
   else
   {
@@ -111,9 +111,9 @@ const JPetFEB& JPetSigCh::getFEB() const
  */
 const JPetTRB& JPetSigCh::getTRB() const
 {
-  if (fTRB.GetObject())
+  if (auto object = JPetParamResolver::resolve(fTRBPointer, fPointerGeneration, fTRBID, fTRB))
   {
-    return (JPetTRB&)*fTRB.GetObject();
+    return *object;
   }
   else
   {
@@ -127,9 +127,9 @@ const JPetTRB& JPetSigCh::getTRB() const
  */
 const JPetTOMBChannel& JPetSigCh::getTOMBChannel() const
 {
-  if (fTOMBChannel.GetObject())
+  if (auto object = JPetParamResolver::resolve(fTOMBChannelPointer, fPointerGeneration, fTOMBChannelID, fTOMBChannel))
   {
-    return (JPetTOMBChannel&)*fTOMBChannel.GetObject();
+    return *object;
   }
   else
   {
@@ -141,7 +141,7 @@ const JPetTOMBChannel& JPetSigCh::getTOMBChannel() const
 /**
  * A proxy method for quick access to DAQ channel number ignorantly of what a TOMBCHannel is
  */
-int JPetSigCh::getChannel() const { return getTOMBChannel().getChannel(); }
+int JPetSigCh::getChannel() const { return fTOMBChannelID != JPetParamResolver::kNoID ? fTOMBChannelID : getTOMBChannel().getChannel(); }
 
 /**
  * Set the reconstruction flag with enum
@@ -176,22 +176,42 @@ void JPetSigCh::setDAQch(int daq) { fDAQch = daq; }
 /**
  * Set the PM associated with this Signal Channel
  */
-void JPetSigCh::setPM(const JPetPM& pm) { fPM = const_cast<JPetPM*>(&pm); }
+void JPetSigCh::setPM(const JPetPM& pm)
+{
+  updatePointerGeneration();
+  fPMPointer = &pm;
+  fPMID = pm.getID();
+}
 
 /**
  * Set the FEB associated with this Signal Channel
  */
-void JPetSigCh::setFEB(const JPetFEB& feb) { fFEB = const_cast<JPetFEB*>(&feb); }
+void JPetSigCh::setFEB(const JPetFEB& feb)
+{
+  updatePointerGeneration();
+  fFEBPointer = &feb;
+  fFEBID = feb.getID();
+}
 
 /**
  * Set the TRB associated with this Signal Channel
  */
-void JPetSigCh::setTRB(const JPetTRB& trb) { fTRB = const_cast<JPetTRB*>(&trb); }
+void JPetSigCh::setTRB(const JPetTRB& trb)
+{
+  updatePointerGeneration();
+  fTRBPointer = &trb;
+  fTRBID = trb.getID();
+}
 
 /**
  * Set the TOMBChannel associated with this Signal Channel
  */
-void JPetSigCh::setTOMBChannel(const JPetTOMBChannel& channel) { fTOMBChannel = const_cast<JPetTOMBChannel*>(&channel); }
+void JPetSigCh::setTOMBChannel(const JPetTOMBChannel& channel)
+{
+  updatePointerGeneration();
+  fTOMBChannelPointer = &channel;
+  fTOMBChannelID = channel.getChannel();
+}
 
 /**
  * Compares two SigChs by their threshold value
@@ -206,6 +226,11 @@ bool JPetSigCh::compareByThresholdNumber(const JPetSigCh& sigA, const JPetSigCh&
   return sigA.getThresholdNumber() < sigB.getThresholdNumber();
 }
 
+void JPetSigCh::updatePointerGeneration()
+{
+  JPetParamResolver::updateGeneration(fPointerGeneration, fPMPointer, fFEBPointer, fTRBPointer, fTOMBChannelPointer);
+}
+
 void JPetSigCh::Clear(Option_t*)
 {
   fType = JPetSigCh::Leading;
@@ -218,4 +243,12 @@ void JPetSigCh::Clear(Option_t*)
   fFEB = NULL;
   fTRB = NULL;
   fTOMBChannel = NULL;
+  fPMID = JPetParamResolver::kNoID;
+  fFEBID = JPetParamResolver::kNoID;
+  fTRBID = JPetParamResolver::kNoID;
+  fTOMBChannelID = JPetParamResolver::kNoID;
+  fPMPointer = nullptr;
+  fFEBPointer = nullptr;
+  fTRBPointer = nullptr;
+  fTOMBChannelPointer = nullptr;
 }
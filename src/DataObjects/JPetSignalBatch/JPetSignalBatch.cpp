@@ -0,0 +1,280 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSignalBatch.cpp
+ */
+
+#include "JPetSignalBatch/JPetSignalBatch.h"
+#include "JPetLoggerInclude.h"
+#include "JPetTypedWindowView/JPetTypedWindowView.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace
+{
+const float kMissingTime = std::numeric_limits<float>::quiet_NaN();
+
+bool isThresholdNumberValid(unsigned int thrNum)
+{
+  if (thrNum < 1 || thrNum > JPetSignalBatch::kNumberOfThresholds)
+  {
+    ERROR("Wrong threshold number: " + std::to_string(thrNum));
+    return false;
+  }
+  return true;
+}
+
+bool haveSameSize(const JPetSignalBatch& sideA, const JPetSignalBatch& sideB)
+{
+  if (sideA.getSize() != sideB.getSize())
+  {
+    ERROR("Batches of the sides A and B have different sizes: " + std::to_string(sideA.getSize()) + " and " +
+          std::to_string(sideB.getSize()));
+    return false;
+  }
+  return true;
+}
+}
+
+void JPetSignalBatch::clear()
+{
+  fSize = 0;
+  for (unsigned int i = 0; i < kNumberOfThresholds; i++)
+  {
+    fLeadingTimes[i].clear();
+    fTrailingTimes[i].clear();
+  }
+}
+
+void JPetSignalBatch::reserve(std::size_t size)
+{
+  for (unsigned int i = 0; i < kNumberOfThresholds; i++)
+  {
+    fLeadingTimes[i].reserve(size);
+    fTrailingTimes[i].reserve(size);
+  }
+}
+
+std::size_t JPetSignalBatch::getSize() const { return fSize; }
+
+/**
+ * @brief Adds the times of the points of the signal at the end of the batch.
+ *
+ * The times of an edge are taken only if its threshold index is complete,
+ * the edges with doubled thresholds or other threshold numbers have only missing times,
+ * as the maps of JPetRawSignal are empty for the doubled thresholds.
+ */
+void JPetSignalBatch::add(const JPetRawSignal& signal)
+{
+  bool isLeadingComplete = signal.isThresholdIndexComplete(JPetSigCh::Leading);
+  bool isTrailingComplete = signal.isThresholdIndexComplete(JPetSigCh::Trailing);
+  for (unsigned int thrNum = 1; thrNum <= kNumberOfThresholds; thrNum++)
+  {
+    fLeadingTimes[thrNum - 1].push_back(isLeadingComplete && signal.hasPoint(JPetSigCh::Leading, thrNum)
+                                          ? signal.getTime(JPetSigCh::Leading, thrNum)
+                                          : kMissingTime);
+    fTrailingTimes[thrNum - 1].push_back(isTrailingComplete && signal.hasPoint(JPetSigCh::Trailing, thrNum)
+                                           ? signal.getTime(JPetSigCh::Trailing, thrNum)
+                                           : kMissingTime);
+  }
+  fSize++;
+}
+
+/**
+ * @brief Replaces the content of the batch with all the raw signals of the time window.
+ *
+ * Returns false and leaves the batch empty if the window does not contain raw signals.
+ */
+bool JPetSignalBatch::fill(const JPetTimeWindow& window)
+{
+  clear();
+  JPetTypedWindowView<const JPetRawSignal> signals(window);
+  if (!signals.isValid())
+  {
+    return window.getNumberOfEvents() == 0;
+  }
+  reserve(signals.size());
+  for (const auto& signal : signals)
+  {
+    add(signal);
+  }
+  return true;
+}
+
+/**
+ * @brief Replaces the content of the batches with the raw signals of the time window
+ * paired by barrel slot, the signals of the side A in sideA and of the side B in sideB.
+ *
+ * Within one barrel slot the k-th signal of the side A in the window is paired with
+ * the k-th signal of the side B, the signals without a partner are skipped,
+ * as are the signals without a barrel slot or a PM. The pairs are ordered by the barrel slot ID,
+ * which is stored for every pair in barrelSlotIDs, if given.
+ * Returns false and leaves the batches empty if the window does not contain raw signals.
+ */
+bool JPetSignalBatch::fill(const JPetTimeWindow& window, JPetSignalBatch& sideA, JPetSignalBatch& sideB,
+                           std::vector<int>* barrelSlotIDs)
+{
+  sideA.clear();
+  sideB.clear();
+  if (barrelSlotIDs)
+  {
+    barrelSlotIDs->clear();
+  }
+  JPetTypedWindowView<const JPetRawSignal> signals(window);
+  if (!signals.isValid())
+  {
+    return window.getNumberOfEvents() == 0;
+  }
+  std::map<int, std::array<std::vector<const JPetRawSignal*>, 2>> signalsPerSlot;
+  for (const auto& signal : signals)
+  {
+    const JPetBarrelSlot& barrelSlot = signal.getBarrelSlot();
+    const JPetPM& pm = signal.getPM();
+    if (barrelSlot.isNullObject() || pm.isNullObject())
+    {
+      continue;
+    }
+    signalsPerSlot[barrelSlot.getID()][pm.getSide() == JPetPM::SideA ? 0 : 1].push_back(&signal);
+  }
+  std::size_t numberOfPairs = 0;
+  for (const auto& slotSignals : signalsPerSlot)
+  {
+    numberOfPairs += std::min(slotSignals.second[0].size(), slotSignals.second[1].size());
+  }
+  sideA.reserve(numberOfPairs);
+  sideB.reserve(numberOfPairs);
+  if (barrelSlotIDs)
+  {
+    barrelSlotIDs->reserve(numberOfPairs);
+  }
+  for (const auto& slotSignals : signalsPerSlot)
+  {
+    const auto& signalsA = slotSignals.second[0];
+    const auto& signalsB = slotSignals.second[1];
+    for (std::size_t i = 0; i < signalsA.size() && i < signalsB.size(); i++)
+    {
+      sideA.add(*signalsA[i]);
+      sideB.add(*signalsB[i]);
+      if (barrelSlotIDs)
+      {
+        barrelSlotIDs->push_back(slotSignals.first);
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Leading times at the threshold number thrNum (from 1 to kNumberOfThresholds).
+ */
+const std::vector<float>& JPetSignalBatch::getLeadingTimes(unsigned int thrNum) const
+{
+  return fLeadingTimes.at(thrNum - 1);
+}
+
+/**
+ * @brief Trailing times at the threshold number thrNum (from 1 to kNumberOfThresholds).
+ */
+const std::vector<float>& JPetSignalBatch::getTrailingTimes(unsigned int thrNum) const
+{
+  return fTrailingTimes.at(thrNum - 1);
+}
+
+/**
+ * @brief Time over threshold (trailing - leading time) at the threshold number thrNum,
+ * computed in float as in JPetRawSignal::getTOTsVsThresholdNumber().
+ */
+bool JPetSignalBatch::computeTOT(const JPetSignalBatch& batch, unsigned int thrNum, std::vector<float>& tot)
+{
+  if (!isThresholdNumberValid(thrNum))
+  {
+    return false;
+  }
+  std::size_t size = batch.getSize();
+  tot.resize(size);
+  const float* leading = batch.fLeadingTimes[thrNum - 1].data();
+  const float* trailing = batch.fTrailingTimes[thrNum - 1].data();
+  float* result = tot.data();
+  for (std::size_t i = 0; i < size; i++)
+  {
+    result[i] = trailing[i] - leading[i];
+  }
+  return true;
+}
+
+/**
+ * @brief Sum of the times over threshold of all the thresholds, which have both points.
+ */
+void JPetSignalBatch::computeSummedTOT(const JPetSignalBatch& batch, std::vector<double>& summedTOT)
+{
+  std::size_t size = batch.getSize();
+  summedTOT.assign(size, 0.);
+  double* result = summedTOT.data();
+  for (unsigned int thr = 0; thr < kNumberOfThresholds; thr++)
+  {
+    const float* leading = batch.fLeadingTimes[thr].data();
+    const float* trailing = batch.fTrailingTimes[thr].data();
+    for (std::size_t i = 0; i < size; i++)
+    {
+      float tot = trailing[i] - leading[i];
+      /// NaN is the only value not equal to itself
+      result[i] += tot == tot ? tot : 0.f;
+    }
+  }
+}
+
+/**
+ * @brief Difference of the leading times of the sides A and B (A - B) at the threshold number thrNum,
+ * as given by JPetHitUtils::getTimeDiffAtThr().
+ */
+bool JPetSignalBatch::computeTimeDiffAB(const JPetSignalBatch& sideA, const JPetSignalBatch& sideB, unsigned int thrNum,
+                                        std::vector<double>& timeDiff)
+{
+  if (!isThresholdNumberValid(thrNum) || !haveSameSize(sideA, sideB))
+  {
+    return false;
+  }
+  std::size_t size = sideA.getSize();
+  timeDiff.resize(size);
+  const float* leadingA = sideA.fLeadingTimes[thrNum - 1].data();
+  const float* leadingB = sideB.fLeadingTimes[thrNum - 1].data();
+  double* result = timeDiff.data();
+  for (std::size_t i = 0; i < size; i++)
+  {
+    result[i] = static_cast<double>(leadingA[i]) - static_cast<double>(leadingB[i]);
+  }
+  return true;
+}
+
+/**
+ * @brief Mean of the leading times of the sides A and B at the threshold number thrNum,
+ * as given by JPetHitUtils::getTimeAtThr().
+ */
+bool JPetSignalBatch::computeMeanTime(const JPetSignalBatch& sideA, const JPetSignalBatch& sideB, unsigned int thrNum,
+                                      std::vector<double>& meanTime)
+{
+  if (!isThresholdNumberValid(thrNum) || !haveSameSize(sideA, sideB))
+  {
+    return false;
+  }
+  std::size_t size = sideA.getSize();
+  meanTime.resize(size);
+  const float* leadingA = sideA.fLeadingTimes[thrNum - 1].data();
+  const float* leadingB = sideB.fLeadingTimes[thrNum - 1].data();
+  double* result = meanTime.data();
+  for (std::size_t i = 0; i < size; i++)
+  {
+    result[i] = 0.5 * (static_cast<double>(leadingA[i]) + static_cast<double>(leadingB[i]));
+  }
+  return true;
+}
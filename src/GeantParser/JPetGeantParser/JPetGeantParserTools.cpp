@@ -55,6 +55,38 @@ JPetHit JPetGeantParserTools::reconstructHit(JPetMCHit& mcHit, const JPetParamBa
   return hit;
 }
 
+/**
+ * Same as reconstructHit with the param bank, with the position of the scintillator
+ * taken from the precomputed geometry instead of the param objects.
+ */
+JPetHit JPetGeantParserTools::reconstructHit(JPetMCHit& mcHit, const JPetDetectorGeometryCache& geometry, const float timeShift,
+                                             JPetHitExperimentalParametrizer& parametrizer)
+{
+  JPetHit hit = dynamic_cast<JPetHit&>(mcHit);
+  /// Nonsmeared values
+  auto scinID = mcHit.getScintillator().getID();
+  auto posZ = mcHit.getPosZ();
+  auto energy = mcHit.getEnergy();
+  auto time = mcHit.getTime() + timeShift;
+
+  hit.setEnergy(parametrizer.addEnergySmearing(scinID, posZ, energy, time));
+  // adjust to time window and smear
+  hit.setTime(parametrizer.addTimeSmearing(scinID, posZ, energy, time));
+  auto index = geometry.getIndex(scinID);
+  if (index == JPetDetectorGeometryCache::kBadIndex)
+  {
+    ERROR("No geometry found for the scintillator with id: " + std::to_string(scinID));
+  }
+  else
+  {
+    hit.setPosX(geometry.getCenterX()[index]);
+    hit.setPosY(geometry.getCenterY()[index]);
+  }
+  hit.setPosZ(parametrizer.addZHitSmearing(scinID, posZ, energy, time));
+
+  return hit;
+}
+
 bool JPetGeantParserTools::isHitReconstructed(JPetHit& hit, const float th) { return hit.getEnergy() >= th; }
 
 void JPetGeantParserTools::identifyRecoHits(JPetGeantScinHits* geantHit, const JPetHit& recHit, bool& isRecPrompt, std::array<bool, 2>& isSaved2g,
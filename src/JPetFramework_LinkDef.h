@@ -35,9 +35,12 @@
 #pragma link C++ class JPetRecoSignal + ;
 #pragma link C++ class JPetBaseSignal + ;
 #pragma link C++ class JPetRawSignal + ;
+#pragma read sourceClass="JPetEntryIndex" targetClass="JPetEntryIndex" version="[1-]" source="" target="fIsTimeOrderChecked" code="{ fIsTimeOrderChecked = false; }"
+#pragma read sourceClass="JPetRawSignal" targetClass="JPetRawSignal" version="[1-]" source="" target="fThresholdIndexState" code="{ fThresholdIndexState = 0; }"
 #pragma link C++ class JPetPhysSignal + ;
 #pragma link C++ class JPetSigCh + ;
 #pragma link C++ class JPetTreeHeader + ;
+#pragma link C++ class JPetEntryIndex + ;
 #pragma link C++ class JPetHit + ;
 #pragma link C++ class JPetTimeWindowMC + ;
 #pragma link C++ class JPetFrame + ;
@@ -66,5 +69,6 @@
 #pragma link C++ struct shapePoint + ;
 #pragma link C++ struct JPetScin::ScinDimensions + ;
 #pragma link C++ struct JPetTreeHeader::ProcessingStageInfo + ;
+#pragma link C++ struct JPetEntryIndex::EntrySummary + ;
 
 #endif
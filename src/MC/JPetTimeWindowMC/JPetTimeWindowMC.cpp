@@ -14,5 +14,68 @@
  */
 
 #include "JPetTimeWindowMC/JPetTimeWindowMC.h"
+#include <TBranchElement.h>
 
 ClassImp(JPetTimeWindowMC);
+
+const char* const JPetTimeWindowMC::kMCHitsBranchName = "MCHits";
+const char* const JPetTimeWindowMC::kDecayTreesBranchName = "DecayTrees";
+
+namespace
+{
+/// The array of a window created without the MC types gets the class of the objects stored in the branch
+void bindArray(TBranch* branch, TClonesArray& array, TClonesArray*& address)
+{
+  address = &array;
+  if (!branch)
+  {
+    return;
+  }
+  auto branchElement = dynamic_cast<TBranchElement*>(branch);
+  if (!array.GetClass() && branchElement)
+  {
+    array.SetClass(branchElement->GetClonesName());
+  }
+  branch->SetAddress(&address);
+}
+}
+
+/**
+ * @brief Bind the TClonesArray branches with the MC truth stored separately from the window to the arrays of this window.
+ */
+void JPetTimeWindowMC::setMCTruthBranches(TBranch* mcHitsBranch, TBranch* decayTreesBranch)
+{
+  fMCHitsBranch = mcHitsBranch;
+  fDecayTreesBranch = decayTreesBranch;
+  bindArray(fMCHitsBranch, fMCHits, fMCHitsAddress);
+  bindArray(fDecayTreesBranch, fDecayTrees, fDecayTreesAddress);
+}
+
+/**
+ * @brief Select the entry of the bound branches with the MC truth of this window.
+ *
+ * The MC truth is not read here, but on the first access to the MC hits or decay trees.
+ */
+void JPetTimeWindowMC::setMCTruthEntry(long long entry)
+{
+  fMCTruthEntry = entry;
+  fIsMCTruthLoaded = !fMCHitsBranch && !fDecayTreesBranch;
+}
+
+/**
+ * @brief Read the MC truth of the selected entry from the bound branches, also if they are disabled in the tree.
+ */
+void JPetTimeWindowMC::readMCTruth() const
+{
+  fIsMCTruthLoaded = true;
+  if (fMCHitsBranch)
+  {
+    fMCHitsBranch->GetEntry(fMCTruthEntry, 1);
+    fMCHitsCount = fMCHits.GetEntriesFast();
+  }
+  if (fDecayTreesBranch)
+  {
+    fDecayTreesBranch->GetEntry(fMCTruthEntry, 1);
+    fDecayTreesCount = fDecayTrees.GetEntriesFast();
+  }
+}
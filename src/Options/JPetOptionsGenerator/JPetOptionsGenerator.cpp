@@ -79,6 +79,8 @@ JPetOptionsGenerator::OptsStrAny JPetOptionsGenerator::generateAndValidateOption
  * At the same time, the input directory with true input files must be also added.
  * The container of pairs <directory, fileName> is generated based on the content
  * of the configuration file.
+ * If the chainInputFiles_bool option is set, all the input files are processed
+ * as one chained input, so only one element named after the first file is generated.
  */
 JPetOptionsGenerator::OptsForFiles JPetOptionsGenerator::generateOptionsForTasks(const OptsStrAny& inOptions, int nbOfRegisteredTasks)
 {
@@ -111,6 +113,16 @@ JPetOptionsGenerator::OptsForFiles JPetOptionsGenerator::generateOptionsForTasks
       optionsPerFile[dirAndFile.second] = options;
     }
   }
+  else if (isChainInputFiles(options))
+  {
+    if (any_cast<std::string>(getOptionValue(options, "type_std::string")) != "root")
+    {
+      ERROR("Chained input is only supported for the root type of input files");
+      return optsForAllFiles;
+    }
+    options["inputFile_std::string"] = files.front();
+    optionsPerFile[files.front()] = options;
+  }
   else
   {
     for (const auto& file : files)
@@ -94,6 +94,15 @@ OptsStrAny generateOptionsForTask(const OptsStrAny& inOptions, const OptsStrAny&
   {
     newOpts["inputFile_std::string"] = getOptionAsString(controlSettings, "outputFile_std::string");
   }
+  // the output of the previous task may be split into several files read as one chained input
+  if (isOptionSet(controlSettings, "chainInputFiles_bool"))
+  {
+    newOpts["chainInputFiles_bool"] = getOptionAsBool(controlSettings, "chainInputFiles_bool");
+    if (isChainInputFiles(controlSettings))
+    {
+      newOpts["file_std::vector<std::string>"] = getInputFiles(controlSettings);
+    }
+  }
   if (isOptionSet(controlSettings, "outputPath_std::string"))
   {
     auto outPath = std::string(getOutputPath(controlSettings));
@@ -193,4 +202,8 @@ void setOutputFile(OptsStrAny& options, const std::string file) { options["outpu
 // cppcheck-suppress passedByValue
 void setOutputPath(OptsStrAny& options, const std::string path) { options["outputPath_std::string"] = path; }
 
+void setChainInputFiles(OptsStrAny& options, bool isChain) { options["chainInputFiles_bool"] = isChain; }
+
+void setInputFiles(OptsStrAny& options, const std::vector<std::string>& files) { options["file_std::vector<std::string>"] = files; }
+
 } // namespace jpet_options_generator_tools
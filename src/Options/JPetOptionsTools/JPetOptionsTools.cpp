@@ -18,6 +18,7 @@
 #include "JPetLoggerInclude.h"
 #include "JPetOptionsGenerator/JPetOptionsTypeHandler.h"
 
+#include <algorithm>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <typeinfo>
@@ -174,6 +175,14 @@ std::string getScopeInputDirectory(const std::map<std::string, boost::any>& opts
   return any_cast<std::string>(opts.at("scopeInputDirectory_std::string"));
 }
 
+/**
+ * Returns true unless the binary cache of the scope data is disabled with the scopeCache_bool option.
+ */
+bool isScopeCache(const std::map<std::string, boost::any>& opts)
+{
+  return !isOptionSet(opts, "scopeCache_bool") || any_cast<bool>(opts.at("scopeCache_bool"));
+}
+
 // cppcheck-suppress unusedFunction
 std::string getOutputFile(const std::map<std::string, boost::any>& opts) { return any_cast<std::string>(opts.at("outputFile_std::string")); }
 
@@ -205,6 +214,63 @@ int getRunNumber(const std::map<std::string, boost::any>& opts) { return any_cas
 
 bool isProgressBar(const std::map<std::string, boost::any>& opts) { return any_cast<bool>(opts.at("progressBar_bool")); }
 
+/**
+ * Returns true if all input files should be processed as one chained input.
+ */
+bool isChainInputFiles(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "chainInputFiles_bool") && any_cast<bool>(opts.at("chainInputFiles_bool"));
+}
+
+/**
+ * Returns the number of time windows after which the output is split into a new file, 0 if not set.
+ */
+int getOutputSplitWindows(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "outputSplitWindows_int") ? std::max(0, any_cast<int>(opts.at("outputSplitWindows_int"))) : 0;
+}
+
+/**
+ * Returns the size in MB after which the output is split into a new file, 0 if not set.
+ */
+int getOutputSplitSizeMB(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "outputSplitSizeMB_int") ? std::max(0, any_cast<int>(opts.at("outputSplitSizeMB_int"))) : 0;
+}
+
+/**
+ * Returns the span of the detector time (in ps) after which the output is split into a new file, 0 if not set.
+ */
+double getOutputSplitTimeSpan(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "outputSplitTimeSpan_double") ? std::max(0., any_cast<double>(opts.at("outputSplitTimeSpan_double"))) : 0.;
+}
+
+/**
+ * Returns true if the JPetEntryIndex should be saved in the output files.
+ */
+bool isSaveEntryIndex(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "saveEntryIndex_bool") && any_cast<bool>(opts.at("saveEntryIndex_bool"));
+}
+
+/**
+ * Returns true if the unpacked data should be processed by the next task while the unpacking is still running.
+ */
+bool isStreamUnpacking(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "streamUnpacking_bool") && any_cast<bool>(opts.at("streamUnpacking_bool"));
+}
+
+/**
+ * Returns the size in MB of the chunks in which the data is handed over between the tasks
+ * with the streamUnpacking_bool option, 0 if not set.
+ */
+int getStreamUnpackingChunkSizeMB(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "streamUnpackingChunkSizeMB_int") ? std::max(0, any_cast<int>(opts.at("streamUnpackingChunkSizeMB_int"))) : 0;
+}
+
 bool isLocalDB(const std::map<std::string, boost::any>& opts) { return (bool)opts.count("localDB_std::string"); }
 
 std::string getLocalDB(const std::map<std::string, boost::any>& opts)
@@ -216,6 +282,16 @@ std::string getLocalDB(const std::map<std::string, boost::any>& opts)
   }
   return result;
 }
+
+/**
+ * Returns true if the local DB json file should be compiled to the binary file, if it is not compiled yet
+ * or was modified since it was compiled.
+ */
+bool isLocalDBCompile(const std::map<std::string, boost::any>& opts)
+{
+  return isOptionSet(opts, "localDBCompile_bool") && any_cast<bool>(opts.at("localDBCompile_bool"));
+}
+
 bool isLocalDBCreate(const std::map<std::string, boost::any>& opts) { return (bool)opts.count("localDBCreate_std::string"); }
 
 std::string getLocalDBCreate(const std::map<std::string, boost::any>& opts)
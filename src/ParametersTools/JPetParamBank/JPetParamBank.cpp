@@ -33,6 +33,9 @@ JPetParamBank::JPetParamBank(const JPetParamBank& paramBank) : fDummy(false)
   copyMapValues(fTOMBChannels, paramBank.fTOMBChannels);
   copyMapValues(fDataSources, paramBank.fDataSources);
   copyMapValues(fDataModules, paramBank.fDataModules);
+  if (paramBank.isIndexBuilt()) {
+    buildIndex();
+  }
 }
 
 JPetParamBank::~JPetParamBank() {}
@@ -51,6 +54,43 @@ void JPetParamBank::clear()
   fTOMBChannels.clear();
   fDataSources.clear();
   fDataModules.clear();
+  fScintillatorsIndex.clear();
+  fPMsIndex.clear();
+  fFEBsIndex.clear();
+  fTRBsIndex.clear();
+  fBarrelSlotsIndex.clear();
+  fLayersIndex.clear();
+  fFramesIndex.clear();
+  fTOMBChannelsIndex.clear();
+  fDataSourcesIndex.clear();
+  fDataModulesIndex.clear();
+}
+
+/**
+ * Builds the dense indices of all objects, used by the getters of single objects
+ * (getScintillator(), getPM(), ...) for O(1) lookups by id. It should be called once
+ * the bank is filled. Adding an object removes the index of its kind,
+ * the getters then use the maps until the index is built again.
+ */
+void JPetParamBank::buildIndex()
+{
+  fScintillatorsIndex.build(fScintillators);
+  fPMsIndex.build(fPMs);
+  fFEBsIndex.build(fFEBs);
+  fTRBsIndex.build(fTRBs);
+  fBarrelSlotsIndex.build(fBarrelSlots);
+  fLayersIndex.build(fLayers);
+  fFramesIndex.build(fFrames);
+  fTOMBChannelsIndex.build(fTOMBChannels);
+  fDataSourcesIndex.build(fDataSources);
+  fDataModulesIndex.build(fDataModules);
+}
+
+bool JPetParamBank::isIndexBuilt() const
+{
+  return fScintillatorsIndex.isBuilt() && fPMsIndex.isBuilt() && fFEBsIndex.isBuilt() && fTRBsIndex.isBuilt()
+    && fBarrelSlotsIndex.isBuilt() && fLayersIndex.isBuilt() && fFramesIndex.isBuilt()
+    && fTOMBChannelsIndex.isBuilt() && fDataSourcesIndex.isBuilt() && fDataModulesIndex.isBuilt();
 }
 
 int JPetParamBank::getSize(ParamObjectType type) const
@@ -0,0 +1,100 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBankRegistry.cpp
+ */
+
+#include "JPetParamBankRegistry/JPetParamBankRegistry.h"
+
+/**
+ * @brief Returns the registered bank or builds it with the given builder and registers it.
+ *
+ * The other callers asking for the same bank wait until it is built. If the builder throws,
+ * nothing is registered, the exception is propagated and the next caller builds the bank again.
+ * A bank released by all its users is built again by the next caller.
+ */
+std::shared_ptr<const JPetParamBank> JPetParamBankRegistry::getParamBank(const Key& key, const Builder& builder)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(getMutex());
+    removeExpiredEntries();
+    auto& registered = getEntries()[key];
+    if (!registered)
+    {
+      registered = std::make_shared<Entry>();
+    }
+    entry = registered;
+  }
+  std::lock_guard<std::mutex> lock(entry->fMutex);
+  auto bank = entry->fBank.lock();
+  if (!bank)
+  {
+    bank = builder();
+    entry->fBank = bank;
+  }
+  return bank;
+}
+
+/**
+ * @brief Returns the number of the registered banks which are still used.
+ */
+std::size_t JPetParamBankRegistry::getSize()
+{
+  std::lock_guard<std::mutex> lock(getMutex());
+  removeExpiredEntries();
+  return getEntries().size();
+}
+
+/**
+ * @brief Removes all the banks from the registry. The banks are deleted when they are no longer used.
+ */
+void JPetParamBankRegistry::clear()
+{
+  std::lock_guard<std::mutex> lock(getMutex());
+  getEntries().clear();
+}
+
+/**
+ * Removes the entries of the deleted banks, except for the ones used by a caller
+ * building or waiting for the bank. Must be called with the registry mutex locked.
+ */
+void JPetParamBankRegistry::removeExpiredEntries()
+{
+  auto& entries = getEntries();
+  for (auto it = entries.begin(); it != entries.end();)
+  {
+    if (it->second.use_count() == 1 && it->second->fBank.expired())
+    {
+      it = entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+std::mutex& JPetParamBankRegistry::getMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+/**
+ * The registry is never destroyed, so its entries are not destroyed after ROOT has been cleaned up.
+ */
+std::map<JPetParamBankRegistry::Key, std::shared_ptr<JPetParamBankRegistry::Entry>>& JPetParamBankRegistry::getEntries()
+{
+  static auto entries = new std::map<Key, std::shared_ptr<Entry>>();
+  return *entries;
+}
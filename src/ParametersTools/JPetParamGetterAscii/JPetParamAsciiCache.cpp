@@ -0,0 +1,146 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamAsciiCache.cpp
+ */
+
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+JPetParamAsciiCache::Document::Document(const boost::property_tree::ptree& tree)
+{
+  for (const auto& run : tree)
+  {
+    auto& objectsOfRun = fRuns[run.first];
+    for (const auto& objects : run.second)
+    {
+      auto& descriptions = objectsOfRun[objects.first];
+      for (const auto& info : objects.second)
+      {
+        descriptions.push_back(toDescription(info.second));
+      }
+    }
+  }
+}
+
+JPetParamAsciiCache::Document::Document(std::map<std::string, ObjectsOfRun>&& runs) : fRuns(std::move(runs)) {}
+
+/**
+ * @brief Returns the objects of the run or nullptr if there is no such run in the file.
+ */
+const JPetParamAsciiCache::ObjectsOfRun* JPetParamAsciiCache::Document::getRun(const std::string& runId) const
+{
+  auto run = fRuns.find(runId);
+  return run == fRuns.end() ? nullptr : &run->second;
+}
+
+const std::map<std::string, JPetParamAsciiCache::ObjectsOfRun>& JPetParamAsciiCache::Document::getRuns() const { return fRuns; }
+
+/**
+ * @brief Returns the parsed json file or nullptr if the file does not exist.
+ *
+ * The parsing errors are reported by the exceptions thrown by boost::property_tree::read_json.
+ */
+std::shared_ptr<const JPetParamAsciiCache::Document> JPetParamAsciiCache::getDocument(const std::string& fileName)
+{
+  return getDocument(fileName, &JPetParamAsciiCache::readJson);
+}
+
+/**
+ * @brief Returns the file read by the loader or nullptr if the file does not exist.
+ *
+ * The file is read only if it is not in the cache or was modified since it was read.
+ * The errors are reported by the exceptions thrown by the loader.
+ * Concurrent callers may read the same file at the same time, the last read document is kept.
+ */
+std::shared_ptr<const JPetParamAsciiCache::Document> JPetParamAsciiCache::getDocument(const std::string& fileName, const Loader& loader)
+{
+  boost::system::error_code error;
+  auto key = boost::filesystem::absolute(fileName).string();
+  auto modificationTime = boost::filesystem::last_write_time(fileName, error);
+  std::uintmax_t size = error ? 0 : boost::filesystem::file_size(fileName, error);
+  if (error)
+  {
+    invalidate(fileName);
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(getMutex());
+    auto entry = getEntries().find(key);
+    if (entry != getEntries().end() && entry->second.fModificationTime == modificationTime && entry->second.fSize == size)
+    {
+      return entry->second.fDocument;
+    }
+  }
+  Entry entry;
+  entry.fModificationTime = modificationTime;
+  entry.fSize = size;
+  entry.fDocument = loader(fileName);
+  std::lock_guard<std::mutex> lock(getMutex());
+  getEntries()[key] = entry;
+  return entry.fDocument;
+}
+
+std::shared_ptr<const JPetParamAsciiCache::Document> JPetParamAsciiCache::readJson(const std::string& fileName)
+{
+  boost::property_tree::ptree tree;
+  boost::property_tree::read_json(fileName, tree);
+  return std::make_shared<const Document>(tree);
+}
+
+void JPetParamAsciiCache::invalidate(const std::string& fileName)
+{
+  auto key = boost::filesystem::absolute(fileName).string();
+  std::lock_guard<std::mutex> lock(getMutex());
+  getEntries().erase(key);
+}
+
+void JPetParamAsciiCache::clear()
+{
+  std::lock_guard<std::mutex> lock(getMutex());
+  getEntries().clear();
+}
+
+/**
+ * @brief Convert the json object to the description, with the boolean values given as "1" and "0".
+ */
+ParamObjectDescription JPetParamAsciiCache::toDescription(const boost::property_tree::ptree& info)
+{
+  ParamObjectDescription description;
+  for (const auto& value : info)
+  {
+    std::string val = value.second.get_value<std::string>();
+    if (val == "true")
+    {
+      val = "1";
+    }
+    if (val == "false")
+    {
+      val = "0";
+    }
+    description[value.first] = val;
+  }
+  return description;
+}
+
+std::mutex& JPetParamAsciiCache::getMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, JPetParamAsciiCache::Entry>& JPetParamAsciiCache::getEntries()
+{
+  static std::map<std::string, Entry> entries;
+  return entries;
+}
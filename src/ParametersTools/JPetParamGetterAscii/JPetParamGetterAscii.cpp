@@ -19,124 +19,102 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
-#include <boost/property_tree/json_parser.hpp>
 
-ParamObjectsDescriptions JPetParamGetterAscii::getAllBasicData(ParamObjectType type, const int runId)
+std::shared_ptr<const JPetParamAsciiCache::Document> JPetParamGetterAscii::loadDocument()
+{
+  return JPetParamAsciiCache::getDocument(filename);
+}
+
+/**
+ * @brief Returns the descriptions of the objects of the given run, or nullptr if
+ * there are no such objects or no such run. The errors are reported.
+ */
+const std::vector<ParamObjectDescription>* JPetParamGetterAscii::getDescriptions(ParamObjectType type, const int runId)
 {
   std::string runNumberS = boost::lexical_cast<std::string>(runId);
   std::string objectsName = objectsNames.at(type);
+  fDocument = loadDocument();
+  if (!fDocument)
+  {
+    ERROR(std::string("Input file does not exist:") + filename);
+    return nullptr;
+  }
+  auto runContents = fDocument->getRun(runNumberS);
+  if (!runContents)
+  {
+    ERROR(std::string("No run with such id:") + runNumberS);
+    return nullptr;
+  }
+  auto infos = runContents->find(objectsName);
+  if (infos == runContents->end())
+  {
+    ERROR(std::string("No ") + objectsName + " in the specified run.");
+    return nullptr;
+  }
+  return &infos->second;
+}
+
+ParamObjectsDescriptions JPetParamGetterAscii::getAllBasicData(ParamObjectType type, const int runId)
+{
   ParamObjectsDescriptions result;
-  if (boost::filesystem::exists(filename))
+  if (auto descriptions = getDescriptions(type, runId))
   {
-    boost::property_tree::ptree dataFromFile;
-    boost::property_tree::read_json(filename, dataFromFile);
-    if (auto possibleRunContents = dataFromFile.get_child_optional(runNumberS))
+    for (const auto& description : *descriptions)
     {
-      auto runContents = *possibleRunContents;
-      if (auto possibleInfos = runContents.get_child_optional(objectsName))
+      int id;
+      if (type == kTOMBChannel)
       {
-        auto infos = *possibleInfos;
-        for (auto infoRaw : infos)
-        {
-          auto info = infoRaw.second;
-          ParamObjectDescription description = toDescription(info);
-          int id;
-          if (type == kTOMBChannel)
-          {
-            id = boost::lexical_cast<int>(description["channel"]);
-          }
-          else
-          {
-            id = boost::lexical_cast<int>(description["id"]);
-          }
-          result[id] = description;
-        }
+        id = boost::lexical_cast<int>(description.at("channel"));
       }
       else
       {
-        ERROR(std::string("No ") + objectsName + " in the specified run.");
+        id = boost::lexical_cast<int>(description.at("id"));
       }
-    }
-    else
-    {
-      ERROR(std::string("No run with such id:") + runNumberS);
+      result[id] = description;
     }
   }
-  else
-  {
-    ERROR(std::string("Input file does not exist:") + filename);
-  }
   return result;
 }
 
 ParamRelationalData JPetParamGetterAscii::getAllRelationalData(ParamObjectType type1, ParamObjectType type2, const int runId)
 {
-  std::string runNumberS = boost::lexical_cast<std::string>(runId);
-  std::string objectsName = objectsNames.at(type1);
   std::string fieldName = objectsNames.at(type2) + "_id";
   ParamRelationalData result;
-  if (boost::filesystem::exists(filename))
+  if (auto descriptions = getDescriptions(type1, runId))
   {
-    boost::property_tree::ptree dataFromFile;
-    boost::property_tree::read_json(filename, dataFromFile);
-    if (auto possibleRunContents = dataFromFile.get_child_optional(runNumberS))
+    for (const auto& description : *descriptions)
     {
-      auto runContents = *possibleRunContents;
-      if (auto possibleInfos = runContents.get_child_optional(objectsName))
+      if (description.count(fieldName))
       {
-        auto infos = *possibleInfos;
-        for (auto infoRaw : infos)
+        int id;
+        if (type1 == kTOMBChannel)
         {
-          auto info = infoRaw.second;
-          ParamObjectDescription description = toDescription(info);
-          if (description.count(fieldName))
-          {
-            int id;
-            if (type1 == kTOMBChannel)
-            {
-              id = boost::lexical_cast<int>(description["channel"]);
-            }
-            else
-            {
-              id = boost::lexical_cast<int>(description["id"]);
-            }
-            int otherId = boost::lexical_cast<int>(description[fieldName]);
-            result[id] = otherId;
-          }
+          id = boost::lexical_cast<int>(description.at("channel"));
         }
+        else
+        {
+          id = boost::lexical_cast<int>(description.at("id"));
+        }
+        int otherId = boost::lexical_cast<int>(description.at(fieldName));
+        result[id] = otherId;
       }
-      else
-      {
-        ERROR(std::string("No ") + objectsName + " in the specified run.");
-      }
-    }
-    else
-    {
-      ERROR(std::string("No run with such id:") + runNumberS);
     }
   }
-  else
-  {
-    ERROR(std::string("Input file does not exist:") + filename);
-  }
   return result;
 }
 
-ParamObjectDescription JPetParamGetterAscii::toDescription(boost::property_tree::ptree& info)
+/**
+ * @brief The id is the absolute path of the file with its modification time and size,
+ * or empty if the file does not exist.
+ */
+std::string JPetParamGetterAscii::getSourceId() const
 {
-  ParamObjectDescription description;
-  for (auto value : info)
+  boost::system::error_code error;
+  auto modificationTime = boost::filesystem::last_write_time(filename, error);
+  std::uintmax_t size = error ? 0 : boost::filesystem::file_size(filename, error);
+  if (error)
   {
-    std::string val = value.second.get_value<std::string>();
-    if (val == "true")
-    {
-      val = "1";
-    }
-    if (val == "false")
-    {
-      val = "0";
-    }
-    description[value.first] = val;
+    return std::string();
   }
-  return description;
+  return boost::filesystem::absolute(filename).string() + ";" + std::to_string(modificationTime) + ";" + std::to_string(size);
 }
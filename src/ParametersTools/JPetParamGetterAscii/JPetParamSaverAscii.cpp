@@ -15,6 +15,7 @@
 
 #include "JPetParamGetterAscii/JPetParamSaverAscii.h"
 #include "JPetParamBank/JPetParamBank.h"
+#include "JPetParamGetterAscii/JPetParamAsciiCache.h"
 #include "JPetParamGetterAscii/JPetParamAsciiConstants.h"
 
 #include <boost/filesystem.hpp>
@@ -27,6 +28,7 @@ void JPetParamSaverAscii::saveParamBank(const JPetParamBank& bank, const int run
   auto fileTree = getTreeFromFile(filename);
   addToTree(fileTree, bank, runNumberS);
   write_json(filename, fileTree);
+  JPetParamAsciiCache::invalidate(filename);
 }
 
 boost::property_tree::ptree JPetParamSaverAscii::getTreeFromFile(const std::string& filename)
@@ -0,0 +1,329 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBinaryFile.cpp
+ */
+
+#include "JPetParamGetterBinary/JPetParamBinaryFile.h"
+#include "JPetLoggerInclude.h"
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+const std::string JPetParamBinaryFile::kFileSuffix = ".bin";
+const std::uint32_t JPetParamBinaryFile::kVersion = 2;
+
+namespace
+{
+const char kMagic[8] = {'J', 'P', 'E', 'T', 'P', 'D', 'B', '\0'};
+const std::uint64_t kFNVOffset = 14695981039346656037ull;
+const std::uint64_t kFNVPrime = 1099511628211ull;
+
+/// FNV-1a hash of the bytes
+std::uint64_t getChecksum(const char* data, std::size_t size)
+{
+  std::uint64_t hash = kFNVOffset;
+  for (std::size_t i = 0; i < size; i++)
+  {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * kFNVPrime;
+  }
+  return hash;
+}
+
+struct Header
+{
+  char fMagic[8];
+  std::uint32_t fVersion;
+  std::uint32_t fReserved;
+  std::uint64_t fSourceHash;
+  std::uint64_t fContentsSize;
+};
+
+template <typename T>
+void append(std::string& buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// Reads the contents, throws if the contents end too early or a string index is wrong
+class ContentsReader
+{
+public:
+  ContentsReader(const char* data, std::size_t size) : fData(data), fSize(size) {}
+
+  std::uint32_t readValue()
+  {
+    std::uint32_t value = 0;
+    if (fSize - fPosition < sizeof(value))
+    {
+      throw std::runtime_error("unexpected end of the contents");
+    }
+    std::memcpy(&value, fData + fPosition, sizeof(value));
+    fPosition += sizeof(value);
+    return value;
+  }
+
+  const std::string& readString(const std::vector<std::string>& strings)
+  {
+    auto index = readValue();
+    if (index >= strings.size())
+    {
+      throw std::runtime_error("wrong index of the string");
+    }
+    return strings[index];
+  }
+
+  std::string readStringValue()
+  {
+    auto length = readValue();
+    if (fSize - fPosition < length)
+    {
+      throw std::runtime_error("unexpected end of the contents");
+    }
+    std::string value(fData + fPosition, length);
+    fPosition += length;
+    return value;
+  }
+
+  bool isAtEnd() const { return fPosition == fSize; }
+
+private:
+  const char* fData;
+  std::size_t fSize;
+  std::size_t fPosition = 0;
+};
+
+/// Reads the whole file, returns false if it cannot be read
+bool readFile(const std::string& fileName, std::string& contents)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  contents = stream.str();
+  return !file.bad();
+}
+} // namespace
+
+/**
+ * @brief The compiled file is placed next to the json file, e.g. localDB.json.bin.
+ */
+std::string JPetParamBinaryFile::getCompiledFileName(const std::string& jsonFileName) { return jsonFileName + kFileSuffix; }
+
+/**
+ * @brief Compile the json file to the binary file, returns false if it failed.
+ *
+ * The json file is read once, the hash stored in the binary file is the hash of the parsed contents.
+ */
+bool JPetParamBinaryFile::compile(const std::string& jsonFileName, const std::string& binaryFileName)
+{
+  std::string json;
+  if (!readFile(jsonFileName, json))
+  {
+    ERROR("Input file does not exist:" + jsonFileName);
+    return false;
+  }
+  std::unique_ptr<JPetParamAsciiCache::Document> document;
+  try
+  {
+    std::istringstream stream(json);
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(stream, tree);
+    document.reset(new JPetParamAsciiCache::Document(tree));
+  }
+  catch (const std::exception& error)
+  {
+    ERROR("Could not parse the local DB file " + jsonFileName + ": " + error.what());
+    return false;
+  }
+  return write(*document, getChecksum(json.data(), json.size()), binaryFileName);
+}
+
+/**
+ * @brief Returns true if the binary file was compiled from the current contents of the json file
+ * and has the current version of the format. The json file is read and hashed, so copying or touching
+ * it does not make the binary file stale, but any change of the contents does.
+ * The checksum of the binary file is not verified.
+ */
+bool JPetParamBinaryFile::isUpToDate(const std::string& jsonFileName, const std::string& binaryFileName)
+{
+  std::ifstream file(binaryFileName, std::ios::binary);
+  Header header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.fMagic, kMagic, sizeof(kMagic)) != 0 ||
+      header.fVersion != kVersion)
+  {
+    return false;
+  }
+  std::string json;
+  return readFile(jsonFileName, json) && header.fSourceHash == getChecksum(json.data(), json.size());
+}
+
+/**
+ * @brief Write the document to the binary file. The file is written to a temporary file first
+ * and renamed, so the readers never see an incomplete file.
+ */
+bool JPetParamBinaryFile::write(const JPetParamAsciiCache::Document& document, std::uint64_t sourceHash,
+                                const std::string& binaryFileName)
+{
+  std::map<std::string, std::uint32_t> stringIndices;
+  std::vector<const std::string*> strings;
+  auto getIndex = [&stringIndices, &strings](const std::string& value) {
+    auto inserted = stringIndices.emplace(value, strings.size());
+    if (inserted.second)
+    {
+      strings.push_back(&inserted.first->first);
+    }
+    return inserted.first->second;
+  };
+  std::string objects;
+  append<std::uint32_t>(objects, document.getRuns().size());
+  for (const auto& run : document.getRuns())
+  {
+    append(objects, getIndex(run.first));
+    append<std::uint32_t>(objects, run.second.size());
+    for (const auto& objectsOfKind : run.second)
+    {
+      append(objects, getIndex(objectsOfKind.first));
+      append<std::uint32_t>(objects, objectsOfKind.second.size());
+      for (const auto& description : objectsOfKind.second)
+      {
+        append<std::uint32_t>(objects, description.size());
+        for (const auto& field : description)
+        {
+          append(objects, getIndex(field.first));
+          append(objects, getIndex(field.second));
+        }
+      }
+    }
+  }
+  std::string contents;
+  append<std::uint32_t>(contents, strings.size());
+  for (const auto value : strings)
+  {
+    append<std::uint32_t>(contents, value->size());
+    contents += *value;
+  }
+  contents += objects;
+
+  Header header;
+  std::memcpy(header.fMagic, kMagic, sizeof(kMagic));
+  header.fVersion = kVersion;
+  header.fReserved = 0;
+  header.fSourceHash = sourceHash;
+  header.fContentsSize = contents.size();
+  std::uint64_t checksum = getChecksum(contents.data(), contents.size());
+
+  auto temporaryFileName = binaryFileName + boost::filesystem::unique_path(".%%%%-%%%%.tmp").string();
+  {
+    std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(contents.data(), contents.size());
+    file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    if (!file.flush())
+    {
+      ERROR("Could not write the compiled local DB file " + temporaryFileName);
+      file.close();
+      boost::filesystem::remove(temporaryFileName);
+      return false;
+    }
+  }
+  boost::system::error_code error;
+  boost::filesystem::rename(temporaryFileName, binaryFileName, error);
+  if (error)
+  {
+    ERROR("Could not rename the compiled local DB file to " + binaryFileName + ": " + error.message());
+    boost::filesystem::remove(temporaryFileName, error);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Read the binary file with a single read. Throws std::runtime_error if the file
+ * cannot be read, has a different version of the format or is corrupted.
+ */
+std::shared_ptr<const JPetParamAsciiCache::Document> JPetParamBinaryFile::read(const std::string& binaryFileName)
+{
+  std::ifstream file(binaryFileName, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    throw std::runtime_error("could not open the compiled local DB file " + binaryFileName);
+  }
+  std::vector<char> data(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0);
+  if (!file.read(data.data(), data.size()) || data.size() < sizeof(Header) + sizeof(std::uint64_t))
+  {
+    throw std::runtime_error("could not read the compiled local DB file " + binaryFileName);
+  }
+  Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.fMagic, kMagic, sizeof(kMagic)) != 0)
+  {
+    throw std::runtime_error(binaryFileName + " is not a compiled local DB file");
+  }
+  if (header.fVersion != kVersion)
+  {
+    throw std::runtime_error(binaryFileName + " has version " + std::to_string(header.fVersion) + " of the format, expected " +
+                             std::to_string(kVersion));
+  }
+  std::uint64_t checksum = 0;
+  if (header.fContentsSize != data.size() - sizeof(Header) - sizeof(checksum))
+  {
+    throw std::runtime_error(binaryFileName + " has a wrong size");
+  }
+  const char* contents = data.data() + sizeof(Header);
+  std::memcpy(&checksum, contents + header.fContentsSize, sizeof(checksum));
+  if (checksum != getChecksum(contents, header.fContentsSize))
+  {
+    throw std::runtime_error(binaryFileName + " has a wrong checksum");
+  }
+
+  ContentsReader reader(contents, header.fContentsSize);
+  std::vector<std::string> strings(reader.readValue());
+  for (auto& value : strings)
+  {
+    value = reader.readStringValue();
+  }
+  std::map<std::string, JPetParamAsciiCache::ObjectsOfRun> runs;
+  auto nbOfRuns = reader.readValue();
+  for (std::uint32_t i = 0; i < nbOfRuns; i++)
+  {
+    auto& objectsOfRun = runs[reader.readString(strings)];
+    auto nbOfKinds = reader.readValue();
+    for (std::uint32_t j = 0; j < nbOfKinds; j++)
+    {
+      auto& descriptions = objectsOfRun[reader.readString(strings)];
+      descriptions.resize(reader.readValue());
+      for (auto& description : descriptions)
+      {
+        auto nbOfFields = reader.readValue();
+        for (std::uint32_t k = 0; k < nbOfFields; k++)
+        {
+          const auto& name = reader.readString(strings);
+          description.emplace_hint(description.end(), name, reader.readString(strings));
+        }
+      }
+    }
+  }
+  if (!reader.isAtEnd())
+  {
+    throw std::runtime_error(binaryFileName + " has unexpected data at the end");
+  }
+  return std::make_shared<const JPetParamAsciiCache::Document>(std::move(runs));
+}
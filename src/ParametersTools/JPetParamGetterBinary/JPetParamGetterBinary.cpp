@@ -0,0 +1,22 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamGetterBinary.cpp
+ */
+
+#include "JPetParamGetterBinary/JPetParamGetterBinary.h"
+#include "JPetParamGetterBinary/JPetParamBinaryFile.h"
+
+std::shared_ptr<const JPetParamAsciiCache::Document> JPetParamGetterBinary::loadDocument()
+{
+  return JPetParamAsciiCache::getDocument(filename, &JPetParamBinaryFile::read);
+}
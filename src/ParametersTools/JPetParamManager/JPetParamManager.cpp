@@ -15,11 +15,65 @@
 
 #include "JPetParamManager/JPetParamManager.h"
 #include "JPetOptionsTools/JPetOptionsTools.h"
+#include "JPetParamBankRegistry/JPetParamBankRegistry.h"
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetParamGetterBinary/JPetParamBinaryFile.h"
+#include "JPetParamGetterBinary/JPetParamGetterBinary.h"
 
 #include <TFile.h>
 #include <boost/property_tree/xml_parser.hpp>
 
+namespace
+{
+/**
+ * Returns the getter of the local DB compiled to the binary file if it is up to date,
+ * compiling it first if requested with the localDBCompile_bool option,
+ * or the getter of the local DB json file otherwise.
+ */
+JPetParamGetter* generateLocalDBGetter(const std::map<std::string, boost::any>& options)
+{
+  using namespace jpet_options_tools;
+  auto localDB = getLocalDB(options);
+  auto compiledLocalDB = JPetParamBinaryFile::getCompiledFileName(localDB);
+  bool isCompiledLocalDBUpToDate = JPetParamBinaryFile::isUpToDate(localDB, compiledLocalDB);
+  if (isLocalDBCompile(options) && !isCompiledLocalDBUpToDate) {
+    INFO("Compiling the local DB file " + localDB + " to " + compiledLocalDB);
+    isCompiledLocalDBUpToDate = JPetParamBinaryFile::compile(localDB, compiledLocalDB);
+  }
+  if (isCompiledLocalDBUpToDate) {
+    try {
+      if (JPetParamAsciiCache::getDocument(compiledLocalDB, &JPetParamBinaryFile::read)) {
+        return new JPetParamGetterBinary(compiledLocalDB);
+      }
+    } catch (const std::exception& error) {
+      WARNING("Could not read the compiled local DB file " + compiledLocalDB + ", using the json file: " + error.what());
+    }
+  }
+  return new JPetParamGetterAscii(localDB);
+}
+
+/**
+ * Reads the ParamBank cycles following the first one. JPetHadd stores them for the merged
+ * inputs with distinct parameters. They are kept in memory only to resolve the TRefs
+ * of the entries of older files, which do not refer to the parameters by id.
+ */
+template <typename GetObject>
+std::vector<std::unique_ptr<JPetParamBank>> readMergedParamBanks(GetObject getObject)
+{
+  std::vector<std::unique_ptr<JPetParamBank>> banks;
+  int cycle = 2;
+  while (auto bank = static_cast<JPetParamBank*>(getObject(Form("ParamBank;%d", cycle)))) {
+    banks.emplace_back(bank);
+    cycle++;
+  }
+  return banks;
+}
+}
+
+/**
+ * The compiled local DB (see JPetParamBinaryFile) is used instead of the json file
+ * if it was compiled from the current version of the json file.
+ */
 std::shared_ptr<JPetParamManager> JPetParamManager::generateParamManager(const std::map<std::string, boost::any>& options)
 {
   using namespace jpet_options_tools;
@@ -44,7 +98,7 @@ std::shared_ptr<JPetParamManager> JPetParamManager::generateParamManager(const s
       expectMissing.insert(ParamObjectType::kDataModule);
     }
     return std::make_shared<JPetParamManager>(
-      new JPetParamGetterAscii(getLocalDB(options)), expectMissing
+      generateLocalDBGetter(options), expectMissing
     );
   } else {
     ERROR("No local database file found.");
@@ -54,11 +108,6 @@ std::shared_ptr<JPetParamManager> JPetParamManager::generateParamManager(const s
 
 JPetParamManager::~JPetParamManager()
 {
-  if (fBank)
-  {
-    delete fBank;
-    fBank = 0;
-  }
   if (fParamGetter)
   {
     delete fParamGetter;
@@ -190,20 +239,38 @@ JPetDataModuleFactory& JPetParamManager::getDataModuleFactory(const int runID)
   return fDataModuleFactories.at(runID);
 }
 
+/**
+ * @brief Generate the param bank for the given run.
+ *
+ * If the param getter has a source id, the bank is taken from JPetParamBankRegistry,
+ * so it is generated only once in the process for the same source, run and missing objects,
+ * and shared by all managers. Otherwise, the bank is generated by this manager.
+ */
 void JPetParamManager::fillParameterBank(const int run)
 {
-  if (fBank)
+  fBank.reset();
+  auto sourceId = fParamGetter->getSourceId();
+  if (sourceId.empty())
+  {
+    fBank = buildParamBank(run);
+  }
+  else
   {
-    delete fBank;
-    fBank = 0;
+    fBank = JPetParamBankRegistry::getParamBank(
+      JPetParamBankRegistry::Key(sourceId, run, fExpectMissing), [this, run]() { return buildParamBank(run); }
+    );
   }
-  fBank = new JPetParamBank();
+}
+
+std::shared_ptr<const JPetParamBank> JPetParamManager::buildParamBank(const int run)
+{
+  auto bank = std::make_shared<JPetParamBank>();
   if (!fExpectMissing.count(ParamObjectType::kTRB))
   {
     for (auto& trbp : getTRBs(run))
     {
       auto& trb = *trbp.second;
-      fBank->addTRB(trb);
+      bank->addTRB(trb);
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kFEB))
@@ -211,8 +278,8 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& febp : getFEBs(run))
     {
       auto& feb = *febp.second;
-      fBank->addFEB(feb);
-      fBank->getFEB(feb.getID()).setTRB(fBank->getTRB(feb.getTRB().getID()));
+      bank->addFEB(feb);
+      bank->getFEB(feb.getID()).setTRB(bank->getTRB(feb.getTRB().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kFrame))
@@ -220,7 +287,7 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& framep : getFrames(run))
     {
       auto& frame = *framep.second;
-      fBank->addFrame(frame);
+      bank->addFrame(frame);
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kLayer))
@@ -228,8 +295,8 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& layerp : getLayers(run))
     {
       auto& layer = *layerp.second;
-      fBank->addLayer(layer);
-      fBank->getLayer(layer.getID()).setFrame(fBank->getFrame(layer.getFrame().getID()));
+      bank->addLayer(layer);
+      bank->getLayer(layer.getID()).setFrame(bank->getFrame(layer.getFrame().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kBarrelSlot))
@@ -237,10 +304,10 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& barrelSlotp : getBarrelSlots(run))
     {
       auto& barrelSlot = *barrelSlotp.second;
-      fBank->addBarrelSlot(barrelSlot);
+      bank->addBarrelSlot(barrelSlot);
       if (barrelSlot.hasLayer())
       {
-        fBank->getBarrelSlot(barrelSlot.getID()).setLayer(fBank->getLayer(barrelSlot.getLayer().getID()));
+        bank->getBarrelSlot(barrelSlot.getID()).setLayer(bank->getLayer(barrelSlot.getLayer().getID()));
       }
     }
   }
@@ -249,8 +316,8 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& scinp : getScins(run))
     {
       auto& scin = *scinp.second;
-      fBank->addScintillator(scin);
-      fBank->getScintillator(scin.getID()).setBarrelSlot(fBank->getBarrelSlot(scin.getBarrelSlot().getID()));
+      bank->addScintillator(scin);
+      bank->getScintillator(scin.getID()).setBarrelSlot(bank->getBarrelSlot(scin.getBarrelSlot().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kPM))
@@ -258,13 +325,13 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& pmp : getPMs(run))
     {
       auto& pm = *pmp.second;
-      fBank->addPM(pm);
+      bank->addPM(pm);
       if (pm.hasFEB())
       {
-        fBank->getPM(pm.getID()).setFEB(fBank->getFEB(pm.getFEB().getID()));
+        bank->getPM(pm.getID()).setFEB(bank->getFEB(pm.getFEB().getID()));
       }
-      fBank->getPM(pm.getID()).setScin(fBank->getScintillator(pm.getScin().getID()));
-      fBank->getPM(pm.getID()).setBarrelSlot(fBank->getBarrelSlot(pm.getBarrelSlot().getID()));
+      bank->getPM(pm.getID()).setScin(bank->getScintillator(pm.getScin().getID()));
+      bank->getPM(pm.getID()).setBarrelSlot(bank->getBarrelSlot(pm.getBarrelSlot().getID()));
     }
   }
   if (!fExpectMissing.count(ParamObjectType::kTOMBChannel))
@@ -272,10 +339,10 @@ void JPetParamManager::fillParameterBank(const int run)
     for (auto& tombChannelp : getTOMBChannels(run))
     {
       auto& tombChannel = *tombChannelp.second;
-      fBank->addTOMBChannel(tombChannel);
-      fBank->getTOMBChannel(tombChannel.getChannel()).setFEB(fBank->getFEB(tombChannel.getFEB().getID()));
-      fBank->getTOMBChannel(tombChannel.getChannel()).setTRB(fBank->getTRB(tombChannel.getTRB().getID()));
-      fBank->getTOMBChannel(tombChannel.getChannel()).setPM(fBank->getPM(tombChannel.getPM().getID()));
+      bank->addTOMBChannel(tombChannel);
+      bank->getTOMBChannel(tombChannel.getChannel()).setFEB(bank->getFEB(tombChannel.getFEB().getID()));
+      bank->getTOMBChannel(tombChannel.getChannel()).setTRB(bank->getTRB(tombChannel.getTRB().getID()));
+      bank->getTOMBChannel(tombChannel.getChannel()).setPM(bank->getPM(tombChannel.getPM().getID()));
     }
   }
 
@@ -283,19 +350,21 @@ void JPetParamManager::fillParameterBank(const int run)
   if (!fExpectMissing.count(ParamObjectType::kDataSource)) {
     for (auto& dataSourceElement : getDataSources(run)) {
       auto& dataSource = *dataSourceElement.second;
-      fBank->addDataSource(dataSource);
+      bank->addDataSource(dataSource);
     }
   }
 
   if (!fExpectMissing.count(ParamObjectType::kDataModule)) {
     for (auto& dataModuleElement : getDataModules(run)) {
       auto& dataModule = *dataModuleElement.second;
-      fBank->addDataModule(dataModule);
-      fBank->getDataModule(dataModule.getID()).setDataSource(
-        fBank->getDataSource(dataModule.getDataSource().getID())
+      bank->addDataModule(dataModule);
+      bank->getDataModule(dataModule.getID()).setDataSource(
+        bank->getDataSource(dataModule.getDataSource().getID())
       );
     }
   }
+  bank->buildIndex();
+  return bank;
 }
 
 bool JPetParamManager::readParametersFromFile(JPetReader* reader)
@@ -306,9 +375,12 @@ bool JPetParamManager::readParametersFromFile(JPetReader* reader)
     ERROR("Cannot read parameters from file. The provided JPetReader is closed.");
     return false;
   }
-  fBank = static_cast<JPetParamBank*>(reader->getObjectFromFile("ParamBank;1"));
-  if (!fBank)
+  auto bank = static_cast<JPetParamBank*>(reader->getObjectFromFile("ParamBank;1"));
+  if (!bank)
     return false;
+  bank->buildIndex();
+  fBank.reset(bank);
+  fMergedParamBanks = readMergedParamBanks([reader](const char* name) { return reader->getObjectFromFile(name); });
   return true;
 }
 
@@ -320,7 +392,7 @@ bool JPetParamManager::saveParametersToFile(JPetWriter* writer)
     ERROR("Could not write parameters to file. The provided JPetWriter is closed.");
     return false;
   }
-  writer->writeObject(fBank, "ParamBank");
+  writer->writeObject(fBank.get(), "ParamBank");
   return true;
 }
 
@@ -332,9 +404,12 @@ bool JPetParamManager::readParametersFromFile(std::string filename)
     ERROR("Could not read from file.");
     return false;
   }
-  fBank = static_cast<JPetParamBank*>(file.Get("ParamBank;1"));
-  if (!fBank)
+  auto bank = static_cast<JPetParamBank*>(file.Get("ParamBank;1"));
+  if (!bank)
     return false;
+  bank->buildIndex();
+  fBank.reset(bank);
+  fMergedParamBanks = readMergedParamBanks([&file](const char* name) { return file.Get(name); });
   return true;
 }
 
@@ -348,6 +423,8 @@ const JPetParamBank& JPetParamManager::getParamBank() const
     return DummyResult;
 }
 
+std::shared_ptr<const JPetParamBank> JPetParamManager::getParamBankAsShared() const { return fBank; }
+
 bool JPetParamManager::saveParametersToFile(std::string filename)
 {
   TFile file(filename.c_str(), "UPDATE");
@@ -358,12 +435,17 @@ bool JPetParamManager::saveParametersToFile(std::string filename)
   }
   file.cd();
   assert(fBank);
-  file.WriteObject(fBank, "ParamBank");
+  file.WriteObject(fBank.get(), "ParamBank");
   return true;
 }
 
+/**
+ * @brief Release the param bank, it can be shared with other managers,
+ * so it is replaced by an empty one instead of being cleared.
+ */
 void JPetParamManager::clearParameters()
 {
   assert(fBank);
-  fBank->clear();
+  fBank = std::make_shared<const JPetParamBank>();
+  fMergedParamBanks.clear();
 }
@@ -0,0 +1,47 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamResolver.cpp
+ */
+
+#include "JPetParamResolver/JPetParamResolver.h"
+
+const int JPetParamResolver::kNoID;
+
+JPetParamResolver::Binding::Binding(std::shared_ptr<const JPetParamBank> bank) : fPreviousBank(getBoundParamBank())
+{
+  getBoundParamBank() = bank;
+  getGenerationCounter()++;
+}
+
+JPetParamResolver::Binding::~Binding()
+{
+  getBoundParamBank() = fPreviousBank;
+  getGenerationCounter()++;
+}
+
+/**
+ * @brief Returns the param bank bound to the current thread or nullptr if there is none.
+ */
+const JPetParamBank* JPetParamResolver::getParamBank() { return getBoundParamBank().get(); }
+
+std::shared_ptr<const JPetParamBank>& JPetParamResolver::getBoundParamBank()
+{
+  static thread_local std::shared_ptr<const JPetParamBank> bank;
+  return bank;
+}
+
+std::atomic<unsigned int>& JPetParamResolver::getGenerationCounter()
+{
+  static std::atomic<unsigned int> generation(0);
+  return generation;
+}
@@ -17,11 +17,30 @@
 
 using namespace jpet_options_tools;
 
-JPetParams::JPetParams() : fParamManager(0) {}
-
-JPetParams::JPetParams(const OptsStrAny& opts, std::shared_ptr<JPetParamManager> mgr) : fOptions(opts), fParamManager(mgr) {}
-
-OptsStrAny JPetParams::getOptions() const { return fOptions; }
+namespace
+{
+const std::shared_ptr<const OptsStrAny>& getEmptyOptions()
+{
+  static const std::shared_ptr<const OptsStrAny> emptyOptions = std::make_shared<const OptsStrAny>();
+  return emptyOptions;
+}
+}
+
+JPetParams::JPetParams() : fOptions(getEmptyOptions()), fParamManager(0) {}
+
+JPetParams::JPetParams(const OptsStrAny& opts, std::shared_ptr<JPetParamManager> mgr)
+    : fOptions(std::make_shared<const OptsStrAny>(opts)), fParamManager(mgr)
+{
+}
+
+JPetParams::JPetParams(std::shared_ptr<const OptsStrAny> opts, std::shared_ptr<JPetParamManager> mgr)
+    : fOptions(opts ? std::move(opts) : getEmptyOptions()), fParamManager(mgr)
+{
+}
+
+const OptsStrAny& JPetParams::getOptions() const { return *fOptions; }
+
+std::shared_ptr<const OptsStrAny> JPetParams::getOptionsAsShared() const { return fOptions; }
 
 JPetParamManager* JPetParams::getParamManager() const { return fParamManager.get(); }
 
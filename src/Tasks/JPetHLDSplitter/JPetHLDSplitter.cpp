@@ -0,0 +1,223 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDSplitter.cpp
+ */
+
+#include "JPetHLDSplitter/JPetHLDSplitter.h"
+#include "JPetLoggerInclude.h"
+#include "JPetTaskIO/JPetOutputHandler.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+const size_t JPetHLDSplitter::kHeaderSize = 32;
+const size_t JPetHLDSplitter::kEventAlignment = 8;
+const size_t JPetHLDSplitter::kDefaultChunkSize = 256 * 1024 * 1024;
+
+namespace
+{
+const size_t kReadBlockSize = 4 * 1024 * 1024;
+}
+
+JPetHLDSplitter::JPetHLDSplitter(const string& fileName, size_t chunkSize, const ChunkHandler& handler, long long maxEvents):
+  fFileName(fileName), fChunkSize(chunkSize), fHandler(handler), fMaxEvents(maxEvents) {}
+
+/**
+ * A chunk which was not closed is removed, it is never passed to the handler.
+ */
+JPetHLDSplitter::~JPetHLDSplitter()
+{
+  if (fChunk) {
+    fclose(fChunk);
+    remove(fChunkFileName.c_str());
+  }
+}
+
+/**
+ * Consume the next block of the data. Returns false if the splitting failed or if
+ * the event limit is reached and no more data is needed (see isEventLimitReached()).
+ */
+bool JPetHLDSplitter::write(const char* data, size_t size)
+{
+  while (size > 0 && !fIsFailed) {
+    size_t consumed = 0;
+    if (fFileHeader.size() < kHeaderSize) {
+      consumed = min(size, kHeaderSize - fFileHeader.size());
+      fFileHeader.append(data, consumed);
+    } else if (fEventBytesLeft > 0) {
+      consumed = min(size, fEventBytesLeft);
+      fEventBytesLeft -= consumed;
+      fIsFailed = !writeToChunk(data, consumed);
+    } else if (isEventLimitReached()) {
+      return false;
+    } else {
+      consumed = min(size, kHeaderSize - fEventHeader.size());
+      fEventHeader.append(data, consumed);
+      if (fEventHeader.size() == kHeaderSize) {
+        fIsFailed = !startEvent();
+      }
+    }
+    data += consumed;
+    size -= consumed;
+  }
+  return !fIsFailed;
+}
+
+/**
+ * Close the last chunk and pass it to the handler. Data ending in the middle of an event
+ * is kept in the last chunk as it is, so Unpacker2 treats it as at the end of the whole file.
+ * If there are no events, a chunk with only the file header is created.
+ * Returns false if the splitting failed.
+ */
+bool JPetHLDSplitter::close()
+{
+  if (fIsFailed) {
+    return false;
+  }
+  if (fFileHeader.size() < kHeaderSize) {
+    ERROR("The HLD data is shorter than the file header: " + fFileName);
+    fIsFailed = true;
+    return false;
+  }
+  if (!fChunk && (fNbOfChunks == 0 || !fEventHeader.empty())) {
+    fIsFailed = !openChunk();
+  }
+  if (!fIsFailed && !fEventHeader.empty()) {
+    fIsFailed = !writeToChunk(fEventHeader.data(), fEventHeader.size());
+    fEventHeader.clear();
+  }
+  if (!fIsFailed && fChunk) {
+    fIsFailed = !closeChunk();
+  }
+  return !fIsFailed;
+}
+
+/**
+ * True if the maximal number of events is set and all of them were already read.
+ */
+bool JPetHLDSplitter::isEventLimitReached() const
+{
+  return fMaxEvents > 0 && fNbOfEvents >= fMaxEvents;
+}
+
+long long JPetHLDSplitter::getNbOfEvents() const { return fNbOfEvents; }
+
+int JPetHLDSplitter::getNbOfChunks() const { return fNbOfChunks; }
+
+/**
+ * Split the HLD file with the given splitter and close it. Reaching the event limit
+ * of the splitter is not an error, the rest of the file is not read then.
+ */
+bool JPetHLDSplitter::splitFile(const string& hldFileName, JPetHLDSplitter& splitter)
+{
+  FILE* input = fopen(hldFileName.c_str(), "rb");
+  if (!input) {
+    ERROR("Cannot open the HLD file: " + hldFileName);
+    return false;
+  }
+  vector<char> buffer(kReadBlockSize);
+  bool isWritten = true;
+  size_t size = 0;
+  while (isWritten && (size = fread(buffer.data(), 1, buffer.size(), input)) > 0) {
+    isWritten = splitter.write(buffer.data(), size);
+  }
+  bool isRead = !ferror(input);
+  fclose(input);
+  if (!isRead) {
+    ERROR("Cannot read the HLD file: " + hldFileName);
+    return false;
+  }
+  if (!isWritten && !splitter.isEventLimitReached()) {
+    return false;
+  }
+  return splitter.close();
+}
+
+/**
+ * Chunk size in bytes for the size in MB given in the options, kDefaultChunkSize if it is not set.
+ */
+size_t JPetHLDSplitter::getChunkSize(int chunkSizeMB)
+{
+  return chunkSizeMB > 0 ? static_cast<size_t>(chunkSizeMB) * 1024 * 1024 : kDefaultChunkSize;
+}
+
+/**
+ * Called when the whole header of the next event is read. Closes the current chunk
+ * if the event does not fit into it and writes the header to the chunk.
+ */
+bool JPetHLDSplitter::startEvent()
+{
+  uint32_t eventSize = 0;
+  memcpy(&eventSize, fEventHeader.data(), sizeof(eventSize));
+  if (eventSize < kHeaderSize) {
+    ERROR("Corrupted HLD data, event " + to_string(fNbOfEvents) + " has the size " + to_string(eventSize) + " in: " + fFileName);
+    return false;
+  }
+  size_t paddedSize = (eventSize + kEventAlignment - 1) / kEventAlignment * kEventAlignment;
+  if (fChunk && fChunkSizeOfEvents > 0 && fChunkSizeOfEvents + paddedSize > fChunkSize && !closeChunk()) {
+    return false;
+  }
+  if (!fChunk && !openChunk()) {
+    return false;
+  }
+  fEventBytesLeft = paddedSize - kHeaderSize;
+  fNbOfEvents++;
+  bool isWritten = writeToChunk(fEventHeader.data(), kHeaderSize);
+  fEventHeader.clear();
+  return isWritten;
+}
+
+bool JPetHLDSplitter::writeToChunk(const char* data, size_t size)
+{
+  if (fwrite(data, 1, size, fChunk) != size) {
+    ERROR("Cannot write the HLD chunk: " + fChunkFileName);
+    return false;
+  }
+  fChunkSizeOfEvents += size;
+  return true;
+}
+
+bool JPetHLDSplitter::openChunk()
+{
+  fChunkFileName = JPetOutputHandler::getPartFileName(fFileName, fNbOfChunks);
+  fChunk = fopen(fChunkFileName.c_str(), "wb");
+  if (!fChunk) {
+    ERROR("Cannot open the HLD chunk: " + fChunkFileName);
+    return false;
+  }
+  fChunkSizeOfEvents = 0;
+  if (fwrite(fFileHeader.data(), 1, kHeaderSize, fChunk) != kHeaderSize) {
+    ERROR("Cannot write the HLD chunk: " + fChunkFileName);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Close the current chunk and pass it to the handler.
+ */
+bool JPetHLDSplitter::closeChunk()
+{
+  bool isClosed = fclose(fChunk) == 0;
+  fChunk = nullptr;
+  if (!isClosed) {
+    ERROR("Cannot write the HLD chunk: " + fChunkFileName);
+    remove(fChunkFileName.c_str());
+    return false;
+  }
+  fNbOfChunks++;
+  return fHandler(fChunkFileName);
+}
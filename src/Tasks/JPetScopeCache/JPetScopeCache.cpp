@@ -0,0 +1,414 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeCache.cpp
+ */
+
+#include "JPetScopeCache/JPetScopeCache.h"
+#include "JPetLoggerInclude.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cstring>
+
+const std::string JPetScopeCache::kCacheFileSuffix = ".scope.cache";
+
+namespace
+{
+const char kMagic[8] = {'J', 'P', 'E', 'T', 'S', 'C', 'O', 'P'};
+/// Read in the native byte order, so it also rejects caches written on machines of different endianness
+const std::uint32_t kVersion = 1;
+const std::uint64_t kFNVOffset = 14695981039346656037ull;
+const std::uint64_t kFNVPrime = 1099511628211ull;
+const std::uint32_t kMaxNbOfPoints = 1u << 28;
+const std::size_t kChecksumBufferSize = 1 << 20;
+
+/// FNV-1a hash of the bytes, continuing from the given hash
+std::uint64_t updateHash(std::uint64_t hash, const void* data, std::size_t size)
+{
+  auto bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; i++)
+  {
+    hash = (hash ^ bytes[i]) * kFNVPrime;
+  }
+  return hash;
+}
+
+std::uint64_t updateHash(std::uint64_t hash, const std::string& value) { return updateHash(hash, value.c_str(), value.size() + 1); }
+
+std::int64_t getModificationTime(const std::string& directory)
+{
+  boost::system::error_code error;
+  auto time = boost::filesystem::last_write_time(directory, error);
+  return error ? -1 : static_cast<std::int64_t>(time);
+}
+}
+
+/**
+ * @brief The cache is identified by the input directory and the mapping of the file prefixes to the photomultiplier ids.
+ */
+JPetScopeCache::JPetScopeCache(const std::string& cacheFileName, const std::string& inputDirectory,
+                               const std::map<std::string, int>& prefixToPMId)
+    : fCacheFileName(cacheFileName), fInputDirectory(inputDirectory)
+{
+  fKey = updateHash(kFNVOffset, boost::filesystem::absolute(inputDirectory).string());
+  for (const auto& prefix : prefixToPMId)
+  {
+    fKey = updateHash(fKey, prefix.first);
+    fKey = updateHash(fKey, &prefix.second, sizeof(prefix.second));
+  }
+}
+
+JPetScopeCache::~JPetScopeCache()
+{
+  if (fOutput.is_open())
+  {
+    abortWriting();
+  }
+}
+
+/**
+ * @brief Open the cache for reading. Returns false if the cache does not exist,
+ * is outdated or corrupted, in which case it should be recreated.
+ */
+bool JPetScopeCache::open()
+{
+  fInput.open(fCacheFileName, std::ios::binary);
+  if (!fInput.is_open())
+  {
+    DEBUG(std::string("No scope cache file: ") + fCacheFileName);
+    return false;
+  }
+  if (!isChecksumCorrect() || !readHeader())
+  {
+    fInput.close();
+    fWindows.clear();
+    return false;
+  }
+  fNextWindow = 0;
+  return true;
+}
+
+const std::vector<JPetScopeCache::Window>& JPetScopeCache::getWindows() const { return fWindows; }
+
+/**
+ * @brief Read the signals of the next time window.
+ */
+bool JPetScopeCache::readSignals(Signals& signals)
+{
+  signals.clear();
+  if (!fInput.is_open() || fNextWindow >= fWindows.size())
+  {
+    return false;
+  }
+  std::vector<float> points;
+  for (const auto& file : fWindows[fNextWindow].second)
+  {
+    std::uint32_t nbOfPoints = 0;
+    if (!readValue(nbOfPoints) || nbOfPoints > kMaxNbOfPoints)
+    {
+      return false;
+    }
+    points.resize(2 * nbOfPoints);
+    if (!read(points.data(), points.size() * sizeof(float)))
+    {
+      return false;
+    }
+    JPetRecoSignal signal(nbOfPoints);
+    for (std::uint32_t i = 0; i < nbOfPoints; i++)
+    {
+      signal.setShapePoint(points[2 * i], points[2 * i + 1]);
+    }
+    signals.emplace(file.first, std::move(signal));
+  }
+  fNextWindow++;
+  return true;
+}
+
+/**
+ * @brief Store the modification times of the input directory and all its subdirectories.
+ *
+ * Should be called before the directory is scanned, so that the files added
+ * during the scan make the cache outdated.
+ */
+void JPetScopeCache::snapshotDirectories()
+{
+  fDirectories.clear();
+  if (!boost::filesystem::is_directory(fInputDirectory))
+  {
+    return;
+  }
+  fDirectories.emplace_back(fInputDirectory, getModificationTime(fInputDirectory));
+  boost::system::error_code error;
+  for (boost::filesystem::recursive_directory_iterator iter(fInputDirectory, error), end; !error && iter != end; iter.increment(error))
+  {
+    if (boost::filesystem::is_directory(iter->status()))
+    {
+      auto directory = iter->path().string();
+      fDirectories.emplace_back(directory, getModificationTime(directory));
+    }
+  }
+  std::sort(fDirectories.begin(), fDirectories.end());
+}
+
+/**
+ * @brief Start writing the cache with the given time windows.
+ *
+ * The cache is written to a temporary file, which replaces the cache file in close().
+ */
+bool JPetScopeCache::create(const std::vector<Window>& windows)
+{
+  if (fDirectories.empty())
+  {
+    snapshotDirectories();
+  }
+  fWindows = windows;
+  fNextWindow = 0;
+  fChecksum = kFNVOffset;
+  fOutput.open(getTemporaryFileName(), std::ios::binary | std::ios::trunc);
+  if (!fOutput.is_open())
+  {
+    WARNING(std::string("Cannot create the scope cache file: ") + fCacheFileName);
+    return false;
+  }
+  bool isOK = write(kMagic, sizeof(kMagic)) && writeValue(kVersion) && writeValue(fKey);
+  isOK = isOK && writeValue(static_cast<std::uint32_t>(fDirectories.size()));
+  for (const auto& directory : fDirectories)
+  {
+    isOK = isOK && writeString(directory.first) && writeValue(directory.second);
+  }
+  isOK = isOK && writeValue(static_cast<std::uint32_t>(fWindows.size()));
+  for (const auto& window : fWindows)
+  {
+    isOK = isOK && writeValue(static_cast<std::int32_t>(window.first));
+    isOK = isOK && writeValue(static_cast<std::uint32_t>(window.second.size()));
+    for (const auto& file : window.second)
+    {
+      isOK = isOK && writeString(file.first) && writeValue(static_cast<std::int32_t>(file.second));
+    }
+  }
+  if (!isOK)
+  {
+    abortWriting();
+  }
+  return isOK;
+}
+
+/**
+ * @brief Write the signals of the next time window. Files missing in the signals are stored as empty signals.
+ */
+bool JPetScopeCache::writeSignals(const Signals& signals)
+{
+  if (!fOutput.is_open() || fNextWindow >= fWindows.size())
+  {
+    return false;
+  }
+  std::vector<float> points;
+  for (const auto& file : fWindows[fNextWindow].second)
+  {
+    points.clear();
+    auto signal = signals.find(file.first);
+    if (signal != signals.end())
+    {
+      for (const auto& point : signal->second.getShape())
+      {
+        points.push_back(point.time);
+        points.push_back(point.amplitude);
+      }
+    }
+    if (!writeValue(static_cast<std::uint32_t>(points.size() / 2)) || !write(points.data(), points.size() * sizeof(float)))
+    {
+      abortWriting();
+      return false;
+    }
+  }
+  fNextWindow++;
+  return true;
+}
+
+/**
+ * @brief Finish reading or writing. The written cache is stored only if the signals
+ * of all the windows were written.
+ */
+bool JPetScopeCache::close()
+{
+  if (fInput.is_open())
+  {
+    fInput.close();
+  }
+  if (!fOutput.is_open())
+  {
+    return true;
+  }
+  if (fNextWindow != fWindows.size())
+  {
+    abortWriting();
+    return false;
+  }
+  fOutput.write(reinterpret_cast<const char*>(&fChecksum), sizeof(fChecksum));
+  fOutput.close();
+  if (!fOutput)
+  {
+    abortWriting();
+    return false;
+  }
+  boost::system::error_code error;
+  boost::filesystem::rename(getTemporaryFileName(), fCacheFileName, error);
+  if (error)
+  {
+    WARNING(std::string("Cannot save the scope cache file: ") + fCacheFileName);
+    abortWriting();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Compare the checksum stored at the end of the cache with the one of its contents.
+ */
+bool JPetScopeCache::isChecksumCorrect()
+{
+  fInput.seekg(0, std::ios::end);
+  std::int64_t size = fInput.tellg();
+  fInput.seekg(0, std::ios::beg);
+  if (size < static_cast<std::int64_t>(sizeof(kMagic) + sizeof(kVersion) + sizeof(fKey) + sizeof(fChecksum)))
+  {
+    WARNING(std::string("The scope cache file is too short: ") + fCacheFileName);
+    return false;
+  }
+  std::vector<char> buffer(kChecksumBufferSize);
+  std::uint64_t checksum = kFNVOffset;
+  std::int64_t remaining = size - sizeof(fChecksum);
+  while (remaining > 0)
+  {
+    auto chunk = std::min<std::int64_t>(remaining, buffer.size());
+    if (!read(buffer.data(), chunk))
+    {
+      return false;
+    }
+    checksum = updateHash(checksum, buffer.data(), chunk);
+    remaining -= chunk;
+  }
+  std::uint64_t storedChecksum = 0;
+  if (!readValue(storedChecksum) || storedChecksum != checksum)
+  {
+    WARNING(std::string("The scope cache file is corrupted: ") + fCacheFileName);
+    return false;
+  }
+  fInput.seekg(0, std::ios::beg);
+  return true;
+}
+
+/**
+ * @brief Read the windows, checking that the cache matches the input directory.
+ */
+bool JPetScopeCache::readHeader()
+{
+  char magic[sizeof(kMagic)];
+  std::uint32_t version = 0;
+  std::uint64_t key = 0;
+  if (!read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !readValue(version) || version != kVersion)
+  {
+    WARNING(std::string("Unknown format of the scope cache file: ") + fCacheFileName);
+    return false;
+  }
+  if (!readValue(key) || key != fKey)
+  {
+    INFO(std::string("The scope cache was created for other input directory or parameters: ") + fCacheFileName);
+    return false;
+  }
+  std::uint32_t nbOfDirectories = 0;
+  if (!readValue(nbOfDirectories))
+  {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < nbOfDirectories; i++)
+  {
+    std::string directory;
+    std::int64_t modificationTime = 0;
+    if (!readString(directory) || !readValue(modificationTime))
+    {
+      return false;
+    }
+    if (getModificationTime(directory) != modificationTime)
+    {
+      INFO(std::string("The scope cache is outdated, the directory was modified: ") + directory);
+      return false;
+    }
+  }
+  std::uint32_t nbOfWindows = 0;
+  if (!readValue(nbOfWindows))
+  {
+    return false;
+  }
+  fWindows.clear();
+  for (std::uint32_t i = 0; i < nbOfWindows; i++)
+  {
+    std::int32_t index = 0;
+    std::uint32_t nbOfFiles = 0;
+    if (!readValue(index) || !readValue(nbOfFiles))
+    {
+      return false;
+    }
+    Window window;
+    window.first = index;
+    for (std::uint32_t j = 0; j < nbOfFiles; j++)
+    {
+      std::string fileName;
+      std::int32_t pmId = 0;
+      if (!readString(fileName) || !readValue(pmId))
+      {
+        return false;
+      }
+      window.second[fileName] = pmId;
+    }
+    fWindows.push_back(std::move(window));
+  }
+  return true;
+}
+
+bool JPetScopeCache::write(const void* data, std::size_t size)
+{
+  fChecksum = updateHash(fChecksum, data, size);
+  fOutput.write(static_cast<const char*>(data), size);
+  return fOutput.good();
+}
+
+bool JPetScopeCache::writeString(const std::string& value)
+{
+  return writeValue(static_cast<std::uint32_t>(value.size())) && write(value.data(), value.size());
+}
+
+bool JPetScopeCache::read(void* data, std::size_t size)
+{
+  fInput.read(static_cast<char*>(data), size);
+  return fInput.good();
+}
+
+bool JPetScopeCache::readString(std::string& value)
+{
+  std::uint32_t size = 0;
+  if (!readValue(size) || size > kChecksumBufferSize)
+  {
+    return false;
+  }
+  value.resize(size);
+  return read(&value[0], size);
+}
+
+void JPetScopeCache::abortWriting()
+{
+  fOutput.close();
+  boost::system::error_code error;
+  boost::filesystem::remove(getTemporaryFileName(), error);
+}
+
+std::string JPetScopeCache::getTemporaryFileName() const { return fCacheFileName + ".tmp"; }
@@ -0,0 +1,328 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeFileReader.cpp
+ */
+
+#include "JPetScopeFileReader/JPetScopeFileReader.h"
+#include "JPetLoggerInclude.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const double JPetScopeFileReader::kSecondsToPicoseconds = 1.0e+12;
+const double JPetScopeFileReader::kVoltsToMillivolts = 1.0e+3;
+
+namespace
+{
+/// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string& fileName)
+  {
+    int descriptor = open(fileName.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+      return;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) == 0)
+    {
+      fSize = status.st_size;
+      fIsOpen = true;
+      if (fSize > 0)
+      {
+        void* data = mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+          fIsOpen = false;
+          fSize = 0;
+        }
+        else
+        {
+          fData = static_cast<const char*>(data);
+          madvise(data, fSize, MADV_SEQUENTIAL);
+        }
+      }
+    }
+    close(descriptor);
+  }
+  ~MappedFile()
+  {
+    if (fData)
+    {
+      munmap(const_cast<char*>(fData), fSize);
+    }
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool isOpen() const { return fIsOpen; }
+  const char* data() const { return fData; }
+  std::size_t size() const { return fSize; }
+
+private:
+  const char* fData = nullptr;
+  std::size_t fSize = 0;
+  bool fIsOpen = false;
+};
+
+/// Exactly representable powers of ten
+const double kPowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+const int kMaxExactPowerOfTen = 22;
+const int kMaxMantissaDigits = 19;
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline bool isSpace(char c) { return isBlank(c) || c == '\n' || c == '\v' || c == '\f'; }
+
+inline const char* skipSpaces(const char* pos, const char* end)
+{
+  while (pos < end && isSpace(*pos))
+  {
+    ++pos;
+  }
+  return pos;
+}
+
+inline const char* skipLine(const char* pos, const char* end)
+{
+  while (pos < end && *pos != '\n')
+  {
+    ++pos;
+  }
+  return pos < end ? pos + 1 : end;
+}
+
+inline const char* skipToken(const char* pos, const char* end)
+{
+  pos = skipSpaces(pos, end);
+  while (pos < end && !isSpace(*pos))
+  {
+    ++pos;
+  }
+  return pos;
+}
+}
+
+/**
+ * @brief Read the signal from the oscilloscope file. Returns false if the file cannot be read.
+ */
+bool JPetScopeFileReader::readSignal(const std::string& fileName, JPetRecoSignal& signal)
+{
+  MappedFile file(fileName);
+  if (!file.isOpen())
+  {
+    ERROR(std::string("Error: cannot open file ") + fileName);
+    signal = JPetRecoSignal(0);
+    return false;
+  }
+  return parseSignal(file.data(), file.size(), hasHeader(fileName), signal, fileName);
+}
+
+/**
+ * @brief Parse the contents of the oscilloscope file.
+ *
+ * The header contains the number of points in the fourth field of its second line.
+ * Each of the following lines contains the time and the amplitude of one point.
+ * Lines which cannot be parsed are reported and skipped.
+ * Returns false if the data does not contain all the points declared in the header.
+ */
+bool JPetScopeFileReader::parseSignal(const char* data, std::size_t size, bool hasHeader, JPetRecoSignal& signal,
+                                      const std::string& fileName)
+{
+  const char* pos = data;
+  const char* end = data + size;
+  int segmentSize = 0;
+  if (hasHeader)
+  {
+    pos = skipLine(pos, end);
+    auto lineEnd = skipLine(pos, end);
+    auto field = skipToken(skipToken(skipToken(pos, lineEnd), lineEnd), lineEnd);
+    if (!parseInt(skipSpaces(field, lineEnd), lineEnd, segmentSize) || segmentSize < 0)
+    {
+      segmentSize = 0;
+    }
+    pos = lineEnd;
+    for (int i = 2; i < kNbOfHeaderLines; i++)
+    {
+      pos = skipLine(pos, end);
+    }
+  }
+  signal = JPetRecoSignal(segmentSize);
+  for (int i = 0; i < segmentSize; ++i)
+  {
+    pos = skipSpaces(pos, end);
+    if (pos == end)
+    {
+      ERROR(std::string("Unexpected end of file ") + fileName + " after " + std::to_string(i) + " of " +
+            std::to_string(segmentSize) + " points");
+      return false;
+    }
+    float value = 0.f;
+    float threshold = 0.f;
+    auto next = parseFloat(pos, end, value);
+    if (next)
+    {
+      next = parseFloat(skipSpaces(next, end), end, threshold);
+    }
+    if (!next)
+    {
+      ERROR(std::string("Non-numerical symbol in file ") + fileName + " at line " + std::to_string(i + 1 + (hasHeader ? kNbOfHeaderLines : 0)));
+      pos = skipLine(pos, end);
+      continue;
+    }
+    pos = next;
+    float time = value * kSecondsToPicoseconds;
+    float amplitude = threshold * kVoltsToMillivolts;
+    signal.setShapePoint(time, amplitude);
+  }
+  return true;
+}
+
+/**
+ * @brief Parse the decimal floating point number starting at pos, in the format
+ * accepted by strtof in the "C" locale (without hex, inf and nan).
+ *
+ * Returns the position after the number or nullptr if there is no number at pos.
+ */
+const char* JPetScopeFileReader::parseFloat(const char* pos, const char* end, float& value)
+{
+  bool isNegative = false;
+  if (pos < end && (*pos == '-' || *pos == '+'))
+  {
+    isNegative = *pos == '-';
+    ++pos;
+  }
+  std::uint64_t mantissa = 0;
+  int nbOfDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  for (; pos < end && isDigit(*pos); ++pos)
+  {
+    hasDigits = true;
+    if (nbOfDigits < kMaxMantissaDigits)
+    {
+      mantissa = mantissa * 10 + (*pos - '0');
+      nbOfDigits += mantissa > 0;
+    }
+    else
+    {
+      exponent++;
+    }
+  }
+  if (pos < end && *pos == '.')
+  {
+    for (++pos; pos < end && isDigit(*pos); ++pos)
+    {
+      hasDigits = true;
+      if (nbOfDigits < kMaxMantissaDigits)
+      {
+        mantissa = mantissa * 10 + (*pos - '0');
+        nbOfDigits += mantissa > 0;
+        exponent--;
+      }
+    }
+  }
+  if (!hasDigits)
+  {
+    return nullptr;
+  }
+  if (pos < end && (*pos == 'e' || *pos == 'E'))
+  {
+    auto exponentPos = pos + 1;
+    bool isExponentNegative = false;
+    if (exponentPos < end && (*exponentPos == '-' || *exponentPos == '+'))
+    {
+      isExponentNegative = *exponentPos == '-';
+      ++exponentPos;
+    }
+    if (exponentPos < end && isDigit(*exponentPos))
+    {
+      int explicitExponent = 0;
+      for (; exponentPos < end && isDigit(*exponentPos); ++exponentPos)
+      {
+        if (explicitExponent < 10000)
+        {
+          explicitExponent = explicitExponent * 10 + (*exponentPos - '0');
+        }
+      }
+      exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+      pos = exponentPos;
+    }
+  }
+  double result = static_cast<double>(mantissa);
+  if (mantissa != 0)
+  {
+    if (exponent < 0 && exponent >= -kMaxExactPowerOfTen)
+    {
+      result /= kPowersOfTen[-exponent];
+    }
+    else if (exponent > 0 && exponent <= kMaxExactPowerOfTen)
+    {
+      result *= kPowersOfTen[exponent];
+    }
+    else if (exponent != 0)
+    {
+      result *= std::pow(10., exponent);
+    }
+  }
+  value = static_cast<float>(isNegative ? -result : result);
+  return pos;
+}
+
+/**
+ * @brief Parse the decimal integer starting at pos. Returns the position after it or nullptr.
+ */
+const char* JPetScopeFileReader::parseInt(const char* pos, const char* end, int& value)
+{
+  bool isNegative = false;
+  if (pos < end && (*pos == '-' || *pos == '+'))
+  {
+    isNegative = *pos == '-';
+    ++pos;
+  }
+  if (pos == end || !isDigit(*pos))
+  {
+    return nullptr;
+  }
+  long long result = 0;
+  for (; pos < end && isDigit(*pos); ++pos)
+  {
+    if (result <= std::numeric_limits<int>::max())
+    {
+      result = result * 10 + (*pos - '0');
+    }
+  }
+  if (result > std::numeric_limits<int>::max())
+  {
+    return nullptr;
+  }
+  value = static_cast<int>(isNegative ? -result : result);
+  return pos;
+}
+
+/**
+ * @brief The .tsv files contain only the points, the other files start with the header.
+ */
+bool JPetScopeFileReader::hasHeader(const std::string& fileName)
+{
+  return fileName.substr(fileName.find_last_of(".") + 1) != "tsv";
+}
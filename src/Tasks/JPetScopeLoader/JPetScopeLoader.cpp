@@ -20,6 +20,8 @@
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
 #include "JPetScopeConfigParser/JPetScopeConfigParser.h"
 #include "JPetScopeData/JPetScopeData.h"
+#include "JPetScopeCache/JPetScopeCache.h"
+#include "JPetScopeWindowReader/JPetScopeWindowReader.h"
 
 #include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
@@ -144,25 +146,90 @@ bool JPetScopeLoader::run(const JPetDataInterface&)
   auto opts = fParams.getOptions();
   auto config = confParser.getConfig(getScopeConfigFile(opts));
   auto prefix2PM = getPMPrefixToPMIdMap();
-  auto inputScopeFiles = createInputScopeFileNames(getScopeInputDirectory(opts), prefix2PM);
-  auto events = JPetScopeLoader::groupScopeFileNamesByTimeWindowIndex(inputScopeFiles);
-
-  for (auto& ev : events)
+  auto inputDirectory = getScopeInputDirectory(opts);
+  JPetScopeCache cache(getScopeCacheFileName(), inputDirectory, prefix2PM);
+  bool isCacheUsed = isScopeCache(opts);
+  if (isCacheUsed && cache.open())
   {
-    JPetScopeData data(ev);
-    subTask->run(data);
-    if (isOutput())
+    INFO(std::string("Reading the scope data from the cache: ") + getScopeCacheFileName());
+    const auto& windows = cache.getWindows();
+    for (std::size_t i = 0; i < windows.size(); i++)
     {
-      if (!fOutputHandler->writeEventToFile(subTask))
+      JPetScopeWindowReader::Signals signals;
+      if (!cache.readSignals(signals))
+      {
+        ERROR(std::string("Error in reading the scope cache: ") + getScopeCacheFileName());
+        return false;
+      }
+      if (!processWindow(subTask, JPetScopeData(windows[i], std::move(signals))))
       {
         return false;
       }
     }
+    cache.close();
+    subTask->terminate(fParams);
+    return true;
+  }
+
+  if (isCacheUsed)
+  {
+    cache.snapshotDirectories();
+  }
+  auto inputScopeFiles = createInputScopeFileNames(inputDirectory, prefix2PM);
+  auto events = JPetScopeLoader::groupScopeFileNamesByTimeWindowIndex(inputScopeFiles);
+
+  /// The files of the next time windows are parsed in parallel, while the task processes the current one
+  std::vector<JPetScopeWindowReader::Window> windows(events.begin(), events.end());
+  JPetScopeWindowReader windowReader(windows);
+  INFO(Form("Parsing the files of %d time windows with %d threads", static_cast<int>(windows.size()), windowReader.getNbOfThreads()));
+  bool isCacheWritten = isCacheUsed && !windows.empty() && cache.create(windows);
+  for (std::size_t i = 0; i < windows.size(); i++)
+  {
+    auto signals = windowReader.getSignals(i);
+    if (isCacheWritten)
+    {
+      isCacheWritten = cache.writeSignals(signals);
+    }
+    if (!processWindow(subTask, JPetScopeData(windows[i], std::move(signals))))
+    {
+      return false;
+    }
+  }
+  if (isCacheWritten && cache.close())
+  {
+    INFO(std::string("The scope data saved in the cache: ") + getScopeCacheFileName());
   }
   subTask->terminate(fParams);
   return true;
 }
 
+bool JPetScopeLoader::processWindow(JPetTaskInterface* subTask, const JPetScopeData& data)
+{
+  subTask->run(data);
+  if (isOutput())
+  {
+    if (!fOutputHandler->writeEventToFile(subTask))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Returns the name of the binary cache of the scope data, placed next to the output file.
+ */
+std::string JPetScopeLoader::getScopeCacheFileName() const
+{
+  std::string fileName = fTaskInfo.fOutFileFullPath;
+  auto suffix = "." + fTaskInfo.fOutFileType + ".root";
+  if (fileName.size() > suffix.size() && fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) == 0)
+  {
+    fileName.erase(fileName.size() - suffix.size());
+  }
+  return fileName + JPetScopeCache::kCacheFileSuffix;
+}
+
 bool JPetScopeLoader::terminate(JPetParams& output_params)
 {
   OptsStrAny new_opts;
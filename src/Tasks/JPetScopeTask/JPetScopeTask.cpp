@@ -30,7 +30,10 @@ bool JPetScopeTask::run(const JPetDataInterface& inData)
 {
   auto& currData = dynamic_cast<const JPetScopeData&>(inData);
   fInputFilesInCurrentWindow = currData.getEvent();
-  return exec();
+  fCurrentData = &currData;
+  bool isOK = exec();
+  fCurrentData = nullptr;
+  return isOK;
 }
 
 bool JPetScopeTask::init()
@@ -54,15 +57,20 @@ bool JPetScopeTask::exec()
     auto files = fInputFilesInCurrentWindow.second;
     for (const auto& file : files)
     {
-      DEBUG(std::string("file to open:") + file.first);
-      JPetRecoSignal sig = RecoSignalUtils::generateSignal(file.first.c_str());
+      /// The signals are moved to the output window, not copied
+      auto parsedSignal = fCurrentData ? fCurrentData->findSignal(file.first) : nullptr;
+      if (!parsedSignal)
+      {
+        DEBUG(std::string("file to open:") + file.first);
+      }
+      auto& sig = parsedSignal ? fOutputEvents->emplace<JPetRecoSignal>(std::move(*parsedSignal))
+                               : fOutputEvents->emplace<JPetRecoSignal>(RecoSignalUtils::generateSignal(file.first.c_str()));
       DEBUG("before setPM");
       const JPetPM& pm = bank.getPM(file.second);
       const JPetBarrelSlot& bs = pm.getBarrelSlot();
       sig.setPM(pm);
       sig.setBarrelSlot(bs);
       DEBUG("after setPM");
-      fOutputEvents->add<JPetRecoSignal>(sig);
     }
   }
   return true;
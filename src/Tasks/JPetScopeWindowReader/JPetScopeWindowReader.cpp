@@ -0,0 +1,109 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeWindowReader.cpp
+ */
+
+#include "JPetScopeWindowReader/JPetScopeWindowReader.h"
+#include "JPetScopeFileReader/JPetScopeFileReader.h"
+#include <algorithm>
+
+/**
+ * @brief Start parsing the windows.
+ *
+ * If the number of threads is 0, the number of hardware threads is used.
+ * If maxWindowsAhead is 0, it is four times the number of threads.
+ */
+JPetScopeWindowReader::JPetScopeWindowReader(const std::vector<Window>& windows, unsigned int nbOfThreads, std::size_t maxWindowsAhead)
+    : fWindows(windows), fSignals(windows.size()), fIsParsed(windows.size(), false)
+{
+  if (nbOfThreads == 0)
+  {
+    nbOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  nbOfThreads = std::min<std::size_t>(nbOfThreads, std::max<std::size_t>(1, fWindows.size()));
+  fMaxWindowsAhead = maxWindowsAhead > 0 ? maxWindowsAhead : 4 * nbOfThreads;
+  for (unsigned int i = 0; i < nbOfThreads; i++)
+  {
+    fWorkers.emplace_back(&JPetScopeWindowReader::work, this);
+  }
+}
+
+JPetScopeWindowReader::~JPetScopeWindowReader()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fIsStopped = true;
+  }
+  fConsumed.notify_all();
+  for (auto& worker : fWorkers)
+  {
+    worker.join();
+  }
+}
+
+std::size_t JPetScopeWindowReader::getNbOfWindows() const { return fWindows.size(); }
+
+unsigned int JPetScopeWindowReader::getNbOfThreads() const { return fWorkers.size(); }
+
+/**
+ * @brief Wait until the window with the given index is parsed and return its signals.
+ *
+ * The windows must be taken in order, each of them once.
+ */
+JPetScopeWindowReader::Signals JPetScopeWindowReader::getSignals(std::size_t index)
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fParsed.wait(lock, [this, index]() { return fIsParsed[index]; });
+  auto signals = std::move(fSignals[index]);
+  fNextToConsume = index + 1;
+  lock.unlock();
+  fConsumed.notify_all();
+  return signals;
+}
+
+/**
+ * @brief Parse all files of the window. Files which cannot be read give empty signals.
+ */
+JPetScopeWindowReader::Signals JPetScopeWindowReader::readWindow(const Window& window)
+{
+  Signals signals;
+  for (const auto& file : window.second)
+  {
+    JPetScopeFileReader::readSignal(file.first, signals[file.first]);
+  }
+  return signals;
+}
+
+void JPetScopeWindowReader::work()
+{
+  while (true)
+  {
+    std::size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fConsumed.wait(lock, [this]() { return fIsStopped || fNextToParse >= fWindows.size() || fNextToParse < fNextToConsume + fMaxWindowsAhead; });
+      if (fIsStopped || fNextToParse >= fWindows.size())
+      {
+        return;
+      }
+      index = fNextToParse++;
+    }
+    auto signals = readWindow(fWindows[index]);
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fSignals[index] = std::move(signals);
+      fIsParsed[index] = true;
+    }
+    fParsed.notify_all();
+  }
+}
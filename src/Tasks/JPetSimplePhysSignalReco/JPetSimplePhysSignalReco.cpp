@@ -15,6 +15,7 @@
 
 #include "JPetSimplePhysSignalReco/JPetSimplePhysSignalReco.h"
 #include "JPetSimplePhysSignalReco/HelperMathFunctions.h"
+#include "JPetTypedWindowView/JPetTypedWindowView.h"
 #include "JPetWriter/JPetWriter.h"
 
 #include <boost/property_tree/json_parser.hpp>
@@ -23,6 +24,50 @@
 
 using namespace boost::numeric::ublas;
 
+static_assert(JPetRawSignal::kNumberOfThresholds <= PolynomialFitBatch::kMaxPoints, "the batch must take the points at all thresholds");
+
+namespace
+{
+const int kNotInBatch = -1;
+
+/**
+ * Reads the leading edge points from the threshold index of the signal, ordered by the threshold value
+ * as getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrValue) does, but without allocating and sorting the copies.
+ * Returns the number of points.
+ */
+int getLeadingPointsByThrValue(const JPetRawSignal& rawSignal, float* times, float* volts)
+{
+  int numberOfPoints = 0;
+  for (unsigned int thrNum = 1; thrNum <= JPetRawSignal::kNumberOfThresholds; thrNum++)
+  {
+    if (!rawSignal.hasPoint(JPetSigCh::Leading, thrNum))
+    {
+      continue;
+    }
+    float time = rawSignal.getTime(JPetSigCh::Leading, thrNum);
+    float volt = rawSignal.getThresholdValue(JPetSigCh::Leading, thrNum);
+    int k = numberOfPoints++;
+    for (; k > 0 && volt < volts[k - 1]; k--)
+    {
+      times[k] = times[k - 1];
+      volts[k] = volts[k - 1];
+    }
+    times[k] = time;
+    volts[k] = volt;
+  }
+  return numberOfPoints;
+}
+
+/**
+ * Returns the reconstructed time at the lowest threshold, used if the time cannot be fitted, or 0 if there are no reconstructed times.
+ */
+double getFirstRecoTime(const JPetRecoSignal& recoSignal)
+{
+  const auto& recoTimes = recoSignal.getRecoTimesAtThreshold();
+  return recoTimes.empty() ? 0. : recoTimes.begin()->second;
+}
+}
+
 JPetSimplePhysSignalReco::JPetSimplePhysSignalReco() : fAlpha(1), fThresholdSel(-1) { readConfigFileAndSetAlphaAndThreshParams("configParams.json"); }
 
 JPetSimplePhysSignalReco::~JPetSimplePhysSignalReco() {}
@@ -31,40 +76,108 @@ bool JPetSimplePhysSignalReco::exec() { return true; }
 
 void JPetSimplePhysSignalReco::savePhysSignal(JPetPhysSignal) {}
 
+/**
+ * Creates the JPetPhysSignals from all JPetRecoSignals of the time window,
+ * fitting their times together in one batch. Returns no signals if the window
+ * does not contain JPetRecoSignals.
+ */
+std::vector<JPetPhysSignal> JPetSimplePhysSignalReco::createPhysSignals(const JPetTimeWindow& window)
+{
+  JPetTypedWindowView<const JPetRecoSignal> recoSignals(window);
+  if (!recoSignals.isValid())
+  {
+    return {};
+  }
+  auto numberOfSignals = recoSignals.size();
+  std::vector<double> times(numberOfSignals);
+  fFitBatch.clear();
+  fFitBatch.reserve(numberOfSignals);
+  fFitIndices.assign(numberOfSignals, kNotInBatch);
+  for (std::size_t i = 0; i < numberOfSignals; i++)
+  {
+    const auto& recoSignal = recoSignals[i];
+    times[i] = getFirstRecoTime(recoSignal);
+    if (addToFitBatch(recoSignal.getRawSignal(), times[i]))
+    {
+      fFitIndices[i] = fFitBatch.getSize() - 1;
+    }
+  }
+  fFitBatch.fit(getAlpha(), getThresholdSel(), fFitTimes);
+  std::vector<JPetPhysSignal> physSignals;
+  physSignals.reserve(numberOfSignals);
+  for (std::size_t i = 0; i < numberOfSignals; i++)
+  {
+    double time = fFitIndices[i] == kNotInBatch ? times[i] : static_cast<double>(fFitTimes[fFitIndices[i]]);
+    physSignals.push_back(createPhysSignal(recoSignals[i], time));
+  }
+  return physSignals;
+}
+
 /**
  * Simple example of creating JPetPhysSignal from JPetRecoSignal
  */
 JPetPhysSignal JPetSimplePhysSignalReco::createPhysSignal(JPetRecoSignal& recoSignal)
+{
+  double time = getFirstRecoTime(recoSignal);
+  fFitBatch.clear();
+  if (addToFitBatch(recoSignal.getRawSignal(), time))
+  {
+    fFitBatch.fit(getAlpha(), getThresholdSel(), fFitTimes);
+    time = static_cast<double>(fFitTimes.front());
+  }
+  return createPhysSignal(recoSignal, time);
+}
+
+JPetPhysSignal JPetSimplePhysSignalReco::createPhysSignal(const JPetRecoSignal& recoSignal, double time) const
 {
   JPetPhysSignal physSignal;
   physSignal.setPhe(recoSignal.getCharge() * 1.0 + 0.0);
   physSignal.setQualityOfPhe(1.0);
-  double time = recoSignal.getRecoTimesAtThreshold().begin()->second;
-  JPetRawSignal rawSignal = recoSignal.getRawSignal();
-
-  if (rawSignal.getNumberOfPoints(JPetSigCh::Leading) >= 2 && rawSignal.getNumberOfPoints(JPetSigCh::Trailing) >= 2)
-  {
-    int iNumPoints = rawSignal.getNumberOfPoints(JPetSigCh::Leading);
-    std::vector<JPetSigCh> leadingPoints = rawSignal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrValue);
-    vector<float> vecTime(iNumPoints);
-    vector<float> vecVolt(iNumPoints);
-    for (int j = 0; j < iNumPoints; j++)
-    {
-      vecTime(j) = leadingPoints.at(j).getValue();
-      vecVolt(j) = leadingPoints.at(j).getThreshold();
-    }
-    int alfa = getAlpha();
-    float thr_sel = getThresholdSel();
-    assert(thr_sel < 0);
-    assert(alfa > 0);
-    time = static_cast<double>(polynomialFit(vecTime, vecVolt, alfa, thr_sel));
-  }
   physSignal.setTime(time);
   physSignal.setQualityOfTime(1.0);
   physSignal.setRecoSignal(recoSignal);
   return physSignal;
 }
 
+/**
+ * Adds the leading edge points of the signal to the batch of fits, if it has at least 2 points on both edges.
+ * The points are read from the threshold index of the signal. The signals with doubled thresholds
+ * are read from their points and, if they have more points than the batch takes, fitted at once
+ * with polynomialFit(), setting the time. Returns true if the signal is added to the batch.
+ */
+bool JPetSimplePhysSignalReco::addToFitBatch(const JPetRawSignal& rawSignal, double& time)
+{
+  if (rawSignal.getNumberOfPoints(JPetSigCh::Leading) < 2 || rawSignal.getNumberOfPoints(JPetSigCh::Trailing) < 2)
+  {
+    return false;
+  }
+  int alfa = getAlpha();
+  float thr_sel = getThresholdSel();
+  assert(thr_sel < 0);
+  assert(alfa > 0);
+  float times[PolynomialFitBatch::kMaxPoints];
+  float volts[PolynomialFitBatch::kMaxPoints];
+  if (rawSignal.isThresholdIndexComplete(JPetSigCh::Leading))
+  {
+    return fFitBatch.add(times, volts, getLeadingPointsByThrValue(rawSignal, times, volts));
+  }
+  std::vector<JPetSigCh> leadingPoints = rawSignal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrValue);
+  int iNumPoints = leadingPoints.size();
+  vector<float> vecTime(iNumPoints);
+  vector<float> vecVolt(iNumPoints);
+  for (int j = 0; j < iNumPoints; j++)
+  {
+    vecTime(j) = leadingPoints.at(j).getValue();
+    vecVolt(j) = leadingPoints.at(j).getThreshold();
+  }
+  if (fFitBatch.add(&vecTime(0), &vecVolt(0), iNumPoints))
+  {
+    return true;
+  }
+  time = static_cast<double>(polynomialFit(vecTime, vecVolt, alfa, thr_sel));
+  return false;
+}
+
 void JPetSimplePhysSignalReco::readConfigFileAndSetAlphaAndThreshParams(const char* filename)
 {
   boost::property_tree::ptree content;
@@ -17,7 +17,12 @@
 #include "JPetOptionsTools/JPetOptionsTools.h"
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetUnpackTask/JPetUnpackTask.h"
+#include "JPetHLDSplitter/JPetHLDSplitter.h"
 #include "JPetParams/JPetParams.h"
+#include "JPetStreamedFile/JPetStreamedFile.h"
+#include "JPetTaskIO/JPetOutputHandler.h"
+#include <TROOT.h>
+#include <cstdio>
 #include <fstream>
 
 using namespace jpet_options_tools;
@@ -25,6 +30,17 @@ using namespace std;
 
 JPetUnpackTask::JPetUnpackTask(const char* name) : JPetTask(name) {}
 
+JPetUnpackTask::~JPetUnpackTask()
+{
+  if (fUnpackThread.joinable()) {
+    fUnpackThread.join();
+  }
+  if (fUnpacker2) {
+    delete fUnpacker2;
+    fUnpacker2 = 0;
+  }
+}
+
 bool JPetUnpackTask::init(const JPetParams& inParams)
 {
   INFO("UnpackTask started.");
@@ -61,30 +77,37 @@ bool JPetUnpackTask::init(const JPetParams& inParams)
     WARNING("No TDC nonlinearity file set int the user options!");
   }
 
+  /// The input decompressed in the background exists only as the chunks handed over by JPetUnzipTask
+  bool isInputStreamed = isStreamUnpacking(fOptions) && JPetStreamedFile::find(getInputFile(fOptions));
+
   return validateFiles(
     fInputFilePath+fInputFile, fXMLConfFile,
     fTOTOffsetCalibFile, totCalibSet,
-    fTDCnonlinearityCalibFile, tdcCalibSet
+    fTDCnonlinearityCalibFile, tdcCalibSet,
+    isInputStreamed
   );
 }
 
 bool JPetUnpackTask::run(const JPetDataInterface&)
 {
-  int refChannelOffset = 65;
   fUnpacker2 = new Unpacker2();
-
   INFO(Form("Using Unpacker2 to process first %i events", fEventsToProcess));
-  fUnpacker2->UnpackSingleStep(
-    fInputFile, fInputFilePath, fOutputFilePath,
-    fXMLConfFile, fEventsToProcess, refChannelOffset,
-    fTOTOffsetCalibFile, fTDCnonlinearityCalibFile
-  );
-  return true;
+  if (isStreamUnpacking(fOptions)) {
+    /// The next task reads the output file in parallel with the unpacking
+    ROOT::EnableThreadSafety();
+    auto input = JPetStreamedFile::find(getInputFile(fOptions));
+    auto output = JPetStreamedFile::start(getUnpackedFileName());
+    INFO("Unpacking in the background, the unpacked data will be processed by the next task in parts.");
+    fUnpackThread = std::thread([this, input, output]() { output->finish(unpackStream(input, *output)); });
+    return true;
+  }
+  return unpack(fInputFile, fInputFilePath);
 }
 
 bool JPetUnpackTask::terminate(JPetParams& outParams)
 {
-  if (fUnpacker2) {
+  /// In the streaming mode Unpacker2 is still running and is deleted in the destructor
+  if (fUnpacker2 && !fUnpackThread.joinable()) {
     delete fUnpacker2;
     fUnpacker2 = 0;
   }
@@ -102,11 +125,108 @@ bool JPetUnpackTask::terminate(JPetParams& outParams)
   return true;
 }
 
+bool JPetUnpackTask::unpack(const std::string& inputFile, const std::string& inputFilePath)
+{
+  int refChannelOffset = 65;
+  try {
+    fUnpacker2->UnpackSingleStep(
+      inputFile, inputFilePath, fOutputFilePath,
+      fXMLConfFile, fEventsToProcess, refChannelOffset,
+      fTOTOffsetCalibFile, fTDCnonlinearityCalibFile
+    );
+  } catch (const std::exception& e) {
+    ERROR(Form("Unpacking failed: %s", e.what()));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Unpack the HLD data in chunks and publish the unpacked ones as the parts of the output.
+ * The chunks handed over by the previous task are unpacked one after another as they arrive.
+ * Otherwise the input file is split into chunks here, written next to the output,
+ * and every chunk is unpacked as soon as it is closed.
+ */
+bool JPetUnpackTask::unpackStream(std::shared_ptr<JPetStreamedFile> input, JPetStreamedFile& output)
+{
+  if (!input) {
+    JPetHLDSplitter splitter(
+      fOutputFilePath + fInputFile,
+      JPetHLDSplitter::getChunkSize(getStreamUnpackingChunkSizeMB(fOptions)),
+      [this, &output](const std::string& chunkFileName) { return unpackChunk(chunkFileName, output); },
+      fEventsToProcess
+    );
+    if (!JPetHLDSplitter::splitFile(fInputFilePath + fInputFile, splitter)) {
+      return false;
+    }
+    return writeManifest(output);
+  }
+  std::string chunkFileName;
+  for (std::size_t i = 0; input->waitForPart(i, chunkFileName); i++) {
+    if (!unpackChunk(chunkFileName, output)) {
+      return false;
+    }
+  }
+  if (!input->isSuccessful()) {
+    ERROR(Form("The HLD data was not handed over completely: %s", input->getFileName().c_str()));
+    return false;
+  }
+  return writeManifest(output);
+}
+
+/**
+ * Unpack a single chunk with a new instance of Unpacker2, remove it and publish the unpacked file.
+ */
+bool JPetUnpackTask::unpackChunk(const std::string& chunkFileName, JPetStreamedFile& output)
+{
+  auto chunkFile = JPetCommonTools::extractFileNameFromFullPath(chunkFileName);
+  auto chunkFilePath = JPetCommonTools::appendSlashToPathIfAbsent(
+    JPetCommonTools::extractPathFromFile(chunkFileName)
+  );
+  delete fUnpacker2;
+  fUnpacker2 = new Unpacker2();
+  bool isUnpacked = unpack(chunkFile, chunkFilePath);
+  std::remove(chunkFileName.c_str());
+  auto partFileName = fOutputFilePath + JPetCommonTools::replaceDataTypeInFileName(chunkFile, "hld");
+  if (!isUnpacked || !boost::filesystem::exists(partFileName)) {
+    ERROR(Form("Problem with unpacking the chunk: %s", chunkFileName.c_str()));
+    return false;
+  }
+  output.addPart(partFileName);
+  return true;
+}
+
+/**
+ * Write the list of the published parts, one file name per line.
+ */
+bool JPetUnpackTask::writeManifest(const JPetStreamedFile& output) const
+{
+  auto manifestFileName = JPetOutputHandler::getManifestFileName(getUnpackedFileName());
+  std::ofstream manifest(manifestFileName);
+  for (const auto& partFileName : output.getPartFileNames()) {
+    manifest << partFileName << std::endl;
+  }
+  if (!manifest.good()) {
+    ERROR(Form("Could not write the manifest of the unpacked parts: %s", manifestFileName.c_str()));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Name of the file written by Unpacker2, the same as the input file name of the next task.
+ */
+std::string JPetUnpackTask::getUnpackedFileName() const
+{
+  return fOutputFilePath + JPetCommonTools::replaceDataTypeInFileName(fInputFile, "hld");
+}
+
 bool JPetUnpackTask::validateFiles(
   string fileNameWithPath, string xmlConfig,
-  string totCalib, bool totCalibSet, string tdcCalib, bool tdcCalibSet
+  string totCalib, bool totCalibSet, string tdcCalib, bool tdcCalibSet,
+  bool isInputStreamed
 ){
-  if(!boost::filesystem::exists(fileNameWithPath)) {
+  if(!isInputStreamed && !boost::filesystem::exists(fileNameWithPath)) {
     ERROR(Form("No input HLD file found: %s", fileNameWithPath.c_str()));
     return false;
   }
@@ -17,7 +17,17 @@
 #include "JPetOptionsTools/JPetOptionsTools.h"
 #include "JPetCommonTools/JPetCommonTools.h"
 #include "JPetUnzipTask/JPetUnzipTask.h"
+#include "JPetHLDSplitter/JPetHLDSplitter.h"
 #include "JPetParams/JPetParams.h"
+#include "JPetStreamedFile/JPetStreamedFile.h"
+#include <algorithm>
+#include <bzlib.h>
+#include <cstdint>
+#include <cstdio>
+#include <lzma.h>
+#include <thread>
+#include <vector>
+#include <zlib.h>
 
 using namespace jpet_options_generator_tools;
 using namespace jpet_options_tools;
@@ -25,6 +35,13 @@ using namespace std;
 
 JPetUnzipTask::JPetUnzipTask(const char* name): JPetTask(name) {}
 
+JPetUnzipTask::~JPetUnzipTask()
+{
+  if (fUnzipThread.joinable()) {
+    fUnzipThread.join();
+  }
+}
+
 bool JPetUnzipTask::init(const JPetParams& inParams)
 {
   INFO("UnzipTask started.");
@@ -37,6 +54,17 @@ bool JPetUnzipTask::run(const JPetDataInterface&)
   auto inputFileWithPath = getInputFile(fOptions);
   auto outputPath = getOutputPath(fOptions);
   if(outputPath == "") { outputPath = "./"; }
+  if (isStreamUnpacking(fOptions)) {
+    /// The next task unpacks the chunks in parallel with the decompression
+    auto stream = JPetStreamedFile::start(getNextInputFile());
+    auto hldFileName = getUnzippedFileName(inputFileWithPath, outputPath);
+    auto chunkSize = JPetHLDSplitter::getChunkSize(getStreamUnpackingChunkSizeMB(fOptions));
+    INFO(Form("Unzipping file: %s in the background, handing over chunks of %s", inputFileWithPath.c_str(), hldFileName.c_str()));
+    fUnzipThread = std::thread([inputFileWithPath, hldFileName, chunkSize, stream]() {
+      stream->finish(unzipToChunks(inputFileWithPath, hldFileName, chunkSize, *stream));
+    });
+    return true;
+  }
   INFO(Form("Unzipping file: %s into %s", inputFileWithPath.c_str(), outputPath.c_str()));
   if (!unzipFile(inputFileWithPath, outputPath)) {
     ERROR(Form("Problem with unzipping file: %s", inputFileWithPath.c_str()));
@@ -49,9 +77,7 @@ bool JPetUnzipTask::terminate(JPetParams& outParams)
 {
   OptsStrAny new_opts;
   setOutputFileType(new_opts, "hld");
-  auto outputFile =
-    getOutputPath(fOptions)
-    + JPetCommonTools::stripFileNameSuffix(getInputFile(fOptions));
+  auto outputFile = getNextInputFile();
   setOutputFile(new_opts, outputFile);
 
   if (isOptionSet(fOptions, "firstEvent_int") && isOptionSet(fOptions, "lastEvent_int")) {
@@ -67,68 +93,338 @@ bool JPetUnzipTask::terminate(JPetParams& outParams)
   return true;
 }
 
-bool JPetUnzipTask::unzipFile(string fileNameWithPath, string outputPath)
+/**
+ * Name of the decompressed file, placed as the external tools used to place it:
+ * next to the archive (or in the current directory for .zip archives)
+ * unless a different output path is given.
+ */
+string JPetUnzipTask::getUnzippedFileName(const string& fileNameWithPath, const string& outputPath)
 {
   auto inputPath = JPetCommonTools::extractPathFromFile(fileNameWithPath);
-  auto fimeName = JPetCommonTools::extractFileNameFromFullPath(fileNameWithPath);
+  auto fileName = JPetCommonTools::stripFileNameSuffix(
+    JPetCommonTools::extractFileNameFromFullPath(fileNameWithPath)
+  );
+  if (inputPath + string("/") != outputPath && outputPath != "./") {
+    return JPetCommonTools::appendSlashToPathIfAbsent(outputPath) + fileName;
+  }
+  if (JPetCommonTools::exctractFileNameSuffix(fileNameWithPath) == ".zip") {
+    return fileName;
+  }
+  return JPetCommonTools::stripFileNameSuffix(fileNameWithPath);
+}
 
-  int unzip = 1;
-  int move = 1;
+/**
+ * Name of the decompressed file passed to the next task.
+ */
+string JPetUnzipTask::getNextInputFile() const
+{
+  return getOutputPath(fOptions) + JPetCommonTools::stripFileNameSuffix(getInputFile(fOptions));
+}
 
-  if (JPetCommonTools::exctractFileNameSuffix(fimeName) == ".gz") {
+/**
+ * Decompress the file into HLD chunks named after hldFileName (see JPetHLDSplitter)
+ * and publish every finished chunk as the next part of the stream.
+ */
+bool JPetUnzipTask::unzipToChunks(const string& fileNameWithPath, const string& hldFileName,
+  size_t chunkSize, JPetStreamedFile& stream)
+{
+  JPetHLDSplitter splitter(hldFileName, chunkSize, [&stream](const string& chunkFileName) {
+    stream.addPart(chunkFileName);
+    return true;
+  });
+  if (!decompress(fileNameWithPath, [&splitter](const char* data, size_t size) { return splitter.write(data, size); })) {
+    ERROR(Form("Problem with unzipping file: %s", fileNameWithPath.c_str()));
+    return false;
+  }
+  return splitter.close();
+}
 
-    unzip = system((string("gzip -dk ") + fileNameWithPath).c_str());
+bool JPetUnzipTask::unzipFile(string fileNameWithPath, string outputPath)
+{
+  auto outputFileName = getUnzippedFileName(fileNameWithPath, outputPath);
+  FILE* output = fopen(outputFileName.c_str(), "wb");
+  if (!output) {
+    ERROR(Form("Cannot open the output file: %s", outputFileName.c_str()));
+    return false;
+  }
+  /// the data is written in blocks of kBufferSize, no need for additional buffering
+  setvbuf(output, nullptr, _IONBF, 0);
+  bool isDecompressed = decompress(fileNameWithPath, [output](const char* data, size_t size) {
+    return fwrite(data, 1, size, output) == size;
+  });
+  if (fclose(output) != 0) {
+    isDecompressed = false;
+  }
+  if (!isDecompressed) {
+    remove(outputFileName.c_str());
+  }
+  return isDecompressed;
+}
 
-    if(inputPath+string("/") != outputPath && outputPath != "./") {
-      move = system((
-        string("mv ")+fileNameWithPath.substr(0, fileNameWithPath.size()-3)
-        +string(" ")+outputPath
-      ).c_str());
-    } else {
-      move = 0;
-    }
+namespace
+{
 
-  } else if (JPetCommonTools::exctractFileNameSuffix(fimeName) == ".xz") {
+/**
+ * Input file read in blocks, with the unconsumed part of the block kept
+ * for the next decompression step.
+ */
+class InputBuffer
+{
+public:
+  explicit InputBuffer(const string& fileName):
+    fFile(fopen(fileName.c_str(), "rb")), fBuffer(JPetUnzipTask::kBufferSize) {}
+  ~InputBuffer() { if (fFile) { fclose(fFile); } }
+  bool isOpen() const { return fFile; }
+  /// Reads the next block if the current one is consumed, returns false if no data is left
+  bool fill()
+  {
+    if (fBegin == fEnd && fFile && !feof(fFile) && !ferror(fFile)) {
+      fBegin = 0;
+      fEnd = fread(fBuffer.data(), 1, fBuffer.size(), fFile);
+    }
+    return fBegin != fEnd;
+  }
+  bool hasError() const { return !fFile || ferror(fFile); }
+  unsigned char* data() { return fBuffer.data() + fBegin; }
+  size_t size() const { return fEnd - fBegin; }
+  void consume(size_t n) { fBegin += n; }
+  bool read(unsigned char* out, size_t n)
+  {
+    while (n > 0) {
+      if (!fill()) { return false; }
+      auto chunk = min(n, size());
+      copy(data(), data() + chunk, out);
+      consume(chunk);
+      out += chunk;
+      n -= chunk;
+    }
+    return true;
+  }
+  bool skip(size_t n)
+  {
+    while (n > 0) {
+      if (!fill()) { return false; }
+      auto chunk = min(n, size());
+      consume(chunk);
+      n -= chunk;
+    }
+    return true;
+  }
 
-    unzip = system((string("xz -dk ") + string(fileNameWithPath)).c_str());
+private:
+  FILE* fFile = nullptr;
+  vector<unsigned char> fBuffer;
+  size_t fBegin = 0;
+  size_t fEnd = 0;
+};
 
-    if(inputPath+string("/") != outputPath && outputPath != "./") {
-      move = system((
-        string("mv ")+fileNameWithPath.substr(0, fileNameWithPath.size()-3)
-        +string(" ")+outputPath
-      ).c_str());
-    } else {
-      move = 0;
+/// Inflates one zlib/gzip/raw deflate stream, depending on windowBits
+bool inflateStream(InputBuffer& input, int windowBits, const JPetUnzipTask::DataSink& sink, uLong* crc = nullptr)
+{
+  z_stream stream = {};
+  if (inflateInit2(&stream, windowBits) != Z_OK) {
+    return false;
+  }
+  vector<unsigned char> output(JPetUnzipTask::kBufferSize);
+  int status = Z_OK;
+  while (status != Z_STREAM_END) {
+    if (!input.fill()) {
+      break;
     }
+    stream.next_in = input.data();
+    stream.avail_in = input.size();
+    stream.next_out = output.data();
+    stream.avail_out = output.size();
+    status = inflate(&stream, Z_NO_FLUSH);
+    input.consume(input.size() - stream.avail_in);
+    if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+      break;
+    }
+    auto produced = output.size() - stream.avail_out;
+    if (crc) {
+      *crc = crc32(*crc, output.data(), produced);
+    }
+    if (produced > 0 && !sink(reinterpret_cast<const char*>(output.data()), produced)) {
+      status = Z_ERRNO;
+      break;
+    }
+  }
+  inflateEnd(&stream);
+  return status == Z_STREAM_END;
+}
 
-  } else if (JPetCommonTools::exctractFileNameSuffix(fimeName) == ".bz2") {
-
-    unzip = system((string("bzip2 -dk ") + fileNameWithPath).c_str());
+bool decompressGz(InputBuffer& input, const JPetUnzipTask::DataSink& sink)
+{
+  /// concatenated gzip members are decompressed one after another, as gzip does
+  do {
+    if (!inflateStream(input, 15 + 16, sink)) {
+      return false;
+    }
+  } while (input.fill());
+  return !input.hasError();
+}
 
-    if(inputPath+string("/") != outputPath && outputPath != "./") {
-      move = system((
-        string("mv ")+fileNameWithPath.substr(0, fileNameWithPath.size()-4)
-        +string(" ")+outputPath
-      ).c_str());
-    } else {
-      move = 0;
+bool decompressXz(InputBuffer& input, const JPetUnzipTask::DataSink& sink)
+{
+  lzma_stream stream = LZMA_STREAM_INIT;
+#if LZMA_VERSION >= 50040002
+  lzma_mt options = {};
+  options.flags = LZMA_CONCATENATED;
+  options.threads = max(1u, thread::hardware_concurrency());
+  options.memlimit_threading = max<uint64_t>(lzma_physmem() / 4, uint64_t(1) << 28);
+  options.memlimit_stop = UINT64_MAX;
+  auto status = lzma_stream_decoder_mt(&stream, &options);
+#else
+  auto status = lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED);
+#endif
+  if (status != LZMA_OK) {
+    return false;
+  }
+  vector<uint8_t> output(JPetUnzipTask::kBufferSize);
+  lzma_action action = LZMA_RUN;
+  while (status == LZMA_OK) {
+    if (action == LZMA_RUN && !input.fill()) {
+      if (input.hasError()) {
+        break;
+      }
+      action = LZMA_FINISH;
     }
+    stream.next_in = input.data();
+    stream.avail_in = input.size();
+    stream.next_out = output.data();
+    stream.avail_out = output.size();
+    status = lzma_code(&stream, action);
+    input.consume(input.size() - stream.avail_in);
+    auto produced = output.size() - stream.avail_out;
+    if (produced > 0 && !sink(reinterpret_cast<const char*>(output.data()), produced)) {
+      status = LZMA_PROG_ERROR;
+      break;
+    }
+  }
+  lzma_end(&stream);
+  return status == LZMA_STREAM_END;
+}
 
-  } else if (JPetCommonTools::exctractFileNameSuffix(fimeName) == ".zip") {
+bool decompressBz2(InputBuffer& input, const JPetUnzipTask::DataSink& sink)
+{
+  vector<char> output(JPetUnzipTask::kBufferSize);
+  /// concatenated streams are decompressed one after another, as bzip2 does
+  do {
+    bz_stream stream = {};
+    if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+      return false;
+    }
+    int status = BZ_OK;
+    while (status == BZ_OK) {
+      if (!input.fill()) {
+        break;
+      }
+      stream.next_in = reinterpret_cast<char*>(input.data());
+      stream.avail_in = input.size();
+      stream.next_out = output.data();
+      stream.avail_out = output.size();
+      status = BZ2_bzDecompress(&stream);
+      input.consume(input.size() - stream.avail_in);
+      auto produced = output.size() - stream.avail_out;
+      if (produced > 0 && !sink(output.data(), produced)) {
+        status = BZ_IO_ERROR;
+      }
+    }
+    BZ2_bzDecompressEnd(&stream);
+    if (status != BZ_STREAM_END) {
+      return false;
+    }
+  } while (input.fill());
+  return !input.hasError();
+}
 
-    unzip = system(( string("unzip ") + fileNameWithPath ).c_str());
+uint32_t littleEndian(const unsigned char* bytes, int size)
+{
+  uint32_t value = 0;
+  for (int i = size - 1; i >= 0; i--) {
+    value = (value << 8) | bytes[i];
+  }
+  return value;
+}
 
-    if(inputPath+string("/") != outputPath && outputPath != "./") {
-      move = system((
-        string("cd ")+JPetCommonTools::currentFullPath()
-        +string(" && ")
-        +string("mv ")+fimeName.substr(0, fimeName.size()-4)
-        +string(" ")+outputPath
-      ).c_str());
-    } else {
-      move = 0;
+/// Extracts the first file of the zip archive, stored or compressed with deflate
+bool decompressZip(InputBuffer& input, const JPetUnzipTask::DataSink& sink)
+{
+  const uint32_t kLocalHeaderSignature = 0x04034b50;
+  const uint32_t kDataDescriptorSignature = 0x08074b50;
+  const uint16_t kDataDescriptorFlag = 0x8;
+  unsigned char header[30];
+  if (!input.read(header, sizeof(header)) || littleEndian(header, 4) != kLocalHeaderSignature) {
+    ERROR("Not a zip archive");
+    return false;
+  }
+  auto flags = littleEndian(header + 6, 2);
+  auto method = littleEndian(header + 8, 2);
+  auto crc = littleEndian(header + 14, 4);
+  auto compressedSize = littleEndian(header + 18, 4);
+  if (!input.skip(littleEndian(header + 26, 2) + littleEndian(header + 28, 2))) {
+    return false;
+  }
+  uLong computedCrc = crc32(0L, Z_NULL, 0);
+  if (method == Z_DEFLATED) {
+    if (!inflateStream(input, -MAX_WBITS, sink, &computedCrc)) {
+      return false;
+    }
+  } else if (method == 0 && !(flags & kDataDescriptorFlag)) {
+    while (compressedSize > 0) {
+      if (!input.fill()) {
+        return false;
+      }
+      auto chunk = min<size_t>(compressedSize, input.size());
+      computedCrc = crc32(computedCrc, input.data(), chunk);
+      if (!sink(reinterpret_cast<const char*>(input.data()), chunk)) {
+        return false;
+      }
+      input.consume(chunk);
+      compressedSize -= chunk;
+    }
+  } else {
+    ERROR(Form("Unsupported zip compression method: %u", method));
+    return false;
+  }
+  if (flags & kDataDescriptorFlag) {
+    unsigned char descriptor[4];
+    if (!input.read(descriptor, 4)) {
+      return false;
+    }
+    crc = littleEndian(descriptor, 4);
+    if (crc == kDataDescriptorSignature && input.read(descriptor, 4)) {
+      crc = littleEndian(descriptor, 4);
     }
   }
+  return computedCrc == crc;
+}
+
+}
 
-  return !(unzip+move);
+const size_t JPetUnzipTask::kBufferSize = 4 * 1024 * 1024;
+
+/**
+ * Decompress the file according to its suffix, passing the data to the sink
+ * in blocks of at most kBufferSize bytes.
+ */
+bool JPetUnzipTask::decompress(const string& fileNameWithPath, const DataSink& sink)
+{
+  InputBuffer input(fileNameWithPath);
+  if (!input.isOpen()) {
+    ERROR(Form("Cannot open the file: %s", fileNameWithPath.c_str()));
+    return false;
+  }
+  auto suffix = JPetCommonTools::exctractFileNameSuffix(fileNameWithPath);
+  if (suffix == ".gz") {
+    return decompressGz(input, sink);
+  } else if (suffix == ".xz") {
+    return decompressXz(input, sink);
+  } else if (suffix == ".bz2") {
+    return decompressBz2(input, sink);
+  } else if (suffix == ".zip") {
+    return decompressZip(input, sink);
+  }
+  ERROR(Form("Unknown compression format of the file: %s", fileNameWithPath.c_str()));
+  return false;
 }
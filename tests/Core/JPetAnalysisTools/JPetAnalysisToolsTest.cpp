@@ -36,4 +36,17 @@ BOOST_AUTO_TEST_CASE(constructor_getHitsOrderedByTime)
   BOOST_REQUIRE_CLOSE(results[3].getTime(), 4, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(sortHitsByTime)
+{
+  std::vector<JPetHit> hits(3);
+  hits[0].setTime(2);
+  hits[1].setTime(3);
+  hits[2].setTime(1);
+  JPetAnalysisTools::sortHitsByTime(hits);
+  double epsilon = 0.0001;
+  BOOST_REQUIRE_CLOSE(hits[0].getTime(), 1, epsilon);
+  BOOST_REQUIRE_CLOSE(hits[1].getTime(), 2, epsilon);
+  BOOST_REQUIRE_CLOSE(hits[2].getTime(), 3, epsilon);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
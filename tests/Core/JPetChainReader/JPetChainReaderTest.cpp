@@ -0,0 +1,161 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetChainReaderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetChainReaderTest
+
+#include "JPetChainReader/JPetChainReader.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetWriter/JPetWriter.h"
+
+#include <TError.h>
+#include <TROOT.h>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+
+/// Writes nbOfWindows time windows, the i-th window containing firstSize + i signal channels
+void createTestFile(const std::string& fileName, int nbOfWindows, int firstSize)
+{
+  JPetWriter writer(fileName.c_str());
+  for (int i = 0; i < nbOfWindows; i++)
+  {
+    JPetTimeWindow window("JPetSigCh");
+    for (int j = 0; j < firstSize + i; j++)
+    {
+      window.add<JPetSigCh>(JPetSigCh());
+    }
+    writer.write(window);
+  }
+  writer.closeFile();
+}
+
+int getNumberOfEventsInCurrentEntry(JPetChainReader& reader)
+{
+  return dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents();
+}
+
+/// The files are opened in parallel, as in the framework ROOT is prepared for threads at startup
+struct ThreadSafetyFixture
+{
+  ThreadSafetyFixture() { ROOT::EnableThreadSafety(); }
+};
+
+BOOST_GLOBAL_FIXTURE(ThreadSafetyFixture);
+
+BOOST_AUTO_TEST_SUITE(JPetChainReaderTestSuite)
+
+BOOST_AUTO_TEST_CASE(default_constructor)
+{
+  JPetChainReader reader;
+  BOOST_REQUIRE(!reader.isOpen());
+  BOOST_REQUIRE(!reader.nextEntry());
+  BOOST_REQUIRE(!reader.firstEntry());
+  BOOST_REQUIRE(!reader.nthEntry(0));
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 0);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfFiles(), 0);
+  BOOST_REQUIRE_EQUAL(reader.getCurrentFileIndex(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(bad_files)
+{
+  gErrorIgnoreLevel = 6000;
+  createTestFile("chainReaderTest_good.root", 2, 1);
+  JPetChainReader reader;
+  BOOST_REQUIRE(!reader.openFilesAndLoadData({}));
+  BOOST_REQUIRE(!reader.openFilesAndLoadData({"chainReaderTest_good.root", "bad_file.root"}));
+  BOOST_REQUIRE(!reader.isOpen());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(global_entry_numbering)
+{
+  createTestFile("chainReaderTest_1.root", 3, 1);
+  createTestFile("chainReaderTest_2.root", 0, 1);
+  createTestFile("chainReaderTest_3.root", 2, 10);
+  for (auto prefetch : {true, false})
+  {
+    JPetChainReader reader;
+    reader.setPrefetchEnabled(prefetch);
+    BOOST_REQUIRE(reader.openFilesAndLoadData({"chainReaderTest_1.root", "chainReaderTest_2.root", "chainReaderTest_3.root"}));
+    BOOST_REQUIRE(reader.isOpen());
+    BOOST_REQUIRE_EQUAL(reader.getNbOfFiles(), 3);
+    BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 5);
+    BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), 0);
+    BOOST_REQUIRE_EQUAL(reader.getCurrentFileIndex(), 0);
+    std::vector<int> expectedSizes = {1, 2, 3, 10, 11};
+    for (unsigned int i = 0; i < expectedSizes.size(); i++)
+    {
+      BOOST_REQUIRE_EQUAL(reader.getCurrentEntryNumber(), static_cast<long long>(i));
+      BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), expectedSizes[i]);
+      BOOST_REQUIRE_EQUAL(reader.nextEntry(), i + 1 < expectedSizes.size());
+    }
+    BOOST_REQUIRE(reader.nthEntry(1));
+    BOOST_REQUIRE_EQUAL(reader.getCurrentFileIndex(), 0);
+    BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), 2);
+    BOOST_REQUIRE(reader.lastEntry());
+    BOOST_REQUIRE_EQUAL(reader.getCurrentFileIndex(), 2);
+    BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), 11);
+    BOOST_REQUIRE(!reader.nthEntry(5));
+    BOOST_REQUIRE(!reader.nthEntry(-1));
+    reader.closeFile();
+    BOOST_REQUIRE(!reader.isOpen());
+    BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(many_files)
+{
+  std::vector<std::string> fileNames;
+  for (int i = 0; i < 20; i++)
+  {
+    fileNames.push_back("chainReaderTest_many_" + std::to_string(i) + ".root");
+    createTestFile(fileNames.back(), 2, i);
+  }
+  for (auto prefetch : {true, false})
+  {
+    JPetChainReader reader;
+    reader.setPrefetchEnabled(prefetch);
+    BOOST_REQUIRE(reader.openFilesAndLoadData(fileNames));
+    BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 2 * static_cast<long long>(fileNames.size()));
+    for (unsigned int i = 0; i < 2 * fileNames.size(); i++)
+    {
+      BOOST_REQUIRE_EQUAL(reader.getCurrentFileIndex(), static_cast<int>(i / 2));
+      BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), static_cast<int>(i / 2 + i % 2));
+      BOOST_REQUIRE_EQUAL(reader.nextEntry(), i + 1 < 2 * fileNames.size());
+    }
+    BOOST_REQUIRE(reader.nthEntry(3));
+    BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(entry_reused_between_files)
+{
+  createTestFile("chainReaderTest_reuse_1.root", 1, 1);
+  createTestFile("chainReaderTest_reuse_2.root", 1, 2);
+  JPetChainReader reader;
+  BOOST_REQUIRE(reader.openFilesAndLoadData({"chainReaderTest_reuse_1.root", "chainReaderTest_reuse_2.root"}));
+  auto firstEntry = &reader.getCurrentEntry();
+  BOOST_REQUIRE(reader.nextEntry());
+  BOOST_REQUIRE_EQUAL(reader.getCurrentFileIndex(), 1);
+  BOOST_REQUIRE_EQUAL(&reader.getCurrentEntry(), firstEntry);
+  BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), 2);
+  BOOST_REQUIRE(reader.firstEntry());
+  BOOST_REQUIRE_EQUAL(&reader.getCurrentEntry(), firstEntry);
+  BOOST_REQUIRE_EQUAL(getNumberOfEventsInCurrentEntry(reader), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetDetectorGeometryCacheTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetDetectorGeometryCacheTest
+#include "JPetDetectorGeometryCache/JPetDetectorGeometryCache.h"
+#include <TMath.h>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+/// Layer 1 with 4 slots and layer 2 with 2 slots, one scintillator in each slot
+std::shared_ptr<JPetParamBank> createBank()
+{
+  auto bank = std::make_shared<JPetParamBank>();
+  bank->addLayer(JPetLayer(1, true, "Layer01", 42.5));
+  bank->addLayer(JPetLayer(2, true, "Layer02", 50.0));
+  std::vector<std::pair<int, float>> slots = {{1, 180.}, {2, 0.}, {3, 270.}, {4, 90.}, {5, 225.}, {6, 45.}};
+  for (const auto& slot : slots)
+  {
+    bank->addBarrelSlot(JPetBarrelSlot(slot.first, true, "slot", slot.second, 1));
+    bank->getBarrelSlot(slot.first).setLayer(bank->getLayer(slot.first <= 4 ? 1 : 2));
+    bank->addScintillator(JPetScin(100 + slot.first, 0., 50. + slot.first, 1.9, 0.7));
+    bank->getScintillator(100 + slot.first).setBarrelSlot(bank->getBarrelSlot(slot.first));
+  }
+  return bank;
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(emptyBank)
+{
+  JPetParamBank bank;
+  JPetDetectorGeometryCache geometry(bank);
+  BOOST_REQUIRE_EQUAL(geometry.getSize(), 0u);
+  BOOST_REQUIRE_EQUAL(geometry.getIndex(1), JPetDetectorGeometryCache::kBadIndex);
+}
+
+BOOST_AUTO_TEST_CASE(scintillatorsOrderedByLayerAndSlot)
+{
+  auto bank = createBank();
+  JPetDetectorGeometryCache geometry(*bank);
+  BOOST_REQUIRE_EQUAL(geometry.getSize(), 6u);
+  std::vector<int> expectedIDs = {102, 104, 101, 103, 106, 105};
+  std::vector<int> expectedLayers = {1, 1, 1, 1, 2, 2};
+  std::vector<int> expectedSlots = {1, 2, 3, 4, 1, 2};
+  for (std::size_t i = 0; i < expectedIDs.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(geometry.getScinIDs()[i], expectedIDs[i]);
+    BOOST_REQUIRE_EQUAL(geometry.getIndex(expectedIDs[i]), static_cast<int>(i));
+    BOOST_REQUIRE_EQUAL(geometry.getLayerNumber()[i], expectedLayers[i]);
+    BOOST_REQUIRE_EQUAL(geometry.getSlotNumber()[i], expectedSlots[i]);
+  }
+  BOOST_REQUIRE_EQUAL(geometry.getIndex(107), JPetDetectorGeometryCache::kBadIndex);
+}
+
+BOOST_AUTO_TEST_CASE(centersOfScintillators)
+{
+  auto bank = createBank();
+  JPetDetectorGeometryCache geometry(*bank);
+  double epsilon = 0.0001;
+  for (const auto& scin : bank->getScintillators())
+  {
+    auto index = geometry.getIndex(scin.first);
+    const auto& slot = scin.second->getBarrelSlot();
+    auto radius = slot.getLayer().getRadius();
+    auto theta = TMath::DegToRad() * slot.getTheta();
+    BOOST_REQUIRE_EQUAL(geometry.getCenterX()[index], radius * std::cos(theta));
+    BOOST_REQUIRE_EQUAL(geometry.getCenterY()[index], radius * std::sin(theta));
+    BOOST_REQUIRE_EQUAL(geometry.getRadius()[index], radius);
+    BOOST_REQUIRE_EQUAL(geometry.getTheta()[index], slot.getTheta());
+    BOOST_REQUIRE_CLOSE(geometry.getLength()[index], 50. + slot.getID(), epsilon);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(neighbours)
+{
+  auto bank = createBank();
+  JPetDetectorGeometryCache geometry(*bank);
+  auto neighbours = geometry.getNeighbours(geometry.getIndex(102));
+  std::sort(neighbours.begin(), neighbours.end());
+  BOOST_REQUIRE_EQUAL(neighbours.size(), 2u);
+  BOOST_REQUIRE_EQUAL(neighbours[0], geometry.getIndex(104));
+  BOOST_REQUIRE_EQUAL(neighbours[1], geometry.getIndex(103));
+  neighbours = geometry.getNeighbours(geometry.getIndex(106));
+  BOOST_REQUIRE_EQUAL(neighbours.size(), 1u);
+  BOOST_REQUIRE_EQUAL(neighbours[0], geometry.getIndex(105));
+}
+
+BOOST_AUTO_TEST_CASE(getPositions)
+{
+  auto bank = createBank();
+  JPetDetectorGeometryCache geometry(*bank);
+  std::vector<double> posX;
+  std::vector<double> posY;
+  geometry.getPositions({104, 1, 106}, posX, posY);
+  BOOST_REQUIRE_EQUAL(posX.size(), 3u);
+  BOOST_REQUIRE_EQUAL(posY.size(), 3u);
+  BOOST_REQUIRE_EQUAL(posX[0], geometry.getCenterX()[geometry.getIndex(104)]);
+  BOOST_REQUIRE_EQUAL(posY[0], geometry.getCenterY()[geometry.getIndex(104)]);
+  BOOST_REQUIRE(std::isnan(posX[1]));
+  BOOST_REQUIRE(std::isnan(posY[1]));
+  BOOST_REQUIRE_EQUAL(posX[2], geometry.getCenterX()[geometry.getIndex(106)]);
+  BOOST_REQUIRE_EQUAL(posY[2], geometry.getCenterY()[geometry.getIndex(106)]);
+}
+
+BOOST_AUTO_TEST_CASE(geometrySharedForTheSameBank)
+{
+  BOOST_REQUIRE(!JPetDetectorGeometryCache::getGeometry(nullptr));
+  std::shared_ptr<const JPetParamBank> bank = createBank();
+  std::shared_ptr<const JPetParamBank> otherBank = createBank();
+  auto geometry = JPetDetectorGeometryCache::getGeometry(bank);
+  BOOST_REQUIRE(geometry);
+  BOOST_REQUIRE_EQUAL(geometry->getSize(), 6u);
+  BOOST_REQUIRE_EQUAL(JPetDetectorGeometryCache::getGeometry(bank), geometry);
+  BOOST_REQUIRE(JPetDetectorGeometryCache::getGeometry(otherBank) != geometry);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
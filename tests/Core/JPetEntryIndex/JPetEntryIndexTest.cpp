@@ -0,0 +1,207 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetEntryIndexTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetEntryIndexTest
+
+#include "JPetBarrelSlot/JPetBarrelSlot.h"
+#include "JPetEntryIndex/JPetEntryIndex.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetLayer/JPetLayer.h"
+#include "JPetRawSignal/JPetRawSignal.h"
+#include "JPetScin/JPetScin.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include <TList.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(emptySummary)
+{
+  JPetTimeWindow window("JPetSigCh");
+  auto summary = JPetEntryIndex::summarize(window);
+  BOOST_REQUIRE_EQUAL(summary.fObjectCount, 0u);
+  BOOST_REQUIRE(!summary.hasTime());
+  BOOST_REQUIRE(!summary.hasEnergy());
+  BOOST_REQUIRE(summary.overlapsTime(0., 1.));
+  BOOST_REQUIRE(!summary.overlapsEnergy(0., 1000.));
+  BOOST_REQUIRE(!summary.isScinHit(1));
+  BOOST_REQUIRE(!summary.isLayerHit(1));
+}
+
+BOOST_AUTO_TEST_CASE(sigChSummary)
+{
+  JPetTimeWindow window("JPetSigCh");
+  JPetSigCh sigCh1;
+  sigCh1.setValue(100.f);
+  JPetSigCh sigCh2;
+  sigCh2.setValue(50.f);
+  window.add<JPetSigCh>(sigCh1);
+  window.add<JPetSigCh>(sigCh2);
+  auto summary = JPetEntryIndex::summarize(window);
+  BOOST_REQUIRE_EQUAL(summary.fObjectCount, 2u);
+  BOOST_REQUIRE(summary.hasTime());
+  BOOST_REQUIRE_CLOSE(summary.fStartTime, 50., 0.001);
+  BOOST_REQUIRE_CLOSE(summary.fEndTime, 100., 0.001);
+  BOOST_REQUIRE(summary.overlapsTime(90., 200.));
+  BOOST_REQUIRE(!summary.overlapsTime(101., 200.));
+  BOOST_REQUIRE(!summary.hasEnergy());
+}
+
+BOOST_AUTO_TEST_CASE(hitSummary)
+{
+  JPetLayer layer(2, true, "", 50.f);
+  JPetBarrelSlot slot(7, true, "", 0.f, 7);
+  slot.setLayer(layer);
+  JPetScin scin(130);
+
+  JPetTimeWindow window("JPetHit");
+  JPetHit hit1;
+  hit1.setTime(1000.f);
+  hit1.setEnergy(200.f);
+  hit1.setBarrelSlot(slot);
+  hit1.setScintillator(scin);
+  JPetHit hit2;
+  hit2.setTime(3000.f);
+  hit2.setEnergy(450.f);
+  window.add<JPetHit>(hit1);
+  window.add<JPetHit>(hit2);
+
+  auto summary = JPetEntryIndex::summarize(window);
+  BOOST_REQUIRE_EQUAL(summary.fObjectCount, 2u);
+  BOOST_REQUIRE_CLOSE(summary.fStartTime, 1000., 0.001);
+  BOOST_REQUIRE_CLOSE(summary.fEndTime, 3000., 0.001);
+  BOOST_REQUIRE_CLOSE(summary.fMinEnergy, 200., 0.001);
+  BOOST_REQUIRE_CLOSE(summary.fMaxEnergy, 450., 0.001);
+  BOOST_REQUIRE(summary.overlapsEnergy(400., 500.));
+  BOOST_REQUIRE(!summary.overlapsEnergy(500., 600.));
+  BOOST_REQUIRE(summary.isScinHit(130));
+  BOOST_REQUIRE(!summary.isScinHit(129));
+  BOOST_REQUIRE(!summary.isScinHit(1));
+  BOOST_REQUIRE(summary.isLayerHit(2));
+  BOOST_REQUIRE(!summary.isLayerHit(1));
+  auto timeSummary = JPetEntryIndex::summarize(window, true);
+  BOOST_REQUIRE_EQUAL(timeSummary.fObjectCount, 2u);
+  BOOST_REQUIRE_CLOSE(timeSummary.fStartTime, 1000., 0.001);
+  BOOST_REQUIRE_CLOSE(timeSummary.fEndTime, 3000., 0.001);
+  BOOST_REQUIRE(!timeSummary.hasEnergy());
+  BOOST_REQUIRE(!timeSummary.isScinHit(130));
+}
+
+BOOST_AUTO_TEST_CASE(rawSignalSummary)
+{
+  JPetTimeWindow window("JPetRawSignal");
+  JPetRawSignal signal;
+  for (int thrNum = 1; thrNum <= 2; thrNum++)
+  {
+    JPetSigCh sigCh(JPetSigCh::Leading, 100.f * thrNum);
+    sigCh.setThresholdNumber(thrNum);
+    signal.addPoint(sigCh);
+  }
+  window.add<JPetRawSignal>(signal);
+  JPetSigCh doubled(JPetSigCh::Leading, 50.f);
+  doubled.setThresholdNumber(2);
+  signal.addPoint(doubled);
+  window.add<JPetRawSignal>(signal);
+  auto summary = JPetEntryIndex::summarize(window);
+  BOOST_REQUIRE_EQUAL(summary.fObjectCount, 2u);
+  BOOST_REQUIRE_CLOSE(summary.fStartTime, 50., 0.001);
+  BOOST_REQUIRE_CLOSE(summary.fEndTime, 200., 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(layerMask)
+{
+  JPetEntryIndex::EntrySummary summary;
+  summary.addLayer(40);
+  summary.addLayer(JPetEntryIndex::kMaxLayerID);
+  summary.addLayer(JPetEntryIndex::kMaxLayerID + 1);
+  BOOST_REQUIRE(summary.isLayerHit(40));
+  BOOST_REQUIRE(summary.isLayerHit(JPetEntryIndex::kMaxLayerID));
+  BOOST_REQUIRE(!summary.isLayerHit(JPetEntryIndex::kMaxLayerID + 1));
+  BOOST_REQUIRE(!summary.isLayerHit(8));
+}
+
+BOOST_AUTO_TEST_CASE(findFirstEntryAtTime)
+{
+  JPetEntryIndex index;
+  JPetEntryIndex::EntrySummary noTime;
+  for (int i = 0; i < 5; i++)
+  {
+    JPetEntryIndex::EntrySummary summary;
+    summary.addTime(i * 100.);
+    summary.addTime(i * 100. + 50.);
+    index.addSummary(summary);
+  }
+  index.addSummary(noTime);
+  BOOST_REQUIRE_EQUAL(index.getNumberOfEntries(), 6u);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(-10., 0, 5), 0);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(120., 0, 5), 1);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(160., 0, 5), 2);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(160., 3, 5), 3);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(1000., 0, 5), -1);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(120., 0, 100), 1);
+  BOOST_REQUIRE(!index.isTimeOrdered());
+}
+
+BOOST_AUTO_TEST_CASE(findEntryInOrderedIndex)
+{
+  JPetEntryIndex index;
+  for (int i = 0; i < 100; i++)
+  {
+    JPetEntryIndex::EntrySummary summary;
+    summary.addTime(i * 100.);
+    summary.addTime(i * 100. + 50.);
+    index.addSummary(summary);
+  }
+  BOOST_REQUIRE(index.isTimeOrdered());
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(-10., 0, 99), 0);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(1220., 0, 99), 12);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(1260., 0, 99), 13);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(1260., 20, 99), 20);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(1260., 5, 10), -1);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(20000., 0, 99), -1);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryInTimeRange(1260., 1280., 0, 99), -1);
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryInTimeRange(1260., 1310., 0, 99), 13);
+  JPetEntryIndex::EntrySummary earlier;
+  earlier.addTime(10.);
+  index.addSummary(earlier);
+  BOOST_REQUIRE(!index.isTimeOrdered());
+  BOOST_REQUIRE_EQUAL(index.findFirstEntryAtTime(1220., 0, 100), 12);
+}
+
+BOOST_AUTO_TEST_CASE(merge)
+{
+  JPetEntryIndex index1;
+  JPetEntryIndex index2;
+  JPetEntryIndex::EntrySummary summary;
+  summary.fObjectCount = 1;
+  index1.addSummary(summary);
+  summary.fObjectCount = 2;
+  index2.addSummary(summary);
+  summary.fObjectCount = 3;
+  index2.addSummary(summary);
+  TList list;
+  list.Add(&index2);
+  BOOST_REQUIRE_EQUAL(index1.Merge(&list), 3);
+  BOOST_REQUIRE_EQUAL(index1.getSummary(0).fObjectCount, 1u);
+  BOOST_REQUIRE_EQUAL(index1.getSummary(1).fObjectCount, 2u);
+  BOOST_REQUIRE_EQUAL(index1.getSummary(2).fObjectCount, 3u);
+  index1.Clear();
+  BOOST_REQUIRE_EQUAL(index1.getNumberOfEntries(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
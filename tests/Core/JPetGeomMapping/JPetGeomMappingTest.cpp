@@ -20,6 +20,7 @@
 #include "JPetParamManager/JPetParamManager.h"
 
 #include <boost/test/unit_test.hpp>
+#include <memory>
 
 const std::string dataDir = "unitTestData/JPetGeomMappingTest/";
 const std::string dataFileName = dataDir + "data.json";
@@ -169,6 +170,100 @@ BOOST_AUTO_TEST_CASE(TestOfLargeBarrelJson)
   BOOST_REQUIRE_EQUAL(tombMap.size(), 1536u);
 }
 
+BOOST_FIXTURE_TEST_CASE(getTOMBOutOfRange, myFixture)
+{
+  auto bank = fparamManagerInstance.getParamBank();
+  auto mapper = JPetGeomMapping(bank);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(0, 1, JPetPM::SideA, 1), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(4, 1, JPetPM::SideA, 1), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(1, 0, JPetPM::SideA, 1), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(1, 3, JPetPM::SideA, 1), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(1, 1, JPetPM::SideA, 2), -1);
+  BOOST_REQUIRE_EQUAL(mapper.getTOMB(2, 1, JPetPM::SideB, 1), -1);
+}
+
+BOOST_FIXTURE_TEST_CASE(getTOMBChannelPos, myFixture)
+{
+  auto bank = fparamManagerInstance.getParamBank();
+  auto mapper = JPetGeomMapping(bank);
+  auto pos = mapper.getTOMBChannelPos(10);
+  BOOST_REQUIRE(pos);
+  BOOST_REQUIRE_EQUAL(pos->layer, 2);
+  BOOST_REQUIRE_EQUAL(pos->slot, 1);
+  BOOST_REQUIRE_EQUAL(pos->side, JPetPM::SideA);
+  BOOST_REQUIRE_EQUAL(pos->threshold, 1);
+  pos = mapper.getTOMBChannelPos(1);
+  BOOST_REQUIRE(pos);
+  BOOST_REQUIRE_EQUAL(pos->layer, 1);
+  BOOST_REQUIRE_EQUAL(pos->slot, 1);
+  BOOST_REQUIRE_EQUAL(pos->side, JPetPM::SideB);
+  BOOST_REQUIRE(!mapper.getTOMBChannelPos(5));
+  BOOST_REQUIRE(!mapper.getTOMBChannelPos(-1));
+}
+
+BOOST_FIXTURE_TEST_CASE(getStripPosByID, myFixture)
+{
+  auto bank = fparamManagerInstance.getParamBank();
+  auto mapper = JPetGeomMapping(bank);
+  for (const auto& slot : bank.getBarrelSlots())
+  {
+    auto expected = mapper.getStripPos(*slot.second);
+    auto pos = mapper.getStripPosByID(slot.first);
+    BOOST_REQUIRE_EQUAL(pos.layer, expected.layer);
+    BOOST_REQUIRE_EQUAL(pos.slot, expected.slot);
+  }
+  auto pos = mapper.getStripPosByID(-1);
+  BOOST_REQUIRE_EQUAL(pos.layer, JPetGeomMapping::kBadLayerNumber);
+  BOOST_REQUIRE_EQUAL(pos.slot, JPetGeomMapping::kBadSlotNumber);
+}
+
+BOOST_FIXTURE_TEST_CASE(copiedMapping, myFixture)
+{
+  auto bank = fparamManagerInstance.getParamBank();
+  std::unique_ptr<JPetGeomMapping> original(new JPetGeomMapping(bank));
+  JPetGeomMapping copy(*original);
+  JPetGeomMapping assigned(JPetParamBank{});
+  assigned = *original;
+  original.reset();
+  for (const auto* mapper : {&copy, &assigned})
+  {
+    auto pos = mapper->getTOMBChannelPos(10);
+    BOOST_REQUIRE(pos);
+    BOOST_REQUIRE_EQUAL(pos->layer, 2);
+    BOOST_REQUIRE_EQUAL(pos->slot, 1);
+    for (const auto& slot : bank.getBarrelSlots())
+    {
+      BOOST_REQUIRE_EQUAL(mapper->getStripPosByID(slot.first).slot, mapper->getStripPos(*slot.second).slot);
+    }
+    BOOST_REQUIRE_EQUAL(mapper->getStripPosByID(-1).slot, JPetGeomMapping::kBadSlotNumber);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(denseTablesOfLargeBarrel)
+{
+  JPetParamManager fparamManagerInstance(new JPetParamGetterAscii("unitTestData/JPetGeomMappingTest/large_barrel.json"));
+  fparamManagerInstance.fillParameterBank(43);
+  auto bank = fparamManagerInstance.getParamBank();
+  auto mapper = JPetGeomMapping(bank);
+  const auto& tombMap = mapper.getTOMBMapping();
+  BOOST_REQUIRE_EQUAL(&tombMap, &mapper.getTOMBMapping());
+  BOOST_REQUIRE_EQUAL(tombMap.size(), 1536u);
+  for (const auto& el : tombMap)
+  {
+    auto layer = std::get<0>(el.first);
+    auto slot = std::get<1>(el.first);
+    auto side = std::get<2>(el.first);
+    auto threshold = std::get<3>(el.first);
+    BOOST_REQUIRE_EQUAL(mapper.getTOMB(layer, slot, side, threshold), el.second);
+    auto pos = mapper.getTOMBChannelPos(el.second);
+    BOOST_REQUIRE(pos);
+    BOOST_REQUIRE_EQUAL(pos->layer, layer);
+    BOOST_REQUIRE_EQUAL(pos->slot, slot);
+    BOOST_REQUIRE_EQUAL(pos->side, side);
+    BOOST_REQUIRE_EQUAL(pos->threshold, threshold);
+  }
+}
+
 BOOST_FIXTURE_TEST_CASE(radiusOfLayer, myFixture)
 {
   auto bank = fparamManagerInstance.getParamBank();
@@ -17,15 +17,23 @@
 #define BOOST_TEST_MODULE JPetHaddTest
 #include "JPetBarrelSlot/JPetBarrelSlot.h"
 #include "JPetEvent/JPetEvent.h"
+#include "JPetHadd/JPetHadd.h"
+#include "JPetParamManager/JPetParamManager.h"
 #include "JPetReader/JPetReader.h"
 #include "JPetScin/JPetScin.h"
 #include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetTreeHeader/JPetTreeHeader.h"
 
+#include <TFile.h>
+#include <TH1F.h>
+#include <TTree.h>
 #include <boost/test/unit_test.hpp>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(JPetHaddTestSuite)
 
@@ -161,4 +169,151 @@ BOOST_AUTO_TEST_CASE(check_param_bank)
   delete haddedParamBank;
 }
 
+BOOST_AUTO_TEST_CASE(jpet_hadd_same_data)
+{
+  std::string firstFileName = "unitTestData/JPetHaddTest/single_link_def/dabc_17237091818.hadd.test.root";
+  std::string secondFileName = "unitTestData/JPetHaddTest/single_link_def/dabc_17237093844.hadd.test.root";
+  std::string haddedFileName = "unitTestData/JPetHaddTest/jpethadded.hadd.test.root";
+  JPetHadd hadd(haddedFileName);
+  hadd.setNumberOfThreads(2);
+  hadd.setForceOverwrite(true);
+  BOOST_REQUIRE(hadd.merge({firstFileName, secondFileName}));
+  BOOST_REQUIRE_GE(hadd.getNumberOfDistinctParamBanks(), 1);
+  BOOST_REQUIRE_LE(hadd.getNumberOfDistinctParamBanks(), 2);
+
+  JPetReader readerFirstFile(firstFileName.c_str());
+  JPetReader readerSecondFile(secondFileName.c_str());
+  JPetReader readerHaddedFile(haddedFileName.c_str());
+  BOOST_REQUIRE(readerHaddedFile.isOpen());
+  /// All distinct banks of the merged file are read
+  JPetParamManager paramManager;
+  BOOST_REQUIRE(paramManager.readParametersFromFile(&readerHaddedFile));
+
+  long long firstFileNumberOfEntries = readerFirstFile.getNbOfAllEntries();
+  long long haddedFileNumberOfEntries = readerHaddedFile.getNbOfAllEntries();
+  BOOST_REQUIRE_EQUAL(haddedFileNumberOfEntries, firstFileNumberOfEntries + readerSecondFile.getNbOfAllEntries());
+  for (long long i = 0; i < haddedFileNumberOfEntries; i++)
+  {
+    auto& compareReader = i < firstFileNumberOfEntries ? readerFirstFile : readerSecondFile;
+    const auto& haddedTimeWindow = static_cast<const JPetTimeWindow&>(readerHaddedFile.getCurrentEntry());
+    const auto& compareTimeWindow = static_cast<const JPetTimeWindow&>(compareReader.getCurrentEntry());
+    BOOST_REQUIRE_EQUAL(haddedTimeWindow.getNumberOfEvents(), compareTimeWindow.getNumberOfEvents());
+    for (size_t j = 0; j < haddedTimeWindow.getNumberOfEvents(); j++)
+    {
+      const auto& haddedHits = static_cast<const JPetEvent&>(haddedTimeWindow[j]).getHits();
+      const auto& compareHits = static_cast<const JPetEvent&>(compareTimeWindow[j]).getHits();
+      BOOST_REQUIRE_EQUAL(haddedHits.size(), compareHits.size());
+      for (unsigned int k = 0; k < haddedHits.size(); k++)
+      {
+        BOOST_REQUIRE_EQUAL(haddedHits[k].getTime(), compareHits[k].getTime());
+        BOOST_REQUIRE(!haddedHits[k].getScintillator().isNullObject());
+        BOOST_REQUIRE(!haddedHits[k].getBarrelSlot().isNullObject());
+        BOOST_REQUIRE_EQUAL(haddedHits[k].getScintillator().getID(), compareHits[k].getScintillator().getID());
+        BOOST_REQUIRE_EQUAL(haddedHits[k].getBarrelSlot().getID(), compareHits[k].getBarrelSlot().getID());
+      }
+    }
+    readerHaddedFile.nextEntry();
+    compareReader.nextEntry();
+  }
+
+  auto firstHeader = readerFirstFile.getHeaderClone();
+  auto haddedHeader = readerHaddedFile.getHeaderClone();
+  BOOST_REQUIRE(firstHeader);
+  BOOST_REQUIRE(haddedHeader);
+  BOOST_REQUIRE_GE(haddedHeader->getStagesNb(), firstHeader->getStagesNb());
+  BOOST_REQUIRE_EQUAL(haddedHeader->getVariable("Merged files"), "2");
+  delete firstHeader;
+  delete haddedHeader;
+}
+
+/// Writes a file with one time window and the histogram of its statistics filled nbOfFills times
+void createStatisticsFile(const std::string& fileName, int nbOfFills)
+{
+  TFile file(fileName.c_str(), "RECREATE");
+  auto tree = new TTree("T", "T");
+  auto window = new JPetTimeWindow("JPetEvent");
+  tree->Branch("JPetTimeWindow", "JPetTimeWindow", &window);
+  tree->Fill();
+  auto directory = file.mkdir("Stats");
+  TH1F histogram("hits", "hits", 10, 0, 10);
+  histogram.SetDirectory(nullptr);
+  for (int i = 0; i < nbOfFills; i++)
+  {
+    histogram.Fill(i);
+  }
+  directory->WriteTObject(&histogram);
+  file.Write();
+  file.Close();
+  delete window;
+}
+
+BOOST_AUTO_TEST_CASE(jpet_hadd_identical_param_banks)
+{
+  std::string inputFileName = "unitTestData/JPetHaddTest/single_link_def/dabc_17237091818.hadd.test.root";
+  JPetHadd hadd("unitTestData/JPetHaddTest/jpethadded_identical.hadd.test.root");
+  hadd.setForceOverwrite(true);
+  BOOST_REQUIRE(hadd.merge({inputFileName, inputFileName, inputFileName}));
+  BOOST_REQUIRE_EQUAL(hadd.getNumberOfDistinctParamBanks(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(jpet_hadd_merge_statistics)
+{
+  std::vector<std::string> inputFileNames;
+  for (int i = 0; i < 3; i++)
+  {
+    inputFileNames.push_back("unitTestData/JPetHaddTest/statistics_" + std::to_string(i) + ".hadd.test.root");
+    createStatisticsFile(inputFileNames.back(), i + 1);
+  }
+  std::string haddedFileName = "unitTestData/JPetHaddTest/jpethadded_statistics.hadd.test.root";
+  for (unsigned int nbOfThreads : {1u, 2u, 3u})
+  {
+    JPetHadd hadd(haddedFileName);
+    hadd.setNumberOfThreads(nbOfThreads);
+    hadd.setForceOverwrite(true);
+    BOOST_REQUIRE(hadd.merge(inputFileNames));
+    TFile haddedFile(haddedFileName.c_str(), "READ");
+    std::unique_ptr<TH1F> histogram(dynamic_cast<TH1F*>(haddedFile.Get("Stats/hits")));
+    BOOST_REQUIRE(histogram);
+    BOOST_REQUIRE_EQUAL(histogram->GetEntries(), 6);
+    BOOST_REQUIRE_EQUAL(histogram->GetBinContent(histogram->FindBin(0)), 3);
+    BOOST_REQUIRE_EQUAL(histogram->GetBinContent(histogram->FindBin(2)), 1);
+    auto tree = dynamic_cast<TTree*>(haddedFile.Get("T"));
+    BOOST_REQUIRE(tree);
+    BOOST_REQUIRE_EQUAL(tree->GetEntries(), 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(jpet_hadd_force_overwrite)
+{
+  std::string inputFileName = "unitTestData/JPetHaddTest/single_link_def/dabc_17237091818.hadd.test.root";
+  JPetHadd hadd("unitTestData/JPetHaddTest/jpethadded_overwrite.hadd.test.root");
+  hadd.setForceOverwrite(true);
+  BOOST_REQUIRE(hadd.merge({inputFileName}));
+  hadd.setForceOverwrite(false);
+  BOOST_REQUIRE(!hadd.merge({inputFileName}));
+}
+
+BOOST_AUTO_TEST_CASE(jpet_hadd_bad_input)
+{
+  JPetHadd hadd("unitTestData/JPetHaddTest/jpethadded_bad.hadd.test.root");
+  hadd.setForceOverwrite(true);
+  BOOST_REQUIRE(!hadd.merge({}));
+  BOOST_REQUIRE(!hadd.merge({"unitTestData/JPetHaddTest/nonexistent.root"}));
+}
+
+BOOST_AUTO_TEST_CASE(merge_stage_history)
+{
+  JPetTreeHeader first;
+  first.addStageInfo("Unpacker", "unpacking", 1, "2018-01-01");
+  first.addStageInfo("HitFinder", "hit finding", 1, "2018-01-02");
+  JPetTreeHeader second;
+  second.addStageInfo("Unpacker", "unpacking", 1, "2018-01-01");
+  second.addStageInfo("HitFinder", "hit finding", 2, "2018-01-03");
+  JPetHadd::mergeStageHistory(first, second);
+  BOOST_REQUIRE_EQUAL(first.getStagesNb(), 3);
+  BOOST_REQUIRE_EQUAL(first.getProcessingStageInfo(2).fModuleVersion, 2);
+  JPetHadd::mergeStageHistory(first, second);
+  BOOST_REQUIRE_EQUAL(first.getStagesNb(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,243 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStreamReaderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetStreamReaderTest
+
+#include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetParams/JPetParams.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetStreamReader/JPetStreamReader.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetUnpackTask/JPetUnpackTask.h"
+#include "JPetWriter/JPetWriter.h"
+
+#include <TError.h>
+#include <TROOT.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+
+/// Writes the time windows with the numbers from firstWindow to endWindow - 1, the i-th window containing i + 1 signal channels
+void createTestFile(const std::string& fileName, int firstWindow, int endWindow)
+{
+  JPetWriter writer(fileName.c_str());
+  for (int i = firstWindow; i < endWindow; i++)
+  {
+    JPetTimeWindow window("JPetSigCh");
+    for (int j = 0; j < i + 1; j++)
+    {
+      window.add<JPetSigCh>(JPetSigCh());
+    }
+    writer.write(window);
+  }
+  writer.closeFile();
+}
+
+/// Reads all entries, checking that the i-th entry contains i + 1 signal channels, returns the number of entries
+int readAllEntries(JPetStreamReader& reader)
+{
+  int nbOfEntries = 0;
+  if (reader.firstEntry())
+  {
+    do
+    {
+      nbOfEntries++;
+      BOOST_REQUIRE_EQUAL(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents(), static_cast<unsigned int>(nbOfEntries));
+    } while (reader.nextEntry());
+  }
+  return nbOfEntries;
+}
+
+BOOST_AUTO_TEST_SUITE(JPetStreamReaderTestSuite)
+
+BOOST_AUTO_TEST_CASE(streamed_file_registry)
+{
+  BOOST_REQUIRE(!JPetStreamedFile::find("streamReaderTest_registry.root"));
+  auto stream = JPetStreamedFile::start("streamReaderTest_registry.root");
+  BOOST_REQUIRE(stream);
+  BOOST_REQUIRE(!stream->isFinished());
+  BOOST_REQUIRE_EQUAL(JPetStreamedFile::find("./streamReaderTest_registry.root"), stream);
+  stream->addPart("streamReaderTest_registry_0000.root");
+  std::string partFileName;
+  BOOST_REQUIRE(stream->waitForPart(0, partFileName));
+  BOOST_REQUIRE_EQUAL(partFileName, "streamReaderTest_registry_0000.root");
+  stream->finish(true);
+  BOOST_REQUIRE(stream->isFinished());
+  BOOST_REQUIRE(stream->isSuccessful());
+  BOOST_REQUIRE(!stream->waitForPart(1, partFileName));
+  BOOST_REQUIRE_EQUAL(stream->getPartFileNames().size(), 1u);
+  /// the data exists only as the parts, so it stays registered
+  BOOST_REQUIRE_EQUAL(JPetStreamedFile::find("streamReaderTest_registry.root"), stream);
+  auto restarted = JPetStreamedFile::start("streamReaderTest_registry.root");
+  BOOST_REQUIRE_EQUAL(JPetStreamedFile::find("streamReaderTest_registry.root"), restarted);
+  BOOST_REQUIRE(restarted->getPartFileNames().empty());
+}
+
+BOOST_AUTO_TEST_CASE(finished_stream)
+{
+  createTestFile("streamReaderTest_finished_0000.root", 0, 2);
+  createTestFile("streamReaderTest_finished_0001.root", 2, 2);
+  createTestFile("streamReaderTest_finished_0002.root", 2, 5);
+  auto stream = JPetStreamedFile::start("streamReaderTest_finished.root");
+  stream->addPart("streamReaderTest_finished_0000.root");
+  stream->addPart("streamReaderTest_finished_0001.root");
+  stream->addPart("streamReaderTest_finished_0002.root");
+  stream->finish(true);
+  JPetStreamReader reader(stream);
+  BOOST_REQUIRE(reader.openFileAndLoadData("streamReaderTest_finished.root"));
+  BOOST_REQUIRE_EQUAL(readAllEntries(reader), 5);
+  BOOST_REQUIRE(reader.isComplete());
+  BOOST_REQUIRE(reader.isNbOfAllEntriesKnown());
+  BOOST_REQUIRE(reader.isInputValid());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 5);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfFiles(), 3);
+  BOOST_REQUIRE(reader.lastEntry());
+  BOOST_REQUIRE_EQUAL(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents(), 5u);
+  BOOST_REQUIRE(reader.nthEntry(1));
+  BOOST_REQUIRE_EQUAL(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(failed_stream)
+{
+  createTestFile("streamReaderTest_failed_0000.root", 0, 2);
+  auto stream = JPetStreamedFile::start("streamReaderTest_failed.root");
+  stream->addPart("streamReaderTest_failed_0000.root");
+  stream->finish(false);
+  BOOST_REQUIRE_EQUAL(JPetStreamedFile::find("streamReaderTest_failed.root"), stream);
+  JPetStreamReader reader(stream);
+  BOOST_REQUIRE(reader.openFileAndLoadData("streamReaderTest_failed.root"));
+  BOOST_REQUIRE_EQUAL(readAllEntries(reader), 2);
+  BOOST_REQUIRE(reader.isComplete());
+  BOOST_REQUIRE(!reader.isInputValid());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(nothing_published)
+{
+  gErrorIgnoreLevel = 6000;
+  auto stream = JPetStreamedFile::start("streamReaderTest_missing.root");
+  std::thread producer([stream]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stream->finish(false);
+  });
+  JPetStreamReader reader(stream);
+  BOOST_REQUIRE(!reader.openFileAndLoadData("streamReaderTest_missing.root"));
+  producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(unreadable_part)
+{
+  gErrorIgnoreLevel = 6000;
+  createTestFile("streamReaderTest_unreadable_0000.root", 0, 1);
+  auto stream = JPetStreamedFile::start("streamReaderTest_unreadable.root");
+  stream->addPart("streamReaderTest_unreadable_0000.root");
+  stream->addPart("streamReaderTest_unreadable_missing.root");
+  JPetStreamReader reader(stream);
+  BOOST_REQUIRE(reader.openFileAndLoadData("streamReaderTest_unreadable.root"));
+  BOOST_REQUIRE_EQUAL(readAllEntries(reader), 1);
+  BOOST_REQUIRE(reader.isComplete());
+  BOOST_REQUIRE(!reader.isInputValid());
+  stream->finish(true);
+}
+
+BOOST_AUTO_TEST_CASE(reading_while_producing)
+{
+  ROOT::EnableThreadSafety();
+  createTestFile("streamReaderTest_growing_0000.root", 0, 2);
+  createTestFile("streamReaderTest_growing_0001.root", 2, 5);
+  auto stream = JPetStreamedFile::start("streamReaderTest_growing.root");
+  stream->addPart("streamReaderTest_growing_0000.root");
+
+  JPetStreamReader reader(stream);
+  BOOST_REQUIRE(reader.openFileAndLoadData("streamReaderTest_growing.root"));
+  BOOST_REQUIRE(!reader.isComplete());
+  BOOST_REQUIRE(!reader.isNbOfAllEntriesKnown());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), std::numeric_limits<long long>::max());
+  BOOST_REQUIRE_EQUAL(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents(), 1u);
+  BOOST_REQUIRE(reader.nextEntry());
+  BOOST_REQUIRE_EQUAL(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents(), 2u);
+
+  /// the reader waits for the next part at the end of the published ones
+  std::thread producer([stream]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stream->addPart("streamReaderTest_growing_0001.root");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stream->finish(true);
+  });
+  for (unsigned int i = 3; i <= 5; i++)
+  {
+    BOOST_REQUIRE(reader.nextEntry());
+    BOOST_REQUIRE_EQUAL(dynamic_cast<JPetTimeWindow&>(reader.getCurrentEntry()).getNumberOfEvents(), i);
+  }
+  BOOST_REQUIRE(!reader.nextEntry());
+  producer.join();
+  BOOST_REQUIRE(reader.isNbOfAllEntriesKnown());
+  BOOST_REQUIRE(reader.isInputValid());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(reading_while_unpacking)
+{
+  auto opts = jpet_options_generator_tools::getDefaultOptions();
+  opts["inputFile_std::string"] = std::string("unitTestData/JPetUnpackerTest/xx14099113231.hld");
+  opts["outputPath_std::string"] = std::string("./");
+  opts["unpackerConfigFile_std::string"] = std::string("unitTestData/JPetUnpackerTest/conf_trb3.xml");
+  long long nbOfEntries = 0;
+  {
+    JPetParams controlParams;
+    JPetUnpackTask referenceTask;
+    BOOST_REQUIRE(referenceTask.init(JPetParams(opts, nullptr)));
+    BOOST_REQUIRE(referenceTask.run(JPetDataInterface()));
+    BOOST_REQUIRE(referenceTask.terminate(controlParams));
+    JPetReader reader;
+    BOOST_REQUIRE(reader.openFileAndLoadData("./xx14099113231.hld.root"));
+    nbOfEntries = reader.getNbOfAllEntries();
+  }
+  BOOST_REQUIRE(nbOfEntries > 0);
+
+  opts["streamUnpacking_bool"] = true;
+  opts["streamUnpackingChunkSizeMB_int"] = 1;
+  JPetParams controlParams;
+  JPetUnpackTask unpackTask;
+  BOOST_REQUIRE(unpackTask.init(JPetParams(opts, nullptr)));
+  BOOST_REQUIRE(unpackTask.run(JPetDataInterface()));
+  BOOST_REQUIRE(unpackTask.terminate(controlParams));
+  auto stream = JPetStreamedFile::find("./xx14099113231.hld.root");
+  BOOST_REQUIRE(stream);
+  JPetStreamReader reader(stream);
+  BOOST_REQUIRE(reader.openFileAndLoadData("./xx14099113231.hld.root"));
+  long long nbOfStreamedEntries = 0;
+  if (reader.nthEntry(0))
+  {
+    do
+    {
+      nbOfStreamedEntries++;
+    } while (reader.nextEntry());
+  }
+  BOOST_REQUIRE(reader.isComplete());
+  BOOST_REQUIRE(reader.isInputValid());
+  BOOST_REQUIRE_EQUAL(nbOfStreamedEntries, nbOfEntries);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), nbOfEntries);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfFiles(), static_cast<int>(stream->getPartFileNames().size()));
+  BOOST_REQUIRE_EQUAL(stream->getPartFileNames().front(), "./xx14099113231_0000.hld.root");
+  BOOST_REQUIRE(!boost::filesystem::exists("./xx14099113231_0000.hld"));
+  BOOST_REQUIRE(boost::filesystem::exists("./xx14099113231.hld.manifest"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetStripPairTableTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetStripPairTableTest
+#include "JPetDetectorGeometryCache/JPetDetectorGeometryCache.h"
+#include "JPetStripPairTable/JPetStripPairTable.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+/// Layer 1 with 4 slots and layer 2 with 2 slots, one scintillator in each slot
+std::shared_ptr<JPetParamBank> createBank()
+{
+  auto bank = std::make_shared<JPetParamBank>();
+  bank->addLayer(JPetLayer(1, true, "Layer01", 42.5));
+  bank->addLayer(JPetLayer(2, true, "Layer02", 50.0));
+  std::vector<std::pair<int, float>> slots = {{1, 0.}, {2, 90.}, {3, 180.}, {4, 270.}, {5, 45.}, {6, 225.}};
+  for (const auto& slot : slots)
+  {
+    bank->addBarrelSlot(JPetBarrelSlot(slot.first, true, "slot", slot.second, 1));
+    bank->getBarrelSlot(slot.first).setLayer(bank->getLayer(slot.first <= 4 ? 1 : 2));
+    bank->addScintillator(JPetScin(100 + slot.first, 0., 50., 1.9, 0.7));
+    bank->getScintillator(100 + slot.first).setBarrelSlot(bank->getBarrelSlot(slot.first));
+  }
+  return bank;
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(emptyGeometry)
+{
+  JPetParamBank bank;
+  JPetDetectorGeometryCache geometry(bank);
+  JPetStripPairTable table(geometry);
+  BOOST_REQUIRE_EQUAL(table.getSize(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(deltaID)
+{
+  auto bank = createBank();
+  JPetDetectorGeometryCache geometry(*bank);
+  const auto& table = geometry.getStripPairs();
+  BOOST_REQUIRE_EQUAL(&table, &geometry.getStripPairs());
+  BOOST_REQUIRE_EQUAL(table.getSize(), 6u);
+  auto scin1 = geometry.getIndex(101);
+  auto scin2 = geometry.getIndex(102);
+  auto scin3 = geometry.getIndex(103);
+  auto scin4 = geometry.getIndex(104);
+  auto scin5 = geometry.getIndex(105);
+  auto scin6 = geometry.getIndex(106);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin1, scin1), 0);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin1, scin2), 1);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin1, scin3), 2);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin1, scin4), 1);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin4, scin1), 1);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin5, scin6), 1);
+  BOOST_REQUIRE_EQUAL(table.getDeltaID(scin1, scin5), JPetStripPairTable::kDifferentLayers);
+  BOOST_REQUIRE(table.isSameSlot(scin3, scin3));
+  BOOST_REQUIRE(!table.isSameSlot(scin3, scin4));
+  BOOST_REQUIRE(table.isSameLayer(scin3, scin4));
+  BOOST_REQUIRE(!table.isSameLayer(scin6, scin4));
+}
+
+BOOST_AUTO_TEST_CASE(distanceAndMaxTOF)
+{
+  auto bank = createBank();
+  JPetDetectorGeometryCache geometry(*bank);
+  const auto& table = geometry.getStripPairs();
+  double epsilon = 0.001;
+  auto scin1 = geometry.getIndex(101);
+  auto scin2 = geometry.getIndex(102);
+  auto scin3 = geometry.getIndex(103);
+  BOOST_REQUIRE_SMALL(table.getDistance(scin1, scin1), 0.001f);
+  BOOST_REQUIRE_CLOSE(table.getDistance(scin1, scin3), 85., epsilon);
+  BOOST_REQUIRE_CLOSE(table.getDistance(scin2, scin1), 42.5 * std::sqrt(2.), epsilon);
+  BOOST_REQUIRE_CLOSE(table.getDistance(scin1, scin2), table.getDistance(scin2, scin1), epsilon);
+  BOOST_REQUIRE_CLOSE(table.getMaxTOF(scin1, scin1), 50. / JPetStripPairTable::kSpeedOfLight, epsilon);
+  BOOST_REQUIRE_CLOSE(table.getMaxTOF(scin1, scin3), std::hypot(85., 50.) / JPetStripPairTable::kSpeedOfLight, epsilon);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
 #include "JPetTaskIO/JPetInputHandler.h"
 #include "JPetParamGetterAscii/JPetParamGetterAscii.h"
 #include "JPetParamManager/JPetParamManager.h"
+#include "JPetStreamReader/JPetStreamReader.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -25,6 +26,12 @@ int getEntrysInWindow(JPetInputHandler& handler)
   return timeWindow.getNumberOfEvents();
 }
 
+class TestInputHandler: public JPetInputHandler
+{
+public:
+  const JPetReaderInterface* getReader() const { return fReader.get(); }
+};
+
 BOOST_AUTO_TEST_SUITE(FirstSuite)
 
 BOOST_AUTO_TEST_CASE(basicTest)
@@ -203,4 +210,27 @@ BOOST_AUTO_TEST_CASE(getNextEntry)
   BOOST_REQUIRE(!handler.nextEntry());
 }
 
+BOOST_AUTO_TEST_CASE(openReaderForStreamedFile)
+{
+  using namespace jpet_options_generator_tools;
+  auto opts = getDefaultOptions();
+  auto mgr = std::make_shared<JPetParamManager>(new JPetParamManager(new JPetParamGetterAscii(dataFileName)));
+  auto stream = JPetStreamedFile::start(kInputTestFile);
+  stream->addPart(kInputTestFile);
+
+  TestInputHandler handler;
+  BOOST_REQUIRE(handler.openInput(kInputTestFile, JPetParams(opts, mgr)));
+  BOOST_REQUIRE(!dynamic_cast<const JPetStreamReader*>(handler.getReader()));
+  BOOST_REQUIRE(handler.isNbOfAllEntriesKnown());
+
+  opts["streamUnpacking_bool"] = true;
+  TestInputHandler streamHandler;
+  BOOST_REQUIRE(streamHandler.openInput(kInputTestFile, JPetParams(opts, mgr)));
+  BOOST_REQUIRE(dynamic_cast<const JPetStreamReader*>(streamHandler.getReader()));
+  BOOST_REQUIRE(!streamHandler.isNbOfAllEntriesKnown());
+  BOOST_REQUIRE(streamHandler.isInputValid());
+
+  stream->finish(true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,153 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetOutputHandlerTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetOutputHandlerTest
+
+#include "JPetEntryIndex/JPetEntryIndex.h"
+#include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetParamManager/JPetParamManager.h"
+#include "JPetReader/JPetReader.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTaskIO/JPetOutputHandler.h"
+#include "JPetTreeHeader/JPetTreeHeader.h"
+#include "JPetUserTask/JPetUserTask.h"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+const std::string dataFileName = "unitTestData/JPetParamManagerTest/data.json";
+
+/// Task returning a window with a single signal channel at the given time
+class TestTask: public JPetUserTask
+{
+public:
+  TestTask() : JPetUserTask("TestTask"), fWindow("JPetSigCh") {}
+  void setWindowTime(float time)
+  {
+    fWindow.Clear();
+    JPetSigCh sigCh;
+    sigCh.setValue(time);
+    fWindow.add<JPetSigCh>(sigCh);
+  }
+  JPetTimeWindow* getOutputEvents() override { return &fWindow; }
+
+protected:
+  bool init() override { return true; }
+  bool exec() override { return true; }
+  bool terminate() override { return true; }
+  JPetTimeWindow fWindow;
+};
+
+std::vector<std::string> writeSplitOutput(const jpet_options_tools::OptsStrAny& options, int nbOfWindows)
+{
+  JPetParamManager manager(new JPetParamGetterAscii(dataFileName));
+  manager.fillParameterBank(1);
+  auto header = new JPetTreeHeader(1);
+  JPetStatistics statistics;
+  std::map<std::string, std::unique_ptr<JPetStatistics>> subTasksStatistics;
+  JPetOutputHandler handler("outputHandlerTest.hit.root", options);
+  handler.setPartContent(&manager, header, &statistics, &subTasksStatistics);
+  TestTask task;
+  for (int i = 0; i < nbOfWindows; i++)
+  {
+    task.setWindowTime(i * 100.f);
+    BOOST_REQUIRE(handler.writeEventToFile(&task));
+  }
+  handler.saveAndCloseOutput(manager, header, &statistics, subTasksStatistics);
+  return handler.getPartFileNames();
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(partFileNames)
+{
+  BOOST_REQUIRE_EQUAL(JPetOutputHandler::getPartFileName("dir.x/file.hit.root", 2), "dir.x/file_0002.hit.root");
+  BOOST_REQUIRE_EQUAL(JPetOutputHandler::getPartFileName("file.root", 11), "file_0011.root");
+  BOOST_REQUIRE_EQUAL(JPetOutputHandler::getPartFileName("file", 0), "file_0000");
+  BOOST_REQUIRE_EQUAL(JPetOutputHandler::getManifestFileName("dir/file.hit.root"), "dir/file.hit.manifest");
+  BOOST_REQUIRE_EQUAL(JPetOutputHandler::getManifestFileName("file"), "file.manifest");
+}
+
+BOOST_AUTO_TEST_CASE(noSplitting)
+{
+  jpet_options_tools::OptsStrAny options;
+  auto parts = writeSplitOutput(options, 3);
+  BOOST_REQUIRE(parts.empty());
+  JPetReader reader("outputHandlerTest.hit.root");
+  BOOST_REQUIRE(reader.isOpen());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 3);
+  BOOST_REQUIRE(!reader.getObjectFromFile(JPetEntryIndex::kIndexName.c_str()));
+}
+
+BOOST_AUTO_TEST_CASE(savedEntryIndex)
+{
+  jpet_options_tools::OptsStrAny options;
+  options["saveEntryIndex_bool"] = true;
+  writeSplitOutput(options, 3);
+  JPetReader reader("outputHandlerTest.hit.root");
+  BOOST_REQUIRE(reader.isOpen());
+  auto index = dynamic_cast<JPetEntryIndex*>(reader.getObjectFromFile(JPetEntryIndex::kIndexName.c_str()));
+  BOOST_REQUIRE(index);
+  BOOST_REQUIRE_EQUAL(index->getNumberOfEntries(), 3u);
+  BOOST_REQUIRE_CLOSE(index->getSummary(2).fStartTime, 200., 0.001);
+  BOOST_REQUIRE(index->isTimeOrdered());
+  delete index;
+}
+
+BOOST_AUTO_TEST_CASE(splitByWindows)
+{
+  jpet_options_tools::OptsStrAny options;
+  options["outputSplitWindows_int"] = 2;
+  auto parts = writeSplitOutput(options, 5);
+  std::vector<std::string> expectedParts = {"outputHandlerTest_0000.hit.root", "outputHandlerTest_0001.hit.root", "outputHandlerTest_0002.hit.root"};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(parts.begin(), parts.end(), expectedParts.begin(), expectedParts.end());
+  std::vector<long long> expectedEntries = {2, 2, 1};
+  for (unsigned int i = 0; i < parts.size(); i++)
+  {
+    JPetReader reader(parts[i].c_str());
+    BOOST_REQUIRE(reader.isOpen());
+    BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), expectedEntries[i]);
+    auto header = reader.getHeaderClone();
+    BOOST_REQUIRE(header);
+    BOOST_REQUIRE_EQUAL(header->getVariable("Output part"), std::to_string(i));
+    delete header;
+    auto paramBank = reader.getObjectFromFile("ParamBank;1");
+    BOOST_REQUIRE(paramBank);
+    delete paramBank;
+  }
+  std::ifstream manifest("outputHandlerTest.hit.manifest");
+  std::vector<std::string> manifestParts;
+  std::string line;
+  while (std::getline(manifest, line))
+  {
+    manifestParts.push_back(line);
+  }
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(manifestParts.begin(), manifestParts.end(), expectedParts.begin(), expectedParts.end());
+}
+
+BOOST_AUTO_TEST_CASE(splitByTimeSpan)
+{
+  jpet_options_tools::OptsStrAny options;
+  options["outputSplitTimeSpan_double"] = 250.;
+  auto parts = writeSplitOutput(options, 7);
+  BOOST_REQUIRE_EQUAL(parts.size(), 3u);
+  JPetReader reader(parts[0].c_str());
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
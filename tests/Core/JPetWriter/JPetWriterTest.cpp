@@ -20,16 +20,21 @@
 #include "JPetEvent/JPetEvent.h"
 #include "JPetHit/JPetHit.h"
 #include "JPetLOR/JPetLOR.h"
+#include "JPetMCDecayTree/JPetMCDecayTree.h"
+#include "JPetMCHit/JPetMCHit.h"
 #include "JPetPhysSignal/JPetPhysSignal.h"
 #include "JPetRawSignal/JPetRawSignal.h"
 #include "JPetReader/JPetReader.h"
 #include "JPetRecoSignal/JPetRecoSignal.h"
 #include "JPetSigCh/JPetSigCh.h"
 #include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetTimeWindowMC/JPetTimeWindowMC.h"
 
+#include <TBranchElement.h>
 #include <TFile.h>
 #include <TList.h>
 #include <TNamed.h>
+#include <TTree.h>
 #include <iostream>
 
 #include <boost/filesystem.hpp>
@@ -327,4 +332,110 @@ BOOST_AUTO_TEST_CASE(saving_ROOT_container_subdir)
   fread.Close();
 }
 
+BOOST_AUTO_TEST_CASE(saving_with_MC_truth)
+{
+  auto fileTest = "saving_with_MC_truthTest.root";
+  JPetWriter writer(fileTest);
+  JPetTimeWindowMC mcWindow("JPetHit", "JPetMCHit", "JPetMCDecayTree");
+  JPetTimeWindow window("JPetHit");
+  for (int i = 0; i < 3; i++)
+  {
+    mcWindow.Clear();
+    window.Clear();
+    for (int j = 0; j <= i; j++)
+    {
+      JPetMCHit mcHit;
+      mcHit.setMCVtxIndex(j);
+      mcWindow.addMCHit<JPetMCHit>(mcHit);
+      window.add<JPetHit>(JPetHit());
+    }
+    window.add<JPetHit>(JPetHit());
+    BOOST_REQUIRE(writer.writeWithMCTruth(window, mcWindow));
+  }
+  BOOST_REQUIRE(!writer.writeWithMCTruth(mcWindow, mcWindow));
+  writer.closeFile();
+
+  TFile file(fileTest, "READ");
+  auto tree = dynamic_cast<TTree*>(file.Get(JPetWriter::kRootTreeName.c_str()));
+  BOOST_REQUIRE(tree);
+  BOOST_REQUIRE_EQUAL(std::string(tree->GetBranch("JPetTimeWindow")->GetClassName()), "JPetTimeWindow");
+  auto mcHitsBranch = dynamic_cast<TBranchElement*>(tree->GetBranch(JPetTimeWindowMC::kMCHitsBranchName));
+  BOOST_REQUIRE(mcHitsBranch);
+  BOOST_REQUIRE_EQUAL(std::string(mcHitsBranch->GetClassName()), "TClonesArray");
+  BOOST_REQUIRE_EQUAL(std::string(mcHitsBranch->GetClonesName()), "JPetMCHit");
+  BOOST_REQUIRE(file.GetStreamerInfoList()->FindObject("JPetMCHit"));
+  file.Close();
+
+  JPetReader reader(fileTest);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfAllEntries(), 3);
+  for (int i = 0; i < 3; i++)
+  {
+    BOOST_REQUIRE(reader.nthEntry(i));
+    auto readWindow = dynamic_cast<JPetTimeWindowMC*>(&reader.getCurrentEntry());
+    BOOST_REQUIRE(readWindow);
+    BOOST_REQUIRE_EQUAL(readWindow->getNumberOfEvents(), static_cast<size_t>(i + 2));
+    BOOST_REQUIRE(!readWindow->isMCTruthLoaded());
+    BOOST_REQUIRE_EQUAL(readWindow->getNumberOfMCHits(), static_cast<size_t>(i + 1));
+    BOOST_REQUIRE_EQUAL(readWindow->getNumberOfDecayTrees(), 0u);
+    BOOST_REQUIRE_EQUAL(readWindow->getMCHit<JPetMCHit>(i).getMCVtxIndex(), static_cast<UInt_t>(i));
+    BOOST_REQUIRE(readWindow->isMCTruthLoaded());
+  }
+  reader.closeFile();
+  if (boost::filesystem::exists(fileTest))
+    boost::filesystem::remove(fileTest);
+}
+
+BOOST_AUTO_TEST_CASE(passing_MC_truth_through)
+{
+  auto firstFile = "passing_MC_truth_firstTest.root";
+  auto secondFile = "passing_MC_truth_secondTest.root";
+  JPetWriter writer(firstFile);
+  JPetTimeWindowMC mcWindow("JPetHit", "JPetMCHit", "JPetMCDecayTree");
+  JPetTimeWindow window("JPetHit");
+  for (int i = 0; i < 3; i++)
+  {
+    mcWindow.Clear();
+    for (int j = 0; j <= i; j++)
+    {
+      JPetMCHit mcHit;
+      mcHit.setMCVtxIndex(j);
+      mcWindow.addMCHit<JPetMCHit>(mcHit);
+    }
+    BOOST_REQUIRE(writer.writeWithMCTruth(window, mcWindow));
+  }
+  writer.closeFile();
+
+  JPetReader firstReader(firstFile);
+  JPetWriter secondWriter(secondFile);
+  for (int i = 0; i < 3; i++)
+  {
+    BOOST_REQUIRE(firstReader.nthEntry(i));
+    auto readWindow = dynamic_cast<JPetTimeWindowMC*>(&firstReader.getCurrentEntry());
+    BOOST_REQUIRE(readWindow);
+    if (i == 2)
+    {
+      readWindow->addMCHit<JPetMCHit>(JPetMCHit());
+    }
+    BOOST_REQUIRE(secondWriter.writeWithMCTruth(window, *readWindow));
+  }
+  secondWriter.closeFile();
+  firstReader.closeFile();
+
+  JPetReader secondReader(secondFile);
+  BOOST_REQUIRE_EQUAL(secondReader.getNbOfAllEntries(), 3);
+  for (int i = 0; i < 3; i++)
+  {
+    BOOST_REQUIRE(secondReader.nthEntry(i));
+    auto readWindow = dynamic_cast<JPetTimeWindowMC*>(&secondReader.getCurrentEntry());
+    BOOST_REQUIRE(readWindow);
+    BOOST_REQUIRE_EQUAL(readWindow->getNumberOfMCHits(), static_cast<size_t>(i == 2 ? 4 : i + 1));
+    BOOST_REQUIRE_EQUAL(readWindow->getMCHit<JPetMCHit>(i).getMCVtxIndex(), static_cast<UInt_t>(i));
+  }
+  secondReader.closeFile();
+  if (boost::filesystem::exists(firstFile))
+    boost::filesystem::remove(firstFile);
+  if (boost::filesystem::exists(secondFile))
+    boost::filesystem::remove(secondFile);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
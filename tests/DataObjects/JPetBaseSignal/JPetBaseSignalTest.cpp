@@ -56,4 +56,11 @@ BOOST_AUTO_TEST_CASE(SetAndGetTRefBarrelSlotObjectTest)
   BOOST_CHECK(signal.getBarrelSlot().getID() == 2);
 }
 
+BOOST_AUTO_TEST_CASE(NotSetReferencesReturnNullObjectsTest)
+{
+  JPetBaseSignal signal;
+  BOOST_REQUIRE(signal.getPM().isNullObject());
+  BOOST_REQUIRE(signal.getBarrelSlot().isNullObject());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -129,6 +129,29 @@ BOOST_AUTO_TEST_CASE(addHit)
   BOOST_REQUIRE_EQUAL(event.getHits().size(), 3u);
 }
 
+BOOST_AUTO_TEST_CASE(moveHits)
+{
+  std::vector<JPetHit> hits(3);
+  hits[0].setTime(3);
+  hits[1].setTime(1);
+  hits[2].setTime(2);
+  JPetEvent event(std::move(hits), JPetEventType::kUnknown);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 3u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 1);
+  BOOST_REQUIRE_EQUAL(event.getHits()[2].getTime(), 3);
+  std::vector<JPetHit> newHits(2);
+  newHits[0].setTime(5);
+  newHits[1].setTime(4);
+  event.setHits(std::move(newHits), false);
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 2u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[0].getTime(), 5);
+  JPetHit hit;
+  hit.setTime(6);
+  event.addHit(std::move(hit));
+  BOOST_REQUIRE_EQUAL(event.getHits().size(), 3u);
+  BOOST_REQUIRE_EQUAL(event.getHits()[2].getTime(), 6);
+}
+
 BOOST_AUTO_TEST_CASE(eventTypes)
 {
   JPetEvent event;
@@ -0,0 +1,144 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHitUtilsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetHitUtilsTest
+
+#include "JPetHitUtils/JPetHitUtils.h"
+
+#include <boost/test/unit_test.hpp>
+
+JPetSigCh createPoint(JPetSigCh::EdgeType edge, float time, int thrNum)
+{
+  JPetSigCh sigCh(edge, time);
+  sigCh.setThresholdNumber(thrNum);
+  sigCh.setThreshold(80.f * thrNum);
+  return sigCh;
+}
+
+JPetPhysSignal createPhysSignal(JPetRawSignal rawSignal, const JPetPM& pm)
+{
+  rawSignal.setPM(pm);
+  rawSignal.setBarrelSlot(pm.getBarrelSlot());
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+  return physSignal;
+}
+
+JPetHit createHit(const JPetRawSignal& signalA, const JPetRawSignal& signalB)
+{
+  static JPetBarrelSlot slot;
+  static JPetPM pmA(JPetPM::SideA, 101, 0, 0, std::pair<float, float>(0, 0), "");
+  static JPetPM pmB(JPetPM::SideB, 102, 0, 0, std::pair<float, float>(0, 0), "");
+  pmA.setBarrelSlot(slot);
+  pmB.setBarrelSlot(slot);
+  JPetHit hit;
+  hit.setSignals(createPhysSignal(signalA, pmA), createPhysSignal(signalB, pmB));
+  return hit;
+}
+
+/// Signal with the leading points at the thresholds 1 and 2 and the trailing point at the threshold 1
+JPetRawSignal createSignal(float time)
+{
+  JPetRawSignal signal;
+  signal.addPoint(createPoint(JPetSigCh::Leading, time, 1));
+  signal.addPoint(createPoint(JPetSigCh::Leading, time + 100.f, 2));
+  signal.addPoint(createPoint(JPetSigCh::Trailing, time + 900.f, 1));
+  return signal;
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(timesAtThreshold)
+{
+  JPetHit hit = createHit(createSignal(1000.f), createSignal(400.f));
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeDiffAtThr(hit, 1), 600., 0.001);
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeAtThr(hit, 1), 700., 0.001);
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeDiffAtThr(hit, 2), 600., 0.001);
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeAtThr(hit, 2), 800., 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(missingPoints)
+{
+  JPetHit hit = createHit(createSignal(1000.f), createSignal(400.f));
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeDiffAtThr(hit, 3), JPetHitUtils::Unset);
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeAtThr(hit, 3), JPetHitUtils::Unset);
+  JPetHit emptyHit = createHit(createSignal(1000.f), JPetRawSignal());
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeDiffAtThr(emptyHit, 1), JPetHitUtils::Unset);
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeAtThr(emptyHit, 1), JPetHitUtils::Unset);
+}
+
+BOOST_AUTO_TEST_CASE(outOfRangeThresholds)
+{
+  JPetHit hit = createHit(createSignal(1000.f), createSignal(400.f));
+  for (int thr : {-1, 0, 5, 6})
+  {
+    BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeDiffAtThr(hit, thr), JPetHitUtils::Unset);
+    BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeAtThr(hit, thr), JPetHitUtils::Unset);
+  }
+  JPetRawSignal signalA = createSignal(1000.f);
+  JPetRawSignal signalB = createSignal(400.f);
+  signalA.addPoint(createPoint(JPetSigCh::Leading, 1500.f, 6));
+  signalB.addPoint(createPoint(JPetSigCh::Leading, 1000.f, 6));
+  JPetHit hitWithThr6 = createHit(signalA, signalB);
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeDiffAtThr(hitWithThr6, 6), 500., 0.001);
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeAtThr(hitWithThr6, 6), 1250., 0.001);
+  BOOST_REQUIRE_CLOSE(JPetHitUtils::getTimeDiffAtThr(hitWithThr6, 1), 600., 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(doubledThreshold)
+{
+  JPetRawSignal signalA = createSignal(1000.f);
+  signalA.addPoint(createPoint(JPetSigCh::Leading, 1050.f, 1));
+  JPetHit hit = createHit(signalA, createSignal(400.f));
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeDiffAtThr(hit, 1), JPetHitUtils::Unset);
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeAtThr(hit, 1), JPetHitUtils::Unset);
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeDiffAtThr(hit, 2), JPetHitUtils::Unset);
+  BOOST_REQUIRE_EQUAL(JPetHitUtils::getTimeAtThr(hit, 2), JPetHitUtils::Unset);
+}
+
+BOOST_AUTO_TEST_CASE(timesAtThresholdOfTimeWindow)
+{
+  JPetBarrelSlot slot(7, true, "slot7", 0.f, 1);
+  JPetPM pmA(JPetPM::SideA, 101, 0, 0, std::pair<float, float>(0, 0), "");
+  JPetPM pmB(JPetPM::SideB, 102, 0, 0, std::pair<float, float>(0, 0), "");
+  JPetTimeWindow window("JPetRawSignal");
+  JPetRawSignal signalA = createSignal(1000.f);
+  signalA.setPM(pmA);
+  signalA.setBarrelSlot(slot);
+  JPetRawSignal signalB = createSignal(400.f);
+  signalB.setPM(pmB);
+  signalB.setBarrelSlot(slot);
+  window.add<JPetRawSignal>(signalA);
+  window.add<JPetRawSignal>(signalB);
+  std::vector<int> barrelSlotIDs;
+  std::vector<double> times;
+  std::vector<double> timeDiffs;
+  BOOST_REQUIRE(JPetHitUtils::getTimesAtThr(window, 2, barrelSlotIDs, times, timeDiffs));
+  BOOST_REQUIRE_EQUAL(barrelSlotIDs.size(), 1u);
+  BOOST_REQUIRE_EQUAL(barrelSlotIDs[0], 7);
+  JPetHit hit = createHit(signalA, signalB);
+  BOOST_REQUIRE_CLOSE(times[0], JPetHitUtils::getTimeAtThr(hit, 2), 0.001);
+  BOOST_REQUIRE_CLOSE(timeDiffs[0], JPetHitUtils::getTimeDiffAtThr(hit, 2), 0.001);
+  BOOST_REQUIRE(JPetHitUtils::getTimesAtThr(window, 3, barrelSlotIDs, times, timeDiffs));
+  BOOST_REQUIRE_EQUAL(times[0], JPetHitUtils::Unset);
+  BOOST_REQUIRE_EQUAL(timeDiffs[0], JPetHitUtils::Unset);
+  BOOST_REQUIRE(!JPetHitUtils::getTimesAtThr(window, 0, barrelSlotIDs, times, timeDiffs));
+  BOOST_REQUIRE(times.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
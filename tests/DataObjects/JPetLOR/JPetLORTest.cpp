@@ -86,6 +86,29 @@ BOOST_AUTO_TEST_CASE(hitTest)
   BOOST_REQUIRE(lor.getSecondHit().getScintillator().getID() == sh.getScintillator().getID());
 }
 
+BOOST_AUTO_TEST_CASE(moveHitsTest)
+{
+  JPetHit firstHit;
+  JPetHit secondHit;
+  firstHit.setEnergy(1.f);
+  secondHit.setEnergy(2.f);
+  JPetLOR lor(8.5f, 4.5f, std::move(firstHit), std::move(secondHit));
+  BOOST_REQUIRE_EQUAL(lor.getFirstHit().getEnergy(), 1.f);
+  BOOST_REQUIRE_EQUAL(lor.getSecondHit().getEnergy(), 2.f);
+  JPetHit fh;
+  JPetHit sh;
+  fh.setEnergy(3.f);
+  sh.setEnergy(4.f);
+  lor.setHits(std::move(fh), std::move(sh));
+  BOOST_REQUIRE_EQUAL(lor.getFirstHit().getEnergy(), 3.f);
+  BOOST_REQUIRE_EQUAL(lor.getSecondHit().getEnergy(), 4.f);
+  JPetHit hit;
+  hit.setEnergy(5.f);
+  lor.setSecondHit(std::move(hit));
+  BOOST_REQUIRE_EQUAL(lor.getSecondHit().getEnergy(), 5.f);
+  BOOST_REQUIRE(lor.isHitSet(1));
+}
+
 BOOST_AUTO_TEST_CASE(timeDiffTest)
 {
   JPetLOR lor;
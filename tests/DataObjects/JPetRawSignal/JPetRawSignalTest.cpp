@@ -21,6 +21,7 @@
 #include "JPetPM/JPetPM.h"
 
 #include <boost/test/unit_test.hpp>
+#include <thread>
 
 BOOST_AUTO_TEST_SUITE(ParamDataTS)
 
@@ -205,4 +206,191 @@ BOOST_AUTO_TEST_CASE(GetMapOfTOTsVsThrNumOrValueTest)
   BOOST_REQUIRE_EQUAL(map2.count(200.f), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(PointsAtThresholdTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh sigch1l(JPetSigCh::Leading, 10.f);
+  sigch1l.setThreshold(80.f);
+  sigch1l.setThresholdNumber(1);
+  JPetSigCh sigch3l(JPetSigCh::Leading, 12.f);
+  sigch3l.setThreshold(240.f);
+  sigch3l.setThresholdNumber(3);
+  JPetSigCh sigch1t(JPetSigCh::Trailing, 30.f);
+  sigch1t.setThreshold(80.f);
+  sigch1t.setThresholdNumber(1);
+  signal.addPoint(sigch3l);
+  signal.addPoint(sigch1l);
+  signal.addPoint(sigch1t);
+  BOOST_REQUIRE(signal.hasPoint(JPetSigCh::Leading, 1));
+  BOOST_REQUIRE(!signal.hasPoint(JPetSigCh::Leading, 2));
+  BOOST_REQUIRE(signal.hasPoint(JPetSigCh::Leading, 3));
+  BOOST_REQUIRE(!signal.hasPoint(JPetSigCh::Leading, 0));
+  BOOST_REQUIRE(!signal.hasPoint(JPetSigCh::Leading, 5));
+  BOOST_REQUIRE(!signal.hasPoint(JPetSigCh::Trailing, 3));
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Leading, 3), 12.f);
+  BOOST_REQUIRE_EQUAL(signal.getThresholdValue(JPetSigCh::Leading, 3), 240.f);
+  BOOST_REQUIRE_EQUAL(signal.getPoint(JPetSigCh::Leading, 3).getValue(), 12.f);
+  BOOST_REQUIRE_EQUAL(signal.getTime(JPetSigCh::Leading, 2), 0.f);
+  BOOST_REQUIRE(signal.hasTOT(1));
+  BOOST_REQUIRE(!signal.hasTOT(3));
+  BOOST_REQUIRE_EQUAL(signal.getTOT(1), 20.f);
+  BOOST_REQUIRE_EQUAL(signal.getTOT(3), 0.f);
+
+  JPetSigCh sigch3t(JPetSigCh::Trailing, 15.f);
+  sigch3t.setThreshold(240.f);
+  sigch3t.setThresholdNumber(3);
+  signal.addPoint(sigch3t);
+  BOOST_REQUIRE(signal.hasTOT(3));
+  BOOST_REQUIRE_EQUAL(signal.getTOT(3), 3.f);
+  auto points = signal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
+  BOOST_REQUIRE_EQUAL(points.size(), 2u);
+  BOOST_REQUIRE_EQUAL(points[0].getThresholdNumber(), 1u);
+  BOOST_REQUIRE_EQUAL(points[1].getThresholdNumber(), 3u);
+
+  signal.Clear();
+  BOOST_REQUIRE(!signal.hasPoint(JPetSigCh::Leading, 1));
+  BOOST_REQUIRE(!signal.hasTOT(1));
+}
+
+BOOST_AUTO_TEST_CASE(OtherThresholdNumbersTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh sigch1l(JPetSigCh::Leading, 10.f);
+  sigch1l.setThresholdNumber(1);
+  JPetSigCh sigch6l(JPetSigCh::Leading, 12.f);
+  sigch6l.setThresholdNumber(6);
+  JPetSigCh sigch6t(JPetSigCh::Trailing, 19.f);
+  sigch6t.setThresholdNumber(6);
+  signal.addPoint(sigch6l);
+  signal.addPoint(sigch1l);
+  signal.addPoint(sigch6t);
+  BOOST_REQUIRE(signal.hasPoint(JPetSigCh::Leading, 1));
+  BOOST_REQUIRE(!signal.hasPoint(JPetSigCh::Leading, 6));
+  auto times = signal.getTimesVsThresholdNumber(JPetSigCh::Leading);
+  BOOST_REQUIRE_EQUAL(times.size(), 2u);
+  BOOST_REQUIRE_EQUAL(times[6], 12.f);
+  auto tots = signal.getTOTsVsThresholdNumber();
+  BOOST_REQUIRE_EQUAL(tots.size(), 1u);
+  BOOST_REQUIRE_EQUAL(tots[6], 7.f);
+  auto points = signal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
+  BOOST_REQUIRE_EQUAL(points.size(), 2u);
+  BOOST_REQUIRE_EQUAL(points[0].getThresholdNumber(), 1u);
+  BOOST_REQUIRE_EQUAL(points[1].getThresholdNumber(), 6u);
+}
+
+BOOST_AUTO_TEST_CASE(IndexedTOTsVsThrValueAndSortedPointsTest)
+{
+  JPetRawSignal signal;
+  std::vector<float> thresholds = {80.f, 160.f, 240.f};
+  for (unsigned int thrNum = 3; thrNum >= 1; thrNum--)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, 10.f * thrNum);
+    leading.setThreshold(thresholds[thrNum - 1]);
+    leading.setThresholdNumber(thrNum);
+    signal.addPoint(leading);
+    if (thrNum != 2)
+    {
+      JPetSigCh trailing(JPetSigCh::Trailing, 100.f - thrNum);
+      trailing.setThreshold(thresholds[thrNum - 1]);
+      trailing.setThresholdNumber(thrNum);
+      signal.addPoint(trailing);
+    }
+  }
+  auto tots = signal.getTOTsVsThresholdValue();
+  BOOST_REQUIRE_EQUAL(tots.size(), 2u);
+  BOOST_REQUIRE_EQUAL(tots[80], 89.f);
+  BOOST_REQUIRE_EQUAL(tots[240], 67.f);
+  auto points = signal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrValue);
+  BOOST_REQUIRE_EQUAL(points.size(), 3u);
+  BOOST_REQUIRE_EQUAL(points[0].getThreshold(), 80.f);
+  BOOST_REQUIRE_EQUAL(points[1].getThreshold(), 160.f);
+  BOOST_REQUIRE_EQUAL(points[2].getThreshold(), 240.f);
+
+  /// Threshold values decreasing with the threshold number and a trailing point
+  /// with the value of another threshold number are paired by the value
+  JPetRawSignal other;
+  JPetSigCh leading1(JPetSigCh::Leading, 10.f);
+  leading1.setThreshold(200.f);
+  leading1.setThresholdNumber(1);
+  JPetSigCh leading2(JPetSigCh::Leading, 20.f);
+  leading2.setThreshold(100.f);
+  leading2.setThresholdNumber(2);
+  JPetSigCh trailing3(JPetSigCh::Trailing, 50.f);
+  trailing3.setThreshold(100.f);
+  trailing3.setThresholdNumber(3);
+  other.addPoint(leading1);
+  other.addPoint(leading2);
+  other.addPoint(trailing3);
+  auto otherTOTs = other.getTOTsVsThresholdValue();
+  BOOST_REQUIRE_EQUAL(otherTOTs.size(), 1u);
+  BOOST_REQUIRE_EQUAL(otherTOTs[100], 30.f);
+  auto otherPoints = other.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrValue);
+  BOOST_REQUIRE_EQUAL(otherPoints.size(), 2u);
+  BOOST_REQUIRE_EQUAL(otherPoints[0].getThresholdNumber(), 2u);
+  BOOST_REQUIRE_EQUAL(otherPoints[1].getThresholdNumber(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(CopyAndMoveIndexTest)
+{
+  JPetRawSignal signal;
+  JPetSigCh leading(JPetSigCh::Leading, 10.f);
+  leading.setThresholdNumber(2);
+  JPetSigCh trailing(JPetSigCh::Trailing, 14.f);
+  trailing.setThresholdNumber(2);
+  signal.addPoint(leading);
+  signal.addPoint(trailing);
+
+  JPetRawSignal copy(signal);
+  BOOST_REQUIRE_EQUAL(copy.getTOT(2), 4.f);
+  JPetRawSignal moved(std::move(copy));
+  BOOST_REQUIRE_EQUAL(moved.getTOT(2), 4.f);
+  copy.Clear();
+  BOOST_REQUIRE(!copy.hasPoint(JPetSigCh::Leading, 2));
+
+  JPetRawSignal assigned;
+  assigned = moved;
+  BOOST_REQUIRE_EQUAL(assigned.getTime(JPetSigCh::Trailing, 2), 14.f);
+  JPetSigCh leading3(JPetSigCh::Leading, 11.f);
+  leading3.setThresholdNumber(3);
+  assigned.addPoint(leading3);
+  BOOST_REQUIRE(assigned.hasPoint(JPetSigCh::Leading, 3));
+  BOOST_REQUIRE(!moved.hasPoint(JPetSigCh::Leading, 3));
+  moved = std::move(assigned);
+  BOOST_REQUIRE(moved.hasPoint(JPetSigCh::Leading, 3));
+  BOOST_REQUIRE_EQUAL(moved.getTOT(2), 4.f);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentConstAccessTest)
+{
+  JPetRawSignal signal;
+  for (unsigned int thrNum = 1; thrNum <= JPetRawSignal::kNumberOfThresholds; thrNum++)
+  {
+    JPetSigCh leading(JPetSigCh::Leading, 10.f * thrNum);
+    leading.setThresholdNumber(thrNum);
+    JPetSigCh trailing(JPetSigCh::Trailing, 100.f + thrNum);
+    trailing.setThresholdNumber(thrNum);
+    signal.addPoint(leading);
+    signal.addPoint(trailing);
+  }
+  std::vector<std::thread> threads;
+  std::vector<int> nbOfTOTs(4, 0);
+  for (std::size_t i = 0; i < nbOfTOTs.size(); i++)
+  {
+    threads.emplace_back([&signal, &nbOfTOTs, i]() {
+      for (int repetition = 0; repetition < 1000; repetition++)
+      {
+        nbOfTOTs[i] = signal.getTOTsVsThresholdNumber().size();
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (auto nb : nbOfTOTs)
+  {
+    BOOST_REQUIRE_EQUAL(nb, 4);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetSignalBatchTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetSignalBatchTest
+
+#include "JPetSignalBatch/JPetSignalBatch.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+JPetSigCh createPoint(JPetSigCh::EdgeType edge, float time, int thrNum)
+{
+  JPetSigCh sigCh(edge, time);
+  sigCh.setThresholdNumber(thrNum);
+  sigCh.setThreshold(80.f * thrNum);
+  return sigCh;
+}
+
+/// Signal with the leading and trailing points at the thresholds 1 and 2,
+/// and only the leading point at the threshold 3
+JPetRawSignal createSignal(float time)
+{
+  JPetRawSignal signal;
+  signal.addPoint(createPoint(JPetSigCh::Leading, time, 1));
+  signal.addPoint(createPoint(JPetSigCh::Leading, time + 100.f, 2));
+  signal.addPoint(createPoint(JPetSigCh::Leading, time + 200.f, 3));
+  signal.addPoint(createPoint(JPetSigCh::Trailing, time + 1000.f, 1));
+  signal.addPoint(createPoint(JPetSigCh::Trailing, time + 800.f, 2));
+  return signal;
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(emptyBatch)
+{
+  JPetSignalBatch batch;
+  BOOST_REQUIRE_EQUAL(batch.getSize(), 0u);
+  std::vector<float> tot(3, 1.f);
+  BOOST_REQUIRE(JPetSignalBatch::computeTOT(batch, 1, tot));
+  BOOST_REQUIRE(tot.empty());
+  JPetTimeWindow window;
+  BOOST_REQUIRE(batch.fill(window));
+  BOOST_REQUIRE_EQUAL(batch.getSize(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(fillFromTimeWindow)
+{
+  JPetTimeWindow window("JPetRawSignal");
+  for (int i = 0; i < 3; i++)
+  {
+    window.add<JPetRawSignal>(createSignal(i * 5000.f));
+  }
+  JPetSignalBatch batch;
+  BOOST_REQUIRE(batch.fill(window));
+  BOOST_REQUIRE_EQUAL(batch.getSize(), 3u);
+  for (int i = 0; i < 3; i++)
+  {
+    BOOST_REQUIRE_EQUAL(batch.getLeadingTimes(1)[i], i * 5000.f);
+    BOOST_REQUIRE_EQUAL(batch.getLeadingTimes(3)[i], i * 5000.f + 200.f);
+    BOOST_REQUIRE_EQUAL(batch.getTrailingTimes(2)[i], i * 5000.f + 800.f);
+    BOOST_REQUIRE(std::isnan(batch.getTrailingTimes(3)[i]));
+    BOOST_REQUIRE(std::isnan(batch.getLeadingTimes(4)[i]));
+  }
+  JPetTimeWindow wrongWindow("JPetSigCh");
+  wrongWindow.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.f));
+  BOOST_REQUIRE(!batch.fill(wrongWindow));
+  BOOST_REQUIRE_EQUAL(batch.getSize(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(timeOverThreshold)
+{
+  JPetSignalBatch batch;
+  std::vector<JPetRawSignal> signals = {createSignal(0.f), createSignal(12345.f)};
+  for (const auto& signal : signals)
+  {
+    batch.add(signal);
+  }
+  std::vector<float> tot;
+  BOOST_REQUIRE(JPetSignalBatch::computeTOT(batch, 2, tot));
+  BOOST_REQUIRE_EQUAL(tot.size(), 2u);
+  for (std::size_t i = 0; i < signals.size(); i++)
+  {
+    BOOST_REQUIRE_EQUAL(tot[i], signals[i].getTOTsVsThresholdNumber().at(2));
+  }
+  BOOST_REQUIRE(JPetSignalBatch::computeTOT(batch, 3, tot));
+  BOOST_REQUIRE(std::isnan(tot[0]));
+  BOOST_REQUIRE(!JPetSignalBatch::computeTOT(batch, 0, tot));
+  BOOST_REQUIRE(!JPetSignalBatch::computeTOT(batch, 5, tot));
+  std::vector<double> summedTOT;
+  JPetSignalBatch::computeSummedTOT(batch, summedTOT);
+  BOOST_REQUIRE_EQUAL(summedTOT.size(), 2u);
+  BOOST_REQUIRE_CLOSE(summedTOT[0], 1700., 0.001);
+  BOOST_REQUIRE_CLOSE(summedTOT[1], 1700., 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(sidesAB)
+{
+  JPetSignalBatch sideA;
+  JPetSignalBatch sideB;
+  sideA.add(createSignal(1000.f));
+  sideB.add(createSignal(400.f));
+  sideA.add(createSignal(300.f));
+  sideB.add(JPetRawSignal());
+  std::vector<double> timeDiff;
+  std::vector<double> meanTime;
+  BOOST_REQUIRE(JPetSignalBatch::computeTimeDiffAB(sideA, sideB, 1, timeDiff));
+  BOOST_REQUIRE(JPetSignalBatch::computeMeanTime(sideA, sideB, 1, meanTime));
+  BOOST_REQUIRE_EQUAL(timeDiff.size(), 2u);
+  BOOST_REQUIRE_EQUAL(meanTime.size(), 2u);
+  BOOST_REQUIRE_CLOSE(timeDiff[0], 600., 0.001);
+  BOOST_REQUIRE_CLOSE(meanTime[0], 700., 0.001);
+  BOOST_REQUIRE(std::isnan(timeDiff[1]));
+  BOOST_REQUIRE(std::isnan(meanTime[1]));
+  sideB.add(JPetRawSignal());
+  BOOST_REQUIRE(!JPetSignalBatch::computeTimeDiffAB(sideA, sideB, 1, timeDiff));
+  BOOST_REQUIRE(!JPetSignalBatch::computeMeanTime(sideA, sideB, 1, meanTime));
+}
+
+BOOST_AUTO_TEST_CASE(pairedByBarrelSlot)
+{
+  JPetBarrelSlot slot1(1, true, "slot1", 0.f, 1);
+  JPetBarrelSlot slot2(2, true, "slot2", 0.f, 1);
+  JPetPM pm1A(JPetPM::SideA, 11, 0, 0, std::pair<float, float>(0, 0), "");
+  JPetPM pm1B(JPetPM::SideB, 12, 0, 0, std::pair<float, float>(0, 0), "");
+  JPetPM pm2A(JPetPM::SideA, 21, 0, 0, std::pair<float, float>(0, 0), "");
+  JPetPM pm2B(JPetPM::SideB, 22, 0, 0, std::pair<float, float>(0, 0), "");
+  auto addSignal = [](JPetTimeWindow& window, float time, const JPetPM& pm, const JPetBarrelSlot& slot) {
+    JPetRawSignal signal = createSignal(time);
+    signal.setPM(pm);
+    signal.setBarrelSlot(slot);
+    window.add<JPetRawSignal>(signal);
+  };
+  JPetTimeWindow window("JPetRawSignal");
+  addSignal(window, 2000.f, pm2B, slot2);
+  addSignal(window, 1000.f, pm1A, slot1);
+  addSignal(window, 2500.f, pm2A, slot2);
+  addSignal(window, 400.f, pm1B, slot1);
+  addSignal(window, 3000.f, pm2A, slot2);
+  window.add<JPetRawSignal>(createSignal(5000.f));
+  JPetSignalBatch sideA;
+  JPetSignalBatch sideB;
+  std::vector<int> barrelSlotIDs;
+  BOOST_REQUIRE(JPetSignalBatch::fill(window, sideA, sideB, &barrelSlotIDs));
+  BOOST_REQUIRE_EQUAL(sideA.getSize(), 2u);
+  BOOST_REQUIRE_EQUAL(sideB.getSize(), 2u);
+  BOOST_REQUIRE_EQUAL(barrelSlotIDs.size(), 2u);
+  BOOST_REQUIRE_EQUAL(barrelSlotIDs[0], 1);
+  BOOST_REQUIRE_EQUAL(barrelSlotIDs[1], 2);
+  BOOST_REQUIRE_EQUAL(sideA.getLeadingTimes(1)[0], 1000.f);
+  BOOST_REQUIRE_EQUAL(sideB.getLeadingTimes(1)[0], 400.f);
+  BOOST_REQUIRE_EQUAL(sideA.getLeadingTimes(1)[1], 2500.f);
+  BOOST_REQUIRE_EQUAL(sideB.getLeadingTimes(1)[1], 2000.f);
+  std::vector<double> timeDiff;
+  BOOST_REQUIRE(JPetSignalBatch::computeTimeDiffAB(sideA, sideB, 1, timeDiff));
+  BOOST_REQUIRE_CLOSE(timeDiff[0], 600., 0.001);
+  BOOST_REQUIRE_CLOSE(timeDiff[1], 500., 0.001);
+  JPetTimeWindow wrongWindow("JPetSigCh");
+  wrongWindow.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.f));
+  BOOST_REQUIRE(!JPetSignalBatch::fill(wrongWindow, sideA, sideB, &barrelSlotIDs));
+  BOOST_REQUIRE_EQUAL(sideA.getSize(), 0u);
+  BOOST_REQUIRE_EQUAL(sideB.getSize(), 0u);
+  BOOST_REQUIRE(barrelSlotIDs.empty());
+}
+
+BOOST_AUTO_TEST_CASE(doubledThreshold)
+{
+  JPetRawSignal signal = createSignal(0.f);
+  signal.addPoint(createPoint(JPetSigCh::Leading, 50.f, 1));
+  JPetSignalBatch batch;
+  batch.add(signal);
+  for (unsigned int thrNum = 1; thrNum <= JPetSignalBatch::kNumberOfThresholds; thrNum++)
+  {
+    BOOST_REQUIRE(std::isnan(batch.getLeadingTimes(thrNum)[0]));
+  }
+  BOOST_REQUIRE_EQUAL(batch.getTrailingTimes(1)[0], 1000.f);
+  std::vector<float> tot;
+  BOOST_REQUIRE(JPetSignalBatch::computeTOT(batch, 1, tot));
+  BOOST_REQUIRE(std::isnan(tot[0]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
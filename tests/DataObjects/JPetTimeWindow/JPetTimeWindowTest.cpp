@@ -18,6 +18,9 @@
 
 #include "JPetTimeWindow/JPetTimeWindow.h"
 #include "JPetHit/JPetHit.h"
+#include "JPetPhysSignal/JPetPhysSignal.h"
+#include "JPetRawSignal/JPetRawSignal.h"
+#include "JPetRecoSignal/JPetRecoSignal.h"
 #include "JPetSigCh/JPetSigCh.h"
 
 #include <boost/test/unit_test.hpp>
@@ -56,4 +59,79 @@ BOOST_AUTO_TEST_CASE(clearing)
   BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(recycling_events)
+{
+  JPetTimeWindow test("JPetHit");
+  JPetRawSignal rawSignal;
+  for (int i = 1; i <= 4; i++)
+  {
+    rawSignal.addPoint(JPetSigCh(JPetSigCh::Leading, 10.f * i));
+  }
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  recoSignal.setRecoTimeAtThreshold(80.f, 1.f);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+  JPetHit bigHit;
+  bigHit.setSignalA(physSignal);
+  bigHit.setTime(1.f);
+  test.add<JPetHit>(bigHit);
+  test.add<JPetHit>(bigHit);
+  auto first = &test.getEvent<JPetHit>(0);
+  auto second = &test.getEvent<JPetHit>(1);
+  test.Clear();
+
+  JPetHit smallHit;
+  smallHit.setTime(2.f);
+  test.add<JPetHit>(smallHit);
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 1);
+  BOOST_REQUIRE_EQUAL(&test.getEvent<JPetHit>(0), first);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetHit>(0).getTime(), 2.f);
+  JPetRecoSignal reused = test.getEvent<JPetHit>(0).getSignalA().getRecoSignal();
+  BOOST_REQUIRE_EQUAL(reused.getRawSignal().getNumberOfPoints(JPetSigCh::Leading), 0);
+  BOOST_REQUIRE(reused.getRecoTimesAtThreshold().empty());
+  test.add<JPetHit>(bigHit);
+  BOOST_REQUIRE_EQUAL(&test.getEvent<JPetHit>(1), second);
+  BOOST_REQUIRE_EQUAL(test.getEvent<JPetHit>(1).getSignalA().getRecoSignal().getRawSignal().getNumberOfPoints(JPetSigCh::Leading), 4);
+}
+
+BOOST_AUTO_TEST_CASE(moving_and_emplacing_events)
+{
+  JPetTimeWindow test("JPetSigCh");
+  JPetSigCh sigCh(JPetSigCh::Leading, 1.5);
+  test.add<JPetSigCh>(std::move(sigCh));
+  auto& emplaced = test.emplace<JPetSigCh>(JPetSigCh::Trailing, 2.5f);
+  BOOST_REQUIRE_EQUAL(emplaced.getType(), JPetSigCh::Trailing);
+  auto& filled = test.emplace<JPetSigCh>();
+  filled.setValue(3.5f);
+  BOOST_REQUIRE_EQUAL(test.getNumberOfEvents(), 3);
+  double epsilon = 0.001;
+  BOOST_REQUIRE_CLOSE(test.getEvent<JPetSigCh>(0).getValue(), 1.5, epsilon);
+  BOOST_REQUIRE_CLOSE(test.getEvent<JPetSigCh>(1).getValue(), 2.5, epsilon);
+  BOOST_REQUIRE_CLOSE(test.getEvent<JPetSigCh>(2).getValue(), 3.5, epsilon);
+  test.Clear();
+  auto& recycled = test.emplace<JPetSigCh>();
+  BOOST_REQUIRE_EQUAL(recycled.getValue(), 0.f);
+}
+
+BOOST_AUTO_TEST_CASE(clearing_signals_in_place)
+{
+  JPetRawSignal rawSignal;
+  rawSignal.addPoint(JPetSigCh(JPetSigCh::Leading, 10.f));
+  rawSignal.setRecoFlag(JPetBaseSignal::Good);
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  recoSignal.setAmplitude(5.);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+  physSignal.setTime(3.);
+  JPetHit hit;
+  hit.setSignals(physSignal, physSignal);
+  hit.Clear();
+  BOOST_REQUIRE_EQUAL(hit.getSignalA().getTime(), 0.);
+  BOOST_REQUIRE_EQUAL(hit.getSignalB().getRecoSignal().getAmplitude(), 0.);
+  BOOST_REQUIRE_EQUAL(hit.getSignalA().getRecoSignal().getRawSignal().getNumberOfPoints(JPetSigCh::Leading), 0);
+  BOOST_REQUIRE_EQUAL(hit.getSignalA().getRecoSignal().getRawSignal().getRecoFlag(), JPetBaseSignal::Unknown);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
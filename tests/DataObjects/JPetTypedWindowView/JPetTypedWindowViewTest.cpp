@@ -0,0 +1,96 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetTypedWindowViewTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetTypedWindowViewTest
+
+#include "JPetHit/JPetHit.h"
+#include "JPetSigCh/JPetSigCh.h"
+#include "JPetTimeWindow/JPetTimeWindow.h"
+#include "JPetTypedWindowView/JPetTypedWindowView.h"
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(empty_window)
+{
+  JPetTimeWindow window;
+  JPetTypedWindowView<JPetHit> view(window);
+  BOOST_REQUIRE(view.empty());
+  BOOST_REQUIRE(view.begin() == view.end());
+}
+
+BOOST_AUTO_TEST_CASE(wrong_class)
+{
+  JPetTimeWindow window("JPetSigCh");
+  window.add<JPetSigCh>(JPetSigCh(JPetSigCh::Leading, 1.f));
+  JPetTypedWindowView<JPetHit> view(window);
+  BOOST_REQUIRE(!view.isValid());
+  BOOST_REQUIRE_EQUAL(view.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(iterating)
+{
+  JPetTimeWindow window("JPetHit");
+  for (int i = 0; i < 5; i++)
+  {
+    JPetHit hit;
+    hit.setTime(i);
+    window.add<JPetHit>(hit);
+  }
+  const JPetTimeWindow& constWindow = window;
+  JPetTypedWindowView<const JPetHit> view(constWindow);
+  BOOST_REQUIRE(view.isValid());
+  BOOST_REQUIRE_EQUAL(view.size(), 5u);
+  float expected = 0.f;
+  for (const auto& hit : view)
+  {
+    BOOST_REQUIRE_EQUAL(hit.getTime(), expected);
+    expected++;
+  }
+  BOOST_REQUIRE_EQUAL(view[3].getTime(), 3.f);
+  BOOST_REQUIRE_EQUAL(view.end() - view.begin(), 5);
+  BOOST_REQUIRE_EQUAL(view.begin()[2].getTime(), 2.f);
+}
+
+BOOST_AUTO_TEST_CASE(stl_algorithms)
+{
+  JPetTimeWindow window("JPetHit");
+  std::vector<float> times = {4.f, 1.f, 3.f, 0.f, 2.f};
+  for (auto time : times)
+  {
+    JPetHit hit;
+    hit.setTime(time);
+    window.add<JPetHit>(hit);
+  }
+  JPetTypedWindowView<JPetHit> view(window);
+  auto byTime = [](const JPetHit& h1, const JPetHit& h2) { return h1.getTime() < h2.getTime(); };
+  std::sort(view.begin(), view.end(), byTime);
+  for (int i = 0; i < 5; i++)
+  {
+    BOOST_REQUIRE_EQUAL(window.getEvent<JPetHit>(i).getTime(), static_cast<float>(i));
+  }
+  JPetHit searched;
+  searched.setTime(3.f);
+  auto found = std::lower_bound(view.begin(), view.end(), searched, byTime);
+  BOOST_REQUIRE_EQUAL(found - view.begin(), 3);
+  auto middle = std::partition(view.begin(), view.end(), [](const JPetHit& hit) { return hit.getTime() > 2.5f; });
+  BOOST_REQUIRE_EQUAL(middle - view.begin(), 2);
+  BOOST_REQUIRE(std::all_of(view.begin(), middle, [](const JPetHit& hit) { return hit.getTime() > 2.5f; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
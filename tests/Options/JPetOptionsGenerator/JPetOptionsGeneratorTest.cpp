@@ -118,6 +118,22 @@ BOOST_AUTO_TEST_CASE(generateOptions_TwoFilesOneTasks)
   BOOST_REQUIRE(!isLocalDBCreate(opts));
 }
 
+BOOST_AUTO_TEST_CASE(generateOptions_TwoFilesChained)
+{
+  JPetOptionsGenerator gener;
+  auto inArgs =
+      getCmdLineArgs("main.x -i 231 -f unitTestData/JPetOptionsGeneratorTest/infile.root unitTestData/JPetOptionsGeneratorTest/infile2.root -t root");
+  auto opt = gener.generateAndValidateOptions(inArgs);
+  setChainInputFiles(opt, true);
+  auto result = gener.generateOptionsForTasks(opt, 1);
+  BOOST_REQUIRE_EQUAL(result.size(), 1u);
+  BOOST_REQUIRE_EQUAL(result.begin()->first, "unitTestData/JPetOptionsGeneratorTest/infile.root");
+  auto opts = result.begin()->second;
+  BOOST_REQUIRE(isChainInputFiles(opts));
+  BOOST_REQUIRE_EQUAL(getInputFile(opts), "unitTestData/JPetOptionsGeneratorTest/infile.root");
+  BOOST_REQUIRE_EQUAL(getInputFiles(opts).size(), 2u);
+}
+
 BOOST_AUTO_TEST_CASE(generateOptions_oneFileTwoTasksWithOutput)
 {
   JPetOptionsGenerator gener;
@@ -211,6 +211,23 @@ BOOST_AUTO_TEST_CASE(generateOptionsForTask_resetEventRange)
   BOOST_REQUIRE_EQUAL(getOptionAsInt(resultsOpt, "lastEvent_int"), -1);
 }
 
+BOOST_AUTO_TEST_CASE(generateOptionsForTask_splitOutput)
+{
+  auto commandLine = "main.x -f unitTestData/JPetCmdParserTest/data.root -t root -i 231";
+  auto inOpts = getOptions(commandLine);
+  std::vector<std::string> parts = {"data_0000.hit.root", "data_0001.hit.root"};
+  std::map<std::string, boost::any> controlSettings = {{"outputFile_std::string", std::string("data.hit.root")},
+                                                       {"chainInputFiles_bool", bool(true)},
+                                                       {"file_std::vector<std::string>", parts}};
+  auto resultsOpt = generateOptionsForTask(inOpts, controlSettings);
+  BOOST_REQUIRE(isChainInputFiles(resultsOpt));
+  auto inputFiles = getInputFiles(resultsOpt);
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(inputFiles.begin(), inputFiles.end(), parts.begin(), parts.end());
+  controlSettings["chainInputFiles_bool"] = false;
+  resultsOpt = generateOptionsForTask(resultsOpt, controlSettings);
+  BOOST_REQUIRE(!isChainInputFiles(resultsOpt));
+}
+
 BOOST_AUTO_TEST_CASE(generateOptionsForTask_outputPath)
 {
   auto commandLine = "main.x -f data.root -t root -r 2 100  -i 231 ";
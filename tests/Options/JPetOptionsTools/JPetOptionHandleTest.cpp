@@ -0,0 +1,83 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetOptionHandleTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetOptionHandleTest
+#include "JPetOptionsTools/JPetOptionHandle.h"
+
+#include <boost/any.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace jpet_options_tools;
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(defaultHandle)
+{
+  JPetOptionHandle<double> handle;
+  BOOST_REQUIRE(!handle.isSet());
+  BOOST_REQUIRE_EQUAL(handle.getOr(4.5), 4.5);
+}
+
+BOOST_AUTO_TEST_CASE(handlesOfSetOptions)
+{
+  auto opts = std::make_shared<OptsStrAny>();
+  (*opts)["time_double"] = 2.5;
+  (*opts)["seed_int"] = 7;
+  (*opts)["name_std::string"] = std::string("value");
+  (*opts)["thresholds_std::vector<double>"] = std::vector<double>{1., 2.};
+  std::shared_ptr<const OptsStrAny> sharedOpts = opts;
+  JPetOptionHandle<double> time(sharedOpts, "time_double");
+  JPetOptionHandle<int> seed(sharedOpts, "seed_int");
+  JPetOptionHandle<std::string> name(sharedOpts, "name_std::string");
+  JPetOptionHandle<std::vector<double>> thresholds(sharedOpts, "thresholds_std::vector<double>");
+  BOOST_REQUIRE(time.isSet());
+  BOOST_REQUIRE_EQUAL(time.get(), 2.5);
+  BOOST_REQUIRE_EQUAL(time.getOr(1.), 2.5);
+  BOOST_REQUIRE_EQUAL(time.getName(), "time_double");
+  BOOST_REQUIRE_EQUAL(seed.get(), 7);
+  BOOST_REQUIRE_EQUAL(name.get(), "value");
+  BOOST_REQUIRE_EQUAL(thresholds.get().size(), 2u);
+  BOOST_REQUIRE_EQUAL(&time.get(), &boost::any_cast<const double&>(sharedOpts->at("time_double")));
+}
+
+BOOST_AUTO_TEST_CASE(handlesKeepOptionsAlive)
+{
+  auto opts = std::make_shared<OptsStrAny>();
+  (*opts)["time_double"] = 2.5;
+  JPetOptionHandle<double> time(opts, "time_double");
+  opts.reset();
+  BOOST_REQUIRE(time.isSet());
+  BOOST_REQUIRE_EQUAL(time.get(), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(handlesOfMissingOrBadOptions)
+{
+  auto opts = std::make_shared<OptsStrAny>();
+  (*opts)["time_double"] = 2.5;
+  JPetOptionHandle<double> missing(opts, "missing_double");
+  JPetOptionHandle<int> badType(opts, "time_double");
+  JPetOptionHandle<int> noOptions(nullptr, "time_double");
+  BOOST_REQUIRE(!missing.isSet());
+  BOOST_REQUIRE_EQUAL(missing.getOr(1.5), 1.5);
+  BOOST_REQUIRE(!badType.isSet());
+  BOOST_REQUIRE_EQUAL(badType.getOr(3), 3);
+  BOOST_REQUIRE(!noOptions.isSet());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
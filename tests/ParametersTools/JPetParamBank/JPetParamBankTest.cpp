@@ -22,6 +22,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 #include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(JPetParamBankTestSuite)
 
@@ -357,4 +359,56 @@ BOOST_AUTO_TEST_CASE(saving_reading_file)
   file2.Close();
 }
 
+BOOST_AUTO_TEST_CASE(IndexWithCompactIdsTest)
+{
+  JPetParamBank bank;
+  for (int id = 1; id <= 192; id++) {
+    bank.addScintillator(JPetScin(id, 8.f, 2.f, 4.f, 8.f));
+  }
+  BOOST_REQUIRE(!bank.isIndexBuilt());
+  bank.buildIndex();
+  BOOST_REQUIRE(bank.isIndexBuilt());
+  for (int id = 1; id <= 192; id++) {
+    BOOST_REQUIRE_EQUAL(&bank.getScintillator(id), bank.getScintillators().at(id));
+  }
+  BOOST_REQUIRE_THROW(bank.getScintillator(0), std::out_of_range);
+  BOOST_REQUIRE_THROW(bank.getScintillator(193), std::out_of_range);
+  BOOST_REQUIRE_THROW(bank.getPM(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(IndexWithSparseIdsTest)
+{
+  JPetParamBank bank;
+  std::vector<int> ids = {-7, 3, 1000, 65536, 123456789, 2147483647};
+  for (auto id : ids) {
+    bank.addTRB(JPetTRB(id, 64, 128));
+  }
+  bank.buildIndex();
+  BOOST_REQUIRE(bank.isIndexBuilt());
+  for (auto id : ids) {
+    BOOST_REQUIRE_EQUAL(&bank.getTRB(id), bank.getTRBs().at(id));
+  }
+  BOOST_REQUIRE_THROW(bank.getTRB(4), std::out_of_range);
+  BOOST_REQUIRE_THROW(bank.getTRB(-2147483647 - 1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(IndexAfterAddingTest)
+{
+  JPetParamBank bank;
+  bank.addTRB(JPetTRB(1, 64, 128));
+  bank.buildIndex();
+  bank.addTRB(JPetTRB(100000, 64, 128));
+  BOOST_REQUIRE(!bank.isIndexBuilt());
+  BOOST_REQUIRE_EQUAL(bank.getTRB(100000).getID(), 100000);
+  JPetParamBank copy(bank);
+  BOOST_REQUIRE(!copy.isIndexBuilt());
+  bank.buildIndex();
+  JPetParamBank indexedCopy(bank);
+  BOOST_REQUIRE(indexedCopy.isIndexBuilt());
+  BOOST_REQUIRE_EQUAL(indexedCopy.getTRB(100000).getID(), 100000);
+  bank.clear();
+  BOOST_REQUIRE(!bank.isIndexBuilt());
+  BOOST_REQUIRE_THROW(bank.getTRB(1), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
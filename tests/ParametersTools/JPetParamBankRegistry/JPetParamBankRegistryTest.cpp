@@ -0,0 +1,115 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamBankRegistryTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetParamBankRegistryTest
+
+#include "JPetParamBankRegistry/JPetParamBankRegistry.h"
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(JPetParamBankRegistryTestSuite)
+
+BOOST_AUTO_TEST_CASE(bank_is_built_once_per_key)
+{
+  JPetParamBankRegistry::clear();
+  int nbOfBuilds = 0;
+  auto builder = [&nbOfBuilds]() {
+    nbOfBuilds++;
+    return std::make_shared<const JPetParamBank>();
+  };
+  auto first = JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("db.json", 1, {}), builder);
+  auto second = JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("db.json", 1, {}), builder);
+  BOOST_REQUIRE(first);
+  BOOST_REQUIRE_EQUAL(first, second);
+  BOOST_REQUIRE_EQUAL(nbOfBuilds, 1);
+  auto otherRun = JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("db.json", 2, {}), builder);
+  auto otherMissing = JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("db.json", 1, {ParamObjectType::kTRB}), builder);
+  auto otherSource = JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("other.json", 1, {}), builder);
+  BOOST_REQUIRE(otherRun != first);
+  BOOST_REQUIRE(otherMissing != first);
+  BOOST_REQUIRE(otherSource != first);
+  BOOST_REQUIRE_EQUAL(nbOfBuilds, 4);
+  BOOST_REQUIRE_EQUAL(JPetParamBankRegistry::getSize(), 4u);
+  JPetParamBankRegistry::clear();
+  BOOST_REQUIRE_EQUAL(JPetParamBankRegistry::getSize(), 0u);
+  BOOST_REQUIRE(JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("db.json", 1, {}), builder) != first);
+  BOOST_REQUIRE_EQUAL(nbOfBuilds, 5);
+}
+
+BOOST_AUTO_TEST_CASE(failed_build_is_not_registered)
+{
+  JPetParamBankRegistry::clear();
+  JPetParamBankRegistry::Key key("db.json", 1, {});
+  BOOST_REQUIRE_THROW(JPetParamBankRegistry::getParamBank(key, []() -> std::shared_ptr<const JPetParamBank> {
+    throw std::runtime_error("no such run");
+  }), std::runtime_error);
+  auto bank = JPetParamBankRegistry::getParamBank(key, []() { return std::make_shared<const JPetParamBank>(); });
+  BOOST_REQUIRE(bank);
+}
+
+BOOST_AUTO_TEST_CASE(released_bank_is_removed)
+{
+  JPetParamBankRegistry::clear();
+  int nbOfBuilds = 0;
+  auto builder = [&nbOfBuilds]() {
+    nbOfBuilds++;
+    return std::make_shared<const JPetParamBank>();
+  };
+  JPetParamBankRegistry::Key key("db.json", 1, {});
+  auto bank = JPetParamBankRegistry::getParamBank(key, builder);
+  std::weak_ptr<const JPetParamBank> released = bank;
+  BOOST_REQUIRE_EQUAL(JPetParamBankRegistry::getSize(), 1u);
+  bank.reset();
+  BOOST_REQUIRE(released.expired());
+  BOOST_REQUIRE_EQUAL(JPetParamBankRegistry::getSize(), 0u);
+  bank = JPetParamBankRegistry::getParamBank(key, builder);
+  BOOST_REQUIRE(bank);
+  BOOST_REQUIRE_EQUAL(nbOfBuilds, 2);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_callers_share_one_bank)
+{
+  JPetParamBankRegistry::clear();
+  std::atomic<int> nbOfBuilds(0);
+  const int nbOfThreads = 8;
+  std::vector<std::shared_ptr<const JPetParamBank>> banks(nbOfThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nbOfThreads; i++)
+  {
+    threads.emplace_back([&banks, &nbOfBuilds, i]() {
+      banks[i] = JPetParamBankRegistry::getParamBank(JPetParamBankRegistry::Key("db.json", 1, {}), [&nbOfBuilds]() {
+        nbOfBuilds++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::make_shared<const JPetParamBank>();
+      });
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  BOOST_REQUIRE_EQUAL(nbOfBuilds, 1);
+  for (const auto& bank : banks)
+  {
+    BOOST_REQUIRE_EQUAL(bank, banks.front());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <fstream>
 
 const std::string dataDir = "unitTestData/JPetParamGetterAsciiTest/";
 
@@ -167,4 +168,45 @@ BOOST_AUTO_TEST_CASE(minimal_example_write)
   boost::filesystem::remove(writtenFileName);
 }
 
+BOOST_AUTO_TEST_CASE(cache_noExisting_file)
+{
+  BOOST_REQUIRE(!JPetParamAsciiCache::getDocument(dataDir + "noExisting.json"));
+}
+
+BOOST_AUTO_TEST_CASE(cache_shares_parsed_document)
+{
+  auto first = JPetParamAsciiCache::getDocument(dataDir + "DB2.json");
+  auto second = JPetParamAsciiCache::getDocument(dataDir + "DB2.json");
+  BOOST_REQUIRE(first);
+  BOOST_REQUIRE_EQUAL(first, second);
+  auto run = first->getRun("1");
+  BOOST_REQUIRE(run);
+  BOOST_REQUIRE(!first->getRun("1000"));
+  BOOST_REQUIRE_EQUAL(run->at("PMs").size(), 1u);
+  BOOST_REQUIRE_EQUAL(run->at("PMs").front().at("is_right_side"), "1");
+}
+
+BOOST_AUTO_TEST_CASE(cache_reparses_modified_file)
+{
+  std::string fileName(dataDir + "cachedDB.json");
+  {
+    std::ofstream file(fileName);
+    file << "{\"1\": {\"PMs\": [{\"id\": 1}]}}";
+  }
+  JPetParamGetterAscii getter(fileName);
+  BOOST_REQUIRE_EQUAL(getter.getAllBasicData(ParamObjectType::kPM, 1).size(), 1u);
+  auto first = JPetParamAsciiCache::getDocument(fileName);
+  {
+    std::ofstream file(fileName);
+    file << "{\"1\": {\"PMs\": [{\"id\": 1}, {\"id\": 2}]}}";
+  }
+  BOOST_REQUIRE_EQUAL(getter.getAllBasicData(ParamObjectType::kPM, 1).size(), 2u);
+  BOOST_REQUIRE(first != JPetParamAsciiCache::getDocument(fileName));
+  auto second = JPetParamAsciiCache::getDocument(fileName);
+  JPetParamAsciiCache::invalidate(fileName);
+  BOOST_REQUIRE(second != JPetParamAsciiCache::getDocument(fileName));
+  boost::filesystem::remove(fileName);
+  BOOST_REQUIRE(!JPetParamAsciiCache::getDocument(fileName));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
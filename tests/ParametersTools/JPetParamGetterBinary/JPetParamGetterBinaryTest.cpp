@@ -0,0 +1,125 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamGetterBinaryTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetParamGetterBinaryTest
+
+#include "JPetParamGetterAscii/JPetParamGetterAscii.h"
+#include "JPetParamGetterBinary/JPetParamBinaryFile.h"
+#include "JPetParamGetterBinary/JPetParamGetterBinary.h"
+#include "JPetParamManager/JPetParamManager.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+const std::string dataFileName = "unitTestData/JPetParamManagerTest/data.json";
+
+BOOST_AUTO_TEST_SUITE(JPetParamGetterBinaryTestSuite)
+
+BOOST_AUTO_TEST_CASE(compiled_file_gives_the_same_descriptions)
+{
+  auto compiledFileName = boost::filesystem::unique_path("compiledDB%%%%.json.bin").string();
+  BOOST_REQUIRE(JPetParamBinaryFile::compile(dataFileName, compiledFileName));
+  BOOST_REQUIRE(JPetParamBinaryFile::isUpToDate(dataFileName, compiledFileName));
+  JPetParamGetterAscii asciiGetter(dataFileName);
+  JPetParamGetterBinary binaryGetter(compiledFileName);
+  std::vector<ParamObjectType> types = {ParamObjectType::kScintillator, ParamObjectType::kPM, ParamObjectType::kBarrelSlot,
+                                        ParamObjectType::kLayer,        ParamObjectType::kFrame, ParamObjectType::kFEB,
+                                        ParamObjectType::kTRB,          ParamObjectType::kTOMBChannel};
+  for (auto type : types)
+  {
+    BOOST_REQUIRE(asciiGetter.getAllBasicData(type, 1) == binaryGetter.getAllBasicData(type, 1));
+    for (auto otherType : types)
+    {
+      BOOST_REQUIRE(asciiGetter.getAllRelationalData(type, otherType, 1) == binaryGetter.getAllRelationalData(type, otherType, 1));
+    }
+  }
+  BOOST_REQUIRE_EQUAL(binaryGetter.getAllBasicData(ParamObjectType::kPM, 1).size(), 4u);
+  BOOST_REQUIRE_EQUAL(binaryGetter.getAllBasicData(ParamObjectType::kPM, 1000).size(), 0u);
+  boost::filesystem::remove(compiledFileName);
+}
+
+BOOST_AUTO_TEST_CASE(only_modified_contents_make_the_file_stale)
+{
+  auto jsonFileName = boost::filesystem::unique_path("DB%%%%.json").string();
+  auto compiledFileName = JPetParamBinaryFile::getCompiledFileName(jsonFileName);
+  BOOST_REQUIRE_EQUAL(compiledFileName, jsonFileName + ".bin");
+  {
+    std::ofstream file(jsonFileName);
+    file << "{\"1\": {\"PMs\": [{\"id\": 1, \"is_right_side\": true}]}}";
+  }
+  BOOST_REQUIRE(!JPetParamBinaryFile::isUpToDate(jsonFileName, compiledFileName));
+  BOOST_REQUIRE(JPetParamBinaryFile::compile(jsonFileName, compiledFileName));
+  BOOST_REQUIRE(JPetParamBinaryFile::isUpToDate(jsonFileName, compiledFileName));
+  auto document = JPetParamBinaryFile::read(compiledFileName);
+  BOOST_REQUIRE_EQUAL(document->getRun("1")->at("PMs").front().at("is_right_side"), "1");
+  {
+    std::ofstream file(jsonFileName);
+    file << "{\"1\": {\"PMs\": [{\"id\": 1, \"is_right_side\": true}]}}";
+  }
+  BOOST_REQUIRE(JPetParamBinaryFile::isUpToDate(jsonFileName, compiledFileName));
+  {
+    std::ofstream file(jsonFileName);
+    file << "{\"1\": {\"PMs\": [{\"id\": 2, \"is_right_side\": true}]}}";
+  }
+  BOOST_REQUIRE(!JPetParamBinaryFile::isUpToDate(jsonFileName, compiledFileName));
+  BOOST_REQUIRE(JPetParamBinaryFile::compile(jsonFileName, compiledFileName));
+  {
+    std::ofstream file(jsonFileName, std::ios::app);
+    file << "\n";
+  }
+  BOOST_REQUIRE(!JPetParamBinaryFile::isUpToDate(jsonFileName, compiledFileName));
+  boost::filesystem::remove(jsonFileName);
+  boost::filesystem::remove(compiledFileName);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_file_is_rejected)
+{
+  auto compiledFileName = boost::filesystem::unique_path("compiledDB%%%%.json.bin").string();
+  BOOST_REQUIRE(JPetParamBinaryFile::compile(dataFileName, compiledFileName));
+  {
+    std::fstream file(compiledFileName, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-10, std::ios::end);
+    file.put('\x7f');
+  }
+  BOOST_REQUIRE_THROW(JPetParamBinaryFile::read(compiledFileName), std::runtime_error);
+  {
+    std::ofstream file(compiledFileName, std::ios::binary);
+    file << "{}";
+  }
+  BOOST_REQUIRE_THROW(JPetParamBinaryFile::read(compiledFileName), std::runtime_error);
+  BOOST_REQUIRE(!JPetParamBinaryFile::isUpToDate(dataFileName, compiledFileName));
+  boost::filesystem::remove(compiledFileName);
+}
+
+BOOST_AUTO_TEST_CASE(param_manager_uses_compiled_file)
+{
+  auto jsonFileName = boost::filesystem::unique_path("DB%%%%.json").string();
+  boost::filesystem::copy_file(dataFileName, jsonFileName);
+  std::map<std::string, boost::any> options;
+  options["localDB_std::string"] = jsonFileName;
+  options["localDBCompile_bool"] = true;
+  auto paramManager = JPetParamManager::generateParamManager(options);
+  BOOST_REQUIRE(JPetParamBinaryFile::isUpToDate(jsonFileName, JPetParamBinaryFile::getCompiledFileName(jsonFileName)));
+  paramManager->fillParameterBank(1);
+  BOOST_REQUIRE_EQUAL(paramManager->getParamBank().getPMsSize(), 4);
+  boost::filesystem::remove(jsonFileName);
+  boost::filesystem::remove(JPetParamBinaryFile::getCompiledFileName(jsonFileName));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -143,6 +143,20 @@ BOOST_AUTO_TEST_CASE(getParamBankTest)
   checkContainersSize(bank);
 }
 
+BOOST_AUTO_TEST_CASE(managersOfTheSameRunShareParamBank)
+{
+  JPetParamManager firstManager(new JPetParamGetterAscii(dataFileName));
+  JPetParamManager secondManager(new JPetParamGetterAscii(dataFileName));
+  firstManager.fillParameterBank(1);
+  secondManager.fillParameterBank(1);
+  BOOST_REQUIRE(firstManager.getParamBankAsShared());
+  BOOST_REQUIRE_EQUAL(firstManager.getParamBankAsShared(), secondManager.getParamBankAsShared());
+  checkContainersSize(secondManager.getParamBank());
+  secondManager.clearParameters();
+  BOOST_REQUIRE_EQUAL(secondManager.getParamBank().getPMsSize(), 0);
+  checkContainersSize(firstManager.getParamBank());
+}
+
 BOOST_AUTO_TEST_CASE(getParamBankTestWithScopeSettings)
 {
   std::set<ParamObjectType> expectMissing;
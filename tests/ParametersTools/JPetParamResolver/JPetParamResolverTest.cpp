@@ -0,0 +1,172 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetParamResolverTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetParamResolverTest
+
+#include "JPetParamResolver/JPetParamResolver.h"
+#include "JPetHit/JPetHit.h"
+#include "JPetRawSignal/JPetRawSignal.h"
+#include "JPetSigCh/JPetSigCh.h"
+
+#include <TFile.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+namespace
+{
+std::shared_ptr<JPetParamBank> createParamBank()
+{
+  auto bank = std::make_shared<JPetParamBank>();
+  bank->addPM(JPetPM(JPetPM::SideB, 222, 32, 64, std::make_pair(16.f, 32.f), "testPM"));
+  bank->addScintillator(JPetScin(111, 8.f, 2.f, 4.f, 8.f));
+  bank->addBarrelSlot(JPetBarrelSlot(7, true, "barrelSlotTest", 35.f, 6));
+  bank->addTRB(JPetTRB(333, 64, 128));
+  bank->buildIndex();
+  return bank;
+}
+
+/// Sets the TRef member of the object directly, as the setters did before the ids were introduced
+template <typename T>
+void setTRef(T& object, TClass* objectClass, const char* memberName, TObject& referenced)
+{
+  auto offset = objectClass->GetDataMemberOffset(memberName);
+  BOOST_REQUIRE(offset > 0);
+  *reinterpret_cast<TRef*>(reinterpret_cast<char*>(&object) + offset) = &referenced;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(JPetParamResolverTestSuite)
+
+BOOST_AUTO_TEST_CASE(binding_is_restored)
+{
+  BOOST_REQUIRE(!JPetParamResolver::getParamBank());
+  auto bank = createParamBank();
+  {
+    JPetParamResolver::Binding binding(bank);
+    BOOST_REQUIRE_EQUAL(JPetParamResolver::getParamBank(), bank.get());
+    {
+      JPetParamResolver::Binding nullBinding(nullptr);
+      BOOST_REQUIRE(!JPetParamResolver::getParamBank());
+    }
+    BOOST_REQUIRE_EQUAL(JPetParamResolver::getParamBank(), bank.get());
+    std::thread otherThread([]() { BOOST_REQUIRE(!JPetParamResolver::getParamBank()); });
+    otherThread.join();
+  }
+  BOOST_REQUIRE(!JPetParamResolver::getParamBank());
+}
+
+BOOST_AUTO_TEST_CASE(references_set_in_memory)
+{
+  JPetPM pm(1, "first");
+  JPetTRB trb(5, 64, 128);
+  JPetSigCh sigCh;
+  sigCh.setPM(pm);
+  sigCh.setTRB(trb);
+  BOOST_REQUIRE_EQUAL(&sigCh.getPM(), &pm);
+  BOOST_REQUIRE_EQUAL(&sigCh.getTRB(), &trb);
+  sigCh.Clear();
+  BOOST_REQUIRE(sigCh.getPM().isNullObject());
+}
+
+BOOST_AUTO_TEST_CASE(references_read_from_file)
+{
+  auto bank = createParamBank();
+  std::string fileName = boost::filesystem::unique_path("JPetParamResolverTest%%%%.root").string();
+  {
+    JPetSigCh sigCh(JPetSigCh::Leading, 10.f);
+    sigCh.setPM(bank->getPM(222));
+    sigCh.setTRB(bank->getTRB(333));
+    JPetHit hit;
+    hit.setScintillator(bank->getScintillator(111));
+    hit.setBarrelSlot(bank->getBarrelSlot(7));
+    TFile file(fileName.c_str(), "RECREATE");
+    file.WriteObject(&sigCh, "sigCh");
+    file.WriteObject(&hit, "hit");
+  }
+  TFile file(fileName.c_str(), "READ");
+  std::unique_ptr<JPetSigCh> sigCh(static_cast<JPetSigCh*>(file.Get("sigCh")));
+  std::unique_ptr<JPetHit> hit(static_cast<JPetHit*>(file.Get("hit")));
+  BOOST_REQUIRE(sigCh);
+  BOOST_REQUIRE(hit);
+  BOOST_REQUIRE(!hit->isScintillatorSet());
+  {
+    JPetParamResolver::Binding binding(bank);
+    BOOST_REQUIRE_EQUAL(&sigCh->getPM(), &bank->getPM(222));
+    BOOST_REQUIRE_EQUAL(&sigCh->getTRB(), &bank->getTRB(333));
+    BOOST_REQUIRE(sigCh->getFEB().isNullObject());
+    BOOST_REQUIRE(hit->isScintillatorSet());
+    BOOST_REQUIRE_EQUAL(&hit->getScintillator(), &bank->getScintillator(111));
+    BOOST_REQUIRE_EQUAL(&hit->getBarrelSlot(), &bank->getBarrelSlot(7));
+  }
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_CASE(pointers_of_older_binding_generation)
+{
+  auto bank = createParamBank();
+  JPetPM pm(JPetPM::SideA, 222, 0, 0, std::make_pair(0.f, 0.f), "standalone");
+  JPetRawSignal signal;
+  signal.setPM(pm);
+  BOOST_REQUIRE_EQUAL(&signal.getPM(), &pm);
+  {
+    JPetParamResolver::Binding binding(bank);
+    BOOST_REQUIRE_EQUAL(&signal.getPM(), &bank->getPM(222));
+    signal.setPM(pm);
+    BOOST_REQUIRE_EQUAL(&signal.getPM(), &pm);
+  }
+  /// the bank is not bound anymore and the pointer set during the binding is not used
+  BOOST_REQUIRE(signal.getPM().isNullObject());
+  BOOST_REQUIRE(signal.getBarrelSlot().isNullObject());
+}
+
+BOOST_AUTO_TEST_CASE(references_read_from_old_files)
+{
+  std::string fileName = boost::filesystem::unique_path("JPetParamResolverTest%%%%.root").string();
+  {
+    JPetPM pm(JPetPM::SideB, 222, 32, 64, std::make_pair(16.f, 32.f), "testPM");
+    JPetBarrelSlot barrelSlot(7, true, "barrelSlotTest", 35.f, 6);
+    JPetSigCh sigCh(JPetSigCh::Leading, 10.f);
+    setTRef(sigCh, JPetSigCh::Class(), "fPM", pm);
+    JPetRawSignal signal;
+    setTRef(signal, JPetBaseSignal::Class(), "fPM", pm);
+    setTRef(signal, JPetBaseSignal::Class(), "fBarrelSlot", barrelSlot);
+    TFile file(fileName.c_str(), "RECREATE");
+    file.WriteObject(&pm, "pm");
+    file.WriteObject(&barrelSlot, "barrelSlot");
+    file.WriteObject(&sigCh, "sigCh");
+    file.WriteObject(&signal, "signal");
+  }
+  TFile file(fileName.c_str(), "READ");
+  std::unique_ptr<JPetPM> pm(static_cast<JPetPM*>(file.Get("pm")));
+  std::unique_ptr<JPetBarrelSlot> barrelSlot(static_cast<JPetBarrelSlot*>(file.Get("barrelSlot")));
+  std::unique_ptr<JPetSigCh> sigCh(static_cast<JPetSigCh*>(file.Get("sigCh")));
+  std::unique_ptr<JPetRawSignal> signal(static_cast<JPetRawSignal*>(file.Get("signal")));
+  BOOST_REQUIRE(pm);
+  BOOST_REQUIRE(barrelSlot);
+  BOOST_REQUIRE(sigCh);
+  BOOST_REQUIRE(signal);
+  /// the objects have no ids, so the TRefs are used also with a bound bank
+  JPetParamResolver::Binding binding(createParamBank());
+  BOOST_REQUIRE_EQUAL(&sigCh->getPM(), pm.get());
+  BOOST_REQUIRE_EQUAL(&signal->getPM(), pm.get());
+  BOOST_REQUIRE_EQUAL(&signal->getBarrelSlot(), barrelSlot.get());
+  BOOST_REQUIRE_EQUAL(signal->getPM().getID(), 222);
+  boost::filesystem::remove(fileName);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
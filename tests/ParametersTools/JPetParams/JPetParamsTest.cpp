@@ -51,6 +51,32 @@ BOOST_AUTO_TEST_CASE(copyCtr)
   BOOST_REQUIRE_EQUAL(params2.getOptions().size(), params.getOptions().size());
 }
 
+BOOST_AUTO_TEST_CASE(copiesShareOptions)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["blaOption"] = std::string("value");
+  JPetParams params(opts, nullptr);
+  auto params2 = params;
+  BOOST_REQUIRE_EQUAL(&params2.getOptions(), &params.getOptions());
+  BOOST_REQUIRE_EQUAL(params2.getOptionsAsShared(), params.getOptionsAsShared());
+  JPetParams params3(params.getOptionsAsShared(), nullptr);
+  BOOST_REQUIRE_EQUAL(&params3.getOptions(), &params.getOptions());
+  JPetParams params4(std::shared_ptr<const jpet_options_tools::OptsStrAny>(), nullptr);
+  BOOST_REQUIRE(params4.getOptions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(getOptionHandle)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["time_double"] = 2.5;
+  JPetParams params(opts, nullptr);
+  auto time = params.getOptionHandle<double>("time_double");
+  BOOST_REQUIRE(time.isSet());
+  BOOST_REQUIRE_EQUAL(time.get(), 2.5);
+  BOOST_REQUIRE(!params.getOptionHandle<double>("other_double").isSet());
+  BOOST_REQUIRE(!JPetParams().getOptionHandle<double>("time_double").isSet());
+}
+
 BOOST_AUTO_TEST_CASE(memoryLeaks)
 {
   jpet_options_tools::OptsStrAny opts;
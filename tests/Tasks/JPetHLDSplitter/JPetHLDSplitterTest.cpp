@@ -0,0 +1,157 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetHLDSplitterTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetHLDSplitterTest
+
+#include "JPetHLDSplitter/JPetHLDSplitter.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/// Header of the given size, the remaining words of the header are filled with the tag
+std::string createHeader(std::uint32_t size, char tag)
+{
+  std::string header(JPetHLDSplitter::kHeaderSize, tag);
+  std::memcpy(&header[0], &size, sizeof(size));
+  return header;
+}
+
+/// Event with the given number of data bytes, padded to 8 bytes
+std::string createEvent(std::size_t dataSize, char tag)
+{
+  auto event = createHeader(JPetHLDSplitter::kHeaderSize + dataSize, tag) + std::string(dataSize, tag);
+  event.resize((event.size() + 7) / 8 * 8, 0);
+  return event;
+}
+
+std::string readFile(const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// Splits the data given in blocks of the given size, returns the contents of the chunks
+std::vector<std::string> split(const std::string& data, std::size_t chunkSize, std::size_t blockSize, long long maxEvents = -1)
+{
+  std::vector<std::string> chunks;
+  JPetHLDSplitter splitter("hldSplitterTest.hld", chunkSize,
+                           [&chunks](const std::string& chunkFileName) {
+                             chunks.push_back(readFile(chunkFileName));
+                             boost::filesystem::remove(chunkFileName);
+                             return true;
+                           },
+                           maxEvents);
+  for (std::size_t i = 0; i < data.size(); i += blockSize)
+  {
+    if (!splitter.write(data.data() + i, std::min(blockSize, data.size() - i)))
+    {
+      BOOST_REQUIRE(splitter.isEventLimitReached());
+      break;
+    }
+  }
+  BOOST_REQUIRE(splitter.close());
+  BOOST_REQUIRE_EQUAL(splitter.getNbOfChunks(), static_cast<int>(chunks.size()));
+  return chunks;
+}
+
+BOOST_AUTO_TEST_SUITE(JPetHLDSplitterTestSuite)
+
+BOOST_AUTO_TEST_CASE(chunks_of_whole_events)
+{
+  auto fileHeader = createHeader(JPetHLDSplitter::kHeaderSize, 'h');
+  std::vector<std::string> events = {createEvent(20, 'a'), createEvent(16, 'b'), createEvent(20, 'c'), createEvent(100, 'd'), createEvent(4, 'e')};
+  std::string data = fileHeader;
+  for (const auto& event : events)
+  {
+    data += event;
+  }
+  /// events of 56 and 48 bytes fit together, the large one makes up a chunk by itself
+  for (std::size_t blockSize : {std::size_t(1), std::size_t(7), data.size()})
+  {
+    auto chunks = split(data, 110, blockSize);
+    BOOST_REQUIRE_EQUAL(chunks.size(), 4u);
+    BOOST_REQUIRE_EQUAL(chunks[0], fileHeader + events[0] + events[1]);
+    BOOST_REQUIRE_EQUAL(chunks[1], fileHeader + events[2]);
+    BOOST_REQUIRE_EQUAL(chunks[2], fileHeader + events[3]);
+    BOOST_REQUIRE_EQUAL(chunks[3], fileHeader + events[4]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(event_limit)
+{
+  auto fileHeader = createHeader(JPetHLDSplitter::kHeaderSize, 'h');
+  std::string data = fileHeader;
+  for (char tag : {'a', 'b', 'c', 'd'})
+  {
+    data += createEvent(8, tag);
+  }
+  auto chunks = split(data, 1000, 5, 3);
+  BOOST_REQUIRE_EQUAL(chunks.size(), 1u);
+  BOOST_REQUIRE_EQUAL(chunks[0], data.substr(0, fileHeader.size() + 3 * createEvent(8, 'a').size()));
+}
+
+BOOST_AUTO_TEST_CASE(no_events)
+{
+  auto fileHeader = createHeader(JPetHLDSplitter::kHeaderSize, 'h');
+  auto chunks = split(fileHeader, 1000, 1000);
+  BOOST_REQUIRE_EQUAL(chunks.size(), 1u);
+  BOOST_REQUIRE_EQUAL(chunks[0], fileHeader);
+}
+
+BOOST_AUTO_TEST_CASE(truncated_data_kept_in_last_chunk)
+{
+  auto data = createHeader(JPetHLDSplitter::kHeaderSize, 'h') + createEvent(8, 'a') + createEvent(8, 'b').substr(0, 20);
+  auto chunks = split(data, 1000, 3);
+  BOOST_REQUIRE_EQUAL(chunks.size(), 1u);
+  BOOST_REQUIRE_EQUAL(chunks[0], data);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_event_size)
+{
+  auto data = createHeader(JPetHLDSplitter::kHeaderSize, 'h') + createHeader(8, 'a');
+  JPetHLDSplitter splitter("hldSplitterTest_corrupted.hld", 1000, [](const std::string&) { return true; });
+  BOOST_REQUIRE(!splitter.write(data.data(), data.size()));
+  BOOST_REQUIRE(!splitter.isEventLimitReached());
+  BOOST_REQUIRE(!splitter.close());
+}
+
+BOOST_AUTO_TEST_CASE(splitting_file)
+{
+  auto data = createHeader(JPetHLDSplitter::kHeaderSize, 'h') + createEvent(40, 'a') + createEvent(40, 'b');
+  {
+    std::ofstream file("hldSplitterTest_file.hld", std::ios::binary);
+    file << data;
+  }
+  std::vector<std::string> chunkFileNames;
+  JPetHLDSplitter splitter("hldSplitterTest_file.hld", 80, [&chunkFileNames](const std::string& chunkFileName) {
+    chunkFileNames.push_back(chunkFileName);
+    return true;
+  });
+  BOOST_REQUIRE(JPetHLDSplitter::splitFile("hldSplitterTest_file.hld", splitter));
+  BOOST_REQUIRE_EQUAL(chunkFileNames.size(), 2u);
+  BOOST_REQUIRE_EQUAL(chunkFileNames[0], "hldSplitterTest_file_0000.hld");
+  BOOST_REQUIRE_EQUAL(chunkFileNames[1], "hldSplitterTest_file_0001.hld");
+  BOOST_REQUIRE_EQUAL(readFile(chunkFileNames[1]), data.substr(0, 32) + createEvent(40, 'b'));
+  BOOST_REQUIRE(!JPetHLDSplitter::splitFile("hldSplitterTest_missing.hld", splitter));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
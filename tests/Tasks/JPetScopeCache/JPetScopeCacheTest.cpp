@@ -0,0 +1,151 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeCacheTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetScopeCacheTest
+
+#include "JPetScopeCache/JPetScopeCache.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+const std::string kInputDirectory = "scopeCacheTest_files";
+const std::string kCacheFile = "scopeCacheTest.scope.cache";
+const std::map<std::string, int> kPrefixToPMId = {{"C1", 1}, {"C2", 2}};
+
+/// Creates the directory with two scope files in each of three time windows
+std::vector<JPetScopeCache::Window> createWindows()
+{
+  boost::filesystem::remove_all(kInputDirectory);
+  boost::filesystem::create_directories(kInputDirectory + "/position");
+  std::vector<JPetScopeCache::Window> windows;
+  for (int i = 0; i < 3; i++)
+  {
+    JPetScopeCache::Window window{i, {}};
+    for (const auto& prefix : kPrefixToPMId)
+    {
+      auto fileName = kInputDirectory + "/position/" + prefix.first + "_0000" + std::to_string(i) + ".txt";
+      std::ofstream file(fileName);
+      file << "LECROYWR625Zi 1234 Waveform\nSegments 1 SegmentSize 3\n\n\nTime Ampl\n";
+      for (int j = 0; j < 3; j++)
+      {
+        file << j << "e-10 " << -(i + j + prefix.second) << "e-3\n";
+      }
+      window.second[fileName] = prefix.second;
+    }
+    windows.push_back(window);
+  }
+  return windows;
+}
+
+void writeCache(const std::vector<JPetScopeCache::Window>& windows)
+{
+  JPetScopeCache cache(kCacheFile, kInputDirectory, kPrefixToPMId);
+  cache.snapshotDirectories();
+  BOOST_REQUIRE(cache.create(windows));
+  for (const auto& window : windows)
+  {
+    BOOST_REQUIRE(cache.writeSignals(JPetScopeWindowReader::readWindow(window)));
+  }
+  BOOST_REQUIRE(cache.close());
+}
+
+BOOST_AUTO_TEST_SUITE(JPetScopeCacheTestSuite)
+
+BOOST_AUTO_TEST_CASE(no_cache)
+{
+  boost::filesystem::remove(kCacheFile);
+  JPetScopeCache cache(kCacheFile, kInputDirectory, kPrefixToPMId);
+  BOOST_REQUIRE(!cache.open());
+  BOOST_REQUIRE(cache.getWindows().empty());
+}
+
+BOOST_AUTO_TEST_CASE(write_and_read)
+{
+  auto windows = createWindows();
+  writeCache(windows);
+  JPetScopeCache cache(kCacheFile, kInputDirectory, kPrefixToPMId);
+  BOOST_REQUIRE(cache.open());
+  BOOST_REQUIRE(cache.getWindows() == windows);
+  for (const auto& window : windows)
+  {
+    JPetScopeCache::Signals signals;
+    BOOST_REQUIRE(cache.readSignals(signals));
+    auto expected = JPetScopeWindowReader::readWindow(window);
+    BOOST_REQUIRE_EQUAL(signals.size(), expected.size());
+    for (const auto& signal : expected)
+    {
+      const auto& points = signals.at(signal.first).getShape();
+      const auto& expectedPoints = signal.second.getShape();
+      BOOST_REQUIRE_EQUAL(points.size(), expectedPoints.size());
+      for (std::size_t i = 0; i < points.size(); i++)
+      {
+        BOOST_REQUIRE_EQUAL(points[i].time, expectedPoints[i].time);
+        BOOST_REQUIRE_EQUAL(points[i].amplitude, expectedPoints[i].amplitude);
+      }
+    }
+  }
+  JPetScopeCache::Signals signals;
+  BOOST_REQUIRE(!cache.readSignals(signals));
+  BOOST_REQUIRE(cache.close());
+}
+
+BOOST_AUTO_TEST_CASE(other_parameters)
+{
+  writeCache(createWindows());
+  JPetScopeCache cache(kCacheFile, kInputDirectory, {{"C1", 1}, {"C2", 3}});
+  BOOST_REQUIRE(!cache.open());
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_cache)
+{
+  writeCache(createWindows());
+  {
+    std::fstream file(kCacheFile, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(100);
+    char byte = file.get();
+    file.seekp(100);
+    file.put(byte ^ 1);
+  }
+  JPetScopeCache cache(kCacheFile, kInputDirectory, kPrefixToPMId);
+  BOOST_REQUIRE(!cache.open());
+}
+
+BOOST_AUTO_TEST_CASE(modified_directory)
+{
+  writeCache(createWindows());
+  auto directory = kInputDirectory + "/position";
+  boost::filesystem::last_write_time(directory, boost::filesystem::last_write_time(directory) - 10);
+  JPetScopeCache cache(kCacheFile, kInputDirectory, kPrefixToPMId);
+  BOOST_REQUIRE(!cache.open());
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_cache_is_not_saved)
+{
+  boost::filesystem::remove(kCacheFile);
+  auto windows = createWindows();
+  {
+    JPetScopeCache cache(kCacheFile, kInputDirectory, kPrefixToPMId);
+    BOOST_REQUIRE(cache.create(windows));
+    BOOST_REQUIRE(cache.writeSignals(JPetScopeWindowReader::readWindow(windows[0])));
+    BOOST_REQUIRE(!cache.close());
+  }
+  BOOST_REQUIRE(!boost::filesystem::exists(kCacheFile));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeFileReaderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetScopeFileReaderTest
+
+#include "JPetScopeFileReader/JPetScopeFileReader.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(JPetScopeFileReaderTestSuite)
+
+BOOST_AUTO_TEST_CASE(parse_float_like_strtof)
+{
+  std::vector<std::string> numbers = {"0", "-0", "1", "+2.5", "-1.2345678e-08", "3.0517578125e-05", "0.000123456789",
+                                      "12345.678", "1E3", "-7.5e+01", ".5", "5.", "123456789012345678901234", "1e-40"};
+  for (const auto& number : numbers)
+  {
+    float value = 0.f;
+    auto end = JPetScopeFileReader::parseFloat(number.data(), number.data() + number.size(), value);
+    BOOST_REQUIRE(end == number.data() + number.size());
+    BOOST_REQUIRE_CLOSE(value, std::strtof(number.c_str(), nullptr), 1e-5);
+  }
+  float value = 0.f;
+  std::string notNumber = "abc";
+  BOOST_REQUIRE(!JPetScopeFileReader::parseFloat(notNumber.data(), notNumber.data() + notNumber.size(), value));
+  std::string dotOnly = "-.e5";
+  BOOST_REQUIRE(!JPetScopeFileReader::parseFloat(dotOnly.data(), dotOnly.data() + dotOnly.size(), value));
+  std::string danglingExponent = "1.5e";
+  auto end = JPetScopeFileReader::parseFloat(danglingExponent.data(), danglingExponent.data() + danglingExponent.size(), value);
+  BOOST_REQUIRE(end == danglingExponent.data() + 3);
+  BOOST_REQUIRE_EQUAL(value, 1.5f);
+}
+
+BOOST_AUTO_TEST_CASE(parse_int)
+{
+  int value = 0;
+  std::string number = "502,";
+  auto end = JPetScopeFileReader::parseInt(number.data(), number.data() + number.size(), value);
+  BOOST_REQUIRE(end == number.data() + 3);
+  BOOST_REQUIRE_EQUAL(value, 502);
+  std::string notNumber = "x1";
+  BOOST_REQUIRE(!JPetScopeFileReader::parseInt(notNumber.data(), notNumber.data() + notNumber.size(), value));
+}
+
+BOOST_AUTO_TEST_CASE(parse_signal_with_header)
+{
+  std::string data = "Header line\nSegments 1 SegmentSize 3\nline3\nline4\nTime Ampl\n"
+                     "-1.0e-09 -0.002\n0.0e+00\t-0.05\r\n1.0e-09 -0.1\n";
+  JPetRecoSignal signal;
+  BOOST_REQUIRE(JPetScopeFileReader::parseSignal(data.data(), data.size(), true, signal));
+  const auto& shape = signal.getShape();
+  BOOST_REQUIRE_EQUAL(shape.size(), 3u);
+  BOOST_REQUIRE_CLOSE(shape[0].time, -1000., 1e-4);
+  BOOST_REQUIRE_CLOSE(shape[0].amplitude, -2., 1e-4);
+  BOOST_REQUIRE_SMALL(shape[1].time, 1e-6);
+  BOOST_REQUIRE_CLOSE(shape[1].amplitude, -50., 1e-4);
+  BOOST_REQUIRE_CLOSE(shape[2].time, 1000., 1e-4);
+  BOOST_REQUIRE_CLOSE(shape[2].amplitude, -100., 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(parse_signal_with_errors)
+{
+  std::string data = "Header line\nSegments 1 SegmentSize 3\nline3\nline4\nTime Ampl\n"
+                     "1e-09 -0.1\nabc def\n2e-09 -0.2\n";
+  JPetRecoSignal signal;
+  BOOST_REQUIRE(JPetScopeFileReader::parseSignal(data.data(), data.size(), true, signal));
+  BOOST_REQUIRE_EQUAL(signal.getShape().size(), 2u);
+  std::string truncated = "Header line\nSegments 1 SegmentSize 3\nline3\nline4\nTime Ampl\n1e-09 -0.1\n";
+  BOOST_REQUIRE(!JPetScopeFileReader::parseSignal(truncated.data(), truncated.size(), true, signal));
+  BOOST_REQUIRE_EQUAL(signal.getShape().size(), 1u);
+  std::string noHeader = "1e-09 -0.1\n";
+  BOOST_REQUIRE(JPetScopeFileReader::parseSignal(noHeader.data(), noHeader.size(), false, signal));
+  BOOST_REQUIRE(signal.getShape().empty());
+}
+
+BOOST_AUTO_TEST_CASE(read_signal_from_file)
+{
+  const char* fileName = "scopeFileReaderTest_C1_00001.txt";
+  {
+    std::ofstream file(fileName);
+    file << "LECROYWR625Zi 1234 Waveform\nSegments 1 SegmentSize 3\n\n\nTime Ampl\n"
+         << "-1.0e-09 -0.002\n" << "0 -0.05\n" << "1.0e-09 -0.1";
+  }
+  JPetRecoSignal signal;
+  BOOST_REQUIRE(JPetScopeFileReader::readSignal(fileName, signal));
+  BOOST_REQUIRE_EQUAL(signal.getShape().size(), 3u);
+  BOOST_REQUIRE_CLOSE(signal.getShape()[2].amplitude, -100., 1e-4);
+  BOOST_REQUIRE(!JPetScopeFileReader::readSignal("scopeFileReaderTest_missing.txt", signal));
+  BOOST_REQUIRE(signal.getShape().empty());
+}
+
+BOOST_AUTO_TEST_CASE(has_header)
+{
+  BOOST_REQUIRE(JPetScopeFileReader::hasHeader("C1_00001.txt"));
+  BOOST_REQUIRE(!JPetScopeFileReader::hasHeader("some/path/C1_00001.tsv"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file JPetScopeWindowReaderTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetScopeWindowReaderTest
+
+#include "JPetScopeWindowReader/JPetScopeWindowReader.h"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// Writes the scope file with the given number of points, all with the amplitude equal to value mV
+std::string createScopeFile(const std::string& fileName, int nbOfPoints, int value)
+{
+  std::ofstream file(fileName);
+  file << "LECROYWR625Zi 1234 Waveform\nSegments 1 SegmentSize " << nbOfPoints << "\n\n\nTime Ampl\n";
+  for (int i = 0; i < nbOfPoints; i++)
+  {
+    file << i << "e-10 " << value << "e-3\n";
+  }
+  return fileName;
+}
+
+/// Creates windows with two files each, the amplitudes equal to the window index and the window index + 1000
+std::vector<JPetScopeWindowReader::Window> createWindows(int nbOfWindows)
+{
+  std::vector<JPetScopeWindowReader::Window> windows;
+  for (int i = 0; i < nbOfWindows; i++)
+  {
+    auto fileC1 = createScopeFile("scopeWindowReaderTest_C1_" + std::to_string(i) + ".txt", 10 + i, i);
+    auto fileC2 = createScopeFile("scopeWindowReaderTest_C2_" + std::to_string(i) + ".txt", 10, i + 1000);
+    windows.push_back({i, {{fileC1, 1}, {fileC2, 2}}});
+  }
+  return windows;
+}
+
+BOOST_AUTO_TEST_SUITE(JPetScopeWindowReaderTestSuite)
+
+BOOST_AUTO_TEST_CASE(no_windows)
+{
+  JPetScopeWindowReader reader({});
+  BOOST_REQUIRE_EQUAL(reader.getNbOfWindows(), 0u);
+  BOOST_REQUIRE_EQUAL(reader.getNbOfThreads(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(windows_are_returned_in_order)
+{
+  auto windows = createWindows(20);
+  for (unsigned int nbOfThreads : {1u, 3u, 8u})
+  {
+    JPetScopeWindowReader reader(windows, nbOfThreads, 2);
+    for (std::size_t i = 0; i < windows.size(); i++)
+    {
+      auto signals = reader.getSignals(i);
+      BOOST_REQUIRE_EQUAL(signals.size(), 2u);
+      const auto& signalC1 = signals.at("scopeWindowReaderTest_C1_" + std::to_string(i) + ".txt");
+      BOOST_REQUIRE_EQUAL(signalC1.getShape().size(), 10 + i);
+      BOOST_REQUIRE_CLOSE(signalC1.getShape().back().amplitude, static_cast<double>(i), 1e-3);
+      const auto& signalC2 = signals.at("scopeWindowReaderTest_C2_" + std::to_string(i) + ".txt");
+      BOOST_REQUIRE_CLOSE(signalC2.getShape().front().amplitude, i + 1000., 1e-3);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stopping_before_all_windows_are_consumed)
+{
+  auto windows = createWindows(10);
+  JPetScopeWindowReader reader(windows, 4, 1);
+  BOOST_REQUIRE_EQUAL(reader.getSignals(0).size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(missing_files_give_empty_signals)
+{
+  JPetScopeWindowReader::Window window = {0, {{"scopeWindowReaderTest_missing.txt", 1}}};
+  auto signals = JPetScopeWindowReader::readWindow(window);
+  BOOST_REQUIRE_EQUAL(signals.size(), 1u);
+  BOOST_REQUIRE(signals.begin()->second.getShape().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/**
+ *  @copyright Copyright 2018 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file HelperMathFunctionsBenchmark.cpp
+ */
+
+/**
+ * Benchmark of the batched polynomial fit (PolynomialFitBatch) against polynomialFit().
+ *
+ * The signals have 1 to 4 leading edge points at the thresholds of J-PET, with the times
+ * generated from a fixed seed, so every run fits the same signals.
+ * Usage: HelperMathFunctionsBenchmark.x [numberOfSignals [numberOfRepetitions]]
+ * Returns 1 if the results of the batched fit differ from the ones of polynomialFit().
+ */
+
+#include "JPetSimplePhysSignalReco/HelperMathFunctions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+const float kThresholds[PolynomialFitBatch::kMaxPoints] = {-0.08f, -0.16f, -0.24f, -0.32f};
+const float kV0 = -0.1f;
+
+struct Signal
+{
+  int numberOfPoints = 0;
+  float times[PolynomialFitBatch::kMaxPoints];
+  float volts[PolynomialFitBatch::kMaxPoints];
+};
+
+std::vector<Signal> generateSignals(std::size_t numberOfSignals)
+{
+  std::mt19937 generator(20180101);
+  std::uniform_int_distribution<int> numberOfPoints(1, PolynomialFitBatch::kMaxPoints);
+  std::uniform_real_distribution<float> startTime(0.f, 1.e6f);
+  std::normal_distribution<float> riseTime(2000.f, 200.f);
+  std::vector<Signal> signals(numberOfSignals);
+  for (auto& signal : signals)
+  {
+    signal.numberOfPoints = numberOfPoints(generator);
+    float start = startTime(generator);
+    for (int k = 0; k < signal.numberOfPoints; k++)
+    {
+      signal.volts[k] = kThresholds[k];
+      signal.times[k] = start + riseTime(generator) * (k + 1) / PolynomialFitBatch::kMaxPoints;
+    }
+  }
+  return signals;
+}
+
+double getNanosecondsPerSignal(std::chrono::steady_clock::duration duration, std::size_t numberOfFits)
+{
+  return std::chrono::duration<double, std::nano>(duration).count() / numberOfFits;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t numberOfSignals = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  int numberOfRepetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+  auto signals = generateSignals(numberOfSignals);
+  std::vector<float> scalarResults(numberOfSignals);
+  std::vector<float> batchResults;
+  PolynomialFitBatch batch;
+  batch.reserve(numberOfSignals);
+  bool isSame = true;
+  std::cout << "signals: " << numberOfSignals << ", repetitions: " << numberOfRepetitions << std::endl;
+  for (int alfa = 1; alfa <= 3; alfa++)
+  {
+    auto scalarDuration = std::chrono::steady_clock::duration::max();
+    auto batchDuration = std::chrono::steady_clock::duration::max();
+    for (int repetition = 0; repetition < numberOfRepetitions; repetition++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < numberOfSignals; i++)
+      {
+        const auto& signal = signals[i];
+        ublas::vector<float> t(signal.numberOfPoints);
+        ublas::vector<float> v(signal.numberOfPoints);
+        for (int k = 0; k < signal.numberOfPoints; k++)
+        {
+          t(k) = signal.times[k];
+          v(k) = signal.volts[k];
+        }
+        scalarResults[i] = polynomialFit(t, v, alfa, kV0);
+      }
+      scalarDuration = std::min(scalarDuration, std::chrono::steady_clock::now() - start);
+
+      start = std::chrono::steady_clock::now();
+      batch.clear();
+      for (const auto& signal : signals)
+      {
+        batch.add(signal.times, signal.volts, signal.numberOfPoints);
+      }
+      batch.fit(alfa, kV0, batchResults);
+      batchDuration = std::min(batchDuration, std::chrono::steady_clock::now() - start);
+    }
+    isSame = isSame && batchResults == scalarResults;
+    std::cout << "alfa " << alfa << ": polynomialFit " << getNanosecondsPerSignal(scalarDuration, numberOfSignals)
+              << " ns/signal, PolynomialFitBatch (add and fit) " << getNanosecondsPerSignal(batchDuration, numberOfSignals) << " ns/signal"
+              << std::endl;
+  }
+  if (!isSame)
+  {
+    std::cerr << "The results of PolynomialFitBatch differ from the ones of polynomialFit" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -61,4 +61,39 @@ BOOST_AUTO_TEST_CASE(polynomialFitTest2)
   BOOST_REQUIRE_CLOSE(result, 793.1, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(polynomialFitBatchTest)
+{
+  float time[4] = {1035.0, 1542.0, 2282.0, 2900.0};
+  float volt[4] = {-0.06, -0.20, -0.35, -0.50};
+  PolynomialFitBatch batch;
+  for (int numberOfPoints = 0; numberOfPoints <= 4; numberOfPoints++)
+  {
+    BOOST_REQUIRE(batch.add(time, volt, numberOfPoints));
+  }
+  BOOST_REQUIRE(!batch.add(time, volt, 5));
+  BOOST_REQUIRE_EQUAL(batch.getSize(), 5u);
+  std::vector<float> results;
+  for (int alfa = 0; alfa <= 3; alfa++)
+  {
+    batch.fit(alfa, -0.1, results);
+    BOOST_REQUIRE_EQUAL(results.size(), 5u);
+    for (int numberOfPoints = 0; numberOfPoints <= 4; numberOfPoints++)
+    {
+      vector<float> t(numberOfPoints);
+      vector<float> v(numberOfPoints);
+      for (int i = 0; i < numberOfPoints; i++)
+      {
+        t(i) = time[i];
+        v(i) = volt[i];
+      }
+      BOOST_REQUIRE_EQUAL(results[numberOfPoints], polynomialFit(t, v, alfa, -0.1));
+    }
+  }
+  batch.fit(2, -0.05, results);
+  BOOST_REQUIRE_CLOSE(results[4], 793.1, 0.1);
+  batch.clear();
+  batch.fit(1, -0.1, results);
+  BOOST_REQUIRE(results.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
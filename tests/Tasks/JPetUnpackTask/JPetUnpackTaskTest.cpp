@@ -17,9 +17,77 @@
 #define BOOST_TEST_MODULE JPetUnpackTaskTest
 
 #include "JPetOptionsGenerator/JPetOptionsGeneratorTools.h"
+#include "JPetParamsFactory/JPetParamsFactory.h"
+#include "JPetStreamedFile/JPetStreamedFile.h"
+#include "JPetTaskIO/JPetOutputHandler.h"
 #include "JPetUnpackTask/JPetUnpackTask.h"
+#include "JPetUnzipTask/JPetUnzipTask.h"
+#include <TFile.h>
+#include <TTree.h>
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+const std::string kHLDFile = "unitTestData/JPetUnpackerTest/xx14099113231.hld";
+const std::string kConfigFile = "unitTestData/JPetUnpackerTest/conf_trb3.xml";
+
+std::uint32_t computeCrc32(const std::string& data)
+{
+  std::uint32_t crc = 0xFFFFFFFF;
+  for (unsigned char byte : data) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+void writeLittleEndian(std::ofstream& file, std::uint32_t value)
+{
+  for (int i = 0; i < 4; i++) {
+    file.put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+/// Writes the file as a gzip archive whose deflate stream consists of stored (not compressed) blocks
+void writeStoredGzip(const std::string& fileName, const std::string& gzFileName)
+{
+  std::ifstream input(fileName, std::ios::binary);
+  std::string data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  std::ofstream file(gzFileName, std::ios::binary);
+  const char header[] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff'};
+  file.write(header, sizeof(header));
+  std::size_t offset = 0;
+  do {
+    std::size_t size = std::min<std::size_t>(data.size() - offset, 65535);
+    const char blockHeader[] = {
+      static_cast<char>(offset + size == data.size() ? 1 : 0),
+      static_cast<char>(size & 0xff), static_cast<char>(size >> 8),
+      static_cast<char>(~size & 0xff), static_cast<char>((~size >> 8) & 0xff)
+    };
+    file.write(blockHeader, sizeof(blockHeader));
+    file.write(data.data() + offset, size);
+    offset += size;
+  } while (offset < data.size());
+  writeLittleEndian(file, computeCrc32(data));
+  writeLittleEndian(file, static_cast<std::uint32_t>(data.size()));
+}
+
+bool runTask(JPetTask& task, const JPetParams& params, JPetParams& controlParams)
+{
+  return task.init(params) && task.run(JPetDataInterface()) && task.terminate(controlParams);
+}
+
+long long countEntries(const std::string& fileName)
+{
+  TFile file(fileName.c_str(), "READ");
+  auto tree = dynamic_cast<TTree*>(file.Get("T"));
+  return tree ? tree->GetEntries() : -1;
+}
 
 BOOST_AUTO_TEST_SUITE(UnpackTaskSuite)
 
@@ -59,4 +127,45 @@ BOOST_AUTO_TEST_CASE(good_init_test)
   ));
 }
 
+BOOST_AUTO_TEST_CASE(unpacking_while_unzipping)
+{
+  auto opts = jpet_options_generator_tools::getDefaultOptions();
+  opts["inputFile_std::string"] = kHLDFile;
+  opts["outputPath_std::string"] = std::string("./");
+  opts["unpackerConfigFile_std::string"] = kConfigFile;
+  JPetParams controlParams;
+  JPetUnpackTask referenceTask;
+  BOOST_REQUIRE(runTask(referenceTask, JPetParams(opts, nullptr), controlParams));
+  auto nbOfEntries = countEntries("./xx14099113231.hld.root");
+  BOOST_REQUIRE(nbOfEntries > 0);
+
+  writeStoredGzip(kHLDFile, "unpackTaskTest_stream.hld.gz");
+  opts["inputFile_std::string"] = std::string("unpackTaskTest_stream.hld.gz");
+  opts["streamUnpacking_bool"] = true;
+  opts["streamUnpackingChunkSizeMB_int"] = 1;
+  JPetParams params(opts, nullptr);
+  controlParams = JPetParams();
+  {
+    JPetUnzipTask unzipTask;
+    JPetUnpackTask unpackTask;
+    BOOST_REQUIRE(runTask(unzipTask, params, controlParams));
+    /// the decompressed file is never written, the unpacking starts from the first chunk
+    BOOST_REQUIRE(JPetStreamedFile::find("./unpackTaskTest_stream.hld"));
+    BOOST_REQUIRE(runTask(unpackTask, jpet_params_factory::generateParams(params, controlParams), controlParams));
+    auto output = JPetStreamedFile::find("./unpackTaskTest_stream.hld.root");
+    BOOST_REQUIRE(output);
+    long long nbOfStreamedEntries = 0;
+    std::string partFileName;
+    for (std::size_t i = 0; output->waitForPart(i, partFileName); i++) {
+      BOOST_REQUIRE_EQUAL(partFileName, JPetOutputHandler::getPartFileName("./unpackTaskTest_stream.hld.root", i));
+      nbOfStreamedEntries += countEntries(partFileName);
+    }
+    BOOST_REQUIRE(output->isSuccessful());
+    BOOST_REQUIRE_EQUAL(nbOfStreamedEntries, nbOfEntries);
+  }
+  BOOST_REQUIRE(!boost::filesystem::exists("unpackTaskTest_stream.hld"));
+  BOOST_REQUIRE(!boost::filesystem::exists("unpackTaskTest_stream_0000.hld"));
+  BOOST_REQUIRE(boost::filesystem::exists("./unpackTaskTest_stream.hld.manifest"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
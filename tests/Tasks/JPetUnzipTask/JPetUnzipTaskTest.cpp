@@ -19,6 +19,9 @@
 #include "./JPetUnzipTask/JPetUnzipTask.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
 
 BOOST_AUTO_TEST_SUITE(JPetUnzipTaskSuite)
 
@@ -136,4 +139,37 @@ BOOST_AUTO_TEST_CASE(wrongZip)
   ));
 }
 
+BOOST_AUTO_TEST_CASE(unzippedFileNames)
+{
+  BOOST_REQUIRE_EQUAL(JPetUnzipTask::getUnzippedFileName("dir/file.hld.gz", "./"), "dir/file.hld");
+  BOOST_REQUIRE_EQUAL(JPetUnzipTask::getUnzippedFileName("dir/file.hld.xz", "dir/"), "dir/file.hld");
+  BOOST_REQUIRE_EQUAL(JPetUnzipTask::getUnzippedFileName("dir/file.hld.bz2", "out"), "out/file.hld");
+  BOOST_REQUIRE_EQUAL(JPetUnzipTask::getUnzippedFileName("dir/file.hld.zip", "./"), "file.hld");
+  BOOST_REQUIRE_EQUAL(JPetUnzipTask::getUnzippedFileName("dir/file.hld.zip", "out/"), "out/file.hld");
+}
+
+BOOST_AUTO_TEST_CASE(decompressToSink)
+{
+  boost::filesystem::remove("unitTestData/JPetTaskChainExecutorUtilsTest/goodGZ");
+  BOOST_REQUIRE(JPetUnzipTask::unzipFile(
+    "unitTestData/JPetTaskChainExecutorUtilsTest/goodGZ.gz", "./"
+  ));
+  std::string decompressed;
+  BOOST_REQUIRE(JPetUnzipTask::decompress(
+    "unitTestData/JPetTaskChainExecutorUtilsTest/goodGZ.gz",
+    [&decompressed](const char* data, std::size_t size) {
+      decompressed.append(data, size);
+      return true;
+    }
+  ));
+  std::ifstream unzipped("unitTestData/JPetTaskChainExecutorUtilsTest/goodGZ", std::ios::binary);
+  std::string expected((std::istreambuf_iterator<char>(unzipped)), std::istreambuf_iterator<char>());
+  BOOST_REQUIRE(decompressed == expected);
+
+  BOOST_REQUIRE(!JPetUnzipTask::decompress(
+    "unitTestData/JPetTaskChainExecutorUtilsTest/goodGZ.gz",
+    [](const char*, std::size_t) { return false; }
+  ));
+}
+
 BOOST_AUTO_TEST_SUITE_END()